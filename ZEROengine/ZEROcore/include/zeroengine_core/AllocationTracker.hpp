@@ -0,0 +1,116 @@
+#ifndef ZEROENGINE_ALLOCATIONTRACKER_H
+#define ZEROENGINE_ALLOCATIONTRACKER_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace ZEROengine {
+    constexpr uint32_t const_allocation_max_scopes = 64; // scope 0 collects allocations made outside of any scope
+    constexpr uint32_t const_allocation_max_threads = 64; // threads past the limit share the last slot
+    constexpr uint32_t const_allocation_scope_depth = 32;
+
+    struct AllocationCounters {
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        uint64_t bytes = 0; // bytes allocated
+    };
+
+    /**
+     * @brief Heap activity of one frame, per scope and per thread. Only the first scope_count and thread_count entries
+     * are used, threads are numbered in the order they first allocated.
+     *
+     */
+    struct AllocationFrameStatistics {
+        uint64_t frame = 0;
+        AllocationCounters total;
+        uint32_t scope_count = 0;
+        AllocationCounters scopes[const_allocation_max_scopes];
+        uint32_t thread_count = 0;
+        AllocationCounters threads[const_allocation_max_threads];
+    };
+
+    /**
+     * @brief Counts heap allocations made through operator new, per thread and per allocation scope.
+     * The global operator new and delete are only replaced when the engine is built with ZEROENGINE_ALLOCATION_TRACKING,
+     * otherwise every counter stays at zero. Recording never allocates nor locks, counters are per thread atomics
+     * summed by endFrame().
+     * In strict mode, endFrame() throws once a steady-state frame allocated, naming the scope that allocated the most.
+     *
+     */
+    class AllocationTracker {
+    public:
+        /**
+         * @brief Whether operator new is hooked in this build.
+         *
+         */
+        static bool isEnabled();
+
+        /**
+         * @brief Get the id of a scope, registering it the first time. Use ZERO_ALLOCATION_SCOPE instead of calling it directly.
+         *
+         * @param name A string with static storage duration.
+         * @return uint32_t 0 when every scope slot is taken.
+         */
+        static uint32_t registerScope(const char* name);
+        static const char* getScopeName(const uint32_t &scope);
+
+        static void pushScope(const uint32_t &scope);
+        static void popScope();
+
+        static void recordAllocation(const std::size_t &size);
+        static void recordFree();
+
+        /**
+         * @brief Close the current frame and compute its statistics. Called by the application main loop after each frame.
+         *
+         */
+        static void endFrame();
+        static const AllocationFrameStatistics& getLastFrame();
+        static uint64_t getFrame();
+
+        /**
+         * @brief Throw from endFrame() when a frame allocates, once warmup_frames frames have ended since this call.
+         * Strict mode turns itself off when it throws, so the exception does not fail the following frames.
+         *
+         */
+        static void setStrictMode(const bool &strict, const uint32_t &warmup_frames = 0);
+        static bool isStrictMode();
+
+        /**
+         * @brief Counters of the calling thread since it first allocated, every scope included.
+         *
+         */
+        static AllocationCounters getThreadCounters();
+    }; // class AllocationTracker
+
+    /**
+     * @brief Attributes the allocations of the calling thread to a scope until it is destroyed.
+     *
+     */
+    class AllocationScope {
+    public:
+        AllocationScope(const uint32_t &scope) {
+            AllocationTracker::pushScope(scope);
+        }
+        ~AllocationScope() {
+            AllocationTracker::popScope();
+        }
+
+        AllocationScope(const AllocationScope&) = delete;
+        AllocationScope& operator=(const AllocationScope&) = delete;
+    }; // class AllocationScope
+} // namespace ZEROengine
+
+#define ZERO_ALLOCATION_CONCAT_IMPL(a, b) a##b
+#define ZERO_ALLOCATION_CONCAT(a, b) ZERO_ALLOCATION_CONCAT_IMPL(a, b)
+
+#if defined(ZEROENGINE_ALLOCATION_TRACKING)
+// registers the name once per call site, then only pushes its id
+#define ZERO_ALLOCATION_SCOPE(name) \
+    static const uint32_t ZERO_ALLOCATION_CONCAT(__zero_allocation_scope_id, __LINE__) = ::ZEROengine::AllocationTracker::registerScope(name); \
+    ::ZEROengine::AllocationScope ZERO_ALLOCATION_CONCAT(__zero_allocation_scope, __LINE__)(ZERO_ALLOCATION_CONCAT(__zero_allocation_scope_id, __LINE__))
+#else
+#define ZERO_ALLOCATION_SCOPE(name) do {} while(0)
+#endif
+
+#endif // #ifndef ZEROENGINE_ALLOCATIONTRACKER_H
@@ -0,0 +1,58 @@
+#ifndef ZEROENGINE_IMAGEENCODER_H
+#define ZEROENGINE_IMAGEENCODER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ZEROengine {
+    /**
+     * @brief Encoders for 8 bit RGB and RGBA images, used to save captured frames without any image library.
+     * PNG output is lossless but uncompressed (stored deflate blocks), it favors encoding speed and exact pixels
+     * for comparisons over file size.
+     *
+     */
+    class ImageEncoder {
+    public:
+        /**
+         * @brief Encode pixels as a PNG file.
+         *
+         * @param pixels Top to bottom rows of tightly packed RGB or RGBA pixels.
+         * @param row_pitch Bytes between the starts of two rows, at least width * channels.
+         * @param channels 3 for RGB, 4 for RGBA.
+         * @param output Replaced by the file contents.
+         */
+        static void encodePNG(
+            const uint8_t* pixels,
+            const uint32_t &width,
+            const uint32_t &height,
+            const std::size_t &row_pitch,
+            const uint32_t &channels,
+            std::vector<uint8_t> &output);
+
+        /**
+         * @brief Encode pixels as a binary PPM file, alpha is dropped.
+         *
+         */
+        static void encodePPM(
+            const uint8_t* pixels,
+            const uint32_t &width,
+            const uint32_t &height,
+            const std::size_t &row_pitch,
+            const uint32_t &channels,
+            std::vector<uint8_t> &output);
+
+        static uint32_t crc32(const uint8_t* data, const std::size_t &size, const uint32_t &crc = 0);
+        static uint32_t adler32(const uint8_t* data, const std::size_t &size, const uint32_t &adler = 1);
+
+        /**
+         * @brief Write bytes to a file, replacing it.
+         *
+         * @return bool false if the file cannot be written.
+         */
+        static bool writeFile(const std::string &path, const std::vector<uint8_t> &bytes);
+    }; // class ImageEncoder
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_IMAGEENCODER_H
@@ -0,0 +1,42 @@
+#ifndef ZEROENGINE_INSTRUMENTEDMUTEX_H
+#define ZEROENGINE_INSTRUMENTEDMUTEX_H
+
+#include <cstdint>
+#include <mutex>
+#include <atomic>
+
+namespace ZEROengine {
+    struct MutexStatistics {
+        uint64_t acquisitions = 0;
+        uint64_t contentions = 0; // acquisitions that found the mutex taken
+        uint64_t wait_nanoseconds = 0; // time spent blocked by those contentions
+    };
+
+    /**
+     * @brief A std::mutex counting how often it is found locked and for how long callers wait on it.
+     * An uncontended lock costs one try_lock, only contended locks read the clock. Usable with std::lock_guard.
+     *
+     */
+    class InstrumentedMutex {
+    private:
+        std::mutex m_mutex;
+        std::atomic<uint64_t> m_acquisitions;
+        std::atomic<uint64_t> m_contentions;
+        std::atomic<uint64_t> m_wait_nanoseconds;
+
+    public:
+        InstrumentedMutex();
+
+        InstrumentedMutex(const InstrumentedMutex&) = delete;
+        InstrumentedMutex& operator=(const InstrumentedMutex&) = delete;
+
+        void lock();
+        bool try_lock();
+        void unlock();
+
+        MutexStatistics getStatistics() const;
+        void resetStatistics();
+    }; // class InstrumentedMutex
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_INSTRUMENTEDMUTEX_H
@@ -0,0 +1,44 @@
+#ifndef ZEROENGINE_RADIXSORT_H
+#define ZEROENGINE_RADIXSORT_H
+
+#include <cstdint>
+#include <vector>
+
+#include "zeroengine_core/ThreadPool.hpp"
+
+namespace ZEROengine {
+    /**
+     * @brief Stable LSD radix sort of 64 bit keys carrying a 32 bit payload, 8 bits per pass.
+     * Passes over digits that are identical in every key are skipped, and each pass histograms and scatters in parallel chunks.
+     * Scratch storage is kept between calls so sorting every frame does not allocate.
+     * 
+     */
+    class RadixSorter {
+    private:
+        std::vector<uint64_t> m_key_scratch;
+        std::vector<uint32_t> m_value_scratch;
+        std::vector<uint32_t> m_histograms; // 256 counters per chunk
+
+        uint32_t m_last_pass_count;
+
+    public:
+        RadixSorter();
+
+        /**
+         * @brief Sort keys ascending, moving values along with them. Equal keys keep their relative order.
+         * 
+         * @param keys The sort keys.
+         * @param values The payload, same size as keys.
+         * @param thread_pool Pool to spread the passes over, nullptr sorts on the calling thread.
+         */
+        void sort(std::vector<uint64_t> &keys, std::vector<uint32_t> &values, ThreadPool *thread_pool = nullptr);
+
+        /**
+         * @brief Number of digit passes run by the last sort, at most 8.
+         * 
+         */
+        uint32_t getLastPassCount() const;
+    }; // class RadixSorter
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_RADIXSORT_H
@@ -0,0 +1,79 @@
+#ifndef ZEROENGINE_TAGGEDHEAP_H
+#define ZEROENGINE_TAGGEDHEAP_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include <memory>
+
+namespace ZEROengine {
+    constexpr std::size_t const_tagged_heap_min_pooled_size = 16;
+    constexpr std::size_t const_tagged_heap_max_pooled_size = 4096;
+    // recycled blocks are aligned to a cache line, requests with a larger alignment are not pooled
+    constexpr std::size_t const_tagged_heap_pool_alignment = 64;
+
+    struct TaggedHeapStatistics {
+        uint64_t current_bytes = 0;
+        uint64_t peak_bytes = 0;
+        uint64_t live_allocations = 0;
+        uint64_t allocations = 0;
+        uint64_t reallocations = 0;
+        uint64_t frees = 0;
+        uint64_t pool_hits = 0; // allocations served from a recycled block
+        uint64_t pooled_bytes = 0; // bytes held by recycled blocks
+    };
+
+    /**
+     * @brief Thread-safe heap whose allocations carry a tag, for instance the subsystem or lifetime they belong to.
+     * Every tag has its own lock, statistics and recycled blocks, sorted in power of two size classes up to
+     * const_tagged_heap_max_pooled_size bytes. Freed small blocks are kept for the next allocation of their tag
+     * instead of going back to the system heap, so allocation patterns that repeat every frame stop reaching it.
+     * Larger blocks and over-aligned requests go straight to the system heap.
+     *
+     */
+    class TaggedHeap {
+    private:
+        struct Tag;
+        std::vector<std::unique_ptr<Tag>> m_tags;
+
+    public:
+        TaggedHeap(const uint32_t &tag_count);
+        ~TaggedHeap();
+
+        TaggedHeap(const TaggedHeap&) = delete;
+        TaggedHeap& operator=(const TaggedHeap&) = delete;
+
+        /**
+         * @brief Allocate size bytes aligned to alignment, a power of two.
+         *
+         * @return void* nullptr when the system heap is exhausted.
+         */
+        void* allocate(const std::size_t &size, const std::size_t &alignment, const uint32_t &tag);
+
+        /**
+         * @brief Resize an allocation, the result belongs to tag. A null pointer allocates, a zero size frees and returns nullptr.
+         *
+         */
+        void* reallocate(void* pointer, const std::size_t &size, const std::size_t &alignment, const uint32_t &tag);
+        void free(void* pointer);
+
+        /**
+         * @brief Size requested for a live allocation.
+         *
+         */
+        static std::size_t getSize(const void* pointer);
+        static uint32_t getTag(const void* pointer);
+
+        TaggedHeapStatistics getStatistics(const uint32_t &tag) const;
+        uint32_t countTags() const;
+
+        /**
+         * @brief Give every recycled block back to the system heap.
+         *
+         */
+        void trim();
+    }; // class TaggedHeap
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_TAGGEDHEAP_H
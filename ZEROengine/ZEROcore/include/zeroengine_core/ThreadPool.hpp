@@ -0,0 +1,87 @@
+#ifndef ZEROENGINE_THREADPOOL_H
+#define ZEROENGINE_THREADPOOL_H
+
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <condition_variable>
+
+namespace ZEROengine {
+    /**
+     * @brief Non-owning reference to a callable run as job(index, worker_index). Binding a lambda does not allocate,
+     * the callable must outlive the loop it is passed to.
+     * 
+     */
+    class ThreadPoolJob {
+    private:
+        const void* m_callable;
+        void (*m_invoke)(const void*, uint32_t, uint32_t);
+
+    public:
+        template<typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, ThreadPoolJob>::value>>
+        ThreadPoolJob(const F &callable) :
+        m_callable{std::addressof(callable)},
+        m_invoke{[](const void* bound, uint32_t index, uint32_t worker_index) {
+            (*static_cast<const F*>(bound))(index, worker_index);
+        }}
+        {}
+
+        void operator()(const uint32_t &index, const uint32_t &worker_index) const {
+            m_invoke(m_callable, index, worker_index);
+        }
+    }; // class ThreadPoolJob
+
+    /**
+     * @brief A fixed set of worker threads executing data-parallel loops. The calling thread takes part in every loop.
+     * 
+     */
+    class ThreadPool {
+    private:
+        std::vector<std::thread> m_workers;
+
+        std::mutex m_job_mutex;
+        std::condition_variable m_job_signal;
+        std::condition_variable m_job_done_signal;
+
+        // current job, published under m_job_mutex
+        const ThreadPoolJob *m_job;
+        uint32_t m_job_count;
+        uint64_t m_job_generation;
+        std::atomic<uint32_t> m_job_next;
+        uint32_t m_job_active_workers;
+
+        bool m_stopping;
+
+    private:
+        void workerLoop(const uint32_t &worker_index);
+        void runJob(const ThreadPoolJob &job, const uint32_t &count, const uint32_t &worker_index);
+
+    public:
+        /**
+         * @brief Construct a new thread pool.
+         * 
+         * @param thread_count Total number of threads taking part in a loop, including the caller. 0 picks the hardware concurrency.
+         */
+        ThreadPool(const uint32_t &thread_count = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Run job(index, worker_index) for every index in [0, count), blocking until all of them are done.
+         * Indices are handed out dynamically, worker_index is stable in [0, getThreadCount()) for scratch storage.
+         * The job is taken by reference, so a loop does not allocate.
+         * 
+         */
+        void parallelFor(const uint32_t &count, const ThreadPoolJob &job);
+
+        uint32_t getThreadCount() const;
+    }; // class ThreadPool
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_THREADPOOL_H
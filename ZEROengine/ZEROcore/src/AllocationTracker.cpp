@@ -0,0 +1,325 @@
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <algorithm>
+
+#include "zeroengine_core/AllocationTracker.hpp"
+#include "zeroengine_core/ZERODefines.hpp"
+
+namespace ZEROengine {
+    namespace {
+        // written by the owning thread, except the last slot shared by overflowing threads, hence the atomics
+        struct ThreadSlot {
+            std::atomic<uint64_t> allocations[const_allocation_max_scopes];
+            std::atomic<uint64_t> frees[const_allocation_max_scopes];
+            std::atomic<uint64_t> bytes[const_allocation_max_scopes];
+        };
+
+        // static storage only, operator new must not depend on anything it would have to allocate
+        ThreadSlot g_thread_slots[const_allocation_max_threads];
+        std::atomic<uint32_t> g_thread_count{0};
+
+        const char* g_scope_names[const_allocation_max_scopes] = {"unscoped"};
+        std::atomic<uint32_t> g_scope_count{1};
+        std::mutex g_scope_mutex;
+
+        // plain data, a thread_local with a destructor would allocate on registration
+        thread_local int32_t t_thread_index = -1;
+        thread_local uint32_t t_scope_stack[const_allocation_scope_depth];
+        thread_local uint32_t t_scope_depth = 0;
+
+        // frame state, only touched by endFrame()
+        AllocationCounters g_previous[const_allocation_max_threads][const_allocation_max_scopes];
+        AllocationFrameStatistics g_last_frame;
+        uint64_t g_frame = 0;
+        bool g_strict = false;
+        uint64_t g_steady_frame = 0;
+
+        ThreadSlot& getThreadSlot() {
+            if(t_thread_index < 0) {
+                uint32_t index = g_thread_count.fetch_add(1, std::memory_order_relaxed);
+                t_thread_index = static_cast<int32_t>(std::min(index, const_allocation_max_threads - 1));
+            }
+            return g_thread_slots[t_thread_index];
+        }
+
+        uint32_t getCurrentScope() {
+            if(t_scope_depth == 0) {
+                return 0;
+            }
+            return t_scope_stack[std::min(t_scope_depth, const_allocation_scope_depth) - 1];
+        }
+    } // namespace
+
+    bool AllocationTracker::isEnabled() {
+#if defined(ZEROENGINE_ALLOCATION_TRACKING)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    uint32_t AllocationTracker::registerScope(const char* name) {
+        std::lock_guard<std::mutex> lock(g_scope_mutex);
+        uint32_t scope_count = g_scope_count.load(std::memory_order_relaxed);
+        for(uint32_t scope = 0; scope < scope_count; ++scope) {
+            if(g_scope_names[scope] == name || std::strcmp(g_scope_names[scope], name) == 0) {
+                return scope;
+            }
+        }
+        if(scope_count == const_allocation_max_scopes) {
+            return 0;
+        }
+        g_scope_names[scope_count] = name;
+        g_scope_count.store(scope_count + 1, std::memory_order_release);
+        return scope_count;
+    }
+
+    const char* AllocationTracker::getScopeName(const uint32_t &scope) {
+        if(scope >= g_scope_count.load(std::memory_order_acquire)) {
+            return "";
+        }
+        return g_scope_names[scope];
+    }
+
+    void AllocationTracker::pushScope(const uint32_t &scope) {
+        // scopes nested deeper than the stack are attributed to the deepest recorded one
+        if(t_scope_depth < const_allocation_scope_depth) {
+            t_scope_stack[t_scope_depth] = scope;
+        }
+        ++t_scope_depth;
+    }
+
+    void AllocationTracker::popScope() {
+        if(t_scope_depth > 0) {
+            --t_scope_depth;
+        }
+    }
+
+    void AllocationTracker::recordAllocation(const std::size_t &size) {
+        ThreadSlot &slot = getThreadSlot();
+        uint32_t scope = getCurrentScope();
+        slot.allocations[scope].fetch_add(1, std::memory_order_relaxed);
+        slot.bytes[scope].fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void AllocationTracker::recordFree() {
+        ThreadSlot &slot = getThreadSlot();
+        slot.frees[getCurrentScope()].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void AllocationTracker::endFrame() {
+        AllocationFrameStatistics &frame = g_last_frame;
+        frame = AllocationFrameStatistics{};
+        frame.frame = g_frame++;
+        frame.scope_count = g_scope_count.load(std::memory_order_acquire);
+        frame.thread_count = std::min(g_thread_count.load(std::memory_order_relaxed), const_allocation_max_threads);
+        for(uint32_t thread = 0; thread < frame.thread_count; ++thread) {
+            ThreadSlot &slot = g_thread_slots[thread];
+            for(uint32_t scope = 0; scope < frame.scope_count; ++scope) {
+                AllocationCounters current{};
+                current.allocations = slot.allocations[scope].load(std::memory_order_relaxed);
+                current.frees = slot.frees[scope].load(std::memory_order_relaxed);
+                current.bytes = slot.bytes[scope].load(std::memory_order_relaxed);
+                AllocationCounters &previous = g_previous[thread][scope];
+
+                AllocationCounters delta{};
+                delta.allocations = current.allocations - previous.allocations;
+                delta.frees = current.frees - previous.frees;
+                delta.bytes = current.bytes - previous.bytes;
+                previous = current;
+
+                frame.scopes[scope].allocations += delta.allocations;
+                frame.scopes[scope].frees += delta.frees;
+                frame.scopes[scope].bytes += delta.bytes;
+                frame.threads[thread].allocations += delta.allocations;
+                frame.threads[thread].frees += delta.frees;
+                frame.threads[thread].bytes += delta.bytes;
+                frame.total.allocations += delta.allocations;
+                frame.total.frees += delta.frees;
+                frame.total.bytes += delta.bytes;
+            }
+        }
+
+        if(!g_strict || frame.frame < g_steady_frame || frame.total.allocations == 0) {
+            return;
+        }
+        uint32_t worst_scope = 0;
+        for(uint32_t scope = 1; scope < frame.scope_count; ++scope) {
+            if(frame.scopes[scope].allocations > frame.scopes[worst_scope].allocations) {
+                worst_scope = scope;
+            }
+        }
+        g_strict = false;
+        ZERO_ASSERT(false,
+            "steady-state frame " + std::to_string(frame.frame) + " made " + std::to_string(frame.total.allocations) +
+            " heap allocations (" + std::to_string(frame.total.bytes) + " bytes), " +
+            std::to_string(frame.scopes[worst_scope].allocations) + " in scope " + g_scope_names[worst_scope]);
+    }
+
+    const AllocationFrameStatistics& AllocationTracker::getLastFrame() {
+        return g_last_frame;
+    }
+
+    uint64_t AllocationTracker::getFrame() {
+        return g_frame;
+    }
+
+    void AllocationTracker::setStrictMode(const bool &strict, const uint32_t &warmup_frames) {
+        g_strict = strict;
+        g_steady_frame = g_frame + warmup_frames;
+    }
+
+    bool AllocationTracker::isStrictMode() {
+        return g_strict;
+    }
+
+    AllocationCounters AllocationTracker::getThreadCounters() {
+        AllocationCounters counters{};
+        ThreadSlot &slot = getThreadSlot();
+        uint32_t scope_count = g_scope_count.load(std::memory_order_acquire);
+        for(uint32_t scope = 0; scope < scope_count; ++scope) {
+            counters.allocations += slot.allocations[scope].load(std::memory_order_relaxed);
+            counters.frees += slot.frees[scope].load(std::memory_order_relaxed);
+            counters.bytes += slot.bytes[scope].load(std::memory_order_relaxed);
+        }
+        return counters;
+    }
+} // namespace ZEROengine
+
+#if defined(ZEROENGINE_ALLOCATION_TRACKING)
+// Replacement of the global allocation functions. They resolve for the whole process when the engine is linked as
+// a shared library on ELF and Mach-O platforms, Windows DLLs only replace them for the engine itself.
+namespace {
+    void* allocateTracked(std::size_t size) {
+        void* pointer = std::malloc(size == 0 ? 1 : size);
+        if(pointer != nullptr) {
+            ZEROengine::AllocationTracker::recordAllocation(size);
+        }
+        return pointer;
+    }
+
+    void* allocateTrackedAligned(std::size_t size, std::size_t alignment) {
+#if defined(_WIN32)
+        void* pointer = _aligned_malloc(size == 0 ? 1 : size, alignment);
+#else
+        // aligned_alloc wants a multiple of the alignment
+        std::size_t rounded = size == 0 ? alignment : (size + alignment - 1) / alignment * alignment;
+        void* pointer = std::aligned_alloc(alignment, rounded);
+#endif
+        if(pointer != nullptr) {
+            ZEROengine::AllocationTracker::recordAllocation(size);
+        }
+        return pointer;
+    }
+
+    void freeTracked(void* pointer) {
+        if(pointer != nullptr) {
+            ZEROengine::AllocationTracker::recordFree();
+            std::free(pointer);
+        }
+    }
+
+    void freeTrackedAligned(void* pointer) {
+        if(pointer != nullptr) {
+            ZEROengine::AllocationTracker::recordFree();
+#if defined(_WIN32)
+            _aligned_free(pointer);
+#else
+            std::free(pointer);
+#endif
+        }
+    }
+} // namespace
+
+void* operator new(std::size_t size) {
+    void* pointer = allocateTracked(size);
+    if(pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocateTracked(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocateTracked(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* pointer = allocateTrackedAligned(size, static_cast<std::size_t>(alignment));
+    if(pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateTrackedAligned(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateTrackedAligned(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept {
+    freeTracked(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    freeTracked(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    freeTracked(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    freeTracked(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    freeTracked(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    freeTracked(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    freeTrackedAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    freeTrackedAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    freeTrackedAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    freeTrackedAligned(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    freeTrackedAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    freeTrackedAligned(pointer);
+}
+#endif // #if defined(ZEROENGINE_ALLOCATION_TRACKING)
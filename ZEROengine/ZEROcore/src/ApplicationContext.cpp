@@ -1,6 +1,7 @@
 #include <memory>
 
 #include "zeroengine_core/ApplicationContext.hpp"
+#include "zeroengine_core/AllocationTracker.hpp"
 #include "zeroengine_graphical/GPUModule.hpp"
 
 namespace ZEROengine {
@@ -21,7 +22,11 @@ namespace ZEROengine {
             if(graphical_module->isOff()) {
                 break;
             }
-            graphical_module->drawFrame();
+            {
+                ZERO_ALLOCATION_SCOPE("frame");
+                graphical_module->drawFrame();
+            }
+            AllocationTracker::endFrame();
         }
     }
 
@@ -0,0 +1,155 @@
+#include "zeroengine_core/ImageEncoder.hpp"
+
+#include <array>
+#include <fstream>
+#include <algorithm>
+
+#include "zeroengine_core/ZERODefines.hpp"
+
+namespace ZEROengine {
+    // largest payload of a stored deflate block
+    constexpr std::size_t const_deflate_stored_block_size = 65535;
+
+    static const std::array<uint32_t, 256>& crc32Table() {
+        static const std::array<uint32_t, 256> table = [] {
+            std::array<uint32_t, 256> values{};
+            for(uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for(uint32_t k = 0; k < 8; ++k) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                values[i] = c;
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    static void appendBigEndian(std::vector<uint8_t> &output, const uint32_t &value) {
+        output.push_back(static_cast<uint8_t>(value >> 24));
+        output.push_back(static_cast<uint8_t>(value >> 16));
+        output.push_back(static_cast<uint8_t>(value >> 8));
+        output.push_back(static_cast<uint8_t>(value));
+    }
+
+    static void appendChunk(std::vector<uint8_t> &output, const char* type, const uint8_t* data, const std::size_t &size) {
+        appendBigEndian(output, static_cast<uint32_t>(size));
+        std::size_t type_offset = output.size();
+        output.insert(output.end(), type, type + 4);
+        output.insert(output.end(), data, data + size);
+        // the chunk CRC covers its type and data
+        appendBigEndian(output, ImageEncoder::crc32(output.data() + type_offset, size + 4));
+    }
+
+    uint32_t ImageEncoder::crc32(const uint8_t* data, const std::size_t &size, const uint32_t &crc) {
+        const std::array<uint32_t, 256> &table = crc32Table();
+        uint32_t c = crc ^ 0xFFFFFFFFu;
+        for(std::size_t i = 0; i < size; ++i) {
+            c = table[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+        }
+        return c ^ 0xFFFFFFFFu;
+    }
+
+    uint32_t ImageEncoder::adler32(const uint8_t* data, const std::size_t &size, const uint32_t &adler) {
+        constexpr uint32_t modulo = 65521;
+        // largest run before the sums may overflow 32 bits
+        constexpr std::size_t run = 5552;
+        uint32_t a = adler & 0xFFFF;
+        uint32_t b = adler >> 16;
+        for(std::size_t offset = 0; offset < size; offset += run) {
+            std::size_t end = std::min(size, offset + run);
+            for(std::size_t i = offset; i < end; ++i) {
+                a += data[i];
+                b += a;
+            }
+            a %= modulo;
+            b %= modulo;
+        }
+        return (b << 16) | a;
+    }
+
+    void ImageEncoder::encodePNG(
+        const uint8_t* pixels,
+        const uint32_t &width,
+        const uint32_t &height,
+        const std::size_t &row_pitch,
+        const uint32_t &channels,
+        std::vector<uint8_t> &output
+    ) {
+        ZERO_ASSERT(channels == 3 || channels == 4, "PNG encoding expects RGB or RGBA pixels.");
+        ZERO_ASSERT(row_pitch >= static_cast<std::size_t>(width) * channels, "Row pitch is smaller than a row.");
+
+        // scanlines, each prefixed by the filter type, none here
+        std::size_t row_size = static_cast<std::size_t>(width) * channels;
+        std::vector<uint8_t> scanlines((row_size + 1) * height);
+        for(uint32_t y = 0; y < height; ++y) {
+            uint8_t* scanline = scanlines.data() + (row_size + 1) * y;
+            scanline[0] = 0;
+            std::copy(pixels + row_pitch * y, pixels + row_pitch * y + row_size, scanline + 1);
+        }
+
+        // zlib stream of stored deflate blocks
+        std::size_t block_count = std::max<std::size_t>(1, (scanlines.size() + const_deflate_stored_block_size - 1) / const_deflate_stored_block_size);
+        std::vector<uint8_t> zlib;
+        zlib.reserve(2 + scanlines.size() + block_count * 5 + 4);
+        zlib.push_back(0x78);
+        zlib.push_back(0x01);
+        for(std::size_t block = 0; block < block_count; ++block) {
+            std::size_t offset = block * const_deflate_stored_block_size;
+            uint16_t length = static_cast<uint16_t>(std::min(const_deflate_stored_block_size, scanlines.size() - offset));
+            zlib.push_back(block + 1 == block_count ? 1 : 0); // BFINAL, BTYPE 00
+            zlib.push_back(static_cast<uint8_t>(length));
+            zlib.push_back(static_cast<uint8_t>(length >> 8));
+            zlib.push_back(static_cast<uint8_t>(~length));
+            zlib.push_back(static_cast<uint8_t>(~length >> 8));
+            zlib.insert(zlib.end(), scanlines.begin() + offset, scanlines.begin() + offset + length);
+        }
+        appendBigEndian(zlib, adler32(scanlines.data(), scanlines.size()));
+
+        output.clear();
+        output.reserve(8 + 25 + zlib.size() + 12 + 12);
+        const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        output.insert(output.end(), signature, signature + 8);
+
+        std::vector<uint8_t> header;
+        appendBigEndian(header, width);
+        appendBigEndian(header, height);
+        header.push_back(8); // bit depth
+        header.push_back(channels == 4 ? 6 : 2); // color type, RGBA or RGB
+        header.push_back(0); // compression
+        header.push_back(0); // filter
+        header.push_back(0); // no interlace
+        appendChunk(output, "IHDR", header.data(), header.size());
+        appendChunk(output, "IDAT", zlib.data(), zlib.size());
+        appendChunk(output, "IEND", nullptr, 0);
+    }
+
+    void ImageEncoder::encodePPM(
+        const uint8_t* pixels,
+        const uint32_t &width,
+        const uint32_t &height,
+        const std::size_t &row_pitch,
+        const uint32_t &channels,
+        std::vector<uint8_t> &output
+    ) {
+        ZERO_ASSERT(channels == 3 || channels == 4, "PPM encoding expects RGB or RGBA pixels.");
+        std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+        output.assign(header.begin(), header.end());
+        output.reserve(header.size() + static_cast<std::size_t>(width) * height * 3);
+        for(uint32_t y = 0; y < height; ++y) {
+            const uint8_t* row = pixels + row_pitch * y;
+            for(uint32_t x = 0; x < width; ++x) {
+                output.insert(output.end(), row + x * channels, row + x * channels + 3);
+            }
+        }
+    }
+
+    bool ImageEncoder::writeFile(const std::string &path, const std::vector<uint8_t> &bytes) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if(!file) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+} // namespace ZEROengine
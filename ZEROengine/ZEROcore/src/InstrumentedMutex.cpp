@@ -0,0 +1,49 @@
+#include "zeroengine_core/InstrumentedMutex.hpp"
+
+#include <chrono>
+
+namespace ZEROengine {
+    InstrumentedMutex::InstrumentedMutex() :
+    m_mutex{},
+    m_acquisitions{0},
+    m_contentions{0},
+    m_wait_nanoseconds{0}
+    {}
+
+    void InstrumentedMutex::lock() {
+        if(!m_mutex.try_lock()) {
+            std::chrono::steady_clock::time_point wait_start = std::chrono::steady_clock::now();
+            m_mutex.lock();
+            std::chrono::nanoseconds waited = std::chrono::steady_clock::now() - wait_start;
+            m_contentions.fetch_add(1, std::memory_order_relaxed);
+            m_wait_nanoseconds.fetch_add(static_cast<uint64_t>(waited.count()), std::memory_order_relaxed);
+        }
+        m_acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool InstrumentedMutex::try_lock() {
+        if(!m_mutex.try_lock()) {
+            return false;
+        }
+        m_acquisitions.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void InstrumentedMutex::unlock() {
+        m_mutex.unlock();
+    }
+
+    MutexStatistics InstrumentedMutex::getStatistics() const {
+        MutexStatistics statistics{};
+        statistics.acquisitions = m_acquisitions.load(std::memory_order_relaxed);
+        statistics.contentions = m_contentions.load(std::memory_order_relaxed);
+        statistics.wait_nanoseconds = m_wait_nanoseconds.load(std::memory_order_relaxed);
+        return statistics;
+    }
+
+    void InstrumentedMutex::resetStatistics() {
+        m_acquisitions.store(0, std::memory_order_relaxed);
+        m_contentions.store(0, std::memory_order_relaxed);
+        m_wait_nanoseconds.store(0, std::memory_order_relaxed);
+    }
+} // namespace ZEROengine
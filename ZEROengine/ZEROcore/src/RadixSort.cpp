@@ -0,0 +1,114 @@
+#include "zeroengine_core/RadixSort.hpp"
+#include "zeroengine_core/ZERODefines.hpp"
+
+#include <algorithm>
+
+namespace ZEROengine {
+    // below this many keys per chunk the fork/join costs more than it saves
+    constexpr std::size_t const_radix_min_chunk_size = 8192;
+    constexpr uint32_t const_radix_buckets = 256;
+
+    RadixSorter::RadixSorter() :
+    m_key_scratch{},
+    m_value_scratch{},
+    m_histograms{},
+    m_last_pass_count{0}
+    {}
+
+    void RadixSorter::sort(std::vector<uint64_t> &keys, std::vector<uint32_t> &values, ThreadPool *thread_pool) {
+        ZERO_ASSERT(keys.size() == values.size(), "Radix sort keys and values must have the same size.");
+        ZERO_ASSERT(keys.size() <= UINT32_MAX, "Radix sort is limited to 32 bit counts.");
+        m_last_pass_count = 0;
+        const std::size_t count = keys.size();
+        if(count < 2) {
+            return;
+        }
+
+        // bits that differ between keys, digits without any of them would be a no-op pass
+        uint64_t varying_bits = 0;
+        for(std::size_t i = 1; i < count; ++i) {
+            varying_bits |= keys[i] ^ keys[0];
+        }
+        if(varying_bits == 0) {
+            return;
+        }
+
+        uint32_t chunk_count = 1;
+        if(thread_pool) {
+            std::size_t max_chunks = std::max<std::size_t>(count / const_radix_min_chunk_size, 1);
+            chunk_count = static_cast<uint32_t>(std::min<std::size_t>(thread_pool->getThreadCount(), max_chunks));
+        }
+        const std::size_t chunk_size = (count + chunk_count - 1) / chunk_count;
+
+        m_key_scratch.resize(count);
+        m_value_scratch.resize(count);
+        m_histograms.assign(static_cast<std::size_t>(chunk_count) * const_radix_buckets, 0);
+
+        uint64_t *src_keys = keys.data();
+        uint32_t *src_values = values.data();
+        uint64_t *dst_keys = m_key_scratch.data();
+        uint32_t *dst_values = m_value_scratch.data();
+
+        for(uint32_t shift = 0; shift < 64; shift += 8) {
+            if(((varying_bits >> shift) & 0xFF) == 0) {
+                continue;
+            }
+
+            auto histogram_chunk = [&](uint32_t chunk, uint32_t) {
+                uint32_t *histogram = m_histograms.data() + static_cast<std::size_t>(chunk) * const_radix_buckets;
+                std::fill(histogram, histogram + const_radix_buckets, 0);
+                const std::size_t begin = chunk * chunk_size;
+                const std::size_t end = std::min(begin + chunk_size, count);
+                for(std::size_t i = begin; i < end; ++i) {
+                    ++histogram[(src_keys[i] >> shift) & 0xFF];
+                }
+            };
+            auto scatter_chunk = [&](uint32_t chunk, uint32_t) {
+                uint32_t *offsets = m_histograms.data() + static_cast<std::size_t>(chunk) * const_radix_buckets;
+                const std::size_t begin = chunk * chunk_size;
+                const std::size_t end = std::min(begin + chunk_size, count);
+                for(std::size_t i = begin; i < end; ++i) {
+                    uint32_t destination = offsets[(src_keys[i] >> shift) & 0xFF]++;
+                    dst_keys[destination] = src_keys[i];
+                    dst_values[destination] = src_values[i];
+                }
+            };
+
+            if(chunk_count > 1) {
+                thread_pool->parallelFor(chunk_count, histogram_chunk);
+            } else {
+                histogram_chunk(0, 0);
+            }
+
+            // exclusive prefix sum in (digit, chunk) order keeps the scatter stable
+            uint32_t offset = 0;
+            for(uint32_t digit = 0; digit < const_radix_buckets; ++digit) {
+                for(uint32_t chunk = 0; chunk < chunk_count; ++chunk) {
+                    uint32_t &bucket = m_histograms[static_cast<std::size_t>(chunk) * const_radix_buckets + digit];
+                    uint32_t bucket_count = bucket;
+                    bucket = offset;
+                    offset += bucket_count;
+                }
+            }
+
+            if(chunk_count > 1) {
+                thread_pool->parallelFor(chunk_count, scatter_chunk);
+            } else {
+                scatter_chunk(0, 0);
+            }
+
+            std::swap(src_keys, dst_keys);
+            std::swap(src_values, dst_values);
+            ++m_last_pass_count;
+        }
+
+        if(src_keys != keys.data()) {
+            keys.swap(m_key_scratch);
+            values.swap(m_value_scratch);
+        }
+    }
+
+    uint32_t RadixSorter::getLastPassCount() const {
+        return m_last_pass_count;
+    }
+} // namespace ZEROengine
@@ -0,0 +1,207 @@
+#include "zeroengine_core/TaggedHeap.hpp"
+#include "zeroengine_core/ZERODefines.hpp"
+
+#include <new>
+#include <cstring>
+#include <algorithm>
+
+namespace ZEROengine {
+    namespace {
+        constexpr uint32_t const_unpooled_class = 0xFFFFFFFF;
+
+        // stored right before every returned pointer
+        struct BlockHeader {
+            void* raw;
+            uint64_t size;
+            uint32_t tag;
+            uint32_t size_class;
+            uint32_t alignment;
+            uint32_t padding;
+        };
+        static_assert(sizeof(BlockHeader) <= const_tagged_heap_pool_alignment, "Block header must fit in front of pooled blocks.");
+
+        constexpr uint32_t countSizeClasses() {
+            uint32_t count = 0;
+            for(std::size_t size = const_tagged_heap_min_pooled_size; size <= const_tagged_heap_max_pooled_size; size <<= 1) {
+                ++count;
+            }
+            return count;
+        }
+        constexpr uint32_t const_size_class_count = countSizeClasses();
+
+        uint32_t sizeClass(const std::size_t &size) {
+            uint32_t size_class = 0;
+            std::size_t class_size = const_tagged_heap_min_pooled_size;
+            while(class_size < size) {
+                class_size <<= 1;
+                ++size_class;
+            }
+            return size_class;
+        }
+
+        std::size_t classSize(const uint32_t &size_class) {
+            return const_tagged_heap_min_pooled_size << size_class;
+        }
+
+        BlockHeader* headerOf(const void* pointer) {
+            return reinterpret_cast<BlockHeader*>(const_cast<char*>(static_cast<const char*>(pointer)) - sizeof(BlockHeader));
+        }
+    } // namespace
+
+    struct TaggedHeap::Tag {
+        mutable std::mutex mutex;
+        std::vector<void*> free_blocks[const_size_class_count]; // raw pointers of recycled blocks
+        TaggedHeapStatistics statistics;
+    };
+
+    TaggedHeap::TaggedHeap(const uint32_t &tag_count) :
+    m_tags{}
+    {
+        ZERO_ASSERT(tag_count > 0, "Tagged heap needs at least one tag.");
+        for(uint32_t i = 0; i < tag_count; ++i) {
+            m_tags.push_back(std::make_unique<Tag>());
+        }
+    }
+
+    TaggedHeap::~TaggedHeap() {
+        trim();
+    }
+
+    void* TaggedHeap::allocate(const std::size_t &size, const std::size_t &alignment, const uint32_t &tag) {
+        ZERO_ASSERT(tag < m_tags.size(), "Invalid heap tag.");
+        Tag &heap_tag = *m_tags[tag];
+        std::size_t block_alignment = std::max<std::size_t>(alignment, 1);
+
+        void* raw = nullptr;
+        char* pointer = nullptr;
+        uint32_t size_class = const_unpooled_class;
+        if(size <= const_tagged_heap_max_pooled_size && block_alignment <= const_tagged_heap_pool_alignment) {
+            size_class = sizeClass(size);
+            {
+                std::lock_guard<std::mutex> lock(heap_tag.mutex);
+                std::vector<void*> &free_blocks = heap_tag.free_blocks[size_class];
+                if(!free_blocks.empty()) {
+                    raw = free_blocks.back();
+                    free_blocks.pop_back();
+                    ++heap_tag.statistics.pool_hits;
+                    heap_tag.statistics.pooled_bytes -= classSize(size_class);
+                }
+            }
+            if(raw == nullptr) {
+                raw = ::operator new(const_tagged_heap_pool_alignment + classSize(size_class), std::align_val_t{const_tagged_heap_pool_alignment}, std::nothrow);
+            }
+            block_alignment = const_tagged_heap_pool_alignment;
+            pointer = static_cast<char*>(raw) + const_tagged_heap_pool_alignment;
+        } else {
+            block_alignment = std::max<std::size_t>(block_alignment, alignof(BlockHeader));
+            std::size_t offset = (sizeof(BlockHeader) + block_alignment - 1) / block_alignment * block_alignment;
+            raw = ::operator new(offset + size, std::align_val_t{block_alignment}, std::nothrow);
+            pointer = static_cast<char*>(raw) + offset;
+        }
+        if(raw == nullptr) {
+            return nullptr;
+        }
+
+        BlockHeader* header = headerOf(pointer);
+        header->raw = raw;
+        header->size = size;
+        header->tag = tag;
+        header->size_class = size_class;
+        header->alignment = static_cast<uint32_t>(block_alignment);
+
+        std::lock_guard<std::mutex> lock(heap_tag.mutex);
+        TaggedHeapStatistics &statistics = heap_tag.statistics;
+        statistics.current_bytes += size;
+        statistics.peak_bytes = std::max(statistics.peak_bytes, statistics.current_bytes);
+        ++statistics.live_allocations;
+        ++statistics.allocations;
+        return pointer;
+    }
+
+    void* TaggedHeap::reallocate(void* pointer, const std::size_t &size, const std::size_t &alignment, const uint32_t &tag) {
+        if(pointer == nullptr) {
+            return allocate(size, alignment, tag);
+        }
+        if(size == 0) {
+            free(pointer);
+            return nullptr;
+        }
+
+        BlockHeader* header = headerOf(pointer);
+        if(header->tag == tag &&
+            header->size_class != const_unpooled_class &&
+            size <= classSize(header->size_class) &&
+            alignment <= const_tagged_heap_pool_alignment) {
+            // still fits its size class, resize in place
+            std::lock_guard<std::mutex> lock(m_tags[tag]->mutex);
+            TaggedHeapStatistics &statistics = m_tags[tag]->statistics;
+            statistics.current_bytes = statistics.current_bytes - header->size + size;
+            statistics.peak_bytes = std::max(statistics.peak_bytes, statistics.current_bytes);
+            ++statistics.reallocations;
+            header->size = size;
+            return pointer;
+        }
+
+        void* moved = allocate(size, alignment, tag);
+        if(moved == nullptr) {
+            return nullptr;
+        }
+        std::memcpy(moved, pointer, std::min<std::size_t>(size, header->size));
+        free(pointer);
+        std::lock_guard<std::mutex> lock(m_tags[tag]->mutex);
+        ++m_tags[tag]->statistics.reallocations;
+        return moved;
+    }
+
+    void TaggedHeap::free(void* pointer) {
+        if(pointer == nullptr) {
+            return;
+        }
+        BlockHeader header = *headerOf(pointer);
+        ZERO_ASSERT(header.tag < m_tags.size(), "Freeing a block that does not belong to this heap.");
+        Tag &heap_tag = *m_tags[header.tag];
+
+        std::lock_guard<std::mutex> lock(heap_tag.mutex);
+        TaggedHeapStatistics &statistics = heap_tag.statistics;
+        statistics.current_bytes -= header.size;
+        --statistics.live_allocations;
+        ++statistics.frees;
+        if(header.size_class != const_unpooled_class) {
+            heap_tag.free_blocks[header.size_class].push_back(header.raw);
+            statistics.pooled_bytes += classSize(header.size_class);
+        } else {
+            ::operator delete(header.raw, std::align_val_t{header.alignment});
+        }
+    }
+
+    std::size_t TaggedHeap::getSize(const void* pointer) {
+        return static_cast<std::size_t>(headerOf(pointer)->size);
+    }
+
+    uint32_t TaggedHeap::getTag(const void* pointer) {
+        return headerOf(pointer)->tag;
+    }
+
+    TaggedHeapStatistics TaggedHeap::getStatistics(const uint32_t &tag) const {
+        ZERO_ASSERT(tag < m_tags.size(), "Invalid heap tag.");
+        std::lock_guard<std::mutex> lock(m_tags[tag]->mutex);
+        return m_tags[tag]->statistics;
+    }
+
+    uint32_t TaggedHeap::countTags() const {
+        return static_cast<uint32_t>(m_tags.size());
+    }
+
+    void TaggedHeap::trim() {
+        for(std::unique_ptr<Tag> &heap_tag : m_tags) {
+            std::lock_guard<std::mutex> lock(heap_tag->mutex);
+            for(std::vector<void*> &free_blocks : heap_tag->free_blocks) {
+                for(void* raw : free_blocks) {
+                    ::operator delete(raw, std::align_val_t{const_tagged_heap_pool_alignment});
+                }
+                free_blocks.clear();
+            }
+            heap_tag->statistics.pooled_bytes = 0;
+        }
+    }
+} // namespace ZEROengine
@@ -0,0 +1,103 @@
+#include "zeroengine_core/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace ZEROengine {
+    ThreadPool::ThreadPool(const uint32_t &thread_count) :
+    m_workers{},
+    m_job_mutex{},
+    m_job_signal{},
+    m_job_done_signal{},
+    m_job{nullptr},
+    m_job_count{0},
+    m_job_generation{0},
+    m_job_next{0},
+    m_job_active_workers{0},
+    m_stopping{false}
+    {
+        uint32_t total_threads = thread_count;
+        if(total_threads == 0) {
+            total_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        // the calling thread is worker 0
+        m_workers.reserve(total_threads - 1);
+        for(uint32_t i = 1; i < total_threads; ++i) {
+            m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_job_mutex);
+            m_stopping = true;
+        }
+        m_job_signal.notify_all();
+        for(std::thread &worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::runJob(const ThreadPoolJob &job, const uint32_t &count, const uint32_t &worker_index) {
+        for(uint32_t index = m_job_next.fetch_add(1, std::memory_order_relaxed); index < count; index = m_job_next.fetch_add(1, std::memory_order_relaxed)) {
+            job(index, worker_index);
+        }
+    }
+
+    void ThreadPool::workerLoop(const uint32_t &worker_index) {
+        uint64_t seen_generation = 0;
+        while(true) {
+            const ThreadPoolJob *job = nullptr;
+            uint32_t count = 0;
+            {
+                std::unique_lock<std::mutex> lock(m_job_mutex);
+                m_job_signal.wait(lock, [&]() { return m_stopping || m_job_generation != seen_generation; });
+                if(m_stopping) {
+                    return;
+                }
+                seen_generation = m_job_generation;
+                if(m_job == nullptr) {
+                    continue; // woke up after the caller already finished this job
+                }
+                job = m_job;
+                count = m_job_count;
+                ++m_job_active_workers;
+            }
+            runJob(*job, count, worker_index);
+            {
+                std::lock_guard<std::mutex> lock(m_job_mutex);
+                --m_job_active_workers;
+            }
+            m_job_done_signal.notify_one();
+        }
+    }
+
+    void ThreadPool::parallelFor(const uint32_t &count, const ThreadPoolJob &job) {
+        if(count == 0) {
+            return;
+        }
+        if(m_workers.empty() || count == 1) {
+            for(uint32_t i = 0; i < count; ++i) {
+                job(i, 0);
+            }
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_job_mutex);
+            m_job = &job;
+            m_job_count = count;
+            m_job_next.store(0, std::memory_order_relaxed);
+            ++m_job_generation;
+        }
+        m_job_signal.notify_all();
+        runJob(job, count, 0);
+
+        // workers that picked up this generation may still be running their last index
+        std::unique_lock<std::mutex> lock(m_job_mutex);
+        m_job_done_signal.wait(lock, [&]() { return m_job_active_workers == 0; });
+        m_job = nullptr;
+    }
+
+    uint32_t ThreadPool::getThreadCount() const {
+        return static_cast<uint32_t>(m_workers.size()) + 1;
+    }
+} // namespace ZEROengine
@@ -6,4 +6,11 @@ namespace ZEROengine {
     std::shared_ptr<GPUModule> ZEROcore::getGraphicalModule() {
         return m_graphical_module;
     }
+
+    void ZEROcore::cleanup() {
+        if(m_graphical_module) {
+            m_graphical_module->cleanup();
+            m_graphical_module.reset();
+        }
+    }
 } // namespace ZEROengine
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include <memory>
 
+#include "zeroengine_graphical/GPUCommandStream.hpp"
+
 namespace ZEROengine {
     class GPUCommandBuffer {
     public:
@@ -16,7 +18,15 @@ namespace ZEROengine {
         virtual void bindVertex() = 0;
         virtual void bindPipeline() = 0;
         virtual void draw() = 0;
+
+        /**
+         * @brief Translate a recorded command stream into backend commands in a single pass.
+         * The default implementation forwards to the per-command virtual methods, backends override it to resolve handles directly.
+         * 
+         * @param stream The recorded commands.
+         */
+        virtual void execute(const GPUCommandStream &stream);
     }; // class GraphicalCommandBuffer
 } // namespace ZEROengine
 
-#endif // #ifndef ZEROENGINE_GRAPHICALCOMMANDBUFFER_H
\ No newline at end of file
+#endif // #ifndef ZEROENGINE_GRAPHICALCOMMANDBUFFER_H
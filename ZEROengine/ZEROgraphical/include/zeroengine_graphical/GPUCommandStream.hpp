@@ -0,0 +1,168 @@
+#ifndef ZEROENGINE_GPUCOMMANDSTREAM_H
+#define ZEROENGINE_GPUCOMMANDSTREAM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <type_traits>
+
+#include "zeroengine_graphical/GPUDefines.hpp"
+
+namespace ZEROengine {
+    enum GPUCommandType : uint16_t {
+        ZERO_COMMAND_BIND_PIPELINE,
+        ZERO_COMMAND_BIND_DESCRIPTOR_SET,
+        ZERO_COMMAND_BIND_VERTEX_BUFFER,
+        ZERO_COMMAND_BIND_INDEX_BUFFER,
+        ZERO_COMMAND_SET_VIEWPORT,
+        ZERO_COMMAND_SET_SCISSOR,
+        ZERO_COMMAND_DRAW,
+        ZERO_COMMAND_DRAW_INDEXED,
+        ZERO_COMMAND_TYPE_COUNT
+    };
+
+    enum GPUIndexType : uint32_t {
+        ZERO_INDEX_TYPE_UINT16,
+        ZERO_INDEX_TYPE_UINT32
+    };
+
+    /**
+     * @brief Every command starts with this header. size is the full command size in bytes, header included.
+     *
+     */
+    struct GPUCommandHeader {
+        uint16_t type;
+        uint16_t size;
+    };
+
+    struct GPUCommandBindPipeline {
+        GPUCommandHeader header;
+        GPUPipelineHandle pipeline;
+    };
+
+    struct GPUCommandBindDescriptorSet {
+        GPUCommandHeader header;
+        uint32_t set;
+        GPUDescriptorSetHandle descriptor_set;
+    };
+
+    struct GPUCommandBindVertexBuffer {
+        GPUCommandHeader header;
+        uint32_t binding;
+        GPUBufferHandle buffer;
+        uint32_t offset;
+    };
+
+    struct GPUCommandBindIndexBuffer {
+        GPUCommandHeader header;
+        GPUBufferHandle buffer;
+        uint32_t offset;
+        GPUIndexType index_type;
+    };
+
+    struct GPUCommandSetViewport {
+        GPUCommandHeader header;
+        float x, y;
+        float width, height;
+        float min_depth, max_depth;
+    };
+
+    struct GPUCommandSetScissor {
+        GPUCommandHeader header;
+        int32_t x, y;
+        uint32_t width, height;
+    };
+
+    struct GPUCommandDraw {
+        GPUCommandHeader header;
+        uint32_t vertex_count;
+        uint32_t instance_count;
+        uint32_t first_vertex;
+        uint32_t first_instance;
+    };
+
+    struct GPUCommandDrawIndexed {
+        GPUCommandHeader header;
+        uint32_t index_count;
+        uint32_t instance_count;
+        uint32_t first_index;
+        int32_t vertex_offset;
+        uint32_t first_instance;
+    };
+
+    /**
+     * @brief A linear byte stream of recorded commands. Commands are POD structs referring to resources through handles,
+     * so recording is a bounds check and a copy, with no virtual call and no backend involved.
+     * A stream is not thread-safe, each recording thread owns its own stream and the backend replays them in submission order
+     * through GraphicalCommandBuffer::execute().
+     *
+     */
+    class GPUCommandStream {
+    private:
+        // 4 byte aligned storage, every command is a multiple of 4 bytes
+        std::vector<uint32_t> m_storage;
+        uint32_t m_command_count;
+
+    private:
+        template<typename T>
+        T& append(const GPUCommandType &type) {
+            static_assert(std::is_trivially_copyable<T>::value, "Commands must be plain data.");
+            static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Commands must be 4 byte multiples.");
+            static_assert(sizeof(T) <= UINT16_MAX, "Commands must fit the header size field.");
+            std::size_t offset = m_storage.size();
+            m_storage.resize(offset + sizeof(T) / sizeof(uint32_t));
+            T* command = reinterpret_cast<T*>(m_storage.data() + offset);
+            command->header.type = type;
+            command->header.size = static_cast<uint16_t>(sizeof(T));
+            ++m_command_count;
+            return *command;
+        }
+
+    public:
+        GPUCommandStream();
+
+        void bindPipeline(const GPUPipelineHandle &pipeline);
+        void bindDescriptorSet(const uint32_t &set, const GPUDescriptorSetHandle &descriptor_set);
+        void bindVertexBuffer(const uint32_t &binding, const GPUBufferHandle &buffer, const uint32_t &offset = 0);
+        void bindIndexBuffer(const GPUBufferHandle &buffer, const uint32_t &offset = 0, const GPUIndexType &index_type = ZERO_INDEX_TYPE_UINT32);
+        void setViewport(const float &x, const float &y, const float &width, const float &height, const float &min_depth = 0.0f, const float &max_depth = 1.0f);
+        void setScissor(const int32_t &x, const int32_t &y, const uint32_t &width, const uint32_t &height);
+        void draw(const uint32_t &vertex_count, const uint32_t &instance_count = 1, const uint32_t &first_vertex = 0, const uint32_t &first_instance = 0);
+        void drawIndexed(const uint32_t &index_count, const uint32_t &instance_count = 1, const uint32_t &first_index = 0, const int32_t &vertex_offset = 0, const uint32_t &first_instance = 0);
+
+        /**
+         * @brief Drop every recorded command while keeping the storage for the next recording.
+         *
+         */
+        void reset();
+        void reserve(const std::size_t &bytes);
+
+        const uint8_t* data() const;
+        std::size_t size() const;
+        uint32_t countCommands() const;
+        bool empty() const;
+    }; // class GPUCommandStream
+
+    /**
+     * @brief Forward iterator over the commands of a stream, used by the backend translation pass.
+     *
+     */
+    class GPUCommandStreamReader {
+    private:
+        const uint8_t* m_cursor;
+        const uint8_t* m_end;
+
+    public:
+        GPUCommandStreamReader(const GPUCommandStream &stream);
+
+        /**
+         * @brief Advance to the next command.
+         *
+         * @param header Set to the header of the next command, which can be cast to the command struct matching its type.
+         * @return bool false once every command has been read.
+         */
+        bool next(const GPUCommandHeader* &header);
+    }; // class GPUCommandStreamReader
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_GPUCOMMANDSTREAM_H
@@ -5,4 +5,10 @@
 
 typedef uint32_t GPUFlags;
 
+// handles index backend side tables, so recorded commands stay plain data
+typedef uint32_t GPUBufferHandle;
+typedef uint32_t GPUPipelineHandle;
+typedef uint32_t GPUDescriptorSetHandle;
+constexpr uint32_t const_gpu_invalid_handle = 0xFFFFFFFF;
+
 #endif // #ifndef ZEROENGINE_GPUDEFINES_H
\ No newline at end of file
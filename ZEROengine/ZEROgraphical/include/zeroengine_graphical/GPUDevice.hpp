@@ -3,18 +3,76 @@
 
 #include <memory>
 #include <vector>
+#include <cstdint>
 
 #include "zeroengine_core/ZERODefines.hpp"
+#include "zeroengine_core/InstrumentedMutex.hpp"
 #include "zeroengine_graphical/GPUContext.hpp"
+#include "zeroengine_graphical/GPUResource.hpp"
+#include "zeroengine_graphical/GPUDefines.hpp"
 
 namespace ZEROengine {
+    struct GPUAllocationStatistics {
+        uint64_t buffers_allocated = 0;
+        uint64_t buffers_released = 0;
+        uint64_t textures_allocated = 0;
+        // lock guarding the resource tables, contended when loaders allocate in parallel
+        MutexStatistics resource_lock;
+    };
+
+    /**
+     * @brief Resource allocation, release, mapping and the allocation statistics are thread-safe, so loaders may
+     * create resources from worker threads while the render thread records.
+     *
+     */
     class GPUDevice {
     protected:
         std::vector<std::shared_ptr<GraphicalContext>> m_graphical_contexts;
 
     public:
-        virtual ZEROResult allocateBuffer() = 0;
+        /**
+         * @brief Allocate a buffer, referenced by recorded command streams through the returned handle.
+         * 
+         * @param buffer_description Size and usage of the buffer.
+         * @param buffer_handle Set to the handle of the new buffer on success.
+         * @return ZEROResult 
+         */
+        virtual ZEROResult allocateBuffer(const GPUBufferDescription &buffer_description, GPUBufferHandle &buffer_handle) = 0;
+        /**
+         * @brief Release a buffer once the GPU is done with it. Buffers must be released before cleanup(), which frees the remaining ones,
+         * releasing a handle afterwards or twice throws.
+         * 
+         */
+        virtual void releaseBuffer(const GPUBufferHandle &buffer_handle) = 0;
+        /**
+         * @brief Whether the handle refers to a live buffer, false once it was released or the device cleaned up.
+         *
+         */
+        virtual bool containsBuffer(const GPUBufferHandle &buffer_handle) const = 0;
+        /**
+         * @brief Persistently mapped pointer of a buffer, nullptr for static buffers the host cannot see.
+         *
+         */
+        virtual void* getBufferMapped(const GPUBufferHandle &buffer_handle) = 0;
+        /**
+         * @brief Copy data into a buffer. Mapped buffers are written in place and flushed, the others go through a staging
+         * copy and the call blocks until the GPU completed it.
+         *
+         */
+        virtual ZEROResult writeBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const void* data, const uint64_t &size) = 0;
+        /**
+         * @brief Make host writes to a mapped range visible to the GPU. Required after writing through getBufferMapped()
+         * unless the memory is coherent, in which case it does nothing.
+         *
+         */
+        virtual void flushBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const uint64_t &size) = 0;
+        /**
+         * @brief Make GPU writes to a mapped range visible to the host, before reading back a buffer.
+         *
+         */
+        virtual void invalidateBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const uint64_t &size) = 0;
         virtual ZEROResult allocateTexture() = 0;
+        virtual GPUAllocationStatistics getAllocationStatistics() const = 0;
 
         virtual std::weak_ptr<GraphicalContext> allocateGraphicalContext() = 0;
 
@@ -22,4 +80,4 @@ namespace ZEROengine {
     }; // class GPUDevice
 } // namespace ZEROengine
 
-#endif // #ifndef ZEROENGINE_GPUDEVICE_H
\ No newline at end of file
+#endif // #ifndef ZEROENGINE_GPUDEVICE_H
@@ -0,0 +1,150 @@
+#ifndef ZEROENGINE_GPUDRAWLIST_H
+#define ZEROENGINE_GPUDRAWLIST_H
+
+#include <cstdint>
+#include <vector>
+
+#include "zeroengine_core/ThreadPool.hpp"
+#include "zeroengine_core/RadixSort.hpp"
+#include "zeroengine_graphical/GPUDefines.hpp"
+#include "zeroengine_graphical/GPUCommandStream.hpp"
+#include "zeroengine_graphical/GPUStreamingBuffer.hpp"
+
+namespace ZEROengine {
+    // draw key layout, most significant field first: layer | pipeline | material | mesh | depth
+    constexpr uint32_t const_draw_key_depth_bits = 16;
+    constexpr uint32_t const_draw_key_mesh_bits = 14;
+    constexpr uint32_t const_draw_key_material_bits = 14;
+    constexpr uint32_t const_draw_key_pipeline_bits = 14;
+    constexpr uint32_t const_draw_key_layer_bits = 6;
+
+    /**
+     * @brief A draw with every binding it needs. Indexed when index_buffer is a valid handle.
+     * 
+     */
+    struct GPUDrawDescription {
+        GPUPipelineHandle pipeline = const_gpu_invalid_handle;
+        GPUDescriptorSetHandle material = const_gpu_invalid_handle; // bound at set 0
+        GPUBufferHandle vertex_buffer = const_gpu_invalid_handle; // bound at binding 0
+        GPUBufferHandle index_buffer = const_gpu_invalid_handle;
+        GPUIndexType index_type = ZERO_INDEX_TYPE_UINT32;
+
+        uint32_t index_count = 0;
+        uint32_t first_index = 0;
+        int32_t vertex_offset = 0;
+        uint32_t vertex_count = 0; // non-indexed draws
+        uint32_t first_vertex = 0; // non-indexed draws
+        uint32_t instance_count = 1;
+        uint32_t first_instance = 0;
+    };
+
+    /**
+     * @brief Column-major model matrix of an instance, read by the vertex shader as four vec4 instance attributes.
+     * 
+     */
+    struct GPUInstanceTransform {
+        float model[16];
+    };
+
+    struct GPUDrawListStatistics {
+        uint64_t draws = 0;
+        uint64_t pipeline_binds = 0;
+        uint64_t descriptor_set_binds = 0;
+        uint64_t vertex_buffer_binds = 0;
+        uint64_t index_buffer_binds = 0;
+        uint64_t redundant_binds_skipped = 0;
+        uint64_t instanced_batches = 0;
+        uint64_t instances_batched = 0;
+        uint32_t sort_passes = 0;
+    };
+
+    /**
+     * @brief Collects the draws of a frame under 64 bit sort keys, sorts them and emits them with the minimum number of binds.
+     * The key orders draws by layer, then pipeline, material, mesh and quantized depth, so the emitted state changes do not
+     * depend on the order draws were submitted in. Layers and handles must fit their key field, makeKey() throws otherwise
+     * rather than letting two handles share a key, and unbound handles sort after the bound ones.
+     * Draws submitted with a transform are batched: after sorting, runs of identical (pipeline, material, mesh) draws
+     * collapse into one instanced draw whose transforms are streamed into the instance buffer.
+     * 
+     */
+    class GPUDrawList {
+    private:
+        std::vector<GPUDrawDescription> m_draws;
+        std::vector<uint64_t> m_keys;
+        std::vector<uint32_t> m_order;
+
+        // per draw index into m_transforms, const_gpu_invalid_handle for draws without a transform
+        std::vector<uint32_t> m_transform_indices;
+        std::vector<GPUInstanceTransform> m_transforms;
+
+        GPUStreamingBuffer* m_instance_buffer;
+        uint32_t m_instance_binding;
+
+        RadixSorter m_sorter;
+        bool m_is_sorted;
+
+        GPUDrawListStatistics m_statistics;
+
+    private:
+        static bool canBatch(const GPUDrawDescription &a, const GPUDrawDescription &b);
+
+    public:
+        GPUDrawList();
+
+        /**
+         * @brief Build the sort key of a draw.
+         * 
+         * @param layer View or layer, drawn in ascending order, below 1 << const_draw_key_layer_bits.
+         * @param depth View depth in [0, 1], ascending. Pass 1 - depth to draw back to front.
+         * @param draw The draw bindings.
+         * @return uint64_t 
+         */
+        static uint64_t makeKey(const uint32_t &layer, const float &depth, const GPUDrawDescription &draw);
+
+        void submit(const uint32_t &layer, const float &depth, const GPUDrawDescription &draw);
+        void submit(const uint64_t &key, const GPUDrawDescription &draw);
+
+        /**
+         * @brief Submit one instance of a mesh. Instances sharing pipeline, material and mesh are merged into instanced draws.
+         * 
+         * @param layer View or layer, drawn in ascending order.
+         * @param depth View depth in [0, 1].
+         * @param draw The draw bindings, instance_count and first_instance are assigned by the batching.
+         * @param transform The model matrix of the instance.
+         */
+        void submitInstance(const uint32_t &layer, const float &depth, const GPUDrawDescription &draw, const GPUInstanceTransform &transform);
+
+        /**
+         * @brief Set the buffer instance transforms are streamed to, bound as an instance rate vertex buffer.
+         * 
+         * @param instance_buffer Streaming buffer of GPUInstanceTransform elements.
+         * @param binding Vertex binding of the transforms.
+         */
+        void setInstanceBuffer(GPUStreamingBuffer* instance_buffer, const uint32_t &binding);
+
+        /**
+         * @brief Order the submitted draws by key. Draws with equal keys keep their submission order.
+         * 
+         * @param thread_pool Pool to run the radix sort passes on, nullptr sorts on the calling thread.
+         */
+        void sort(ThreadPool *thread_pool = nullptr);
+
+        /**
+         * @brief Record the draws in key order, skipping every bind that would not change the bound state.
+         * 
+         * @param stream The stream to record into.
+         */
+        void emit(GPUCommandStream &stream);
+
+        void reset();
+        void reserve(const std::size_t &draw_count);
+        std::size_t countDraws() const;
+
+        const GPUDrawDescription& getSortedDraw(const std::size_t &index) const;
+        uint64_t getSortedKey(const std::size_t &index) const;
+
+        const GPUDrawListStatistics& getStatistics() const;
+    }; // class GPUDrawList
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_GPUDRAWLIST_H
@@ -0,0 +1,44 @@
+#ifndef ZEROENGINE_GPUFRUSTUM_H
+#define ZEROENGINE_GPUFRUSTUM_H
+
+#include <cstdint>
+
+namespace ZEROengine {
+    enum GPUFrustumPlane : uint32_t {
+        ZERO_FRUSTUM_LEFT,
+        ZERO_FRUSTUM_RIGHT,
+        ZERO_FRUSTUM_BOTTOM,
+        ZERO_FRUSTUM_TOP,
+        ZERO_FRUSTUM_NEAR,
+        ZERO_FRUSTUM_FAR,
+        ZERO_FRUSTUM_PLANE_COUNT
+    };
+
+    /**
+     * @brief View frustum as six normalized planes (a, b, c, d) with the inside where a*x + b*y + c*z + d >= 0.
+     * The layout matches a vec4 array, so the planes can be pushed to culling shaders as is.
+     * 
+     */
+    struct GPUFrustum {
+        float planes[ZERO_FRUSTUM_PLANE_COUNT][4];
+
+        /**
+         * @brief Extract the frustum of a view projection matrix.
+         * 
+         * @param view_projection Column-major matrix mapping world space to clip space, with depth in [0, 1].
+         * @return GPUFrustum The frustum planes in world space.
+         */
+        static GPUFrustum fromViewProjection(const float view_projection[16]);
+
+        /**
+         * @brief Conservative sphere test, a sphere crossing a frustum corner outside may still pass.
+         * 
+         * @param center Sphere center in world space.
+         * @param radius Sphere radius.
+         * @return bool false when the sphere is fully outside one plane.
+         */
+        bool intersectsSphere(const float center[3], const float &radius) const;
+    };
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_GPUFRUSTUM_H
@@ -0,0 +1,85 @@
+#ifndef ZEROENGINE_GPUHANDLETABLE_H
+#define ZEROENGINE_GPUHANDLETABLE_H
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "zeroengine_core/ZERODefines.hpp"
+#include "zeroengine_graphical/GPUDefines.hpp"
+
+namespace ZEROengine {
+    /**
+     * @brief Dense table mapping 32 bit handles to backend objects. Released slots are recycled through a free list.
+     * 
+     * @tparam T The backend object type, default constructible.
+     */
+    template<typename T>
+    class GPUHandleTable {
+    private:
+        std::vector<T> m_objects;
+        std::vector<bool> m_alive;
+        std::vector<uint32_t> m_free_slots;
+
+    public:
+        uint32_t insert(T object) {
+            uint32_t handle;
+            if(!m_free_slots.empty()) {
+                handle = m_free_slots.back();
+                m_free_slots.pop_back();
+                m_objects[handle] = std::move(object);
+                m_alive[handle] = true;
+            } else {
+                handle = static_cast<uint32_t>(m_objects.size());
+                ZERO_ASSERT(handle != const_gpu_invalid_handle, "Handle table is full.");
+                m_objects.push_back(std::move(object));
+                m_alive.push_back(true);
+            }
+            return handle;
+        }
+
+        bool contains(const uint32_t &handle) const {
+            return handle < m_objects.size() && m_alive[handle];
+        }
+
+        T& get(const uint32_t &handle) {
+            ZERO_ASSERT(contains(handle), "Invalid handle.");
+            return m_objects[handle];
+        }
+
+        const T& get(const uint32_t &handle) const {
+            ZERO_ASSERT(contains(handle), "Invalid handle.");
+            return m_objects[handle];
+        }
+
+        T release(const uint32_t &handle) {
+            ZERO_ASSERT(contains(handle), "Invalid handle.");
+            T object = std::move(m_objects[handle]);
+            m_objects[handle] = T{};
+            m_alive[handle] = false;
+            m_free_slots.push_back(handle);
+            return object;
+        }
+
+        template<typename F>
+        void forEach(F &&function) {
+            for(uint32_t i = 0; i < m_objects.size(); ++i) {
+                if(m_alive[i]) {
+                    function(i, m_objects[i]);
+                }
+            }
+        }
+
+        std::size_t count() const {
+            return m_objects.size() - m_free_slots.size();
+        }
+
+        void clear() {
+            m_objects.clear();
+            m_alive.clear();
+            m_free_slots.clear();
+        }
+    }; // class GPUHandleTable
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_GPUHANDLETABLE_H
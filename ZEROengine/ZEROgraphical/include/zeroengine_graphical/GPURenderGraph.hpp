@@ -0,0 +1,287 @@
+#ifndef ZEROENGINE_GPURENDERGRAPH_H
+#define ZEROENGINE_GPURENDERGRAPH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include <utility>
+
+#include "zeroengine_graphical/GPUDefines.hpp"
+#include "zeroengine_graphical/GPUCommandBuffer.hpp"
+
+namespace ZEROengine {
+    typedef uint32_t GPURenderGraphResource;
+    typedef uint32_t GPURenderGraphPass;
+
+    /**
+     * @brief How a pass touches a resource. A pass may combine several accesses on the same resource.
+     *
+     */
+    enum GPUAccessBits : uint32_t {
+        ZERO_ACCESS_NONE = 0x00000000,
+        ZERO_ACCESS_COLOR_ATTACHMENT_READ = 0x00000001,
+        ZERO_ACCESS_COLOR_ATTACHMENT_WRITE = 0x00000002,
+        ZERO_ACCESS_DEPTH_ATTACHMENT_READ = 0x00000004,
+        ZERO_ACCESS_DEPTH_ATTACHMENT_WRITE = 0x00000008,
+        ZERO_ACCESS_SHADER_SAMPLED_READ = 0x00000010,
+        ZERO_ACCESS_SHADER_STORAGE_READ = 0x00000020,
+        ZERO_ACCESS_SHADER_STORAGE_WRITE = 0x00000040,
+        ZERO_ACCESS_TRANSFER_READ = 0x00000080,
+        ZERO_ACCESS_TRANSFER_WRITE = 0x00000100,
+        ZERO_ACCESS_PRESENT = 0x00000200
+    };
+    typedef GPUFlags GPUAccessFlags;
+
+    constexpr GPUAccessFlags const_gpu_access_write_mask =
+        ZERO_ACCESS_COLOR_ATTACHMENT_WRITE |
+        ZERO_ACCESS_DEPTH_ATTACHMENT_WRITE |
+        ZERO_ACCESS_SHADER_STORAGE_WRITE |
+        ZERO_ACCESS_TRANSFER_WRITE;
+
+    /**
+     * @brief Texture declared in a render graph. format is the backend format value, for instance a VkFormat.
+     *
+     */
+    struct GPURenderGraphTextureDescription {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t format = 0;
+        uint32_t samples = 1;
+    };
+
+    struct GPUMemoryRequirements {
+        uint64_t size = 0;
+        uint64_t alignment = 1;
+        uint32_t memory_type_bits = 0;
+        bool external = false; // memory provided by the backend outside of the graph heaps, for instance a render target pool
+    };
+
+    /**
+     * @brief Transition of one resource. discard is set when the previous contents are not needed,
+     * either on the first use of a transient texture or when it takes over memory from an aliased one.
+     *
+     */
+    struct GPURenderGraphBarrier {
+        GPURenderGraphResource resource;
+        GPUAccessFlags before;
+        GPUAccessFlags after;
+        bool discard;
+    };
+
+    struct GPURenderGraphStatistics {
+        uint32_t declared_passes = 0;
+        uint32_t culled_passes = 0;
+        uint32_t transient_textures = 0;
+        uint32_t external_textures = 0; // transient textures the backend provides outside of the heaps
+        uint32_t barriers = 0;
+        uint32_t barrier_batches = 0;
+        uint32_t memory_heaps = 0;
+        uint64_t transient_bytes = 0; // memory needed without aliasing
+        uint64_t aliased_bytes = 0; // memory actually allocated
+    };
+
+    /**
+     * @brief Handed to pass callbacks during execution to reach the command buffer and the physical resources.
+     * Textures are returned as backend handles, for instance VkImage and VkImageView.
+     *
+     */
+    class GPURenderGraphPassContext {
+    public:
+        virtual ~GPURenderGraphPassContext() = default;
+
+        virtual GraphicalCommandBuffer* getCommandBuffer() = 0;
+        virtual void* getTexture(const GPURenderGraphResource &resource) = 0;
+        virtual void* getTextureView(const GPURenderGraphResource &resource) = 0;
+    }; // class GPURenderGraphPassContext
+
+    typedef std::function<void(GPURenderGraphPassContext&)> GPURenderGraphPassExecute;
+    typedef std::function<GPUMemoryRequirements(const GPURenderGraphTextureDescription&, const GPUAccessFlags&)> GPURenderGraphMemoryQuery;
+
+    /**
+     * @brief A frame render graph. Passes declare the resources they read and write.
+     * compile() orders the passes by their dependencies, culls the passes whose results are never consumed, derives
+     * the barriers between passes and packs the memory of transient textures whose lifetimes do not overlap.
+     * Backends only have to translate the compiled result.
+     * Accesses to a resource keep their declaration order, except that a read of a transient texture declared before
+     * any write of it depends on the first pass writing it. Independent passes keep their declaration order.
+     * A write discards the previous contents of a resource unless the same pass also reads it.
+     *
+     */
+    class GPURenderGraph {
+    private:
+        struct ResourceUse {
+            GPURenderGraphResource resource;
+            GPUAccessFlags access;
+        };
+
+        struct PassNode {
+            std::string name;
+            GPURenderGraphPassExecute execute;
+            std::vector<ResourceUse> uses;
+            bool side_effect;
+            bool alive;
+            // barriers recorded before the pass
+            std::size_t first_barrier;
+            std::size_t barrier_count;
+        };
+
+        struct ResourceNode {
+            std::string name;
+            GPURenderGraphTextureDescription description;
+            bool imported;
+            void* native_texture;
+            void* native_view;
+            GPUAccessFlags initial_access;
+            GPUAccessFlags final_access;
+
+            // compiled state
+            GPUAccessFlags usage;
+            uint32_t first_use; // execution order index
+            uint32_t last_use;
+            GPUMemoryRequirements requirements;
+            uint32_t heap;
+            uint64_t offset;
+        };
+
+        std::vector<PassNode> m_passes;
+        std::vector<ResourceNode> m_resources;
+
+        std::vector<GPURenderGraphPass> m_execution_order;
+        std::vector<GPURenderGraphBarrier> m_barriers;
+        std::size_t m_final_barrier;
+        std::vector<GPUMemoryRequirements> m_heaps;
+        bool m_compiled;
+
+        GPURenderGraphStatistics m_statistics;
+
+        // scratch storage of compile(), kept so that recompiling a graph does not allocate
+        std::vector<std::pair<GPURenderGraphPass, GPURenderGraphPass>> m_dependencies;
+        std::vector<uint32_t> m_in_degrees;
+        std::vector<GPURenderGraphPass> m_pass_order;
+        std::vector<GPURenderGraphPass> m_readers;
+        std::vector<GPURenderGraphPass> m_early_readers;
+        std::vector<bool> m_needed;
+        std::vector<GPURenderGraphResource> m_transients;
+        std::vector<std::vector<GPURenderGraphResource>> m_heap_members;
+        std::vector<std::pair<uint64_t, uint64_t>> m_occupied;
+        std::vector<GPUAccessFlags> m_current_access;
+
+    private:
+        void use(const GPURenderGraphPass &pass, const GPURenderGraphResource &resource, const GPUAccessFlags &access);
+        void addDependency(const GPURenderGraphPass &before, const GPURenderGraphPass &after);
+        void sortPasses();
+        void cullPasses();
+        void computeLifetimes();
+        void placeTransients(const GPURenderGraphMemoryQuery &memory_query);
+        void computeBarriers();
+
+    public:
+        GPURenderGraph();
+
+        /**
+         * @brief Declare a texture owned by the graph. Its memory may be shared with other transient textures.
+         *
+         */
+        GPURenderGraphResource createTexture(const std::string &name, const GPURenderGraphTextureDescription &description);
+
+        /**
+         * @brief Declare a texture living outside the graph, such as a swapchain image. Passes writing it are never culled.
+         *
+         * @param native_texture Backend texture handle.
+         * @param native_view Backend texture view handle.
+         * @param initial_access Access the texture is in when the graph starts, ZERO_ACCESS_NONE if its contents are undefined.
+         * @param final_access Access the texture must be left in.
+         */
+        GPURenderGraphResource importTexture(
+            const std::string &name,
+            const GPURenderGraphTextureDescription &description,
+            void* native_texture,
+            void* native_view,
+            const GPUAccessFlags &initial_access,
+            const GPUAccessFlags &final_access);
+
+        /**
+         * @brief Replace the backend handles of an imported texture, for instance with this frame's swapchain image.
+         *
+         */
+        void setImportedTexture(const GPURenderGraphResource &resource, void* native_texture, void* native_view);
+
+        GPURenderGraphPass addPass(const std::string &name, const GPURenderGraphPassExecute &execute);
+        void read(const GPURenderGraphPass &pass, const GPURenderGraphResource &resource, const GPUAccessFlags &access);
+        void write(const GPURenderGraphPass &pass, const GPURenderGraphResource &resource, const GPUAccessFlags &access);
+
+        /**
+         * @brief Keep a pass even if nothing reads its results, for instance a readback.
+         *
+         */
+        void setSideEffect(const GPURenderGraphPass &pass);
+
+        /**
+         * @brief Order, cull and pack the graph. The declarations must not change until the next compile().
+         * Throws when the dependencies form a cycle.
+         *
+         * @param memory_query Backend memory requirements of a texture given its description and the union of its accesses.
+         */
+        void compile(const GPURenderGraphMemoryQuery &memory_query);
+
+        /**
+         * @brief Drop every pass and resource.
+         *
+         */
+        void clear();
+
+        bool isCompiled() const;
+        const std::vector<GPURenderGraphPass>& getExecutionOrder() const;
+        bool isPassCulled(const GPURenderGraphPass &pass) const;
+        const std::string& getPassName(const GPURenderGraphPass &pass) const;
+        void executePass(const GPURenderGraphPass &pass, GPURenderGraphPassContext &context) const;
+        std::vector<GPURenderGraphResource> getPassResources(const GPURenderGraphPass &pass) const;
+        GPUAccessFlags getPassAccess(const GPURenderGraphPass &pass, const GPURenderGraphResource &resource) const;
+
+        /**
+         * @brief Barriers to record before a pass, all in a single batch.
+         *
+         */
+        const GPURenderGraphBarrier* getPassBarriers(const GPURenderGraphPass &pass, std::size_t &barrier_count) const;
+
+        /**
+         * @brief Barriers bringing imported textures to their final access once every pass ran.
+         *
+         */
+        const GPURenderGraphBarrier* getFinalBarriers(std::size_t &barrier_count) const;
+
+        std::size_t countResources() const;
+        std::size_t countPasses() const;
+        const std::string& getResourceName(const GPURenderGraphResource &resource) const;
+        const GPURenderGraphTextureDescription& getTextureDescription(const GPURenderGraphResource &resource) const;
+        bool isImported(const GPURenderGraphResource &resource) const;
+        void* getImportedTexture(const GPURenderGraphResource &resource) const;
+        void* getImportedTextureView(const GPURenderGraphResource &resource) const;
+
+        /**
+         * @brief Union of the accesses of every pass left after culling, the texture usage to create it with.
+         *
+         */
+        GPUAccessFlags getTextureUsage(const GPURenderGraphResource &resource) const;
+
+        /**
+         * @brief Whether a transient texture is used by a pass left after culling and needs memory.
+         *
+         */
+        bool isTextureAllocated(const GPURenderGraphResource &resource) const;
+
+        /**
+         * @brief Whether a transient texture is used by a pass left after culling and the memory query marked it external.
+         *
+         */
+        bool isTextureExternal(const GPURenderGraphResource &resource) const;
+        uint32_t getTextureHeap(const GPURenderGraphResource &resource) const;
+        uint64_t getTextureOffset(const GPURenderGraphResource &resource) const;
+        const std::vector<GPUMemoryRequirements>& getHeaps() const;
+
+        const GPURenderGraphStatistics& getStatistics() const;
+    }; // class GPURenderGraph
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_GPURENDERGRAPH_H
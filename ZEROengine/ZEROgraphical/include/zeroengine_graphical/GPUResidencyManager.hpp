@@ -0,0 +1,122 @@
+#ifndef ZEROENGINE_GPURESIDENCYMANAGER_H
+#define ZEROENGINE_GPURESIDENCYMANAGER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include <functional>
+#include <memory>
+
+#include "zeroengine_graphical/GPUDefines.hpp"
+#include "zeroengine_graphical/GPUHandleTable.hpp"
+
+namespace ZEROengine {
+    typedef uint32_t GPUResidencyHandle;
+
+    /**
+     * @brief Called to shrink a resource, for instance by dropping its far mips, or to evict it entirely.
+     *
+     * @param bytes_wanted Bytes the manager still has to free this frame.
+     * @return uint64_t Bytes actually released, the whole resident size when the resource was evicted.
+     */
+    typedef std::function<uint64_t(const uint64_t &bytes_wanted)> GPUResidencyEvict;
+
+    // usage ratio of the budget starting evictions, and the ratio they bring usage back under
+    constexpr float const_gpu_residency_high_watermark = 0.90f;
+    constexpr float const_gpu_residency_low_watermark = 0.80f;
+    // frames before released memory is actually freed by the deletion queue, and before an unused resource may be evicted
+    constexpr uint32_t const_gpu_residency_release_latency = 3;
+
+    struct GPUMemoryBudget {
+        uint64_t usage = 0;
+        uint64_t budget = 0;
+    };
+
+    struct GPUResidencyStatistics {
+        uint64_t resident_bytes = 0; // registered resources only
+        uint64_t evicted_bytes = 0;
+        uint64_t evictions = 0;
+        uint64_t over_budget_frames = 0;
+        std::size_t resources = 0;
+    };
+
+    /**
+     * @brief Keeps the memory of registered resources under the device budget. Once usage passes the high watermark,
+     * resources are shrunk through their eviction callback, lowest priority and least recently used first, until usage
+     * is back under the low watermark. Resources used by the frames in flight are never evicted.
+     * Registration, use and unregistration are thread-safe. Eviction callbacks run without the manager locked, so they may
+     * update or unregister resources, but must not call update().
+     * The Vulkan device only feeds it the budget for now: its buffers hold data that cannot be rebuilt once evicted, and
+     * textures, the resources that can drop mips and stream back, are not allocated by the device yet.
+     *
+     */
+    class GPUResidencyManager {
+    private:
+        struct Resource {
+            uint64_t size;
+            uint32_t priority;
+            uint64_t last_used_frame;
+            std::shared_ptr<const GPUResidencyEvict> evict; // kept alive by update() while the callback runs unlocked
+        };
+
+        struct Candidate {
+            GPUResidencyHandle handle;
+            uint32_t priority;
+            uint64_t last_used_frame;
+            std::shared_ptr<const GPUResidencyEvict> evict;
+        };
+
+        mutable std::mutex m_mutex;
+        std::mutex m_update_mutex; // serializes update(), held while the eviction callbacks run
+        GPUHandleTable<Resource> m_resources;
+        uint64_t m_frame;
+
+        // bytes released in the last frames, still allocated until the deletion queue frees them
+        uint64_t m_released_bytes[const_gpu_residency_release_latency];
+
+        GPUResidencyStatistics m_statistics;
+
+        // scratch storage of update(), guarded by m_update_mutex
+        std::vector<Candidate> m_candidates;
+
+    public:
+        GPUResidencyManager();
+
+        /**
+         * @brief Track a resource for eviction.
+         *
+         * @param size Resident size in bytes.
+         * @param priority Resources of lower priority are evicted first.
+         * @param evict Shrinks or evicts the resource.
+         */
+        GPUResidencyHandle registerResource(const uint64_t &size, const uint32_t &priority, const GPUResidencyEvict &evict);
+        void unregisterResource(const GPUResidencyHandle &handle);
+
+        /**
+         * @brief Mark a resource as used by the current frame, protecting it from eviction while the frame is in flight.
+         *
+         */
+        void markUsed(const GPUResidencyHandle &handle);
+
+        /**
+         * @brief Update the resident size of a resource, after it was streamed back in for instance.
+         *
+         */
+        void setSize(const GPUResidencyHandle &handle, const uint64_t &size);
+        void setPriority(const GPUResidencyHandle &handle, const uint32_t &priority);
+
+        /**
+         * @brief Advance the frame and evict resources if the usage is over budget. Should be called once per frame.
+         *
+         * @param budget Usage and budget of the device memory, as reported by the backend.
+         * @return uint64_t Bytes released this frame.
+         */
+        uint64_t update(const GPUMemoryBudget &budget);
+
+        uint64_t getFrame() const;
+        GPUResidencyStatistics getStatistics() const;
+    }; // class GPUResidencyManager
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_GPURESIDENCYMANAGER_H
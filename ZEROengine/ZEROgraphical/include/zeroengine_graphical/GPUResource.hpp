@@ -42,15 +42,26 @@ namespace ZEROengine {
     };
     typedef GPUFlags GPUBufferUsageFlags;
 
+    /**
+     * @brief How the host accesses a buffer, which decides where its memory is placed.
+     *
+     */
+    enum GPUBufferAccess : uint32_t {
+        ZERO_BUFFER_ACCESS_STATIC, // written once, for instance meshes, placed in device local memory and uploaded through a staging copy when not mappable
+        ZERO_BUFFER_ACCESS_DYNAMIC, // rewritten sequentially every frame through the mapped pointer, placed in write-combined memory
+        ZERO_BUFFER_ACCESS_READBACK // written by the GPU and read by the host, placed in cached host memory
+    };
+
     struct GPUBufferDescription{
         uint64_t stride;
         uint64_t size;
         uint32_t elements_count;
 
         GPUBufferUsageFlags m_usage;
+        GPUBufferAccess access = ZERO_BUFFER_ACCESS_DYNAMIC;
     };
 
-    class GPUBuffer : GPUResource {
+    class GPUBuffer : public GPUResource {
     protected:
         void* m_buffer_handle;
         void* m_buffer_mapped;
@@ -62,10 +73,10 @@ namespace ZEROengine {
         virtual uint64_t getStride() const = 0;
         virtual uint64_t getElementsCount() const = 0;
         
-        virtual void* getBufferHandle() = 0;
-        virtual void setBufferHandle(void* handle) = 0;
+        virtual void* getBufferHandle();
+        virtual void setBufferHandle(void* handle);
 
-        virtual void* getBufferMapped() = 0;
+        virtual void* getBufferMapped();
 
         virtual void cleanup() override;
     }; // class GPUBuffer
@@ -0,0 +1,61 @@
+#ifndef ZEROENGINE_GPUSLOTALLOCATOR_H
+#define ZEROENGINE_GPUSLOTALLOCATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "zeroengine_graphical/GPUDefines.hpp"
+
+namespace ZEROengine {
+    /**
+     * @brief Fixed capacity allocator of descriptor slots. A released slot may still be read by frames in flight,
+     * so it is only handed out again once the GPU has completed the submission it was released after.
+     *
+     */
+    class GPUSlotAllocator {
+    private:
+        struct RetiredSlot {
+            uint32_t slot;
+            uint64_t retire_value;
+        };
+
+        uint32_t m_capacity;
+        uint32_t m_next_slot; // slots past this one have never been allocated
+        std::vector<uint32_t> m_free_slots;
+        std::vector<RetiredSlot> m_retired_slots;
+
+    public:
+        GPUSlotAllocator(const uint32_t &capacity);
+
+        /**
+         * @brief Take a free slot, recycled slots first.
+         *
+         * @return uint32_t The slot, const_gpu_invalid_handle when every slot is in use or waiting for the GPU.
+         */
+        uint32_t allocate();
+
+        /**
+         * @brief Give a slot back once the GPU reaches retire_value.
+         *
+         * @param slot A slot returned by allocate().
+         * @param retire_value Value of the last submission that may read the slot.
+         */
+        void release(const uint32_t &slot, const uint64_t &retire_value);
+
+        /**
+         * @brief Make the slots retired at or before completed_value allocatable again.
+         *
+         * @return std::size_t Number of slots recycled.
+         */
+        std::size_t collect(const uint64_t &completed_value);
+
+        uint32_t getCapacity() const;
+        uint32_t countAllocated() const;
+        std::size_t countRetired() const;
+
+        void reset();
+    }; // class GPUSlotAllocator
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_GPUSLOTALLOCATOR_H
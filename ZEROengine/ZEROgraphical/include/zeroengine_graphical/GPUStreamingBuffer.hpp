@@ -0,0 +1,87 @@
+#ifndef ZEROENGINE_GPUSTREAMINGBUFFER_H
+#define ZEROENGINE_GPUSTREAMINGBUFFER_H
+
+#include <cstdint>
+
+#include "zeroengine_graphical/GPUDefines.hpp"
+#include "zeroengine_graphical/GPUResource.hpp"
+
+namespace ZEROengine {
+    class GPUDevice;
+
+    /**
+     * @brief A host visible buffer rewritten every frame. It is split into one segment per frame in flight, so the CPU
+     * writes a segment while the GPU reads the others. Elements are addressed by their index in the whole buffer, which
+     * lets draws select their data through first_instance with the buffer bound once.
+     * 
+     */
+    class GPUStreamingBuffer {
+    private:
+        GPUDevice* m_device;
+        GPUBufferHandle m_buffer_handle;
+        uint8_t* m_mapped;
+
+        uint32_t m_element_size;
+        uint32_t m_elements_per_frame;
+        uint32_t m_frames_in_flight;
+
+        uint32_t m_frame_segment;
+        uint32_t m_frame_used;
+
+    public:
+        /**
+         * @brief Allocate the buffer on the device.
+         * 
+         * @param device The device owning the buffer, it must outlive the streaming buffer. The buffer should be cleaned up
+         * before the device is, the destructor leaves it to the device otherwise.
+         * @param element_size Size of one element in bytes.
+         * @param elements_per_frame Elements available to each frame.
+         * @param frames_in_flight Number of frames the GPU may still be reading.
+         * @param usage Buffer usage flags.
+         */
+        GPUStreamingBuffer(
+            GPUDevice* device,
+            const uint32_t &element_size,
+            const uint32_t &elements_per_frame,
+            const uint32_t &frames_in_flight,
+            const GPUBufferUsageFlags &usage);
+        ~GPUStreamingBuffer();
+
+        GPUStreamingBuffer(const GPUStreamingBuffer&) = delete;
+        GPUStreamingBuffer& operator=(const GPUStreamingBuffer&) = delete;
+
+        /**
+         * @brief Move to the next segment. The caller must have waited for the frame that last used it.
+         * 
+         */
+        void beginFrame();
+
+        /**
+         * @brief Reserve consecutive elements in the current frame segment.
+         * 
+         * @param count Number of elements.
+         * @param first_element Set to the index of the first reserved element in the whole buffer.
+         * @return void* Mapped pointer to the first element, nullptr when the segment is full.
+         */
+        void* allocate(const uint32_t &count, uint32_t &first_element);
+
+        /**
+         * @brief Flush the elements written in the current frame segment. Must be called before the frame is submitted.
+         *
+         */
+        void flush();
+
+        GPUBufferHandle getBufferHandle() const;
+        uint32_t getElementSize() const;
+        uint32_t getUsedElements() const;
+        uint32_t getElementsPerFrame() const;
+
+        /**
+         * @brief Release the buffer. Throws when the device no longer holds it.
+         *
+         */
+        void cleanup();
+    }; // class GPUStreamingBuffer
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_GPUSTREAMINGBUFFER_H
@@ -0,0 +1,24 @@
+#include "zeroengine_graphical/GPUCommandBuffer.hpp"
+
+namespace ZEROengine {
+    void GraphicalCommandBuffer::execute(const GPUCommandStream &stream) {
+        GPUCommandStreamReader reader(stream);
+        const GPUCommandHeader *header = nullptr;
+        while(reader.next(header)) {
+            switch(header->type) {
+            case ZERO_COMMAND_BIND_PIPELINE:
+                bindPipeline();
+                break;
+            case ZERO_COMMAND_BIND_VERTEX_BUFFER:
+                bindVertex();
+                break;
+            case ZERO_COMMAND_DRAW:
+            case ZERO_COMMAND_DRAW_INDEXED:
+                draw();
+                break;
+            default:
+                break;
+            }
+        }
+    }
+} // namespace ZEROengine
@@ -0,0 +1,109 @@
+#include "zeroengine_graphical/GPUCommandStream.hpp"
+#include "zeroengine_core/ZERODefines.hpp"
+
+namespace ZEROengine {
+    GPUCommandStream::GPUCommandStream() :
+    m_storage{},
+    m_command_count{0}
+    {}
+
+    void GPUCommandStream::bindPipeline(const GPUPipelineHandle &pipeline) {
+        GPUCommandBindPipeline &command = append<GPUCommandBindPipeline>(ZERO_COMMAND_BIND_PIPELINE);
+        command.pipeline = pipeline;
+    }
+
+    void GPUCommandStream::bindDescriptorSet(const uint32_t &set, const GPUDescriptorSetHandle &descriptor_set) {
+        GPUCommandBindDescriptorSet &command = append<GPUCommandBindDescriptorSet>(ZERO_COMMAND_BIND_DESCRIPTOR_SET);
+        command.set = set;
+        command.descriptor_set = descriptor_set;
+    }
+
+    void GPUCommandStream::bindVertexBuffer(const uint32_t &binding, const GPUBufferHandle &buffer, const uint32_t &offset) {
+        GPUCommandBindVertexBuffer &command = append<GPUCommandBindVertexBuffer>(ZERO_COMMAND_BIND_VERTEX_BUFFER);
+        command.binding = binding;
+        command.buffer = buffer;
+        command.offset = offset;
+    }
+
+    void GPUCommandStream::bindIndexBuffer(const GPUBufferHandle &buffer, const uint32_t &offset, const GPUIndexType &index_type) {
+        GPUCommandBindIndexBuffer &command = append<GPUCommandBindIndexBuffer>(ZERO_COMMAND_BIND_INDEX_BUFFER);
+        command.buffer = buffer;
+        command.offset = offset;
+        command.index_type = index_type;
+    }
+
+    void GPUCommandStream::setViewport(const float &x, const float &y, const float &width, const float &height, const float &min_depth, const float &max_depth) {
+        GPUCommandSetViewport &command = append<GPUCommandSetViewport>(ZERO_COMMAND_SET_VIEWPORT);
+        command.x = x;
+        command.y = y;
+        command.width = width;
+        command.height = height;
+        command.min_depth = min_depth;
+        command.max_depth = max_depth;
+    }
+
+    void GPUCommandStream::setScissor(const int32_t &x, const int32_t &y, const uint32_t &width, const uint32_t &height) {
+        GPUCommandSetScissor &command = append<GPUCommandSetScissor>(ZERO_COMMAND_SET_SCISSOR);
+        command.x = x;
+        command.y = y;
+        command.width = width;
+        command.height = height;
+    }
+
+    void GPUCommandStream::draw(const uint32_t &vertex_count, const uint32_t &instance_count, const uint32_t &first_vertex, const uint32_t &first_instance) {
+        GPUCommandDraw &command = append<GPUCommandDraw>(ZERO_COMMAND_DRAW);
+        command.vertex_count = vertex_count;
+        command.instance_count = instance_count;
+        command.first_vertex = first_vertex;
+        command.first_instance = first_instance;
+    }
+
+    void GPUCommandStream::drawIndexed(const uint32_t &index_count, const uint32_t &instance_count, const uint32_t &first_index, const int32_t &vertex_offset, const uint32_t &first_instance) {
+        GPUCommandDrawIndexed &command = append<GPUCommandDrawIndexed>(ZERO_COMMAND_DRAW_INDEXED);
+        command.index_count = index_count;
+        command.instance_count = instance_count;
+        command.first_index = first_index;
+        command.vertex_offset = vertex_offset;
+        command.first_instance = first_instance;
+    }
+
+    void GPUCommandStream::reset() {
+        m_storage.clear();
+        m_command_count = 0;
+    }
+
+    void GPUCommandStream::reserve(const std::size_t &bytes) {
+        m_storage.reserve((bytes + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+    }
+
+    const uint8_t* GPUCommandStream::data() const {
+        return reinterpret_cast<const uint8_t*>(m_storage.data());
+    }
+
+    std::size_t GPUCommandStream::size() const {
+        return m_storage.size() * sizeof(uint32_t);
+    }
+
+    uint32_t GPUCommandStream::countCommands() const {
+        return m_command_count;
+    }
+
+    bool GPUCommandStream::empty() const {
+        return m_command_count == 0;
+    }
+
+    GPUCommandStreamReader::GPUCommandStreamReader(const GPUCommandStream &stream) :
+    m_cursor{stream.data()},
+    m_end{stream.data() + stream.size()}
+    {}
+
+    bool GPUCommandStreamReader::next(const GPUCommandHeader* &header) {
+        if(m_cursor >= m_end) {
+            return false;
+        }
+        header = reinterpret_cast<const GPUCommandHeader*>(m_cursor);
+        ZERO_ASSERT(header->size >= sizeof(GPUCommandHeader) && m_cursor + header->size <= m_end, "Corrupted command stream.");
+        m_cursor += header->size;
+        return true;
+    }
+} // namespace ZEROengine
@@ -0,0 +1,220 @@
+#include "zeroengine_graphical/GPUDrawList.hpp"
+#include "zeroengine_core/ZERODefines.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace ZEROengine {
+    static_assert(const_draw_key_layer_bits + const_draw_key_pipeline_bits + const_draw_key_material_bits
+        + const_draw_key_mesh_bits + const_draw_key_depth_bits == 64, "Draw key fields must fill 64 bits.");
+
+    static uint64_t keyField(const uint32_t &value, const uint32_t &bits) {
+        ZERO_ASSERT(value < (1u << bits), "Draw key field out of range, " + std::to_string(value) + " does not fit in " + std::to_string(bits) + " bits.");
+        return static_cast<uint64_t>(value);
+    }
+
+    // the all ones value of a field is left to unbound handles, they sort after every bound one
+    static uint64_t handleField(const uint32_t &handle, const uint32_t &bits) {
+        if(handle == const_gpu_invalid_handle) {
+            return (uint64_t(1) << bits) - 1;
+        }
+        ZERO_ASSERT(handle < (1u << bits) - 1, "Draw key handle out of range, " + std::to_string(handle) + " does not fit in " + std::to_string(bits) + " bits.");
+        return static_cast<uint64_t>(handle);
+    }
+
+    GPUDrawList::GPUDrawList() :
+    m_draws{},
+    m_keys{},
+    m_order{},
+    m_transform_indices{},
+    m_transforms{},
+    m_instance_buffer{nullptr},
+    m_instance_binding{1},
+    m_sorter{},
+    m_is_sorted{true},
+    m_statistics{}
+    {}
+
+    uint64_t GPUDrawList::makeKey(const uint32_t &layer, const float &depth, const GPUDrawDescription &draw) {
+        const float clamped_depth = std::min(std::max(depth, 0.0f), 1.0f);
+        const uint32_t quantized_depth = static_cast<uint32_t>(std::lround(clamped_depth * static_cast<float>((1u << const_draw_key_depth_bits) - 1)));
+
+        uint64_t key = keyField(layer, const_draw_key_layer_bits);
+        key = (key << const_draw_key_pipeline_bits) | handleField(draw.pipeline, const_draw_key_pipeline_bits);
+        key = (key << const_draw_key_material_bits) | handleField(draw.material, const_draw_key_material_bits);
+        key = (key << const_draw_key_mesh_bits) | handleField(draw.vertex_buffer, const_draw_key_mesh_bits);
+        key = (key << const_draw_key_depth_bits) | keyField(quantized_depth, const_draw_key_depth_bits);
+        return key;
+    }
+
+    void GPUDrawList::submit(const uint32_t &layer, const float &depth, const GPUDrawDescription &draw) {
+        submit(makeKey(layer, depth, draw), draw);
+    }
+
+    void GPUDrawList::submit(const uint64_t &key, const GPUDrawDescription &draw) {
+        m_order.push_back(static_cast<uint32_t>(m_draws.size()));
+        m_draws.push_back(draw);
+        m_keys.push_back(key);
+        m_transform_indices.push_back(const_gpu_invalid_handle);
+        m_is_sorted = false;
+    }
+
+    void GPUDrawList::submitInstance(const uint32_t &layer, const float &depth, const GPUDrawDescription &draw, const GPUInstanceTransform &transform) {
+        submit(makeKey(layer, depth, draw), draw);
+        m_transform_indices.back() = static_cast<uint32_t>(m_transforms.size());
+        m_transforms.push_back(transform);
+    }
+
+    void GPUDrawList::setInstanceBuffer(GPUStreamingBuffer* instance_buffer, const uint32_t &binding) {
+        ZERO_ASSERT(instance_buffer == nullptr || instance_buffer->getElementSize() == sizeof(GPUInstanceTransform), "Instance buffer elements must be GPUInstanceTransform.");
+        m_instance_buffer = instance_buffer;
+        m_instance_binding = binding;
+    }
+
+    bool GPUDrawList::canBatch(const GPUDrawDescription &a, const GPUDrawDescription &b) {
+        return a.pipeline == b.pipeline
+            && a.material == b.material
+            && a.vertex_buffer == b.vertex_buffer
+            && a.index_buffer == b.index_buffer
+            && a.index_type == b.index_type
+            && a.index_count == b.index_count
+            && a.first_index == b.first_index
+            && a.vertex_offset == b.vertex_offset
+            && a.vertex_count == b.vertex_count
+            && a.first_vertex == b.first_vertex;
+    }
+
+    void GPUDrawList::sort(ThreadPool *thread_pool) {
+        m_sorter.sort(m_keys, m_order, thread_pool);
+        m_statistics.sort_passes = m_sorter.getLastPassCount();
+        m_is_sorted = true;
+    }
+
+    void GPUDrawList::emit(GPUCommandStream &stream) {
+        ZERO_ASSERT(m_is_sorted, "Draw list must be sorted before it is emitted.");
+
+        GPUPipelineHandle bound_pipeline = const_gpu_invalid_handle;
+        GPUDescriptorSetHandle bound_material = const_gpu_invalid_handle;
+        GPUBufferHandle bound_vertex_buffer = const_gpu_invalid_handle;
+        GPUBufferHandle bound_index_buffer = const_gpu_invalid_handle;
+        GPUIndexType bound_index_type = ZERO_INDEX_TYPE_UINT32;
+        bool instance_buffer_bound = false;
+
+        const std::size_t draw_count = m_order.size();
+        for(std::size_t i = 0; i < draw_count; ++i) {
+            const uint32_t draw_index = m_order[i];
+            const GPUDrawDescription &draw = m_draws[draw_index];
+
+            // gather the run of instances this draw can be merged with
+            uint32_t instance_count = draw.instance_count;
+            uint32_t first_instance = draw.first_instance;
+            if(m_transform_indices[draw_index] != const_gpu_invalid_handle) {
+                if(m_instance_buffer == nullptr) {
+                    ZERO_EXCEPT(ZEROResultEnum::ZERO_NULL_POINTER, "Draw list has instances but no instance buffer.");
+                }
+                std::size_t run_end = i + 1;
+                while(run_end < draw_count
+                    && m_transform_indices[m_order[run_end]] != const_gpu_invalid_handle
+                    && canBatch(draw, m_draws[m_order[run_end]])) {
+                    ++run_end;
+                }
+                instance_count = static_cast<uint32_t>(run_end - i);
+                GPUInstanceTransform *transforms = static_cast<GPUInstanceTransform*>(m_instance_buffer->allocate(instance_count, first_instance));
+                if(transforms == nullptr) {
+                    ZERO_EXCEPT(ZEROResultEnum::ZERO_FAILED, "Instance buffer is too small for the frame, " + std::to_string(m_instance_buffer->getElementsPerFrame()) + " transforms per frame.");
+                }
+                for(std::size_t j = i; j < run_end; ++j) {
+                    std::memcpy(&transforms[j - i], &m_transforms[m_transform_indices[m_order[j]]], sizeof(GPUInstanceTransform));
+                }
+                if(!instance_buffer_bound) {
+                    // bound once, batches select their transforms through first_instance
+                    stream.bindVertexBuffer(m_instance_binding, m_instance_buffer->getBufferHandle());
+                    instance_buffer_bound = true;
+                }
+                ++m_statistics.instanced_batches;
+                m_statistics.instances_batched += instance_count;
+                i = run_end - 1;
+            }
+
+            if(draw.pipeline != bound_pipeline) {
+                stream.bindPipeline(draw.pipeline);
+                bound_pipeline = draw.pipeline;
+                // a new pipeline layout may disturb the bound sets
+                bound_material = const_gpu_invalid_handle;
+                ++m_statistics.pipeline_binds;
+            } else {
+                ++m_statistics.redundant_binds_skipped;
+            }
+
+            if(draw.material != const_gpu_invalid_handle) {
+                if(draw.material != bound_material) {
+                    stream.bindDescriptorSet(0, draw.material);
+                    bound_material = draw.material;
+                    ++m_statistics.descriptor_set_binds;
+                } else {
+                    ++m_statistics.redundant_binds_skipped;
+                }
+            }
+
+            if(draw.vertex_buffer != const_gpu_invalid_handle) {
+                if(draw.vertex_buffer != bound_vertex_buffer) {
+                    stream.bindVertexBuffer(0, draw.vertex_buffer);
+                    bound_vertex_buffer = draw.vertex_buffer;
+                    ++m_statistics.vertex_buffer_binds;
+                } else {
+                    ++m_statistics.redundant_binds_skipped;
+                }
+            }
+
+            if(draw.index_buffer != const_gpu_invalid_handle) {
+                if(draw.index_buffer != bound_index_buffer || draw.index_type != bound_index_type) {
+                    stream.bindIndexBuffer(draw.index_buffer, 0, draw.index_type);
+                    bound_index_buffer = draw.index_buffer;
+                    bound_index_type = draw.index_type;
+                    ++m_statistics.index_buffer_binds;
+                } else {
+                    ++m_statistics.redundant_binds_skipped;
+                }
+                stream.drawIndexed(draw.index_count, instance_count, draw.first_index, draw.vertex_offset, first_instance);
+            } else {
+                stream.draw(draw.vertex_count, instance_count, draw.first_vertex, first_instance);
+            }
+            ++m_statistics.draws;
+        }
+    }
+
+    void GPUDrawList::reset() {
+        m_draws.clear();
+        m_keys.clear();
+        m_order.clear();
+        m_transform_indices.clear();
+        m_transforms.clear();
+        m_is_sorted = true;
+        m_statistics = GPUDrawListStatistics{};
+    }
+
+    void GPUDrawList::reserve(const std::size_t &draw_count) {
+        m_draws.reserve(draw_count);
+        m_keys.reserve(draw_count);
+        m_order.reserve(draw_count);
+        m_transform_indices.reserve(draw_count);
+    }
+
+    std::size_t GPUDrawList::countDraws() const {
+        return m_draws.size();
+    }
+
+    const GPUDrawDescription& GPUDrawList::getSortedDraw(const std::size_t &index) const {
+        return m_draws[m_order[index]];
+    }
+
+    uint64_t GPUDrawList::getSortedKey(const std::size_t &index) const {
+        return m_keys[index];
+    }
+
+    const GPUDrawListStatistics& GPUDrawList::getStatistics() const {
+        return m_statistics;
+    }
+} // namespace ZEROengine
@@ -0,0 +1,48 @@
+#include "zeroengine_graphical/GPUFrustum.hpp"
+
+#include <cmath>
+
+namespace ZEROengine {
+    GPUFrustum GPUFrustum::fromViewProjection(const float view_projection[16]) {
+        // rows of the column-major matrix
+        float rows[4][4];
+        for(uint32_t row = 0; row < 4; ++row) {
+            for(uint32_t column = 0; column < 4; ++column) {
+                rows[row][column] = view_projection[column * 4 + row];
+            }
+        }
+
+        GPUFrustum frustum{};
+        for(uint32_t i = 0; i < 4; ++i) {
+            frustum.planes[ZERO_FRUSTUM_LEFT][i] = rows[3][i] + rows[0][i];
+            frustum.planes[ZERO_FRUSTUM_RIGHT][i] = rows[3][i] - rows[0][i];
+            frustum.planes[ZERO_FRUSTUM_BOTTOM][i] = rows[3][i] + rows[1][i];
+            frustum.planes[ZERO_FRUSTUM_TOP][i] = rows[3][i] - rows[1][i];
+            // Vulkan clip depth is [0, w] rather than [-w, w]
+            frustum.planes[ZERO_FRUSTUM_NEAR][i] = rows[2][i];
+            frustum.planes[ZERO_FRUSTUM_FAR][i] = rows[3][i] - rows[2][i];
+        }
+
+        // normalized planes turn the plane equation into a signed distance
+        for(uint32_t plane = 0; plane < ZERO_FRUSTUM_PLANE_COUNT; ++plane) {
+            float *p = frustum.planes[plane];
+            float length = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+            if(length > 0.0f) {
+                for(uint32_t i = 0; i < 4; ++i) {
+                    p[i] /= length;
+                }
+            }
+        }
+        return frustum;
+    }
+
+    bool GPUFrustum::intersectsSphere(const float center[3], const float &radius) const {
+        for(uint32_t plane = 0; plane < ZERO_FRUSTUM_PLANE_COUNT; ++plane) {
+            const float *p = planes[plane];
+            if(p[0] * center[0] + p[1] * center[1] + p[2] * center[2] + p[3] < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace ZEROengine
@@ -0,0 +1,521 @@
+#include "zeroengine_graphical/GPURenderGraph.hpp"
+#include "zeroengine_core/ZERODefines.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace ZEROengine {
+    constexpr uint32_t const_render_graph_unused = std::numeric_limits<uint32_t>::max();
+
+    static uint64_t alignUp(const uint64_t &value, const uint64_t &alignment) {
+        return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+    }
+
+    GPURenderGraph::GPURenderGraph() :
+    m_passes{},
+    m_resources{},
+    m_execution_order{},
+    m_barriers{},
+    m_final_barrier{0},
+    m_heaps{},
+    m_compiled{false},
+    m_statistics{},
+    m_dependencies{},
+    m_in_degrees{},
+    m_pass_order{},
+    m_readers{},
+    m_early_readers{},
+    m_needed{},
+    m_transients{},
+    m_heap_members{},
+    m_occupied{},
+    m_current_access{}
+    {}
+
+    GPURenderGraphResource GPURenderGraph::createTexture(const std::string &name, const GPURenderGraphTextureDescription &description) {
+        ResourceNode resource{};
+        resource.name = name;
+        resource.description = description;
+        resource.imported = false;
+        resource.native_texture = nullptr;
+        resource.native_view = nullptr;
+        resource.initial_access = ZERO_ACCESS_NONE;
+        resource.final_access = ZERO_ACCESS_NONE;
+        m_resources.push_back(resource);
+        m_compiled = false;
+        return static_cast<GPURenderGraphResource>(m_resources.size() - 1);
+    }
+
+    GPURenderGraphResource GPURenderGraph::importTexture(
+        const std::string &name,
+        const GPURenderGraphTextureDescription &description,
+        void* native_texture,
+        void* native_view,
+        const GPUAccessFlags &initial_access,
+        const GPUAccessFlags &final_access
+    ) {
+        ResourceNode resource{};
+        resource.name = name;
+        resource.description = description;
+        resource.imported = true;
+        resource.native_texture = native_texture;
+        resource.native_view = native_view;
+        resource.initial_access = initial_access;
+        resource.final_access = final_access;
+        m_resources.push_back(resource);
+        m_compiled = false;
+        return static_cast<GPURenderGraphResource>(m_resources.size() - 1);
+    }
+
+    void GPURenderGraph::setImportedTexture(const GPURenderGraphResource &resource, void* native_texture, void* native_view) {
+        ZERO_ASSERT(resource < m_resources.size() && m_resources[resource].imported, "Render graph resource is not imported.");
+        m_resources[resource].native_texture = native_texture;
+        m_resources[resource].native_view = native_view;
+    }
+
+    GPURenderGraphPass GPURenderGraph::addPass(const std::string &name, const GPURenderGraphPassExecute &execute) {
+        PassNode pass{};
+        pass.name = name;
+        pass.execute = execute;
+        pass.side_effect = false;
+        pass.alive = false;
+        pass.first_barrier = 0;
+        pass.barrier_count = 0;
+        m_passes.push_back(std::move(pass));
+        m_compiled = false;
+        return static_cast<GPURenderGraphPass>(m_passes.size() - 1);
+    }
+
+    void GPURenderGraph::use(const GPURenderGraphPass &pass, const GPURenderGraphResource &resource, const GPUAccessFlags &access) {
+        ZERO_ASSERT(pass < m_passes.size(), "Unknown render graph pass.");
+        ZERO_ASSERT(resource < m_resources.size(), "Unknown render graph resource.");
+        // a new access on a used resource changes the barriers and the culling as much as a new use
+        m_compiled = false;
+        for(ResourceUse &resource_use : m_passes[pass].uses) {
+            if(resource_use.resource == resource) {
+                resource_use.access |= access;
+                return;
+            }
+        }
+        m_passes[pass].uses.push_back({resource, access});
+    }
+
+    void GPURenderGraph::read(const GPURenderGraphPass &pass, const GPURenderGraphResource &resource, const GPUAccessFlags &access) {
+        ZERO_ASSERT((access & const_gpu_access_write_mask) == 0, "Render graph read declared with a write access.");
+        use(pass, resource, access);
+    }
+
+    void GPURenderGraph::write(const GPURenderGraphPass &pass, const GPURenderGraphResource &resource, const GPUAccessFlags &access) {
+        ZERO_ASSERT((access & const_gpu_access_write_mask) != 0, "Render graph write declared without a write access.");
+        use(pass, resource, access);
+    }
+
+    void GPURenderGraph::setSideEffect(const GPURenderGraphPass &pass) {
+        ZERO_ASSERT(pass < m_passes.size(), "Unknown render graph pass.");
+        m_passes[pass].side_effect = true;
+        m_compiled = false;
+    }
+
+    void GPURenderGraph::addDependency(const GPURenderGraphPass &before, const GPURenderGraphPass &after) {
+        if(before != after) {
+            m_dependencies.emplace_back(before, after);
+            ++m_in_degrees[after];
+        }
+    }
+
+    void GPURenderGraph::sortPasses() {
+        m_dependencies.clear();
+        m_in_degrees.assign(m_passes.size(), 0);
+        m_pass_order.clear();
+
+        // read after write, write after write and write after read edges, resource by resource
+        for(std::size_t i = 0; i < m_resources.size(); ++i) {
+            const GPURenderGraphResource resource = static_cast<GPURenderGraphResource>(i);
+            GPURenderGraphPass last_writer = const_render_graph_unused;
+            m_readers.clear();
+            m_early_readers.clear();
+            for(std::size_t j = 0; j < m_passes.size(); ++j) {
+                const GPURenderGraphPass pass = static_cast<GPURenderGraphPass>(j);
+                GPUAccessFlags access = getPassAccess(pass, resource);
+                bool reads = (access & ~const_gpu_access_write_mask) != 0;
+                bool writes = (access & const_gpu_access_write_mask) != 0;
+
+                if(reads) {
+                    if(last_writer != const_render_graph_unused) {
+                        addDependency(last_writer, pass);
+                        m_readers.push_back(pass);
+                    } else if(!m_resources[i].imported && !writes) {
+                        // declared before the pass producing the texture, runs after it
+                        m_early_readers.push_back(pass);
+                    }
+                }
+                if(writes) {
+                    if(last_writer != const_render_graph_unused) {
+                        addDependency(last_writer, pass);
+                    }
+                    for(const GPURenderGraphPass &reader : m_readers) {
+                        addDependency(reader, pass);
+                    }
+                    m_readers.clear();
+                    if(last_writer == const_render_graph_unused) {
+                        for(const GPURenderGraphPass &reader : m_early_readers) {
+                            addDependency(pass, reader);
+                            m_readers.push_back(reader);
+                        }
+                        m_early_readers.clear();
+                    }
+                    last_writer = pass;
+                }
+            }
+        }
+
+        // Kahn's algorithm, always taking the first declared ready pass so that independent passes keep their order
+        for(std::size_t count = 0; count < m_passes.size(); ++count) {
+            GPURenderGraphPass next = const_render_graph_unused;
+            for(std::size_t j = 0; j < m_passes.size(); ++j) {
+                if(m_in_degrees[j] == 0) {
+                    next = static_cast<GPURenderGraphPass>(j);
+                    break;
+                }
+            }
+            if(next == const_render_graph_unused) {
+                ZERO_EXCEPT(ZEROResultEnum::ZERO_FAILED, "Render graph passes have cyclic dependencies.");
+            }
+            m_in_degrees[next] = const_render_graph_unused;
+            m_pass_order.push_back(next);
+            for(const std::pair<GPURenderGraphPass, GPURenderGraphPass> &dependency : m_dependencies) {
+                if(dependency.first == next) {
+                    --m_in_degrees[dependency.second];
+                }
+            }
+        }
+    }
+
+    void GPURenderGraph::cullPasses() {
+        // walk backwards, a pass survives when a surviving pass consumes one of its writes
+        m_needed.assign(m_resources.size(), false);
+        for(std::size_t i = m_pass_order.size(); i-- > 0;) {
+            PassNode &pass = m_passes[m_pass_order[i]];
+            pass.alive = pass.side_effect;
+            for(const ResourceUse &resource_use : pass.uses) {
+                if((resource_use.access & const_gpu_access_write_mask)
+                    && (m_resources[resource_use.resource].imported || m_needed[resource_use.resource])) {
+                    pass.alive = true;
+                }
+            }
+            if(!pass.alive) {
+                ++m_statistics.culled_passes;
+                continue;
+            }
+            // a write hides older contents from the passes after it, unless the pass reads them too
+            for(const ResourceUse &resource_use : pass.uses) {
+                if(resource_use.access & const_gpu_access_write_mask) {
+                    m_needed[resource_use.resource] = false;
+                }
+            }
+            for(const ResourceUse &resource_use : pass.uses) {
+                if(resource_use.access & ~const_gpu_access_write_mask) {
+                    m_needed[resource_use.resource] = true;
+                }
+            }
+        }
+    }
+
+    void GPURenderGraph::computeLifetimes() {
+        for(ResourceNode &resource : m_resources) {
+            resource.usage = ZERO_ACCESS_NONE;
+            resource.first_use = const_render_graph_unused;
+            resource.last_use = 0;
+            resource.requirements = GPUMemoryRequirements{};
+            resource.heap = const_render_graph_unused;
+            resource.offset = 0;
+        }
+
+        for(const GPURenderGraphPass &pass : m_pass_order) {
+            if(m_passes[pass].alive) {
+                m_execution_order.push_back(pass);
+            }
+        }
+        for(uint32_t order = 0; order < m_execution_order.size(); ++order) {
+            for(const ResourceUse &resource_use : m_passes[m_execution_order[order]].uses) {
+                ResourceNode &resource = m_resources[resource_use.resource];
+                if(resource.first_use == const_render_graph_unused) {
+                    resource.first_use = order;
+                    if(!resource.imported && (resource_use.access & const_gpu_access_write_mask) == 0) {
+                        ZERO_EXCEPT(ZEROResultEnum::ZERO_FAILED, "Render graph texture '" + resource.name + "' is read by '" + m_passes[m_execution_order[order]].name + "' before any pass writes it.");
+                    }
+                }
+                resource.last_use = order;
+                resource.usage |= resource_use.access;
+            }
+        }
+    }
+
+    void GPURenderGraph::placeTransients(const GPURenderGraphMemoryQuery &memory_query) {
+        m_transients.clear();
+        for(std::size_t i = 0; i < m_resources.size(); ++i) {
+            ResourceNode &resource = m_resources[i];
+            if(resource.imported || resource.first_use == const_render_graph_unused) {
+                continue;
+            }
+            resource.requirements = memory_query(resource.description, resource.usage);
+            ++m_statistics.transient_textures;
+            if(resource.requirements.external) {
+                ++m_statistics.external_textures;
+                continue;
+            }
+            m_statistics.transient_bytes += resource.requirements.size;
+            m_transients.push_back(static_cast<GPURenderGraphResource>(i));
+        }
+
+        // largest first, then first fit between the textures alive at the same time
+        // ties broken by index rather than with std::stable_sort, which allocates its temporary buffer
+        std::sort(m_transients.begin(), m_transients.end(), [this](const GPURenderGraphResource &a, const GPURenderGraphResource &b) {
+            if(m_resources[a].requirements.size != m_resources[b].requirements.size) {
+                return m_resources[a].requirements.size > m_resources[b].requirements.size;
+            }
+            return a < b;
+        });
+
+        // member lists keep their capacity from the previous compile()
+        for(std::vector<GPURenderGraphResource> &members : m_heap_members) {
+            members.clear();
+        }
+        for(const GPURenderGraphResource &index : m_transients) {
+            ResourceNode &resource = m_resources[index];
+
+            uint32_t heap = 0;
+            while(heap < m_heaps.size() && m_heaps[heap].memory_type_bits != resource.requirements.memory_type_bits) {
+                ++heap;
+            }
+            if(heap == m_heaps.size()) {
+                GPUMemoryRequirements heap_requirements{};
+                heap_requirements.memory_type_bits = resource.requirements.memory_type_bits;
+                m_heaps.push_back(heap_requirements);
+                if(m_heap_members.size() < m_heaps.size()) {
+                    m_heap_members.emplace_back();
+                }
+            }
+
+            m_occupied.clear();
+            for(const GPURenderGraphResource &member_index : m_heap_members[heap]) {
+                const ResourceNode &member = m_resources[member_index];
+                if(member.first_use <= resource.last_use && resource.first_use <= member.last_use) {
+                    m_occupied.emplace_back(member.offset, member.offset + member.requirements.size);
+                }
+            }
+            std::sort(m_occupied.begin(), m_occupied.end());
+
+            uint64_t offset = 0;
+            for(const std::pair<uint64_t, uint64_t> &range : m_occupied) {
+                if(alignUp(offset, resource.requirements.alignment) + resource.requirements.size <= range.first) {
+                    break;
+                }
+                offset = std::max(offset, range.second);
+            }
+            offset = alignUp(offset, resource.requirements.alignment);
+
+            resource.heap = heap;
+            resource.offset = offset;
+            m_heaps[heap].size = std::max(m_heaps[heap].size, offset + resource.requirements.size);
+            m_heaps[heap].alignment = std::max(m_heaps[heap].alignment, resource.requirements.alignment);
+            m_heap_members[heap].push_back(index);
+        }
+
+        m_statistics.memory_heaps = static_cast<uint32_t>(m_heaps.size());
+        for(const GPUMemoryRequirements &heap : m_heaps) {
+            m_statistics.aliased_bytes += heap.size;
+        }
+    }
+
+    void GPURenderGraph::computeBarriers() {
+        std::vector<GPUAccessFlags> &current = m_current_access;
+        current.assign(m_resources.size(), ZERO_ACCESS_NONE);
+        for(std::size_t i = 0; i < m_resources.size(); ++i) {
+            current[i] = m_resources[i].imported ? m_resources[i].initial_access : ZERO_ACCESS_NONE;
+        }
+
+        for(uint32_t order = 0; order < m_execution_order.size(); ++order) {
+            PassNode &pass = m_passes[m_execution_order[order]];
+            pass.first_barrier = m_barriers.size();
+
+            for(const ResourceUse &resource_use : pass.uses) {
+                const ResourceNode &resource = m_resources[resource_use.resource];
+                GPURenderGraphBarrier barrier{resource_use.resource, current[resource_use.resource], resource_use.access, false};
+
+                if(!resource.imported && resource.first_use == order) {
+                    // the memory may still be in use by the textures aliased before this one
+                    barrier.before = ZERO_ACCESS_NONE;
+                    barrier.discard = true;
+                    for(std::size_t i = 0; i < m_resources.size() && resource.heap != const_render_graph_unused; ++i) {
+                        const ResourceNode &other = m_resources[i];
+                        if(other.imported || other.heap != resource.heap || other.first_use == const_render_graph_unused || other.last_use >= order) {
+                            continue;
+                        }
+                        if(other.offset < resource.offset + resource.requirements.size && resource.offset < other.offset + other.requirements.size) {
+                            barrier.before |= current[i];
+                        }
+                    }
+                    m_barriers.push_back(barrier);
+                } else if(barrier.before != barrier.after || ((barrier.before | barrier.after) & const_gpu_access_write_mask)) {
+                    barrier.discard = barrier.before == ZERO_ACCESS_NONE;
+                    m_barriers.push_back(barrier);
+                }
+                current[resource_use.resource] = resource_use.access;
+            }
+
+            pass.barrier_count = m_barriers.size() - pass.first_barrier;
+            if(pass.barrier_count > 0) {
+                ++m_statistics.barrier_batches;
+            }
+        }
+
+        m_final_barrier = m_barriers.size();
+        for(std::size_t i = 0; i < m_resources.size(); ++i) {
+            const ResourceNode &resource = m_resources[i];
+            if(resource.imported && current[i] != resource.final_access) {
+                m_barriers.push_back({static_cast<GPURenderGraphResource>(i), current[i], resource.final_access, current[i] == ZERO_ACCESS_NONE});
+            }
+        }
+        if(m_barriers.size() > m_final_barrier) {
+            ++m_statistics.barrier_batches;
+        }
+        m_statistics.barriers = static_cast<uint32_t>(m_barriers.size());
+    }
+
+    void GPURenderGraph::compile(const GPURenderGraphMemoryQuery &memory_query) {
+        m_execution_order.clear();
+        m_barriers.clear();
+        m_heaps.clear();
+        m_statistics = GPURenderGraphStatistics{};
+        m_statistics.declared_passes = static_cast<uint32_t>(m_passes.size());
+
+        sortPasses();
+        cullPasses();
+        computeLifetimes();
+        placeTransients(memory_query);
+        computeBarriers();
+        m_compiled = true;
+    }
+
+    void GPURenderGraph::clear() {
+        m_passes.clear();
+        m_resources.clear();
+        m_execution_order.clear();
+        m_barriers.clear();
+        m_final_barrier = 0;
+        m_heaps.clear();
+        m_compiled = false;
+        m_statistics = GPURenderGraphStatistics{};
+    }
+
+    bool GPURenderGraph::isCompiled() const {
+        return m_compiled;
+    }
+
+    const std::vector<GPURenderGraphPass>& GPURenderGraph::getExecutionOrder() const {
+        return m_execution_order;
+    }
+
+    bool GPURenderGraph::isPassCulled(const GPURenderGraphPass &pass) const {
+        return !m_passes[pass].alive;
+    }
+
+    const std::string& GPURenderGraph::getPassName(const GPURenderGraphPass &pass) const {
+        return m_passes[pass].name;
+    }
+
+    void GPURenderGraph::executePass(const GPURenderGraphPass &pass, GPURenderGraphPassContext &context) const {
+        if(m_passes[pass].execute) {
+            m_passes[pass].execute(context);
+        }
+    }
+
+    std::vector<GPURenderGraphResource> GPURenderGraph::getPassResources(const GPURenderGraphPass &pass) const {
+        std::vector<GPURenderGraphResource> resources;
+        resources.reserve(m_passes[pass].uses.size());
+        for(const ResourceUse &resource_use : m_passes[pass].uses) {
+            resources.push_back(resource_use.resource);
+        }
+        return resources;
+    }
+
+    GPUAccessFlags GPURenderGraph::getPassAccess(const GPURenderGraphPass &pass, const GPURenderGraphResource &resource) const {
+        for(const ResourceUse &resource_use : m_passes[pass].uses) {
+            if(resource_use.resource == resource) {
+                return resource_use.access;
+            }
+        }
+        return ZERO_ACCESS_NONE;
+    }
+
+    const GPURenderGraphBarrier* GPURenderGraph::getPassBarriers(const GPURenderGraphPass &pass, std::size_t &barrier_count) const {
+        ZERO_ASSERT(m_compiled, "Render graph must be compiled first.");
+        barrier_count = m_passes[pass].barrier_count;
+        return m_barriers.data() + m_passes[pass].first_barrier;
+    }
+
+    const GPURenderGraphBarrier* GPURenderGraph::getFinalBarriers(std::size_t &barrier_count) const {
+        ZERO_ASSERT(m_compiled, "Render graph must be compiled first.");
+        barrier_count = m_barriers.size() - m_final_barrier;
+        return m_barriers.data() + m_final_barrier;
+    }
+
+    std::size_t GPURenderGraph::countResources() const {
+        return m_resources.size();
+    }
+
+    std::size_t GPURenderGraph::countPasses() const {
+        return m_passes.size();
+    }
+
+    const std::string& GPURenderGraph::getResourceName(const GPURenderGraphResource &resource) const {
+        return m_resources[resource].name;
+    }
+
+    const GPURenderGraphTextureDescription& GPURenderGraph::getTextureDescription(const GPURenderGraphResource &resource) const {
+        return m_resources[resource].description;
+    }
+
+    bool GPURenderGraph::isImported(const GPURenderGraphResource &resource) const {
+        return m_resources[resource].imported;
+    }
+
+    void* GPURenderGraph::getImportedTexture(const GPURenderGraphResource &resource) const {
+        return m_resources[resource].native_texture;
+    }
+
+    void* GPURenderGraph::getImportedTextureView(const GPURenderGraphResource &resource) const {
+        return m_resources[resource].native_view;
+    }
+
+    GPUAccessFlags GPURenderGraph::getTextureUsage(const GPURenderGraphResource &resource) const {
+        return m_resources[resource].usage;
+    }
+
+    bool GPURenderGraph::isTextureAllocated(const GPURenderGraphResource &resource) const {
+        return !m_resources[resource].imported && m_resources[resource].heap != const_render_graph_unused;
+    }
+
+    bool GPURenderGraph::isTextureExternal(const GPURenderGraphResource &resource) const {
+        const ResourceNode &node = m_resources[resource];
+        return !node.imported && node.first_use != const_render_graph_unused && node.requirements.external;
+    }
+
+    uint32_t GPURenderGraph::getTextureHeap(const GPURenderGraphResource &resource) const {
+        return m_resources[resource].heap;
+    }
+
+    uint64_t GPURenderGraph::getTextureOffset(const GPURenderGraphResource &resource) const {
+        return m_resources[resource].offset;
+    }
+
+    const std::vector<GPUMemoryRequirements>& GPURenderGraph::getHeaps() const {
+        return m_heaps;
+    }
+
+    const GPURenderGraphStatistics& GPURenderGraph::getStatistics() const {
+        return m_statistics;
+    }
+} // namespace ZEROengine
@@ -0,0 +1,132 @@
+#include "zeroengine_graphical/GPUResidencyManager.hpp"
+
+#include <algorithm>
+
+#include "zeroengine_core/ZERODefines.hpp"
+
+namespace ZEROengine {
+    GPUResidencyManager::GPUResidencyManager() :
+    m_mutex{},
+    m_update_mutex{},
+    m_resources{},
+    m_frame{0},
+    m_released_bytes{},
+    m_statistics{},
+    m_candidates{}
+    {}
+
+    GPUResidencyHandle GPUResidencyManager::registerResource(const uint64_t &size, const uint32_t &priority, const GPUResidencyEvict &evict) {
+        ZERO_ASSERT(evict, "Resident resources need an eviction callback.");
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_statistics.resident_bytes += size;
+        return m_resources.insert({size, priority, m_frame, std::make_shared<const GPUResidencyEvict>(evict)});
+    }
+
+    void GPUResidencyManager::unregisterResource(const GPUResidencyHandle &handle) {
+        std::shared_ptr<const GPUResidencyEvict> evict; // destroyed once the lock is released
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_resources.contains(handle)) {
+            return;
+        }
+        Resource resource = m_resources.release(handle);
+        m_statistics.resident_bytes -= resource.size;
+        evict = std::move(resource.evict);
+    }
+
+    void GPUResidencyManager::markUsed(const GPUResidencyHandle &handle) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_resources.get(handle).last_used_frame = m_frame;
+    }
+
+    void GPUResidencyManager::setSize(const GPUResidencyHandle &handle, const uint64_t &size) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Resource &resource = m_resources.get(handle);
+        m_statistics.resident_bytes = m_statistics.resident_bytes - resource.size + size;
+        resource.size = size;
+    }
+
+    void GPUResidencyManager::setPriority(const GPUResidencyHandle &handle, const uint32_t &priority) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_resources.get(handle).priority = priority;
+    }
+
+    uint64_t GPUResidencyManager::update(const GPUMemoryBudget &budget) {
+        std::lock_guard<std::mutex> update_lock(m_update_mutex);
+        uint64_t usage = 0;
+        uint64_t low = 0;
+        std::size_t released_slot = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_frame;
+            released_slot = m_frame % const_gpu_residency_release_latency;
+            m_released_bytes[released_slot] = 0;
+
+            // memory released in the previous frames is still counted by the driver until the deletion queue frees it
+            uint64_t pending = 0;
+            for(const uint64_t &bytes : m_released_bytes) {
+                pending += bytes;
+            }
+            usage = budget.usage > pending ? budget.usage - pending : 0;
+
+            const uint64_t high = static_cast<uint64_t>(static_cast<double>(budget.budget) * const_gpu_residency_high_watermark);
+            if(usage <= high) {
+                return 0;
+            }
+            ++m_statistics.over_budget_frames;
+            low = static_cast<uint64_t>(static_cast<double>(budget.budget) * const_gpu_residency_low_watermark);
+
+            m_candidates.clear();
+            m_resources.forEach([&](const uint32_t &handle, const Resource &resource) {
+                if(resource.size > 0 && resource.last_used_frame + const_gpu_residency_release_latency <= m_frame) {
+                    m_candidates.push_back({handle, resource.priority, resource.last_used_frame, resource.evict});
+                }
+            });
+        }
+        std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidate &a, const Candidate &b) {
+            if(a.priority != b.priority) {
+                return a.priority < b.priority;
+            }
+            return a.last_used_frame < b.last_used_frame;
+        });
+
+        // the callbacks run unlocked, they may stream, resize or unregister resources themselves
+        uint64_t released = 0;
+        for(const Candidate &candidate : m_candidates) {
+            if(usage <= low) {
+                break;
+            }
+            uint64_t freed = (*candidate.evict)(usage - low);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // the slot may have been unregistered, even reused, by a callback
+            if(m_resources.contains(candidate.handle) && m_resources.get(candidate.handle).evict == candidate.evict) {
+                Resource &resource = m_resources.get(candidate.handle);
+                freed = std::min(freed, resource.size);
+                resource.size -= freed;
+                m_statistics.resident_bytes -= freed;
+            }
+            if(freed == 0) {
+                continue;
+            }
+            usage = usage > freed ? usage - freed : 0;
+            released += freed;
+            m_released_bytes[released_slot] += freed;
+            m_statistics.evicted_bytes += freed;
+            ++m_statistics.evictions;
+        }
+        m_candidates.clear();
+        return released;
+    }
+
+    uint64_t GPUResidencyManager::getFrame() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_frame;
+    }
+
+    GPUResidencyStatistics GPUResidencyManager::getStatistics() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        GPUResidencyStatistics statistics = m_statistics;
+        statistics.resources = m_resources.count();
+        return statistics;
+    }
+} // namespace ZEROengine
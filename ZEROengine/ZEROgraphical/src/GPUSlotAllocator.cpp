@@ -0,0 +1,64 @@
+#include "zeroengine_graphical/GPUSlotAllocator.hpp"
+
+#include "zeroengine_core/ZERODefines.hpp"
+
+namespace ZEROengine {
+    GPUSlotAllocator::GPUSlotAllocator(const uint32_t &capacity) :
+    m_capacity{capacity},
+    m_next_slot{0},
+    m_free_slots{},
+    m_retired_slots{}
+    {
+        ZERO_ASSERT(capacity != const_gpu_invalid_handle, "Slot allocator capacity collides with the invalid handle.");
+    }
+
+    uint32_t GPUSlotAllocator::allocate() {
+        if(!m_free_slots.empty()) {
+            uint32_t slot = m_free_slots.back();
+            m_free_slots.pop_back();
+            return slot;
+        }
+        if(m_next_slot < m_capacity) {
+            return m_next_slot++;
+        }
+        return const_gpu_invalid_handle;
+    }
+
+    void GPUSlotAllocator::release(const uint32_t &slot, const uint64_t &retire_value) {
+        ZERO_ASSERT(slot < m_next_slot, "Releasing a slot that was never allocated.");
+        m_retired_slots.push_back({slot, retire_value});
+    }
+
+    std::size_t GPUSlotAllocator::collect(const uint64_t &completed_value) {
+        std::size_t recycled = 0;
+        for(std::size_t i = 0; i < m_retired_slots.size();) {
+            if(m_retired_slots[i].retire_value <= completed_value) {
+                m_free_slots.push_back(m_retired_slots[i].slot);
+                m_retired_slots[i] = m_retired_slots.back();
+                m_retired_slots.pop_back();
+                ++recycled;
+            } else {
+                ++i;
+            }
+        }
+        return recycled;
+    }
+
+    uint32_t GPUSlotAllocator::getCapacity() const {
+        return m_capacity;
+    }
+
+    uint32_t GPUSlotAllocator::countAllocated() const {
+        return m_next_slot - static_cast<uint32_t>(m_free_slots.size() + m_retired_slots.size());
+    }
+
+    std::size_t GPUSlotAllocator::countRetired() const {
+        return m_retired_slots.size();
+    }
+
+    void GPUSlotAllocator::reset() {
+        m_next_slot = 0;
+        m_free_slots.clear();
+        m_retired_slots.clear();
+    }
+} // namespace ZEROengine
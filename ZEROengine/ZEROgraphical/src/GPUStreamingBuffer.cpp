@@ -0,0 +1,95 @@
+#include "zeroengine_graphical/GPUStreamingBuffer.hpp"
+#include "zeroengine_graphical/GPUDevice.hpp"
+#include "zeroengine_core/ZERODefines.hpp"
+
+namespace ZEROengine {
+    GPUStreamingBuffer::GPUStreamingBuffer(
+        GPUDevice* device,
+        const uint32_t &element_size,
+        const uint32_t &elements_per_frame,
+        const uint32_t &frames_in_flight,
+        const GPUBufferUsageFlags &usage
+    ) :
+    m_device{device},
+    m_buffer_handle{const_gpu_invalid_handle},
+    m_mapped{nullptr},
+    m_element_size{element_size},
+    m_elements_per_frame{elements_per_frame},
+    m_frames_in_flight{frames_in_flight},
+    m_frame_segment{0},
+    m_frame_used{0}
+    {
+        ZERO_ASSERT(m_device != nullptr, "Streaming buffer needs a device.");
+        ZERO_ASSERT(element_size > 0 && elements_per_frame > 0 && frames_in_flight > 0, "Streaming buffer must not be empty.");
+
+        GPUBufferDescription buffer_description{};
+        buffer_description.stride = element_size;
+        buffer_description.elements_count = elements_per_frame * frames_in_flight;
+        buffer_description.size = static_cast<uint64_t>(element_size) * buffer_description.elements_count;
+        buffer_description.m_usage = usage;
+        buffer_description.access = ZERO_BUFFER_ACCESS_DYNAMIC;
+        ZEROResult result = m_device->allocateBuffer(buffer_description, m_buffer_handle);
+        if(result.result_code != ZERO_SUCCESS) {
+            ZERO_EXCEPT(result.result_code, "Cannot allocate streaming buffer: " + result.result_string);
+        }
+        m_mapped = static_cast<uint8_t*>(m_device->getBufferMapped(m_buffer_handle));
+        if(m_mapped == nullptr) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_NULL_POINTER, "Streaming buffer is not host visible.");
+        }
+    }
+
+    GPUStreamingBuffer::~GPUStreamingBuffer() {
+        // must not throw, the device may have been cleaned up first and freed the buffer already
+        if(m_buffer_handle != const_gpu_invalid_handle && m_device->containsBuffer(m_buffer_handle)) {
+            m_device->releaseBuffer(m_buffer_handle);
+        }
+    }
+
+    void GPUStreamingBuffer::beginFrame() {
+        m_frame_segment = (m_frame_segment + 1) % m_frames_in_flight;
+        m_frame_used = 0;
+    }
+
+    void* GPUStreamingBuffer::allocate(const uint32_t &count, uint32_t &first_element) {
+        if(count > m_elements_per_frame - m_frame_used) {
+            return nullptr;
+        }
+        first_element = m_frame_segment * m_elements_per_frame + m_frame_used;
+        m_frame_used += count;
+        return m_mapped + static_cast<std::size_t>(first_element) * m_element_size;
+    }
+
+    void GPUStreamingBuffer::flush() {
+        if(m_frame_used == 0) {
+            return;
+        }
+        // only the dirty range, the other segments may be read by the GPU
+        uint64_t segment_offset = static_cast<uint64_t>(m_frame_segment) * m_elements_per_frame * m_element_size;
+        m_device->flushBuffer(m_buffer_handle, segment_offset, static_cast<uint64_t>(m_frame_used) * m_element_size);
+    }
+
+    GPUBufferHandle GPUStreamingBuffer::getBufferHandle() const {
+        return m_buffer_handle;
+    }
+
+    uint32_t GPUStreamingBuffer::getElementSize() const {
+        return m_element_size;
+    }
+
+    uint32_t GPUStreamingBuffer::getUsedElements() const {
+        return m_frame_used;
+    }
+
+    uint32_t GPUStreamingBuffer::getElementsPerFrame() const {
+        return m_elements_per_frame;
+    }
+
+    void GPUStreamingBuffer::cleanup() {
+        if(m_buffer_handle == const_gpu_invalid_handle) {
+            return;
+        }
+        m_device->releaseBuffer(m_buffer_handle);
+        m_buffer_handle = const_gpu_invalid_handle;
+        m_mapped = nullptr;
+    }
+} // namespace ZEROengine
@@ -0,0 +1,32 @@
+#ifndef ZEROENGINE_NULLCOMMANDBUFFER_H
+#define ZEROENGINE_NULLCOMMANDBUFFER_H
+
+#include <memory>
+
+#include "zeroengine_graphical/GPUCommandBuffer.hpp"
+#include "zeroengine_null/NullDefines.hpp"
+
+namespace ZEROengine {
+    /**
+     * @brief A command buffer accepting every command, discarding the work and counting it.
+     * 
+     */
+    class NullCommandBuffer : public GraphicalCommandBuffer {
+    private:
+        std::shared_ptr<NullGraphicalCounters> m_counters;
+
+    public:
+        NullCommandBuffer(const std::shared_ptr<NullGraphicalCounters> &counters);
+
+        void init() override final;
+        void cleanup() override final;
+
+        void bindVertex() override final;
+        void bindPipeline() override final;
+        void draw() override final;
+
+        void execute(const GPUCommandStream &stream) override final;
+    }; // class NullCommandBuffer
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_NULLCOMMANDBUFFER_H
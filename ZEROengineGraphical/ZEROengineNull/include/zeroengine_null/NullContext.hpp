@@ -0,0 +1,34 @@
+#ifndef ZEROENGINE_NULLCONTEXT_H
+#define ZEROENGINE_NULLCONTEXT_H
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "zeroengine_graphical/GPUContext.hpp"
+#include "zeroengine_null/NullCommandBuffer.hpp"
+#include "zeroengine_null/NullDefines.hpp"
+
+namespace ZEROengine {
+    class NullGraphicalContext : public GraphicalContext {
+    private:
+        std::shared_ptr<NullGraphicalCounters> m_counters;
+        std::vector<std::shared_ptr<NullCommandBuffer>> m_null_command_buffers;
+
+        bool m_is_recording;
+
+    public:
+        NullGraphicalContext(const std::shared_ptr<NullGraphicalCounters> &counters);
+        void init() override final;
+        void cleanup() override final;
+
+        std::weak_ptr<GraphicalCommandBuffer> allocateCommandBuffer() override final;
+        std::weak_ptr<GraphicalCommandBuffer> getCommandBuffer() override final;
+        size_t countCommandBuffers() const override final;
+
+        void beginRecording() override final;
+        void endRecording() override final;
+    }; // class NullGraphicalContext
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_NULLCONTEXT_H
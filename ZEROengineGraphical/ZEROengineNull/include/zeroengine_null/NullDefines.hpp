@@ -0,0 +1,83 @@
+#ifndef ZEROENGINE_NULLDEFINES_H
+#define ZEROENGINE_NULLDEFINES_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace ZEROengine {
+    /**
+     * @brief A snapshot of the work submitted to the null backend.
+     * 
+     */
+    struct NullGraphicalStatistics {
+        uint64_t frames = 0;
+
+        uint64_t buffers_allocated = 0;
+        uint64_t textures_allocated = 0;
+        uint64_t contexts_allocated = 0;
+        uint64_t command_buffers_allocated = 0;
+
+        uint64_t recordings = 0;
+        uint64_t bind_vertex_calls = 0;
+        uint64_t bind_pipeline_calls = 0;
+        uint64_t bind_descriptor_set_calls = 0;
+        uint64_t draw_calls = 0;
+        uint64_t streams_executed = 0;
+        uint64_t stream_commands = 0;
+    };
+
+    /**
+     * @brief Exact counters shared by every object of a null backend instance. Command buffers may record from any thread.
+     * 
+     */
+    struct NullGraphicalCounters {
+        std::atomic<uint64_t> frames{0};
+
+        std::atomic<uint64_t> buffers_allocated{0};
+        std::atomic<uint64_t> textures_allocated{0};
+        std::atomic<uint64_t> contexts_allocated{0};
+        std::atomic<uint64_t> command_buffers_allocated{0};
+
+        std::atomic<uint64_t> recordings{0};
+        std::atomic<uint64_t> bind_vertex_calls{0};
+        std::atomic<uint64_t> bind_pipeline_calls{0};
+        std::atomic<uint64_t> bind_descriptor_set_calls{0};
+        std::atomic<uint64_t> draw_calls{0};
+        std::atomic<uint64_t> streams_executed{0};
+        std::atomic<uint64_t> stream_commands{0};
+
+        NullGraphicalStatistics snapshot() const {
+            NullGraphicalStatistics ret{};
+            ret.frames = frames.load(std::memory_order_relaxed);
+            ret.buffers_allocated = buffers_allocated.load(std::memory_order_relaxed);
+            ret.textures_allocated = textures_allocated.load(std::memory_order_relaxed);
+            ret.contexts_allocated = contexts_allocated.load(std::memory_order_relaxed);
+            ret.command_buffers_allocated = command_buffers_allocated.load(std::memory_order_relaxed);
+            ret.recordings = recordings.load(std::memory_order_relaxed);
+            ret.bind_vertex_calls = bind_vertex_calls.load(std::memory_order_relaxed);
+            ret.bind_pipeline_calls = bind_pipeline_calls.load(std::memory_order_relaxed);
+            ret.bind_descriptor_set_calls = bind_descriptor_set_calls.load(std::memory_order_relaxed);
+            ret.draw_calls = draw_calls.load(std::memory_order_relaxed);
+            ret.streams_executed = streams_executed.load(std::memory_order_relaxed);
+            ret.stream_commands = stream_commands.load(std::memory_order_relaxed);
+            return ret;
+        }
+
+        void reset() {
+            frames.store(0, std::memory_order_relaxed);
+            buffers_allocated.store(0, std::memory_order_relaxed);
+            textures_allocated.store(0, std::memory_order_relaxed);
+            contexts_allocated.store(0, std::memory_order_relaxed);
+            command_buffers_allocated.store(0, std::memory_order_relaxed);
+            recordings.store(0, std::memory_order_relaxed);
+            bind_vertex_calls.store(0, std::memory_order_relaxed);
+            bind_pipeline_calls.store(0, std::memory_order_relaxed);
+            bind_descriptor_set_calls.store(0, std::memory_order_relaxed);
+            draw_calls.store(0, std::memory_order_relaxed);
+            streams_executed.store(0, std::memory_order_relaxed);
+            stream_commands.store(0, std::memory_order_relaxed);
+        }
+    };
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_NULLDEFINES_H
@@ -0,0 +1,46 @@
+#ifndef ZEROENGINE_NULLDEVICE_H
+#define ZEROENGINE_NULLDEVICE_H
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "zeroengine_core/ZERODefines.hpp"
+#include "zeroengine_core/InstrumentedMutex.hpp"
+#include "zeroengine_graphical/GPUDevice.hpp"
+#include "zeroengine_graphical/GPUHandleTable.hpp"
+#include "zeroengine_null/NullDefines.hpp"
+
+namespace ZEROengine {
+    /**
+     * @brief A device without a GPU behind it. Resource allocations always succeed and are only counted.
+     * Buffers are backed by host memory so mapped writes cost what they would on a host visible heap.
+     * 
+     */
+    class NullDevice : public GPUDevice {
+    private:
+        std::shared_ptr<NullGraphicalCounters> m_counters;
+        GPUHandleTable<std::vector<uint8_t>> m_buffers;
+        mutable InstrumentedMutex m_resource_mutex;
+        GPUAllocationStatistics m_allocation_statistics;
+
+    public:
+        NullDevice(const std::shared_ptr<NullGraphicalCounters> &counters);
+
+        ZEROResult allocateBuffer(const GPUBufferDescription &buffer_description, GPUBufferHandle &buffer_handle) override;
+        void releaseBuffer(const GPUBufferHandle &buffer_handle) override;
+        bool containsBuffer(const GPUBufferHandle &buffer_handle) const override;
+        void* getBufferMapped(const GPUBufferHandle &buffer_handle) override;
+        ZEROResult writeBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const void* data, const uint64_t &size) override;
+        void flushBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const uint64_t &size) override;
+        void invalidateBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const uint64_t &size) override;
+        ZEROResult allocateTexture() override;
+        GPUAllocationStatistics getAllocationStatistics() const override;
+
+        std::weak_ptr<GraphicalContext> allocateGraphicalContext() override final;
+
+        void cleanup() override;
+    }; // class NullDevice
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_NULLDEVICE_H
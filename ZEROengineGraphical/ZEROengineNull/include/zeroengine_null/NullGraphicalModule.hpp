@@ -0,0 +1,46 @@
+#ifndef ZEROENGINE_NULLGRAPHICALMODULE_H
+#define ZEROENGINE_NULLGRAPHICALMODULE_H
+
+#include <memory>
+#include <cstdint>
+
+#include "zeroengine_graphical/GPUModule.hpp"
+#include "zeroengine_null/NullDevice.hpp"
+#include "zeroengine_null/NullDefines.hpp"
+
+namespace ZEROengine {
+    /**
+     * @brief A graphical module that takes the GPU driver out of the picture. 
+     * All resource creation and command recording is accepted and discarded while keeping exact counters,
+     * so the engine-side cost of drawFrame, resource management and command building can be measured on its own.
+     * 
+     */
+    class NullGraphicalModule : public GPUModule {
+    private:
+        std::shared_ptr<NullGraphicalCounters> m_counters;
+        std::shared_ptr<NullDevice> m_null_device;
+
+        uint64_t m_frame_limit; // turns the module off after this many frames, 0 for unlimited
+
+    public:
+        NullGraphicalModule();
+        std::weak_ptr<NullDevice> getNullDevice();
+
+        void initGraphicalModule() override;
+        void drawFrame() override;
+
+        /**
+         * @brief Turn the module off once the frame count is reached, ending the application main loop.
+         * 
+         * @param frame_limit Number of frames to draw, 0 for unlimited.
+         */
+        void setFrameLimit(const uint64_t &frame_limit);
+
+        NullGraphicalStatistics getStatistics() const;
+        void resetStatistics();
+
+        void cleanup() override;
+    }; // class NullGraphicalModule
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_NULLGRAPHICALMODULE_H
@@ -0,0 +1,61 @@
+#include "zeroengine_null/NullCommandBuffer.hpp"
+
+namespace ZEROengine {
+    NullCommandBuffer::NullCommandBuffer(const std::shared_ptr<NullGraphicalCounters> &counters) :
+    m_counters{counters}
+    {}
+
+    void NullCommandBuffer::init() {
+    }
+
+    void NullCommandBuffer::cleanup() {
+    }
+
+    void NullCommandBuffer::bindVertex() {
+        m_counters->bind_vertex_calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void NullCommandBuffer::bindPipeline() {
+        m_counters->bind_pipeline_calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void NullCommandBuffer::draw() {
+        m_counters->draw_calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void NullCommandBuffer::execute(const GPUCommandStream &stream) {
+        // walk the stream as a backend translation pass would, publishing the counts once
+        uint64_t bind_vertex_calls = 0;
+        uint64_t bind_pipeline_calls = 0;
+        uint64_t bind_descriptor_set_calls = 0;
+        uint64_t draw_calls = 0;
+        GPUCommandStreamReader reader(stream);
+        const GPUCommandHeader *header = nullptr;
+        while(reader.next(header)) {
+            switch(header->type) {
+            case ZERO_COMMAND_BIND_PIPELINE:
+                ++bind_pipeline_calls;
+                break;
+            case ZERO_COMMAND_BIND_DESCRIPTOR_SET:
+                ++bind_descriptor_set_calls;
+                break;
+            case ZERO_COMMAND_BIND_VERTEX_BUFFER:
+            case ZERO_COMMAND_BIND_INDEX_BUFFER:
+                ++bind_vertex_calls;
+                break;
+            case ZERO_COMMAND_DRAW:
+            case ZERO_COMMAND_DRAW_INDEXED:
+                ++draw_calls;
+                break;
+            default:
+                break;
+            }
+        }
+        m_counters->bind_vertex_calls.fetch_add(bind_vertex_calls, std::memory_order_relaxed);
+        m_counters->bind_pipeline_calls.fetch_add(bind_pipeline_calls, std::memory_order_relaxed);
+        m_counters->bind_descriptor_set_calls.fetch_add(bind_descriptor_set_calls, std::memory_order_relaxed);
+        m_counters->draw_calls.fetch_add(draw_calls, std::memory_order_relaxed);
+        m_counters->stream_commands.fetch_add(stream.countCommands(), std::memory_order_relaxed);
+        m_counters->streams_executed.fetch_add(1, std::memory_order_relaxed);
+    }
+} // namespace ZEROengine
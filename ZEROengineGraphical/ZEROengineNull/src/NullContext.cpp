@@ -0,0 +1,53 @@
+#include "zeroengine_null/NullContext.hpp"
+#include "zeroengine_core/ZERODefines.hpp"
+
+namespace ZEROengine {
+    NullGraphicalContext::NullGraphicalContext(const std::shared_ptr<NullGraphicalCounters> &counters) :
+    m_counters{counters},
+    m_null_command_buffers{},
+    m_is_recording{false}
+    {
+        init();
+    }
+
+    void NullGraphicalContext::init() {
+        m_counters->contexts_allocated.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::weak_ptr<GraphicalCommandBuffer> NullGraphicalContext::allocateCommandBuffer() {
+        std::shared_ptr<NullCommandBuffer> command_buffer = std::make_shared<NullCommandBuffer>(m_counters);
+        command_buffer->init();
+        m_null_command_buffers.push_back(command_buffer);
+        m_counters->command_buffers_allocated.fetch_add(1, std::memory_order_relaxed);
+        return command_buffer;
+    }
+
+    std::weak_ptr<GraphicalCommandBuffer> NullGraphicalContext::getCommandBuffer() {
+        if(m_null_command_buffers.empty()) {
+            return allocateCommandBuffer();
+        }
+        return m_null_command_buffers.back();
+    }
+
+    size_t NullGraphicalContext::countCommandBuffers() const {
+        return m_null_command_buffers.size();
+    }
+
+    void NullGraphicalContext::beginRecording() {
+        ZERO_ASSERT(!m_is_recording, "Context is already recording.");
+        m_is_recording = true;
+    }
+
+    void NullGraphicalContext::endRecording() {
+        ZERO_ASSERT(m_is_recording, "Context is not recording.");
+        m_is_recording = false;
+        m_counters->recordings.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void NullGraphicalContext::cleanup() {
+        for(std::shared_ptr<NullCommandBuffer> &command_buffer : m_null_command_buffers) {
+            command_buffer->cleanup();
+        }
+        m_null_command_buffers.clear();
+    }
+} // namespace ZEROengine
@@ -0,0 +1,93 @@
+#include "zeroengine_null/NullDevice.hpp"
+#include "zeroengine_null/NullContext.hpp"
+
+#include <mutex>
+#include <cstring>
+#include <utility>
+
+namespace ZEROengine {
+    NullDevice::NullDevice(const std::shared_ptr<NullGraphicalCounters> &counters) :
+    m_counters{counters},
+    m_buffers{},
+    m_resource_mutex{},
+    m_allocation_statistics{}
+    {}
+
+    ZEROResult NullDevice::allocateBuffer(const GPUBufferDescription &buffer_description, GPUBufferHandle &buffer_handle) {
+        std::vector<uint8_t> storage(buffer_description.size);
+        {
+            std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+            buffer_handle = m_buffers.insert(std::move(storage));
+            ++m_allocation_statistics.buffers_allocated;
+        }
+        m_counters->buffers_allocated.fetch_add(1, std::memory_order_relaxed);
+        return { ZERO_SUCCESS, "" };
+    }
+
+    void NullDevice::releaseBuffer(const GPUBufferHandle &buffer_handle) {
+        std::vector<uint8_t> storage; // freed once the lock is released
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        ZERO_ASSERT(m_buffers.contains(buffer_handle), "Releasing an unknown buffer handle, release buffers before the device is cleaned up.");
+        storage = m_buffers.release(buffer_handle);
+        ++m_allocation_statistics.buffers_released;
+    }
+
+    bool NullDevice::containsBuffer(const GPUBufferHandle &buffer_handle) const {
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        return m_buffers.contains(buffer_handle);
+    }
+
+    void* NullDevice::getBufferMapped(const GPUBufferHandle &buffer_handle) {
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        return m_buffers.get(buffer_handle).data();
+    }
+
+    ZEROResult NullDevice::writeBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const void* data, const uint64_t &size) {
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        std::vector<uint8_t> &storage = m_buffers.get(buffer_handle);
+        if(offset > storage.size() || size > storage.size() - offset) {
+            return { ZERO_FAILED, "Buffer write out of bounds." };
+        }
+        std::memcpy(storage.data() + offset, data, size);
+        return { ZERO_SUCCESS, "" };
+    }
+
+    void NullDevice::flushBuffer(const GPUBufferHandle&, const uint64_t&, const uint64_t&) {
+        // host memory, always coherent
+    }
+
+    void NullDevice::invalidateBuffer(const GPUBufferHandle&, const uint64_t&, const uint64_t&) {
+    }
+
+    ZEROResult NullDevice::allocateTexture() {
+        m_counters->textures_allocated.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        ++m_allocation_statistics.textures_allocated;
+        return { ZERO_SUCCESS, "" };
+    }
+
+    GPUAllocationStatistics NullDevice::getAllocationStatistics() const {
+        GPUAllocationStatistics statistics{};
+        {
+            std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+            statistics = m_allocation_statistics;
+        }
+        statistics.resource_lock = m_resource_mutex.getStatistics();
+        return statistics;
+    }
+
+    std::weak_ptr<GraphicalContext> NullDevice::allocateGraphicalContext() {
+        std::shared_ptr<GraphicalContext> graphical_context = std::make_shared<NullGraphicalContext>(m_counters);
+        m_graphical_contexts.push_back(graphical_context);
+        return graphical_context;
+    }
+
+    void NullDevice::cleanup() {
+        for(std::shared_ptr<GraphicalContext> &graphical_context : m_graphical_contexts) {
+            graphical_context->cleanup();
+        }
+        m_graphical_contexts.clear();
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        m_buffers.clear();
+    }
+} // namespace ZEROengine
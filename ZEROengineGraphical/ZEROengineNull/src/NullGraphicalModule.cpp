@@ -0,0 +1,45 @@
+#include "zeroengine_null/NullGraphicalModule.hpp"
+
+namespace ZEROengine {
+    NullGraphicalModule::NullGraphicalModule() :
+    m_counters{std::make_shared<NullGraphicalCounters>()},
+    m_null_device{},
+    m_frame_limit{0}
+    {}
+
+    void NullGraphicalModule::initGraphicalModule() {
+        m_is_off = false;
+        m_null_device = std::make_shared<NullDevice>(m_counters);
+    }
+
+    void NullGraphicalModule::drawFrame() {
+        uint64_t frame = m_counters->frames.fetch_add(1, std::memory_order_relaxed) + 1;
+        if(m_frame_limit > 0 && frame >= m_frame_limit) {
+            m_is_off = true;
+        }
+    }
+
+    std::weak_ptr<NullDevice> NullGraphicalModule::getNullDevice() {
+        return m_null_device;
+    }
+
+    void NullGraphicalModule::setFrameLimit(const uint64_t &frame_limit) {
+        m_frame_limit = frame_limit;
+    }
+
+    NullGraphicalStatistics NullGraphicalModule::getStatistics() const {
+        return m_counters->snapshot();
+    }
+
+    void NullGraphicalModule::resetStatistics() {
+        m_counters->reset();
+    }
+
+    void NullGraphicalModule::cleanup() {
+        if(m_null_device) {
+            m_null_device->cleanup();
+            m_null_device.reset();
+        }
+        m_is_off = true;
+    }
+} // namespace ZEROengine
@@ -0,0 +1,63 @@
+#ifndef ZEROENGINE_SOFTWARECOMMANDBUFFER_H
+#define ZEROENGINE_SOFTWARECOMMANDBUFFER_H
+
+#include <memory>
+#include <cstdint>
+#include <vector>
+
+#include "zeroengine_graphical/GPUCommandBuffer.hpp"
+#include "zeroengine_graphical/GPUDrawList.hpp"
+#include "zeroengine_software/SoftwareRasterizer.hpp"
+
+namespace ZEROengine {
+    /**
+     * @brief A command buffer feeding draws straight into the software rasterizer bins.
+     * Bound vertex and index data is referenced, not copied, and must stay alive until the draw is recorded.
+     * Command streams resolve buffer handles against the device buffer table and hold a reference on the bound storage,
+     * so a buffer released by another thread during the replay stays valid until it is unbound. Vertex buffers are read as SoftwareVertex
+     * from binding 0, pipelines, viewports and scissors are ignored by the fixed function rasterizer.
+     * A vertex buffer bound at any other binding holds the GPUInstanceTransform of each instance, whose 2D affine part is applied
+     * to the vertex positions. Without one the rasterizer has no per instance input, so draws of more than one instance are rejected.
+     * 
+     */
+    class SoftwareCommandBuffer : public GraphicalCommandBuffer {
+    private:
+        std::shared_ptr<SoftwareRasterizer> m_rasterizer;
+        std::shared_ptr<SoftwareBufferTable> m_buffers;
+
+        const SoftwareVertex *m_vertices;
+        uint32_t m_vertex_count;
+        const uint32_t *m_indices;
+        uint32_t m_index_count;
+        const GPUInstanceTransform *m_instances;
+        uint32_t m_instance_count;
+
+        std::vector<uint32_t> m_widened_indices; // 16 bit index buffers are widened here
+        std::vector<uint32_t> m_rebased_indices; // indices of draws whose vertex offset leaves the bound vertex range
+        std::vector<SoftwareVertex> m_instance_vertices; // fetched vertices of an instance, transformed
+        // storage of the buffers bound by execute(), m_vertices and m_indices point into them
+        std::shared_ptr<const std::vector<uint8_t>> m_vertex_storage;
+        std::shared_ptr<const std::vector<uint8_t>> m_index_storage;
+        std::shared_ptr<const std::vector<uint8_t>> m_instance_storage;
+
+        void submitInstances(const SoftwareVertex *vertices, const uint32_t &vertex_count, const uint32_t *indices, const uint32_t &index_count,
+            const uint32_t &instance_count, const uint32_t &first_instance);
+
+    public:
+        SoftwareCommandBuffer(const std::shared_ptr<SoftwareRasterizer> &rasterizer, const std::shared_ptr<SoftwareBufferTable> &buffers);
+
+        void init() override final;
+        void cleanup() override final;
+
+        void bindVertexData(const SoftwareVertex *vertices, const uint32_t &vertex_count);
+        void bindIndexData(const uint32_t *indices, const uint32_t &index_count);
+
+        void bindVertex() override final;
+        void bindPipeline() override final;
+        void draw() override final;
+
+        void execute(const GPUCommandStream &stream) override final;
+    }; // class SoftwareCommandBuffer
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_SOFTWARECOMMANDBUFFER_H
@@ -0,0 +1,34 @@
+#ifndef ZEROENGINE_SOFTWARECONTEXT_H
+#define ZEROENGINE_SOFTWARECONTEXT_H
+
+#include <memory>
+#include <vector>
+
+#include "zeroengine_graphical/GPUContext.hpp"
+#include "zeroengine_software/SoftwareCommandBuffer.hpp"
+#include "zeroengine_software/SoftwareRasterizer.hpp"
+
+namespace ZEROengine {
+    class SoftwareGraphicalContext : public GraphicalContext {
+    private:
+        std::shared_ptr<SoftwareRasterizer> m_rasterizer;
+        std::shared_ptr<SoftwareBufferTable> m_buffers;
+        std::vector<std::shared_ptr<SoftwareCommandBuffer>> m_software_command_buffers;
+
+        bool m_is_recording;
+
+    public:
+        SoftwareGraphicalContext(const std::shared_ptr<SoftwareRasterizer> &rasterizer, const std::shared_ptr<SoftwareBufferTable> &buffers);
+        void init() override final;
+        void cleanup() override final;
+
+        std::weak_ptr<GraphicalCommandBuffer> allocateCommandBuffer() override final;
+        std::weak_ptr<GraphicalCommandBuffer> getCommandBuffer() override final;
+        size_t countCommandBuffers() const override final;
+
+        void beginRecording() override final;
+        void endRecording() override final;
+    }; // class SoftwareGraphicalContext
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_SOFTWARECONTEXT_H
@@ -0,0 +1,66 @@
+#ifndef ZEROENGINE_SOFTWAREDEFINES_H
+#define ZEROENGINE_SOFTWAREDEFINES_H
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+#include "zeroengine_core/InstrumentedMutex.hpp"
+#include "zeroengine_graphical/GPUHandleTable.hpp"
+
+namespace ZEROengine {
+    // square tile edge in pixels, a multiple of the SIMD width
+    constexpr uint32_t const_sw_tile_size = 64;
+    // fractional bits of the fixed point screen coordinates
+    constexpr int64_t const_sw_subpixel_bits = 4;
+    constexpr int64_t const_sw_subpixel_scale = int64_t(1) << const_sw_subpixel_bits;
+    // NDC extent triangles are clipped to, keeping edge functions within 64 bits
+    constexpr float const_sw_guard_band = 4.0f;
+
+    /**
+     * @brief Position and color vertex, layout compatible with BaseVertex of the Vulkan backend.
+     * Positions are in normalized device coordinates, with y pointing down as in Vulkan.
+     * 
+     */
+    struct SoftwareVertex {
+        float x, y;
+        float r, g, b;
+    };
+
+    /**
+     * @brief RGBA8 color target. Rows are padded to a multiple of four pixels.
+     * 
+     */
+    struct SoftwareFramebuffer {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t stride = 0; // pixels per row
+        std::vector<uint32_t> pixels; // 0xAABBGGRR, R in the lowest byte
+
+        uint32_t getPixel(const uint32_t &x, const uint32_t &y) const {
+            return pixels[static_cast<std::size_t>(y) * stride + x];
+        }
+    };
+
+    /**
+     * @brief Host memory buffers, shared by the device and the command buffers resolving stream handles.
+     * Loaders may allocate while command buffers replay, every access goes through mutex.
+     * Storage is shared so that a command buffer keeps a bound buffer alive after its release, until the replay rebinds.
+     *
+     */
+    struct SoftwareBufferTable {
+        GPUHandleTable<std::shared_ptr<std::vector<uint8_t>>> buffers;
+        InstrumentedMutex mutex;
+    };
+
+    struct SoftwareRasterizerStatistics {
+        uint64_t triangles_submitted = 0;
+        uint64_t triangles_culled = 0; // degenerate or outside the framebuffer
+        uint64_t triangles_clipped = 0; // crossed the guard band
+        uint64_t tile_bin_entries = 0;
+        uint64_t tiles_rasterized = 0;
+        uint64_t scalar_fallbacks = 0; // SIMD regions whose edge functions would overflow 32 bits
+    };
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_SOFTWAREDEFINES_H
@@ -0,0 +1,42 @@
+#ifndef ZEROENGINE_SOFTWAREDEVICE_H
+#define ZEROENGINE_SOFTWAREDEVICE_H
+
+#include <memory>
+#include <cstdint>
+
+#include "zeroengine_core/ZERODefines.hpp"
+#include "zeroengine_graphical/GPUDevice.hpp"
+#include "zeroengine_software/SoftwareRasterizer.hpp"
+
+namespace ZEROengine {
+    /**
+     * @brief A device backed by the CPU rasterizer. Every context records into the same rasterizer.
+     * 
+     */
+    class SoftwareDevice : public GPUDevice {
+    private:
+        std::shared_ptr<SoftwareRasterizer> m_rasterizer;
+        std::shared_ptr<SoftwareBufferTable> m_buffers;
+        GPUAllocationStatistics m_allocation_statistics; // guarded by the buffer table mutex
+
+    public:
+        SoftwareDevice(const uint32_t &width, const uint32_t &height, const uint32_t &thread_count = 0);
+
+        ZEROResult allocateBuffer(const GPUBufferDescription &buffer_description, GPUBufferHandle &buffer_handle) override;
+        void releaseBuffer(const GPUBufferHandle &buffer_handle) override;
+        bool containsBuffer(const GPUBufferHandle &buffer_handle) const override;
+        void* getBufferMapped(const GPUBufferHandle &buffer_handle) override;
+        ZEROResult writeBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const void* data, const uint64_t &size) override;
+        void flushBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const uint64_t &size) override;
+        void invalidateBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const uint64_t &size) override;
+        ZEROResult allocateTexture() override;
+        GPUAllocationStatistics getAllocationStatistics() const override;
+
+        std::weak_ptr<GraphicalContext> allocateGraphicalContext() override final;
+        std::weak_ptr<SoftwareRasterizer> getRasterizer();
+
+        void cleanup() override;
+    }; // class SoftwareDevice
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_SOFTWAREDEVICE_H
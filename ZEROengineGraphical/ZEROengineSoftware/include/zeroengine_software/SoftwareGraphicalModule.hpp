@@ -0,0 +1,48 @@
+#ifndef ZEROENGINE_SOFTWAREGRAPHICALMODULE_H
+#define ZEROENGINE_SOFTWAREGRAPHICALMODULE_H
+
+#include <memory>
+#include <cstdint>
+
+#include "zeroengine_graphical/GPUModule.hpp"
+#include "zeroengine_software/SoftwareDevice.hpp"
+
+namespace ZEROengine {
+    /**
+     * @brief A graphical module rendering on the CPU into an in-memory framebuffer.
+     * drawFrame() rasterizes everything recorded since the previous frame, so headless machines can run the engine end to end.
+     * 
+     */
+    class SoftwareGraphicalModule : public GPUModule {
+    private:
+        std::shared_ptr<SoftwareDevice> m_software_device;
+
+        uint32_t m_width;
+        uint32_t m_height;
+        uint32_t m_thread_count;
+
+        uint64_t m_frame_count;
+        uint64_t m_frame_limit; // turns the module off after this many frames, 0 for unlimited
+
+    public:
+        SoftwareGraphicalModule(const uint32_t &width, const uint32_t &height, const uint32_t &thread_count = 0);
+        std::weak_ptr<SoftwareDevice> getSoftwareDevice();
+
+        void initGraphicalModule() override;
+        void drawFrame() override;
+
+        /**
+         * @brief Turn the module off once the frame count is reached, ending the application main loop.
+         * 
+         * @param frame_limit Number of frames to draw, 0 for unlimited.
+         */
+        void setFrameLimit(const uint64_t &frame_limit);
+        uint64_t getFrameCount() const;
+
+        const SoftwareFramebuffer& getFramebuffer() const;
+
+        void cleanup() override;
+    }; // class SoftwareGraphicalModule
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_SOFTWAREGRAPHICALMODULE_H
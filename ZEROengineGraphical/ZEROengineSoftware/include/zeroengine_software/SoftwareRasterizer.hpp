@@ -0,0 +1,90 @@
+#ifndef ZEROENGINE_SOFTWARERASTERIZER_H
+#define ZEROENGINE_SOFTWARERASTERIZER_H
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <atomic>
+
+#include "zeroengine_core/ThreadPool.hpp"
+#include "zeroengine_software/SoftwareDefines.hpp"
+
+namespace ZEROengine {
+    /**
+     * @brief Triangle set up for rasterization. Edge function i is opposite to vertex i, evaluates to E = a*x + b*y + c on 
+     * fixed point pixel centers, and is non-negative inside the triangle (the top-left fill rule bias is folded into c).
+     * 
+     */
+    struct SoftwareTriangle {
+        int64_t edge_a[3];
+        int64_t edge_b[3];
+        int64_t edge_c[3];
+
+        int32_t min_x, min_y, max_x, max_y; // inclusive pixel bounds, clipped to the framebuffer
+
+        float color[3][3];
+        float inv_area;
+    };
+
+    /**
+     * @brief Tile-binned, multithreaded triangle rasterizer with SIMD edge functions and color interpolation.
+     * Submitted triangles are binned into tiles, and flush() rasterizes every tile in parallel. Each tile processes its 
+     * triangles in submission order and owns its pixels, so the output does not depend on the thread count.
+     * Submission is not thread-safe.
+     * 
+     */
+    class SoftwareRasterizer {
+    private:
+        std::unique_ptr<ThreadPool> m_thread_pool;
+
+        SoftwareFramebuffer m_framebuffer;
+        uint32_t m_tiles_x;
+        uint32_t m_tiles_y;
+        uint32_t m_clear_color;
+
+        std::vector<SoftwareTriangle> m_triangles;
+        std::vector<std::vector<uint32_t>> m_tile_bins;
+
+        SoftwareRasterizerStatistics m_statistics;
+        std::atomic<uint64_t> m_scalar_fallbacks; // counted by the tile workers, folded into the statistics on flush
+        bool m_simd;
+
+    private:
+        void clipAndSetup(const SoftwareVertex &v0, const SoftwareVertex &v1, const SoftwareVertex &v2);
+        void setupTriangle(const SoftwareVertex &v0, const SoftwareVertex &v1, const SoftwareVertex &v2);
+
+        void rasterizeTile(const uint32_t &tile_index);
+        void rasterizeRegion(const SoftwareTriangle &triangle, const int32_t &x0, const int32_t &y0, const int32_t &x1, const int32_t &y1);
+        void rasterizeRegionScalar(const SoftwareTriangle &triangle, const int32_t &x0, const int32_t &y0, const int32_t &x1, const int32_t &y1);
+
+    public:
+        SoftwareRasterizer(const uint32_t &width, const uint32_t &height, const uint32_t &thread_count = 0);
+
+        void resize(const uint32_t &width, const uint32_t &height);
+        void setClearColor(const uint32_t &color);
+
+        /**
+         * @brief Use the SIMD path when it is compiled in, on by default. The scalar path produces the same pixels.
+         * 
+         */
+        void setSIMD(const bool &enable);
+        bool isSIMD() const;
+
+        void submitTriangles(const SoftwareVertex *vertices, const uint32_t &vertex_count);
+        void submitIndexedTriangles(const SoftwareVertex *vertices, const uint32_t &vertex_count, const uint32_t *indices, const uint32_t &index_count);
+
+        /**
+         * @brief Clear the framebuffer, rasterize every binned triangle and empty the bins.
+         * 
+         */
+        void flush();
+
+        const SoftwareFramebuffer& getFramebuffer() const;
+        uint32_t getThreadCount() const;
+
+        const SoftwareRasterizerStatistics& getStatistics() const;
+        void resetStatistics();
+    }; // class SoftwareRasterizer
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_SOFTWARERASTERIZER_H
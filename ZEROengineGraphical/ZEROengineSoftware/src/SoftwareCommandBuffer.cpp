@@ -0,0 +1,203 @@
+#include "zeroengine_software/SoftwareCommandBuffer.hpp"
+#include "zeroengine_core/ZERODefines.hpp"
+
+#include <mutex>
+
+namespace ZEROengine {
+    SoftwareCommandBuffer::SoftwareCommandBuffer(const std::shared_ptr<SoftwareRasterizer> &rasterizer, const std::shared_ptr<SoftwareBufferTable> &buffers) :
+    m_rasterizer{rasterizer},
+    m_buffers{buffers},
+    m_vertices{nullptr},
+    m_vertex_count{0},
+    m_indices{nullptr},
+    m_index_count{0},
+    m_instances{nullptr},
+    m_instance_count{0},
+    m_widened_indices{},
+    m_rebased_indices{},
+    m_instance_vertices{},
+    m_vertex_storage{},
+    m_index_storage{},
+    m_instance_storage{}
+    {}
+
+    void SoftwareCommandBuffer::init() {
+    }
+
+    void SoftwareCommandBuffer::cleanup() {
+        m_vertices = nullptr;
+        m_vertex_count = 0;
+        m_indices = nullptr;
+        m_index_count = 0;
+        m_instances = nullptr;
+        m_instance_count = 0;
+        m_vertex_storage.reset();
+        m_index_storage.reset();
+        m_instance_storage.reset();
+    }
+
+    void SoftwareCommandBuffer::bindVertexData(const SoftwareVertex *vertices, const uint32_t &vertex_count) {
+        m_vertices = vertices;
+        m_vertex_count = vertex_count;
+        m_vertex_storage.reset();
+    }
+
+    void SoftwareCommandBuffer::bindIndexData(const uint32_t *indices, const uint32_t &index_count) {
+        m_indices = indices;
+        m_index_count = index_count;
+        m_index_storage.reset();
+    }
+
+    void SoftwareCommandBuffer::bindVertex() {
+        // vertex data is bound through bindVertexData
+    }
+
+    void SoftwareCommandBuffer::bindPipeline() {
+        // the rasterizer has a single fixed function pipeline
+    }
+
+    void SoftwareCommandBuffer::draw() {
+        if(m_vertices == nullptr) {
+            return;
+        }
+        if(m_indices != nullptr) {
+            m_rasterizer->submitIndexedTriangles(m_vertices, m_vertex_count, m_indices, m_index_count);
+        } else {
+            m_rasterizer->submitTriangles(m_vertices, m_vertex_count);
+        }
+    }
+
+    void SoftwareCommandBuffer::submitInstances(const SoftwareVertex *vertices, const uint32_t &vertex_count, const uint32_t *indices, const uint32_t &index_count,
+        const uint32_t &instance_count, const uint32_t &first_instance) {
+        if(m_instances == nullptr) {
+            // without per instance input every instance would rasterize the same triangles
+            ZERO_ASSERT(instance_count <= 1, "Instanced draw without a bound instance buffer.");
+            if(instance_count == 0) {
+                return;
+            }
+            if(indices != nullptr) {
+                m_rasterizer->submitIndexedTriangles(vertices, vertex_count, indices, index_count);
+            } else {
+                m_rasterizer->submitTriangles(vertices, vertex_count);
+            }
+            return;
+        }
+        ZERO_ASSERT(static_cast<uint64_t>(first_instance) + instance_count <= m_instance_count, "Draw out of the bound instance range.");
+
+        const uint32_t fetched_count = indices != nullptr ? index_count : vertex_count;
+        m_instance_vertices.resize(fetched_count);
+        for(uint32_t instance = 0; instance < instance_count; ++instance) {
+            const float *model = m_instances[first_instance + instance].model;
+            for(uint32_t i = 0; i < fetched_count; ++i) {
+                const uint32_t index = indices != nullptr ? indices[i] : i;
+                if(index >= vertex_count) {
+                    ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Index out of the bound vertex range.");
+                }
+                // column-major, the rasterizer has no depth so only the 2D affine part applies
+                const SoftwareVertex &vertex = vertices[index];
+                m_instance_vertices[i] = {
+                    model[0] * vertex.x + model[4] * vertex.y + model[12],
+                    model[1] * vertex.x + model[5] * vertex.y + model[13],
+                    vertex.r, vertex.g, vertex.b
+                };
+            }
+            m_rasterizer->submitTriangles(m_instance_vertices.data(), fetched_count);
+        }
+    }
+
+    void SoftwareCommandBuffer::execute(const GPUCommandStream &stream) {
+        GPUCommandStreamReader reader(stream);
+        const GPUCommandHeader *header = nullptr;
+        while(reader.next(header)) {
+            switch(header->type) {
+            case ZERO_COMMAND_BIND_VERTEX_BUFFER: {
+                const GPUCommandBindVertexBuffer *command = reinterpret_cast<const GPUCommandBindVertexBuffer*>(header);
+                std::shared_ptr<const std::vector<uint8_t>> storage;
+                {
+                    std::lock_guard<InstrumentedMutex> lock(m_buffers->mutex);
+                    storage = m_buffers->buffers.get(command->buffer);
+                }
+                ZERO_ASSERT(command->offset <= storage->size(), "Vertex buffer offset out of range.");
+                if(command->binding != 0) {
+                    m_instances = reinterpret_cast<const GPUInstanceTransform*>(storage->data() + command->offset);
+                    m_instance_count = static_cast<uint32_t>((storage->size() - command->offset) / sizeof(GPUInstanceTransform));
+                    m_instance_storage = std::move(storage);
+                    break;
+                }
+                bindVertexData(
+                    reinterpret_cast<const SoftwareVertex*>(storage->data() + command->offset),
+                    static_cast<uint32_t>((storage->size() - command->offset) / sizeof(SoftwareVertex)));
+                // kept until the next bind, the draws read it without the table lock
+                m_vertex_storage = std::move(storage);
+                break;
+            }
+            case ZERO_COMMAND_BIND_INDEX_BUFFER: {
+                const GPUCommandBindIndexBuffer *command = reinterpret_cast<const GPUCommandBindIndexBuffer*>(header);
+                std::shared_ptr<const std::vector<uint8_t>> storage;
+                {
+                    std::lock_guard<InstrumentedMutex> lock(m_buffers->mutex);
+                    storage = m_buffers->buffers.get(command->buffer);
+                }
+                ZERO_ASSERT(command->offset <= storage->size(), "Index buffer offset out of range.");
+                const uint8_t *data = storage->data() + command->offset;
+                std::size_t bytes = storage->size() - command->offset;
+                if(command->index_type == ZERO_INDEX_TYPE_UINT16) {
+                    const uint16_t *narrow = reinterpret_cast<const uint16_t*>(data);
+                    m_widened_indices.assign(narrow, narrow + bytes / sizeof(uint16_t));
+                    bindIndexData(m_widened_indices.data(), static_cast<uint32_t>(m_widened_indices.size()));
+                } else {
+                    bindIndexData(reinterpret_cast<const uint32_t*>(data), static_cast<uint32_t>(bytes / sizeof(uint32_t)));
+                    // kept until the next bind, the draws read it without the table lock
+                    m_index_storage = std::move(storage);
+                }
+                break;
+            }
+            case ZERO_COMMAND_DRAW: {
+                const GPUCommandDraw *command = reinterpret_cast<const GPUCommandDraw*>(header);
+                ZERO_ASSERT(m_vertices != nullptr, "Draw without a bound vertex buffer.");
+                ZERO_ASSERT(static_cast<uint64_t>(command->first_vertex) + command->vertex_count <= m_vertex_count, "Draw out of the bound vertex range.");
+                submitInstances(m_vertices + command->first_vertex, command->vertex_count, nullptr, 0, command->instance_count, command->first_instance);
+                break;
+            }
+            case ZERO_COMMAND_DRAW_INDEXED: {
+                const GPUCommandDrawIndexed *command = reinterpret_cast<const GPUCommandDrawIndexed*>(header);
+                ZERO_ASSERT(m_vertices != nullptr && m_indices != nullptr, "Indexed draw without bound buffers.");
+                ZERO_ASSERT(static_cast<uint64_t>(command->first_index) + command->index_count <= m_index_count, "Draw out of the bound index range.");
+                const uint32_t *indices = m_indices + command->first_index;
+                if(command->vertex_offset >= 0 && static_cast<uint32_t>(command->vertex_offset) <= m_vertex_count) {
+                    // the fetched vertices are checked against the bound range past the offset
+                    const uint32_t vertex_offset = static_cast<uint32_t>(command->vertex_offset);
+                    submitInstances(m_vertices + vertex_offset, m_vertex_count - vertex_offset, indices, command->index_count,
+                        command->instance_count, command->first_instance);
+                    break;
+                }
+                // a negative offset is valid as long as every index it is added to fetches a bound vertex
+                m_rebased_indices.resize(command->index_count);
+                for(uint32_t i = 0; i < command->index_count; ++i) {
+                    const int64_t vertex = static_cast<int64_t>(indices[i]) + command->vertex_offset;
+                    if(vertex < 0 || vertex >= static_cast<int64_t>(m_vertex_count)) {
+                        ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Index out of the bound vertex range.");
+                    }
+                    m_rebased_indices[i] = static_cast<uint32_t>(vertex);
+                }
+                submitInstances(m_vertices, m_vertex_count, m_rebased_indices.data(), command->index_count,
+                    command->instance_count, command->first_instance);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        // the bindings of a stream end with it, the buffers may be freed from here on
+        if(m_vertex_storage) {
+            bindVertexData(nullptr, 0);
+        }
+        if(m_index_storage) {
+            bindIndexData(nullptr, 0);
+        }
+        m_instances = nullptr;
+        m_instance_count = 0;
+        m_instance_storage.reset();
+    }
+} // namespace ZEROengine
@@ -0,0 +1,51 @@
+#include "zeroengine_software/SoftwareContext.hpp"
+#include "zeroengine_core/ZERODefines.hpp"
+
+namespace ZEROengine {
+    SoftwareGraphicalContext::SoftwareGraphicalContext(const std::shared_ptr<SoftwareRasterizer> &rasterizer, const std::shared_ptr<SoftwareBufferTable> &buffers) :
+    m_rasterizer{rasterizer},
+    m_buffers{buffers},
+    m_software_command_buffers{},
+    m_is_recording{false}
+    {
+        init();
+    }
+
+    void SoftwareGraphicalContext::init() {
+    }
+
+    std::weak_ptr<GraphicalCommandBuffer> SoftwareGraphicalContext::allocateCommandBuffer() {
+        std::shared_ptr<SoftwareCommandBuffer> command_buffer = std::make_shared<SoftwareCommandBuffer>(m_rasterizer, m_buffers);
+        command_buffer->init();
+        m_software_command_buffers.push_back(command_buffer);
+        return command_buffer;
+    }
+
+    std::weak_ptr<GraphicalCommandBuffer> SoftwareGraphicalContext::getCommandBuffer() {
+        if(m_software_command_buffers.empty()) {
+            return allocateCommandBuffer();
+        }
+        return m_software_command_buffers.back();
+    }
+
+    size_t SoftwareGraphicalContext::countCommandBuffers() const {
+        return m_software_command_buffers.size();
+    }
+
+    void SoftwareGraphicalContext::beginRecording() {
+        ZERO_ASSERT(!m_is_recording, "Context is already recording.");
+        m_is_recording = true;
+    }
+
+    void SoftwareGraphicalContext::endRecording() {
+        ZERO_ASSERT(m_is_recording, "Context is not recording.");
+        m_is_recording = false;
+    }
+
+    void SoftwareGraphicalContext::cleanup() {
+        for(std::shared_ptr<SoftwareCommandBuffer> &command_buffer : m_software_command_buffers) {
+            command_buffer->cleanup();
+        }
+        m_software_command_buffers.clear();
+    }
+} // namespace ZEROengine
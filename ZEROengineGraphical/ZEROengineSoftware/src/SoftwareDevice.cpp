@@ -0,0 +1,90 @@
+#include "zeroengine_software/SoftwareDevice.hpp"
+#include "zeroengine_software/SoftwareContext.hpp"
+
+#include <mutex>
+#include <cstring>
+#include <utility>
+
+namespace ZEROengine {
+    SoftwareDevice::SoftwareDevice(const uint32_t &width, const uint32_t &height, const uint32_t &thread_count) :
+    m_rasterizer{std::make_shared<SoftwareRasterizer>(width, height, thread_count)},
+    m_buffers{std::make_shared<SoftwareBufferTable>()},
+    m_allocation_statistics{}
+    {}
+
+    ZEROResult SoftwareDevice::allocateBuffer(const GPUBufferDescription &buffer_description, GPUBufferHandle &buffer_handle) {
+        std::shared_ptr<std::vector<uint8_t>> storage = std::make_shared<std::vector<uint8_t>>(buffer_description.size);
+        std::lock_guard<InstrumentedMutex> lock(m_buffers->mutex);
+        buffer_handle = m_buffers->buffers.insert(std::move(storage));
+        ++m_allocation_statistics.buffers_allocated;
+        return { ZERO_SUCCESS, "" };
+    }
+
+    void SoftwareDevice::releaseBuffer(const GPUBufferHandle &buffer_handle) {
+        std::shared_ptr<std::vector<uint8_t>> storage; // freed once the lock is released, unless a command buffer still binds it
+        std::lock_guard<InstrumentedMutex> lock(m_buffers->mutex);
+        ZERO_ASSERT(m_buffers->buffers.contains(buffer_handle), "Releasing an unknown buffer handle, release buffers before the device is cleaned up.");
+        storage = m_buffers->buffers.release(buffer_handle);
+        ++m_allocation_statistics.buffers_released;
+    }
+
+    bool SoftwareDevice::containsBuffer(const GPUBufferHandle &buffer_handle) const {
+        std::lock_guard<InstrumentedMutex> lock(m_buffers->mutex);
+        return m_buffers->buffers.contains(buffer_handle);
+    }
+
+    void* SoftwareDevice::getBufferMapped(const GPUBufferHandle &buffer_handle) {
+        std::lock_guard<InstrumentedMutex> lock(m_buffers->mutex);
+        return m_buffers->buffers.get(buffer_handle)->data();
+    }
+
+    ZEROResult SoftwareDevice::writeBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const void* data, const uint64_t &size) {
+        std::lock_guard<InstrumentedMutex> lock(m_buffers->mutex);
+        std::vector<uint8_t> &storage = *m_buffers->buffers.get(buffer_handle);
+        if(offset > storage.size() || size > storage.size() - offset) {
+            return { ZERO_FAILED, "Buffer write out of bounds." };
+        }
+        std::memcpy(storage.data() + offset, data, size);
+        return { ZERO_SUCCESS, "" };
+    }
+
+    void SoftwareDevice::flushBuffer(const GPUBufferHandle&, const uint64_t&, const uint64_t&) {
+        // the rasterizer reads host memory directly
+    }
+
+    void SoftwareDevice::invalidateBuffer(const GPUBufferHandle&, const uint64_t&, const uint64_t&) {
+    }
+
+    ZEROResult SoftwareDevice::allocateTexture() {
+        return { ZERO_GRAPHICAL_ERROR, "Textures are not supported by the software rasterizer." };
+    }
+
+    GPUAllocationStatistics SoftwareDevice::getAllocationStatistics() const {
+        GPUAllocationStatistics statistics{};
+        {
+            std::lock_guard<InstrumentedMutex> lock(m_buffers->mutex);
+            statistics = m_allocation_statistics;
+        }
+        statistics.resource_lock = m_buffers->mutex.getStatistics();
+        return statistics;
+    }
+
+    std::weak_ptr<GraphicalContext> SoftwareDevice::allocateGraphicalContext() {
+        std::shared_ptr<GraphicalContext> graphical_context = std::make_shared<SoftwareGraphicalContext>(m_rasterizer, m_buffers);
+        m_graphical_contexts.push_back(graphical_context);
+        return graphical_context;
+    }
+
+    std::weak_ptr<SoftwareRasterizer> SoftwareDevice::getRasterizer() {
+        return m_rasterizer;
+    }
+
+    void SoftwareDevice::cleanup() {
+        for(std::shared_ptr<GraphicalContext> &graphical_context : m_graphical_contexts) {
+            graphical_context->cleanup();
+        }
+        m_graphical_contexts.clear();
+        std::lock_guard<InstrumentedMutex> lock(m_buffers->mutex);
+        m_buffers->buffers.clear();
+    }
+} // namespace ZEROengine
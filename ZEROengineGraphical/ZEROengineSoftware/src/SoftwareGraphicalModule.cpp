@@ -0,0 +1,52 @@
+#include "zeroengine_software/SoftwareGraphicalModule.hpp"
+#include "zeroengine_core/ZERODefines.hpp"
+
+namespace ZEROengine {
+    SoftwareGraphicalModule::SoftwareGraphicalModule(const uint32_t &width, const uint32_t &height, const uint32_t &thread_count) :
+    m_software_device{},
+    m_width{width},
+    m_height{height},
+    m_thread_count{thread_count},
+    m_frame_count{0},
+    m_frame_limit{0}
+    {}
+
+    void SoftwareGraphicalModule::initGraphicalModule() {
+        m_is_off = false;
+        m_software_device = std::make_shared<SoftwareDevice>(m_width, m_height, m_thread_count);
+    }
+
+    void SoftwareGraphicalModule::drawFrame() {
+        ZERO_ASSERT(m_software_device, "Software graphical module is not initialized.");
+        m_software_device->getRasterizer().lock()->flush();
+        ++m_frame_count;
+        if(m_frame_limit > 0 && m_frame_count >= m_frame_limit) {
+            m_is_off = true;
+        }
+    }
+
+    std::weak_ptr<SoftwareDevice> SoftwareGraphicalModule::getSoftwareDevice() {
+        return m_software_device;
+    }
+
+    void SoftwareGraphicalModule::setFrameLimit(const uint64_t &frame_limit) {
+        m_frame_limit = frame_limit;
+    }
+
+    uint64_t SoftwareGraphicalModule::getFrameCount() const {
+        return m_frame_count;
+    }
+
+    const SoftwareFramebuffer& SoftwareGraphicalModule::getFramebuffer() const {
+        ZERO_ASSERT(m_software_device, "Software graphical module is not initialized.");
+        return m_software_device->getRasterizer().lock()->getFramebuffer();
+    }
+
+    void SoftwareGraphicalModule::cleanup() {
+        if(m_software_device) {
+            m_software_device->cleanup();
+            m_software_device.reset();
+        }
+        m_is_off = true;
+    }
+} // namespace ZEROengine
@@ -0,0 +1,410 @@
+#include "zeroengine_software/SoftwareRasterizer.hpp"
+#include "zeroengine_core/ZERODefines.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ZERO_SW_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+namespace ZEROengine {
+    static int64_t floorDiv(const int64_t &a, const int64_t &b) {
+        int64_t q = a / b;
+        return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+    }
+
+    static int64_t ceilDiv(const int64_t &a, const int64_t &b) {
+        return -floorDiv(-a, b);
+    }
+
+    static SoftwareVertex lerpVertex(const SoftwareVertex &a, const SoftwareVertex &b, const float &t) {
+        SoftwareVertex ret{};
+        ret.x = a.x + (b.x - a.x) * t;
+        ret.y = a.y + (b.y - a.y) * t;
+        ret.r = a.r + (b.r - a.r) * t;
+        ret.g = a.g + (b.g - a.g) * t;
+        ret.b = a.b + (b.b - a.b) * t;
+        return ret;
+    }
+
+    static uint32_t packColor(const float &r, const float &g, const float &b) {
+        auto channel = [](const float &v) {
+            return static_cast<uint32_t>(std::min(std::max(v, 0.0f), 1.0f) * 255.0f + 0.5f);
+        };
+        return channel(r) | (channel(g) << 8) | (channel(b) << 16) | 0xFF000000u;
+    }
+
+    SoftwareRasterizer::SoftwareRasterizer(const uint32_t &width, const uint32_t &height, const uint32_t &thread_count) :
+    m_thread_pool{std::make_unique<ThreadPool>(thread_count)},
+    m_framebuffer{},
+    m_tiles_x{0},
+    m_tiles_y{0},
+    m_clear_color{0xFF000000u},
+    m_triangles{},
+    m_tile_bins{},
+    m_statistics{},
+    m_scalar_fallbacks{0},
+    m_simd{true}
+    {
+        resize(width, height);
+    }
+
+    void SoftwareRasterizer::resize(const uint32_t &width, const uint32_t &height) {
+        ZERO_ASSERT(width > 0 && height > 0, "Framebuffer extent must not be empty.");
+        m_framebuffer.width = width;
+        m_framebuffer.height = height;
+        m_framebuffer.stride = (width + 3u) & ~3u;
+        m_framebuffer.pixels.assign(static_cast<std::size_t>(m_framebuffer.stride) * height, m_clear_color);
+
+        m_tiles_x = (width + const_sw_tile_size - 1) / const_sw_tile_size;
+        m_tiles_y = (height + const_sw_tile_size - 1) / const_sw_tile_size;
+        m_tile_bins.assign(static_cast<std::size_t>(m_tiles_x) * m_tiles_y, {});
+        m_triangles.clear();
+    }
+
+    void SoftwareRasterizer::setClearColor(const uint32_t &color) {
+        m_clear_color = color;
+    }
+
+    void SoftwareRasterizer::setSIMD(const bool &enable) {
+        m_simd = enable;
+    }
+
+    bool SoftwareRasterizer::isSIMD() const {
+#if defined(ZERO_SW_SSE2)
+        return m_simd;
+#else
+        return false;
+#endif
+    }
+
+    void SoftwareRasterizer::submitTriangles(const SoftwareVertex *vertices, const uint32_t &vertex_count) {
+        for(uint32_t i = 0; i + 2 < vertex_count; i += 3) {
+            clipAndSetup(vertices[i], vertices[i + 1], vertices[i + 2]);
+        }
+    }
+
+    void SoftwareRasterizer::submitIndexedTriangles(const SoftwareVertex *vertices, const uint32_t &vertex_count, const uint32_t *indices, const uint32_t &index_count) {
+        for(uint32_t i = 0; i + 2 < index_count; i += 3) {
+            if(indices[i] >= vertex_count || indices[i + 1] >= vertex_count || indices[i + 2] >= vertex_count) {
+                ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Index out of the bound vertex range.");
+            }
+            clipAndSetup(vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]]);
+        }
+    }
+
+    void SoftwareRasterizer::clipAndSetup(const SoftwareVertex &v0, const SoftwareVertex &v1, const SoftwareVertex &v2) {
+        ++m_statistics.triangles_submitted;
+        auto inside_band = [](const SoftwareVertex &v) {
+            return std::fabs(v.x) <= const_sw_guard_band && std::fabs(v.y) <= const_sw_guard_band;
+        };
+        if(inside_band(v0) && inside_band(v1) && inside_band(v2)) {
+            setupTriangle(v0, v1, v2);
+            return;
+        }
+        ++m_statistics.triangles_clipped;
+
+        // Sutherland-Hodgman against the four guard band planes, a triangle yields at most 7 vertices
+        SoftwareVertex polygon[2][8];
+        uint32_t count = 3;
+        polygon[0][0] = v0;
+        polygon[0][1] = v1;
+        polygon[0][2] = v2;
+        uint32_t src = 0;
+        for(uint32_t plane = 0; plane < 4 && count > 0; ++plane) {
+            auto distance = [&plane](const SoftwareVertex &v) {
+                switch(plane) {
+                case 0: return v.x + const_sw_guard_band;
+                case 1: return const_sw_guard_band - v.x;
+                case 2: return v.y + const_sw_guard_band;
+                default: return const_sw_guard_band - v.y;
+                }
+            };
+            uint32_t dst = src ^ 1u;
+            uint32_t out_count = 0;
+            for(uint32_t i = 0; i < count; ++i) {
+                const SoftwareVertex &current = polygon[src][i];
+                const SoftwareVertex &next = polygon[src][(i + 1) % count];
+                float d_current = distance(current);
+                float d_next = distance(next);
+                if(d_current >= 0.0f) {
+                    polygon[dst][out_count++] = current;
+                }
+                if((d_current >= 0.0f) != (d_next >= 0.0f)) {
+                    polygon[dst][out_count++] = lerpVertex(current, next, d_current / (d_current - d_next));
+                }
+            }
+            count = out_count;
+            src = dst;
+        }
+        if(count < 3) {
+            ++m_statistics.triangles_culled;
+            return;
+        }
+        for(uint32_t i = 1; i + 1 < count; ++i) {
+            setupTriangle(polygon[src][0], polygon[src][i], polygon[src][i + 1]);
+        }
+    }
+
+    void SoftwareRasterizer::setupTriangle(const SoftwareVertex &v0, const SoftwareVertex &v1, const SoftwareVertex &v2) {
+        const SoftwareVertex *v[3] = { &v0, &v1, &v2 };
+
+        // snap to the subpixel grid
+        const float half_width = static_cast<float>(m_framebuffer.width) * 0.5f;
+        const float half_height = static_cast<float>(m_framebuffer.height) * 0.5f;
+        int64_t x[3], y[3];
+        for(uint32_t i = 0; i < 3; ++i) {
+            x[i] = static_cast<int64_t>(std::lround((v[i]->x * half_width + half_width) * static_cast<float>(const_sw_subpixel_scale)));
+            y[i] = static_cast<int64_t>(std::lround((v[i]->y * half_height + half_height) * static_cast<float>(const_sw_subpixel_scale)));
+        }
+
+        int64_t area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+        if(area == 0) {
+            ++m_statistics.triangles_culled;
+            return;
+        }
+        if(area < 0) {
+            // no culling, flip the winding so the inside is positive
+            std::swap(x[1], x[2]);
+            std::swap(y[1], y[2]);
+            std::swap(v[1], v[2]);
+            area = -area;
+        }
+
+        const int64_t half_sample = const_sw_subpixel_scale / 2;
+        int64_t min_x = std::max<int64_t>(ceilDiv(std::min({x[0], x[1], x[2]}) - half_sample, const_sw_subpixel_scale), 0);
+        int64_t min_y = std::max<int64_t>(ceilDiv(std::min({y[0], y[1], y[2]}) - half_sample, const_sw_subpixel_scale), 0);
+        int64_t max_x = std::min<int64_t>(floorDiv(std::max({x[0], x[1], x[2]}) - half_sample, const_sw_subpixel_scale), m_framebuffer.width - 1);
+        int64_t max_y = std::min<int64_t>(floorDiv(std::max({y[0], y[1], y[2]}) - half_sample, const_sw_subpixel_scale), m_framebuffer.height - 1);
+        if(min_x > max_x || min_y > max_y) {
+            ++m_statistics.triangles_culled;
+            return;
+        }
+
+        SoftwareTriangle triangle{};
+        for(uint32_t i = 0; i < 3; ++i) {
+            // edge opposite to vertex i runs from vertex i+1 to vertex i+2
+            uint32_t from = (i + 1) % 3;
+            uint32_t to = (i + 2) % 3;
+            triangle.edge_a[i] = y[from] - y[to];
+            triangle.edge_b[i] = x[to] - x[from];
+            triangle.edge_c[i] = (y[to] - y[from]) * x[from] - (x[to] - x[from]) * y[from];
+
+            // top-left rule, samples exactly on other edges are outside
+            bool top_left = triangle.edge_a[i] > 0 || (triangle.edge_a[i] == 0 && triangle.edge_b[i] > 0);
+            if(!top_left) {
+                triangle.edge_c[i] -= 1;
+            }
+
+            triangle.color[i][0] = v[i]->r;
+            triangle.color[i][1] = v[i]->g;
+            triangle.color[i][2] = v[i]->b;
+        }
+        triangle.min_x = static_cast<int32_t>(min_x);
+        triangle.min_y = static_cast<int32_t>(min_y);
+        triangle.max_x = static_cast<int32_t>(max_x);
+        triangle.max_y = static_cast<int32_t>(max_y);
+        triangle.inv_area = 1.0f / static_cast<float>(area);
+
+        uint32_t triangle_index = static_cast<uint32_t>(m_triangles.size());
+        m_triangles.push_back(triangle);
+
+        uint32_t tile_x0 = triangle.min_x / const_sw_tile_size, tile_x1 = triangle.max_x / const_sw_tile_size;
+        uint32_t tile_y0 = triangle.min_y / const_sw_tile_size, tile_y1 = triangle.max_y / const_sw_tile_size;
+        for(uint32_t ty = tile_y0; ty <= tile_y1; ++ty) {
+            for(uint32_t tx = tile_x0; tx <= tile_x1; ++tx) {
+                m_tile_bins[ty * m_tiles_x + tx].push_back(triangle_index);
+            }
+        }
+        m_statistics.tile_bin_entries += static_cast<uint64_t>(tile_x1 - tile_x0 + 1) * (tile_y1 - tile_y0 + 1);
+    }
+
+    void SoftwareRasterizer::flush() {
+        m_thread_pool->parallelFor(static_cast<uint32_t>(m_tile_bins.size()), [this](uint32_t tile_index, uint32_t) {
+            rasterizeTile(tile_index);
+        });
+        m_statistics.tiles_rasterized += m_tile_bins.size();
+        m_statistics.scalar_fallbacks += m_scalar_fallbacks.exchange(0, std::memory_order_relaxed);
+
+        for(std::vector<uint32_t> &bin : m_tile_bins) {
+            bin.clear();
+        }
+        m_triangles.clear();
+    }
+
+    void SoftwareRasterizer::rasterizeTile(const uint32_t &tile_index) {
+        const int32_t tile_x0 = static_cast<int32_t>((tile_index % m_tiles_x) * const_sw_tile_size);
+        const int32_t tile_y0 = static_cast<int32_t>((tile_index / m_tiles_x) * const_sw_tile_size);
+        const int32_t tile_x1 = std::min<int32_t>(tile_x0 + const_sw_tile_size, m_framebuffer.width) - 1;
+        const int32_t tile_y1 = std::min<int32_t>(tile_y0 + const_sw_tile_size, m_framebuffer.height) - 1;
+
+        for(int32_t y = tile_y0; y <= tile_y1; ++y) {
+            uint32_t *row = m_framebuffer.pixels.data() + static_cast<std::size_t>(y) * m_framebuffer.stride;
+            std::fill(row + tile_x0, row + tile_x1 + 1, m_clear_color);
+        }
+
+        for(const uint32_t &triangle_index : m_tile_bins[tile_index]) {
+            const SoftwareTriangle &triangle = m_triangles[triangle_index];
+            int32_t x0 = std::max(triangle.min_x, tile_x0);
+            int32_t y0 = std::max(triangle.min_y, tile_y0);
+            int32_t x1 = std::min(triangle.max_x, tile_x1);
+            int32_t y1 = std::min(triangle.max_y, tile_y1);
+            if(x0 > x1 || y0 > y1) {
+                continue;
+            }
+            rasterizeRegion(triangle, x0, y0, x1, y1);
+        }
+    }
+
+    void SoftwareRasterizer::rasterizeRegion(const SoftwareTriangle &triangle, const int32_t &x0, const int32_t &y0, const int32_t &x1, const int32_t &y1) {
+#if defined(ZERO_SW_SSE2)
+        if(!m_simd) {
+            rasterizeRegionScalar(triangle, x0, y0, x1, y1);
+            return;
+        }
+        // 4-wide rows starting on an aligned column, tiles and rows are padded to multiples of 4 so lanes never leave the tile
+        const int32_t x_start = x0 & ~3;
+        const int64_t sample_x = static_cast<int64_t>(x_start) * const_sw_subpixel_scale + const_sw_subpixel_scale / 2;
+        const int64_t sample_y = static_cast<int64_t>(y0) * const_sw_subpixel_scale + const_sw_subpixel_scale / 2;
+
+        int64_t row_edge[3];
+        int64_t step_x[3];
+        int64_t step_y[3];
+        for(uint32_t i = 0; i < 3; ++i) {
+            row_edge[i] = triangle.edge_a[i] * sample_x + triangle.edge_b[i] * sample_y + triangle.edge_c[i];
+            step_x[i] = triangle.edge_a[i] * const_sw_subpixel_scale;
+            step_y[i] = triangle.edge_b[i] * const_sw_subpixel_scale;
+
+            // the incremental 32 bit evaluation must not overflow anywhere in the region
+            int64_t reach = std::abs(row_edge[i])
+                + std::abs(step_x[i]) * (x1 - x_start + 4)
+                + std::abs(step_y[i]) * (y1 - y0 + 1);
+            if(reach > std::numeric_limits<int32_t>::max()) {
+                m_scalar_fallbacks.fetch_add(1, std::memory_order_relaxed);
+                rasterizeRegionScalar(triangle, x0, y0, x1, y1);
+                return;
+            }
+        }
+
+        __m128i lane_offset[3], step_x4[3];
+        int32_t row_edge32[3];
+        for(uint32_t i = 0; i < 3; ++i) {
+            const int32_t sx = static_cast<int32_t>(step_x[i]);
+            lane_offset[i] = _mm_setr_epi32(0, sx, 2 * sx, 3 * sx);
+            step_x4[i] = _mm_set1_epi32(4 * sx);
+            row_edge32[i] = static_cast<int32_t>(row_edge[i]);
+        }
+        const __m128 inv_area = _mm_set1_ps(triangle.inv_area);
+        __m128 color[3][3];
+        for(uint32_t v = 0; v < 3; ++v) {
+            for(uint32_t c = 0; c < 3; ++c) {
+                color[v][c] = _mm_set1_ps(triangle.color[v][c]);
+            }
+        }
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 scale = _mm_set1_ps(255.0f);
+        const __m128 rounding = _mm_set1_ps(0.5f);
+        const __m128i alpha = _mm_set1_epi32(static_cast<int32_t>(0xFF000000u));
+        const __m128i minus_one = _mm_set1_epi32(-1);
+        const __m128i lane_index = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128i region_begin = _mm_set1_epi32(x0 - 1);
+        const __m128i region_end = _mm_set1_epi32(x1 + 1);
+
+        for(int32_t y = y0; y <= y1; ++y) {
+            uint32_t *row = m_framebuffer.pixels.data() + static_cast<std::size_t>(y) * m_framebuffer.stride;
+            __m128i e0 = _mm_add_epi32(_mm_set1_epi32(row_edge32[0]), lane_offset[0]);
+            __m128i e1 = _mm_add_epi32(_mm_set1_epi32(row_edge32[1]), lane_offset[1]);
+            __m128i e2 = _mm_add_epi32(_mm_set1_epi32(row_edge32[2]), lane_offset[2]);
+
+            for(int32_t x = x_start; x <= x1; x += 4) {
+                __m128i inside = _mm_cmpgt_epi32(_mm_or_si128(e0, _mm_or_si128(e1, e2)), minus_one);
+                __m128i xs = _mm_add_epi32(_mm_set1_epi32(x), lane_index);
+                __m128i in_region = _mm_and_si128(_mm_cmpgt_epi32(xs, region_begin), _mm_cmplt_epi32(xs, region_end));
+                __m128i mask = _mm_and_si128(inside, in_region);
+
+                if(_mm_movemask_epi8(mask) != 0) {
+                    __m128 w0 = _mm_mul_ps(_mm_cvtepi32_ps(e0), inv_area);
+                    __m128 w1 = _mm_mul_ps(_mm_cvtepi32_ps(e1), inv_area);
+                    __m128 w2 = _mm_mul_ps(_mm_cvtepi32_ps(e2), inv_area);
+
+                    __m128i packed = alpha;
+                    for(uint32_t c = 0; c < 3; ++c) {
+                        __m128 value = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, color[0][c]), _mm_mul_ps(w1, color[1][c])), _mm_mul_ps(w2, color[2][c]));
+                        value = _mm_min_ps(_mm_max_ps(value, zero), one);
+                        __m128i channel = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, scale), rounding));
+                        switch(c) {
+                        case 0: packed = _mm_or_si128(packed, channel); break;
+                        case 1: packed = _mm_or_si128(packed, _mm_slli_epi32(channel, 8)); break;
+                        default: packed = _mm_or_si128(packed, _mm_slli_epi32(channel, 16)); break;
+                        }
+                    }
+
+                    __m128i *dst = reinterpret_cast<__m128i*>(row + x);
+                    __m128i previous = _mm_loadu_si128(dst);
+                    _mm_storeu_si128(dst, _mm_or_si128(_mm_and_si128(mask, packed), _mm_andnot_si128(mask, previous)));
+                }
+                e0 = _mm_add_epi32(e0, step_x4[0]);
+                e1 = _mm_add_epi32(e1, step_x4[1]);
+                e2 = _mm_add_epi32(e2, step_x4[2]);
+            }
+            for(uint32_t i = 0; i < 3; ++i) {
+                row_edge32[i] += static_cast<int32_t>(step_y[i]);
+            }
+        }
+#else
+        rasterizeRegionScalar(triangle, x0, y0, x1, y1);
+#endif
+    }
+
+    void SoftwareRasterizer::rasterizeRegionScalar(const SoftwareTriangle &triangle, const int32_t &x0, const int32_t &y0, const int32_t &x1, const int32_t &y1) {
+        const int64_t sample_x = static_cast<int64_t>(x0) * const_sw_subpixel_scale + const_sw_subpixel_scale / 2;
+        const int64_t sample_y = static_cast<int64_t>(y0) * const_sw_subpixel_scale + const_sw_subpixel_scale / 2;
+
+        int64_t row_edge[3];
+        for(uint32_t i = 0; i < 3; ++i) {
+            row_edge[i] = triangle.edge_a[i] * sample_x + triangle.edge_b[i] * sample_y + triangle.edge_c[i];
+        }
+        for(int32_t y = y0; y <= y1; ++y) {
+            uint32_t *row = m_framebuffer.pixels.data() + static_cast<std::size_t>(y) * m_framebuffer.stride;
+            int64_t e[3] = { row_edge[0], row_edge[1], row_edge[2] };
+            for(int32_t x = x0; x <= x1; ++x) {
+                if((e[0] | e[1] | e[2]) >= 0) {
+                    float w[3];
+                    for(uint32_t i = 0; i < 3; ++i) {
+                        w[i] = static_cast<float>(e[i]) * triangle.inv_area;
+                    }
+                    row[x] = packColor(
+                        w[0] * triangle.color[0][0] + w[1] * triangle.color[1][0] + w[2] * triangle.color[2][0],
+                        w[0] * triangle.color[0][1] + w[1] * triangle.color[1][1] + w[2] * triangle.color[2][1],
+                        w[0] * triangle.color[0][2] + w[1] * triangle.color[1][2] + w[2] * triangle.color[2][2]);
+                }
+                for(uint32_t i = 0; i < 3; ++i) {
+                    e[i] += triangle.edge_a[i] * const_sw_subpixel_scale;
+                }
+            }
+            for(uint32_t i = 0; i < 3; ++i) {
+                row_edge[i] += triangle.edge_b[i] * const_sw_subpixel_scale;
+            }
+        }
+    }
+
+    const SoftwareFramebuffer& SoftwareRasterizer::getFramebuffer() const {
+        return m_framebuffer;
+    }
+
+    uint32_t SoftwareRasterizer::getThreadCount() const {
+        return m_thread_pool->getThreadCount();
+    }
+
+    const SoftwareRasterizerStatistics& SoftwareRasterizer::getStatistics() const {
+        return m_statistics;
+    }
+
+    void SoftwareRasterizer::resetStatistics() {
+        m_statistics = SoftwareRasterizerStatistics{};
+    }
+} // namespace ZEROengine
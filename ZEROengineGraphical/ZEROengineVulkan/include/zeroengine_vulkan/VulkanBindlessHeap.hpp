@@ -0,0 +1,138 @@
+#ifndef ZEROENGINE_VULKANBINDLESSHEAP_H
+#define ZEROENGINE_VULKANBINDLESSHEAP_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "vulkan/vulkan.hpp"
+
+#include "zeroengine_graphical/GPUSlotAllocator.hpp"
+
+namespace ZEROengine {
+    class VulkanDevice;
+
+    /**
+     * @brief Descriptor arrays of the bindless set, the binding of each array is its enum value.
+     *
+     */
+    enum VulkanBindlessType : uint32_t {
+        ZERO_VK_BINDLESS_SAMPLED_IMAGE = 0,
+        ZERO_VK_BINDLESS_SAMPLER = 1,
+        ZERO_VK_BINDLESS_STORAGE_BUFFER = 2,
+        ZERO_VK_BINDLESS_TYPE_COUNT
+    };
+
+    /**
+     * @brief Size of the push constant range of the bindless pipeline layout, the minimum every device supports.
+     *
+     */
+    constexpr uint32_t const_vk_bindless_push_constant_size = 128;
+
+    struct VulkanBindlessStatistics {
+        uint32_t allocated[ZERO_VK_BINDLESS_TYPE_COUNT] = {};
+        uint32_t pending_writes = 0;
+        uint64_t descriptor_writes = 0;
+        uint64_t update_calls = 0;
+    };
+
+    /**
+     * @brief One update-after-bind descriptor set holding every sampled image, sampler and storage buffer of the device.
+     * Resources are registered once and referred to by their 32 bit index, which shaders receive through push constants
+     * and use to index the arrays declared in shaders/bindless.glsl. The set is bound once per command buffer with
+     * getPipelineLayout(), so draws no longer allocate, write or bind descriptor sets.
+     * Registrations are batched into a single vkUpdateDescriptorSets by flush(). Released indices are only reused once
+     * the submissions that may still read them have completed.
+     *
+     */
+    class VulkanBindlessHeap {
+    private:
+        struct PendingWrite {
+            VulkanBindlessType type;
+            uint32_t index;
+            VkDescriptorImageInfo image_info;
+            VkDescriptorBufferInfo buffer_info;
+        };
+
+        VulkanDevice* m_device;
+
+        VkDescriptorSetLayout m_descriptor_set_layout;
+        VkDescriptorPool m_descriptor_pool;
+        VkDescriptorSet m_descriptor_set;
+        VkPipelineLayout m_pipeline_layout;
+
+        std::vector<GPUSlotAllocator> m_slots;
+        std::vector<PendingWrite> m_pending_writes;
+
+        // scratch storage of flush()
+        std::vector<VkDescriptorImageInfo> m_image_infos;
+        std::vector<VkDescriptorBufferInfo> m_buffer_infos;
+        std::vector<VkWriteDescriptorSet> m_writes;
+
+        VulkanBindlessStatistics m_statistics;
+
+    private:
+        void createDescriptorSet();
+        uint32_t allocateIndex(const VulkanBindlessType &type);
+        void queueWrite(const PendingWrite &write);
+
+    public:
+        /**
+         * @brief Create the bindless set and its pipeline layout.
+         *
+         * @param device The device, it must have been created with the descriptor indexing features.
+         * @param max_sampled_images Capacity of the sampled image array.
+         * @param max_samplers Capacity of the sampler array.
+         * @param max_storage_buffers Capacity of the storage buffer array.
+         */
+        VulkanBindlessHeap(VulkanDevice* device, const uint32_t &max_sampled_images, const uint32_t &max_samplers, const uint32_t &max_storage_buffers);
+        ~VulkanBindlessHeap();
+
+        VulkanBindlessHeap(const VulkanBindlessHeap&) = delete;
+        VulkanBindlessHeap& operator=(const VulkanBindlessHeap&) = delete;
+
+        uint32_t registerSampledImage(const VkImageView &image_view, const VkImageLayout &image_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        uint32_t registerSampler(const VkSampler &sampler);
+        uint32_t registerStorageBuffer(const VkBuffer &buffer, const VkDeviceSize &offset = 0, const VkDeviceSize &range = VK_WHOLE_SIZE);
+
+        /**
+         * @brief Release an index. It keeps its descriptor until every submission made so far has completed.
+         *
+         */
+        void release(const VulkanBindlessType &type, const uint32_t &index);
+
+        /**
+         * @brief Write every registration made since the last flush in one vkUpdateDescriptorSets call and recycle
+         * the indices the GPU is done with. Should be called once per frame before recording.
+         *
+         */
+        void flush();
+
+        /**
+         * @brief Bind the bindless set as set 0.
+         *
+         */
+        void bind(VkCommandBuffer command_buffer, const VkPipelineBindPoint &bind_point);
+
+        /**
+         * @brief Push resource indices, or any other data up to const_vk_bindless_push_constant_size bytes, to every stage.
+         *
+         */
+        void pushConstants(VkCommandBuffer command_buffer, const void* data, const uint32_t &size, const uint32_t &offset = 0);
+
+        VkDescriptorSetLayout getDescriptorSetLayout() const;
+        VkDescriptorSet getDescriptorSet() const;
+
+        /**
+         * @brief Pipeline layout with the bindless set as set 0 and the push constant range, shared by bindless pipelines.
+         *
+         */
+        VkPipelineLayout getPipelineLayout() const;
+        uint32_t getCapacity(const VulkanBindlessType &type) const;
+        const VulkanBindlessStatistics& getStatistics() const;
+
+        void cleanup();
+    }; // class VulkanBindlessHeap
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_VULKANBINDLESSHEAP_H
@@ -5,18 +5,36 @@
 #include "vulkan/vulkan.hpp"
 
 namespace ZEROengine {
-    class VulkanCommandBuffer : GraphicalCommandBuffer {
+    class VulkanDevice;
+
+    /**
+     * @brief Wraps a VkCommandBuffer owned by a VulkanGraphicalContext pool.
+     * Commands are recorded backend-agnostically into a GPUCommandStream and translated here in one pass by execute().
+     * 
+     */
+    class VulkanCommandBuffer : public GraphicalCommandBuffer {
     private:
         VkCommandBuffer m_api_handle;
         VkCommandBufferLevel m_level;
+
+        // resolves buffer and pipeline handles, the device owns the context owning this command buffer
+        VulkanDevice* m_vulkan_device;
+
     public:
+        VulkanCommandBuffer(const VkCommandBuffer &api_handle, const VkCommandBufferLevel &level, VulkanDevice* vulkan_device);
+
         void init() override final;
         void cleanup() override final;
 
         void bindVertex() override final;
         void bindPipeline() override final;
         void draw() override final;
+
+        void execute(const GPUCommandStream &stream) override final;
+
+        VkCommandBuffer getVkCommandBuffer() const;
+        VkCommandBufferLevel getLevel() const;
     }; // class VulkanCommandBuffer
 } // namespace ZEROengine
 
-#endif // #ifndef ZEROENGINE_VULKANCOMMANDBUFFER_H
\ No newline at end of file
+#endif // #ifndef ZEROENGINE_VULKANCOMMANDBUFFER_H
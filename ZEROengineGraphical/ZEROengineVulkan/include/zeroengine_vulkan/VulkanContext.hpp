@@ -2,23 +2,42 @@
 #define ZEROENGINE_VULKANCONTEXT_H
 
 #include <memory>
+#include <vector>
 #include <cstdint>
 
 #include "zeroengine_graphical/GPUContext.hpp"
 #include "zeroengine_graphical/GPUCommandBuffer.hpp"
+#include "zeroengine_vulkan/VulkanCommandBuffer.hpp"
 #include "vulkan/vulkan.hpp"
 
 namespace ZEROengine {
+    class VulkanDevice;
+
+    /**
+     * @brief A command pool with its primary command buffers. Recording resets the pool and begins every command buffer,
+     * so the context should be used by one frame in flight at a time. beginRecording() blocks until the last submission
+     * of the context, made through submit() or reported to markSubmitted(), has completed.
+     * 
+     */
     class VulkanGraphicalContext : public GraphicalContext {
     private:
         VkCommandBuffer m_primary_command_buffer;
         VkCommandPool m_primary_command_pool;
         VkDevice m_vk_device;
+        VulkanDevice* m_vulkan_device;
 
         const uint32_t m_queue_family;
 
+        std::vector<std::shared_ptr<VulkanCommandBuffer>> m_vulkan_command_buffers;
+        bool m_is_recording;
+        uint64_t m_submission_value; // submission timeline value of the last submission, 0 before the first one
+
+    private:
+        VkCommandBuffer allocateVkCommandBuffer();
+        void waitForSubmission();
+
     public:
-        VulkanGraphicalContext(const VkDevice& vk_device, const uint32_t &queue_family);
+        VulkanGraphicalContext(VulkanDevice* vulkan_device, const uint32_t &queue_family);
         void init() override final;
         void cleanup() override final;
 
@@ -28,6 +47,23 @@ namespace ZEROengine {
         
         void beginRecording() override final;
         void endRecording() override final;
+
+        /**
+         * @brief Submit every command buffer of the context to the graphics queue, in allocation order.
+         *
+         * @return uint64_t The submission timeline value signaled once they completed.
+         */
+        uint64_t submit();
+
+        /**
+         * @brief Report a submission of the command buffers made outside of submit(), for instance with swapchain semaphores.
+         *
+         * @param submission_value Submission timeline value signaled once they completed.
+         */
+        void markSubmitted(const uint64_t &submission_value);
+
+        VkCommandBuffer getPrimaryCommandBuffer() const;
+        uint32_t getQueueFamily() const;
     
     // prohibited methods
     private:
@@ -48,4 +84,4 @@ namespace ZEROengine {
     // }; // class VulkanGraphicalContext
 } // namespace ZEROengine
 
-#endif // #ifndef ZEROENGINE_VULKANCONTEXT_H
\ No newline at end of file
+#endif // #ifndef ZEROENGINE_VULKANCONTEXT_H
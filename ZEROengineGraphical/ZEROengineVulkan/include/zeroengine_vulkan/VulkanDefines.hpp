@@ -30,7 +30,11 @@ namespace ZEROengine {
     class VulkanVertexInputBinding {
     public:
         virtual VkVertexInputBindingDescription bindingDescription(const uint32_t &binding_index) = 0;
-        virtual std::vector<VkVertexInputAttributeDescription> attributesDescription(const uint32_t &binding_index) = 0;
+        /**
+         * @brief Append the attributes of the binding, so that pipeline creation can reuse one vector across bindings.
+         *
+         */
+        virtual void attributesDescription(const uint32_t &binding_index, std::vector<VkVertexInputAttributeDescription> &attributes) = 0;
     }; // class VulkanVertexInputBinding
 
     class VulkanBaseVertexInputBinding : public VulkanVertexInputBinding {
@@ -43,21 +47,47 @@ namespace ZEROengine {
             return info;
         }
         
-        virtual std::vector<VkVertexInputAttributeDescription> attributesDescription(const uint32_t &binding_index) override {
-            std::vector<VkVertexInputAttributeDescription> attributes_desc(2);
-            attributes_desc[0].binding = binding_index;
-            attributes_desc[0].format = VK_FORMAT_R32G32_SFLOAT;
-            attributes_desc[0].location = 0;
-            attributes_desc[0].offset = 0;
+        virtual void attributesDescription(const uint32_t &binding_index, std::vector<VkVertexInputAttributeDescription> &attributes) override {
+            VkVertexInputAttributeDescription attribute_desc {};
+            attribute_desc.binding = binding_index;
+            attribute_desc.format = VK_FORMAT_R32G32_SFLOAT;
+            attribute_desc.location = 0;
+            attribute_desc.offset = 0;
+            attributes.push_back(attribute_desc);
             //
-            attributes_desc[1].binding = binding_index;
-            attributes_desc[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-            attributes_desc[1].location = 1;
-            attributes_desc[1].offset = offsetof(BaseVertex, v_color);
-            return attributes_desc;
+            attribute_desc.format = VK_FORMAT_R32G32B32_SFLOAT;
+            attribute_desc.location = 1;
+            attribute_desc.offset = offsetof(BaseVertex, v_color);
+            attributes.push_back(attribute_desc);
         }
     }; // class VulkanBaseVertexInputBinding
 
+    /**
+     * @brief Per instance model matrix streamed by GPUDrawList batching, read as four vec4 columns at locations 2 to 5.
+     * 
+     */
+    class VulkanInstanceTransformInputBinding : public VulkanVertexInputBinding {
+    public:
+        virtual VkVertexInputBindingDescription bindingDescription(const uint32_t &binding_index) override {
+            VkVertexInputBindingDescription info {};
+            info.binding = binding_index;
+            info.stride = 16 * sizeof(float);
+            info.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+            return info;
+        }
+
+        virtual void attributesDescription(const uint32_t &binding_index, std::vector<VkVertexInputAttributeDescription> &attributes) override {
+            for(uint32_t column = 0; column < 4; ++column) {
+                VkVertexInputAttributeDescription attribute_desc {};
+                attribute_desc.binding = binding_index;
+                attribute_desc.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+                attribute_desc.location = 2 + column;
+                attribute_desc.offset = column * 4 * sizeof(float);
+                attributes.push_back(attribute_desc);
+            }
+        }
+    }; // class VulkanInstanceTransformInputBinding
+
     struct BaseUniformObject {
         glm::mat4 model;
         glm::mat4 view;
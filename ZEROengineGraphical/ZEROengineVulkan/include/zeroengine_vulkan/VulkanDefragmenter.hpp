@@ -0,0 +1,123 @@
+#ifndef ZEROENGINE_VULKANDEFRAGMENTER_H
+#define ZEROENGINE_VULKANDEFRAGMENTER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include "vulkan/vulkan.hpp"
+#include "vk_mem_alloc.h"
+
+namespace ZEROengine {
+    class VulkanDevice;
+    class VulkanBuffer;
+
+    // work allowed per frame, a single pass is in flight at a time
+    constexpr VkDeviceSize const_vk_defragmentation_bytes_per_pass = 16ull * 1024ull * 1024ull;
+    constexpr uint32_t const_vk_defragmentation_moves_per_pass = 64;
+
+    // automatic start: share of the allocated blocks left unused, and the minimum amount of blocks worth compacting
+    constexpr float const_vk_defragmentation_threshold = 0.25f;
+    constexpr VkDeviceSize const_vk_defragmentation_min_block_bytes = 64ull * 1024ull * 1024ull;
+
+    struct VulkanDefragmentationStatistics {
+        uint64_t runs = 0;
+        uint64_t passes = 0;
+        uint64_t moves = 0;
+        uint64_t ignored_moves = 0; // including the moves dropped because the buffer was written during the copy
+        uint64_t bytes_moved = 0;
+        uint64_t bytes_freed = 0;
+        uint64_t blocks_freed = 0;
+        double cpu_milliseconds = 0.0; // spent in update()
+    };
+
+    /**
+     * @brief Called once a buffer has been moved, so that descriptors written with the old VkBuffer can be rewritten.
+     * Handles and resolveBuffer() follow the move on their own.
+     *
+     */
+    typedef std::function<void(const VulkanBuffer &buffer, const VkBuffer &old_buffer)> VulkanDefragmentationRebind;
+
+    /**
+     * @brief Incremental defragmentation of the VMA default pools, spread over frames. Each frame runs at most one bounded
+     * pass: the moved buffers are copied to their new place by a submission on the device timeline, the buffers are rebound
+     * once the copy completed, and the old memory is released once the frames still using the old buffers completed.
+     * Only buffers allocated by VulkanDevice in memory the host cannot see are moved, other allocations are skipped.
+     * A buffer written by VulkanDevice::writeBuffer() after its copy was recorded stays where it is.
+     *
+     */
+    class VulkanDefragmenter {
+    private:
+        enum State {
+            IDLE,
+            COPYING, // waiting for the copy submission
+            RELEASING // rebound, waiting for the frames using the old buffers
+        };
+
+        struct Move {
+            std::shared_ptr<VulkanBuffer> buffer;
+            VkBuffer new_buffer;
+            uint32_t pass_move; // index in the VMA pass moves
+            uint64_t write_generation; // when the copy was recorded, a staged write after it drops the move
+        };
+
+        VulkanDevice* m_device;
+        VkCommandPool m_command_pool;
+        VkCommandBuffer m_command_buffer;
+
+        VmaDefragmentationContext m_context;
+        VmaDefragmentationPassMoveInfo m_pass;
+        State m_state;
+        uint64_t m_wait_value;
+        bool m_requested;
+
+        std::vector<Move> m_moves;
+        std::vector<VkBuffer> m_old_buffers;
+        VulkanDefragmentationRebind m_rebind;
+
+        VulkanDefragmentationStatistics m_statistics;
+
+    private:
+        bool shouldStart() const;
+        void start();
+        void finish();
+        void beginPass();
+        void endPass();
+        std::shared_ptr<VulkanBuffer> findMovableBuffer(const VmaAllocation &allocation) const;
+
+    public:
+        VulkanDefragmenter(VulkanDevice* device);
+        ~VulkanDefragmenter();
+
+        VulkanDefragmenter(const VulkanDefragmenter&) = delete;
+        VulkanDefragmenter& operator=(const VulkanDefragmenter&) = delete;
+
+        /**
+         * @brief Start a defragmentation run on the next update(), even if the heaps are below the fragmentation threshold.
+         *
+         */
+        void request();
+
+        /**
+         * @brief Advance the current run by at most one pass. Should be called once per frame, on the thread submitting to the graphics queue.
+         *
+         */
+        void update();
+
+        /**
+         * @brief Wait for the pass in flight and end the current run.
+         *
+         */
+        void stop();
+
+        bool isActive() const;
+        void setRebindCallback(const VulkanDefragmentationRebind &rebind);
+        const VulkanDefragmentationStatistics& getStatistics() const;
+
+        void cleanup();
+    }; // class VulkanDefragmenter
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_VULKANDEFRAGMENTER_H
@@ -0,0 +1,125 @@
+#ifndef ZEROENGINE_VULKANDELETIONQUEUE_H
+#define ZEROENGINE_VULKANDELETIONQUEUE_H
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+#include "vulkan/vulkan.hpp"
+#include "vk_mem_alloc.h"
+
+#include "zeroengine_vulkan/VulkanSyncPrimitives.hpp"
+
+namespace ZEROengine {
+    /**
+     * @brief Passing this as the last use value tags the retired object with the most recent submission value of the timeline.
+     *
+     */
+    constexpr uint64_t const_vk_retire_on_last_submission = std::numeric_limits<uint64_t>::max();
+
+    enum VulkanRetiredObjectType {
+        ZERO_VK_RETIRED_BUFFER,
+        ZERO_VK_RETIRED_IMAGE,
+        ZERO_VK_RETIRED_IMAGE_VIEW,
+        ZERO_VK_RETIRED_PIPELINE,
+        ZERO_VK_RETIRED_PIPELINE_LAYOUT,
+        ZERO_VK_RETIRED_FRAMEBUFFER,
+        ZERO_VK_RETIRED_RENDER_PASS,
+        ZERO_VK_RETIRED_DESCRIPTOR_POOL,
+        ZERO_VK_RETIRED_DESCRIPTOR_SET_LAYOUT,
+        ZERO_VK_RETIRED_SWAPCHAIN,
+        ZERO_VK_RETIRED_ALLOCATION
+    };
+
+    struct VulkanRetiredObject {
+        VulkanRetiredObjectType type;
+        union {
+            VkBuffer buffer;
+            VkImage image;
+            VkImageView image_view;
+            VkPipeline pipeline;
+            VkPipelineLayout pipeline_layout;
+            VkFramebuffer framebuffer;
+            VkRenderPass render_pass;
+            VkDescriptorPool descriptor_pool;
+            VkDescriptorSetLayout descriptor_set_layout;
+            VkSwapchainKHR swapchain;
+        } handle;
+        VmaAllocation allocation;
+        uint64_t retire_value;
+    };
+
+    /**
+     * @brief VulkanDeletionQueue defers the destruction of Vulkan objects until the GPU has passed the submission they were last used in.
+     * Each retired object is tagged with a value on the device submission timeline, and is freed by collect() once the timeline has reached it.
+     * Objects may be retired from any thread, for instance by loaders releasing resources.
+     *
+     */
+    class VulkanDeletionQueue {
+    private:
+        VkDevice m_vk_device;
+        VmaAllocator m_vma_alloc;
+        std::shared_ptr<VulkanTimelineSemaphore> m_submission_timeline;
+
+        mutable std::mutex m_mutex;
+        std::vector<VulkanRetiredObject> m_retired;
+        bool m_hold_allocations;
+
+    private:
+        void retire(VulkanRetiredObject object, const uint64_t &last_use_value);
+        void destroy(const VulkanRetiredObject &object);
+
+    public:
+        VulkanDeletionQueue(const VkDevice &vk_device, const VmaAllocator &vma_alloc, const std::shared_ptr<VulkanTimelineSemaphore> &submission_timeline);
+
+        void retireBuffer(const VkBuffer &buffer, const VmaAllocation &allocation, const uint64_t &last_use_value = const_vk_retire_on_last_submission);
+        void retireImage(const VkImage &image, const VmaAllocation &allocation, const uint64_t &last_use_value = const_vk_retire_on_last_submission);
+        void retireImageView(const VkImageView &image_view, const uint64_t &last_use_value = const_vk_retire_on_last_submission);
+        void retirePipeline(const VkPipeline &pipeline, const uint64_t &last_use_value = const_vk_retire_on_last_submission);
+        void retirePipelineLayout(const VkPipelineLayout &pipeline_layout, const uint64_t &last_use_value = const_vk_retire_on_last_submission);
+        void retireFramebuffer(const VkFramebuffer &framebuffer, const uint64_t &last_use_value = const_vk_retire_on_last_submission);
+        void retireRenderPass(const VkRenderPass &render_pass, const uint64_t &last_use_value = const_vk_retire_on_last_submission);
+        void retireDescriptorPool(const VkDescriptorPool &descriptor_pool, const uint64_t &last_use_value = const_vk_retire_on_last_submission);
+        void retireDescriptorSetLayout(const VkDescriptorSetLayout &descriptor_set_layout, const uint64_t &last_use_value = const_vk_retire_on_last_submission);
+        void retireSwapchain(const VkSwapchainKHR &swapchain, const uint64_t &last_use_value = const_vk_retire_on_last_submission);
+
+        /**
+         * @brief Retire device memory not owned by a buffer or image, such as a block shared by aliased images.
+         *
+         */
+        void retireAllocation(const VmaAllocation &allocation, const uint64_t &last_use_value = const_vk_retire_on_last_submission);
+
+        /**
+         * @brief Destroy every retired object whose retire value has been reached by the GPU.
+         *
+         * @param completed_value The latest completed value of the submission timeline.
+         * @return std::size_t Number of objects destroyed.
+         */
+        std::size_t collect(const uint64_t &completed_value);
+
+        /**
+         * @brief Query the submission timeline and destroy every object the GPU is done with.
+         *
+         * @return std::size_t Number of objects destroyed.
+         */
+        std::size_t collect();
+
+        /**
+         * @brief Keep retired objects owning device memory until released, for instance while a defragmentation pass is open.
+         *
+         */
+        void holdAllocations(const bool &hold);
+
+        /**
+         * @brief Destroy every retired object regardless of its retire value. Should only be called when the device is idling.
+         *
+         */
+        void flush();
+
+        std::size_t countPending() const;
+    }; // class VulkanDeletionQueue
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_VULKANDELETIONQUEUE_H
@@ -0,0 +1,172 @@
+#ifndef ZEROENGINE_VULKANDESCRIPTORALLOCATOR_H
+#define ZEROENGINE_VULKANDESCRIPTORALLOCATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+
+#include "vulkan/vulkan.hpp"
+
+namespace ZEROengine {
+    class VulkanDevice;
+
+    struct VulkanDescriptorLayoutCacheStatistics {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint32_t layouts = 0;
+    };
+
+    /**
+     * @brief Deduplicates descriptor set layouts. Bindings are sorted by binding index before hashing, so the same
+     * set of bindings declared in any order maps to a single VkDescriptorSetLayout. Layouts live until cleanup().
+     *
+     */
+    class VulkanDescriptorLayoutCache {
+    private:
+        struct LayoutEntry {
+            std::vector<VkDescriptorSetLayoutBinding> bindings;
+            std::vector<VkSampler> immutable_samplers;
+            VkDescriptorSetLayout layout;
+        };
+
+        VulkanDevice* m_device;
+        std::unordered_map<std::size_t, std::vector<LayoutEntry>> m_layouts;
+
+        // scratch storage of the canonical binding list
+        std::vector<VkDescriptorSetLayoutBinding> m_canonical;
+
+        VulkanDescriptorLayoutCacheStatistics m_statistics;
+
+    private:
+        static std::size_t hashBindings(const std::vector<VkDescriptorSetLayoutBinding> &bindings);
+        static bool equalBindings(const std::vector<VkDescriptorSetLayoutBinding> &lhs, const std::vector<VkDescriptorSetLayoutBinding> &rhs);
+
+    public:
+        VulkanDescriptorLayoutCache(VulkanDevice* device);
+        ~VulkanDescriptorLayoutCache();
+
+        VulkanDescriptorLayoutCache(const VulkanDescriptorLayoutCache&) = delete;
+        VulkanDescriptorLayoutCache& operator=(const VulkanDescriptorLayoutCache&) = delete;
+
+        /**
+         * @brief Get the layout of a binding list, creating it on first use.
+         *
+         * @param bindings The bindings, immutable samplers are compared by handle.
+         * @param binding_count Number of bindings.
+         * @return VkDescriptorSetLayout Owned by the cache.
+         */
+        VkDescriptorSetLayout getLayout(const VkDescriptorSetLayoutBinding* bindings, const uint32_t &binding_count);
+        VkDescriptorSetLayout getLayout(const std::vector<VkDescriptorSetLayoutBinding> &bindings);
+
+        const VulkanDescriptorLayoutCacheStatistics& getStatistics() const;
+
+        void cleanup();
+    }; // class VulkanDescriptorLayoutCache
+
+    /**
+     * @brief Relative amount of each descriptor type in a pool, multiplied by the sets per pool.
+     *
+     */
+    struct VulkanDescriptorPoolRatio {
+        VkDescriptorType type;
+        float ratio;
+    };
+
+    struct VulkanDescriptorAllocatorStatistics {
+        uint32_t pools = 0; // pools created so far
+        uint32_t frame_pools = 0; // pools used by the current frame
+        uint32_t frame_sets = 0; // sets allocated by the current frame
+        uint64_t pool_resets = 0;
+        uint64_t descriptor_writes = 0;
+        uint64_t update_calls = 0;
+    };
+
+    /**
+     * @brief Per frame descriptor set allocator. Sets are never freed one by one: every pool a frame allocated from is
+     * reset as a whole when the frame comes around again, and pools are recycled rather than destroyed, so once the
+     * pool count has grown to the peak demand no more Vulkan objects are created.
+     * Writes are queued and submitted in a single vkUpdateDescriptorSets call by flushWrites().
+     *
+     */
+    class VulkanDescriptorAllocator {
+    private:
+        struct PendingWrite {
+            VkDescriptorSet set;
+            uint32_t binding;
+            uint32_t array_element;
+            VkDescriptorType type;
+            VkDescriptorImageInfo image_info;
+            VkDescriptorBufferInfo buffer_info;
+            bool is_image;
+        };
+
+        VulkanDevice* m_device;
+        uint32_t m_sets_per_pool;
+        std::vector<VkDescriptorPoolSize> m_pool_sizes;
+
+        std::vector<std::vector<VkDescriptorPool>> m_frame_pools; // pools used by each frame in flight, the last one is current
+        std::vector<VkDescriptorPool> m_free_pools; // reset pools ready for reuse
+        uint32_t m_frame_index;
+
+        std::vector<PendingWrite> m_pending_writes;
+
+        // scratch storage of flushWrites()
+        std::vector<VkDescriptorImageInfo> m_image_infos;
+        std::vector<VkDescriptorBufferInfo> m_buffer_infos;
+        std::vector<VkWriteDescriptorSet> m_writes;
+
+        VulkanDescriptorAllocatorStatistics m_statistics;
+
+    private:
+        VkDescriptorPool acquirePool();
+        void destroyPool(const VkDescriptorPool &pool);
+
+    public:
+        /**
+         * @brief Create an allocator with no pool, pools are created on demand.
+         *
+         * @param device The device.
+         * @param frames_in_flight Number of frames whose sets may be in use at once.
+         * @param sets_per_pool Sets each pool can hold.
+         * @param pool_ratios Descriptors of each type per set, an empty list selects a default mix.
+         */
+        VulkanDescriptorAllocator(
+            VulkanDevice* device,
+            const uint32_t &frames_in_flight,
+            const uint32_t &sets_per_pool = 256,
+            const std::vector<VulkanDescriptorPoolRatio> &pool_ratios = {});
+        ~VulkanDescriptorAllocator();
+
+        VulkanDescriptorAllocator(const VulkanDescriptorAllocator&) = delete;
+        VulkanDescriptorAllocator& operator=(const VulkanDescriptorAllocator&) = delete;
+
+        /**
+         * @brief Move to the next frame in flight and reset every pool it used. The caller must have waited for the
+         * frame that last used it.
+         *
+         */
+        void beginFrame();
+
+        /**
+         * @brief Allocate a set valid until this frame comes around again, growing to a new pool when the current one is full.
+         *
+         */
+        VkDescriptorSet allocate(const VkDescriptorSetLayout &layout);
+
+        void writeBuffer(const VkDescriptorSet &set, const uint32_t &binding, const VkDescriptorType &type, const VkBuffer &buffer, const VkDeviceSize &offset = 0, const VkDeviceSize &range = VK_WHOLE_SIZE, const uint32_t &array_element = 0);
+        void writeImage(const VkDescriptorSet &set, const uint32_t &binding, const VkDescriptorType &type, const VkImageView &image_view, const VkSampler &sampler, const VkImageLayout &image_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, const uint32_t &array_element = 0);
+
+        /**
+         * @brief Submit every queued write. Must be called before the sets are bound.
+         *
+         */
+        void flushWrites();
+
+        const VulkanDescriptorAllocatorStatistics& getStatistics() const;
+
+        void cleanup();
+    }; // class VulkanDescriptorAllocator
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_VULKANDESCRIPTORALLOCATOR_H
@@ -8,15 +8,25 @@
 #include <optional>
 #include <unordered_map>
 #include <list>
+#include <mutex>
 
 #include "vulkan/vulkan.hpp"
 #include "vk_mem_alloc.h"
 
 #include "zeroengine_core/ZERODefines.hpp"
+#include "zeroengine_core/InstrumentedMutex.hpp"
 #include "zeroengine_graphical/GPUDevice.hpp"
+#include "zeroengine_graphical/GPUHandleTable.hpp"
+#include "zeroengine_graphical/GPUResidencyManager.hpp"
 #include "zeroengine_vulkan/VulkanQueueManager.hpp"
 #include "zeroengine_vulkan/VulkanDefines.hpp"
+#include "zeroengine_vulkan/VulkanSyncPrimitives.hpp"
+#include "zeroengine_vulkan/VulkanDeletionQueue.hpp"
+#include "zeroengine_vulkan/VulkanPipelineManager.hpp"
+#include "zeroengine_vulkan/VulkanResource.hpp"
 #include "zeroengine_vulkan/VulkanWindow.hpp"
+#include "zeroengine_vulkan/VulkanDefragmenter.hpp"
+#include "zeroengine_vulkan/VulkanRenderTargetPool.hpp"
 
 namespace ZEROengine {
     class VulkanWindow;
@@ -27,6 +37,19 @@ namespace ZEROengine {
         const bool const_dbg_enable_validation_layers = true;
     #endif
 
+    /**
+     * @brief Memory of one heap. usage and budget come from VK_EXT_memory_budget when supported,
+     * otherwise from the allocator's own estimate.
+     *
+     */
+    struct VulkanHeapBudget {
+        uint64_t usage; // whole process, as reported by the driver
+        uint64_t budget;
+        uint64_t block_bytes; // allocated by VMA
+        uint64_t allocation_bytes; // used within the blocks
+        bool device_local;
+    };
+
     /**
      * @brief VulkanDevice holds essentials informations about the Vulkan runtime of the application. It also manage the hardware swapchain and auxillary resources.
      * 
@@ -39,13 +62,43 @@ namespace ZEROengine {
         
         VmaAllocator m_vma_alloc;
 
+        // headless devices present to VK_EXT_headless_surface instead of a platform surface
+        const bool m_headless;
+
         std::shared_ptr<VulkanQueueManager> m_vulkan_queue_manager;
+
+        // every queue submission signals the next value of this timeline, retired objects are keyed by it
+        std::shared_ptr<VulkanTimelineSemaphore> m_submission_timeline;
+        std::shared_ptr<VulkanDeletionQueue> m_deletion_queue;
+
+        // objects referenced by handles in recorded command streams, guarded by m_resource_mutex as loaders
+        // allocate from worker threads while the render thread resolves handles
+        mutable InstrumentedMutex m_resource_mutex;
+        GPUHandleTable<std::shared_ptr<VulkanBuffer>> m_buffers;
+        GPUHandleTable<VkDescriptorSet> m_descriptor_sets;
+        GPUAllocationStatistics m_allocation_statistics;
+
+        // every queue operation, submissions and presents from several threads, so that the timeline is signaled in order
+        // and VkQueue external synchronization holds
+        std::mutex m_queue_mutex;
+        // staging copies of static buffers
+        std::mutex m_upload_mutex;
+        VkCommandPool m_upload_command_pool;
+        std::shared_ptr<VulkanPipelineManager> m_pipeline_manager;
+
+        // memory budget, refreshed once per frame
+        bool m_memory_budget_supported;
+        uint32_t m_frame_index;
+        std::vector<VulkanHeapBudget> m_heap_budgets;
+        std::shared_ptr<GPUResidencyManager> m_residency_manager;
+        std::shared_ptr<VulkanDefragmenter> m_defragmenter;
+        std::shared_ptr<VulkanRenderTargetPool> m_render_target_pool;
         
     // initialization and cleanup procedures
     public:
         static constexpr const char* getRequiredExtension();
 
-        VulkanDevice();
+        VulkanDevice(const bool &headless = false);
         void initVulkan(VulkanWindow* vulkan_window = nullptr);
 
         void initInstance();
@@ -63,17 +116,101 @@ namespace ZEROengine {
         void selectPhysicalDevice(const std::vector<VkPhysicalDevice>& devices_list);
         uint32_t evaluatePhysicalDeviceSuitability(const VkPhysicalDevice &phys_device);
         bool checkDeviceExtensionSupport(const VkPhysicalDevice &phys_device);
+        bool checkDeviceExtensionSupport(const VkPhysicalDevice &phys_device, const char* extension);
         
     public:
         VkInstance getInstance();
+        bool isHeadless() const;
         std::weak_ptr<VulkanQueueManager> getQueueManager();
         std::weak_ptr<GraphicalContext> allocateGraphicalContext() override final;
 
         VkDevice getDevice();
         VkPhysicalDevice getPhysicalDevice();
+        VmaAllocator getAllocator();
+
+        std::weak_ptr<VulkanTimelineSemaphore> getSubmissionTimeline();
+        std::weak_ptr<VulkanDeletionQueue> getDeletionQueue();
+        std::weak_ptr<VulkanPipelineManager> getPipelineManager();
+        std::weak_ptr<GPUResidencyManager> getResidencyManager();
+        std::weak_ptr<VulkanDefragmenter> getDefragmenter();
+        std::weak_ptr<VulkanRenderTargetPool> getRenderTargetPool();
+
+        /**
+         * @brief Translate a buffer handle of a command stream into its Vulkan buffer.
+         * 
+         * @param buffer_handle Handle returned by allocateBuffer().
+         * @return VkBuffer 
+         */
+        VkBuffer resolveBuffer(const GPUBufferHandle &buffer_handle);
+        std::weak_ptr<VulkanBuffer> getBuffer(const GPUBufferHandle &buffer_handle);
+
+        /**
+         * @brief Like getBuffer(), but returns nullptr for a released handle instead of asserting.
+         *
+         */
+        std::shared_ptr<VulkanBuffer> findBuffer(const GPUBufferHandle &buffer_handle);
+
+        /**
+         * @brief Give a descriptor set a handle for command streams. The caller keeps ownership of the set and its pool.
+         * 
+         * @param descriptor_set The descriptor set.
+         * @return GPUDescriptorSetHandle 
+         */
+        GPUDescriptorSetHandle registerDescriptorSet(const VkDescriptorSet &descriptor_set);
+        void releaseDescriptorSet(const GPUDescriptorSetHandle &descriptor_set_handle);
+        VkDescriptorSet resolveDescriptorSet(const GPUDescriptorSetHandle &descriptor_set_handle);
+
+        /**
+         * @brief Free every retired object the GPU has finished with. Should be called once per frame.
+         * 
+         * @return std::size_t Number of objects destroyed.
+         */
+        std::size_t collectRetiredObjects();
+
+        /**
+         * @brief Refresh the heap budgets and let the residency manager evict resources when device local memory nears its budget.
+         * Should be called once per frame, after collectRetiredObjects().
+         *
+         */
+        void updateMemoryBudget();
+        bool isMemoryBudgetSupported() const;
+        const std::vector<VulkanHeapBudget>& getHeapBudgets() const;
+
+        /**
+         * @brief Usage and budget summed over the device local heaps, as of the last updateMemoryBudget().
+         *
+         */
+        GPUMemoryBudget getDeviceLocalBudget() const;
+
+        /**
+         * @brief Submit a command buffer to the graphics queue, signaling the next value of the submission timeline.
+         * The submission does not wait on earlier ones, the command buffer records the barriers its work depends on. Thread-safe.
+         *
+         * @return uint64_t The timeline value signaled once the command buffer completed.
+         */
+        uint64_t submitCommandBuffer(VkCommandBuffer command_buffer);
+
+        /**
+         * @brief vkQueuePresentKHR under the queue lock taken by submitCommandBuffer(). Thread-safe.
+         *
+         */
+        VkResult present(const VkQueue &queue, const VkPresentInfoKHR &present_info);
+
+        /**
+         * @brief Block until every submission made so far has completed on the GPU.
+         * 
+         */
+        void waitForSubmissions();
 
-        ZEROResult allocateBuffer() override;
+        ZEROResult allocateBuffer(const GPUBufferDescription &buffer_description, GPUBufferHandle &buffer_handle) override;
+        void releaseBuffer(const GPUBufferHandle &buffer_handle) override;
+        bool containsBuffer(const GPUBufferHandle &buffer_handle) const override;
+        void* getBufferMapped(const GPUBufferHandle &buffer_handle) override;
+        ZEROResult writeBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const void* data, const uint64_t &size) override;
+        void flushBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const uint64_t &size) override;
+        void invalidateBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const uint64_t &size) override;
         ZEROResult allocateTexture() override;
+        GPUAllocationStatistics getAllocationStatistics() const override;
 
         void waitForFence(VkFence fence);
         void releaseFence(VkFence fence);
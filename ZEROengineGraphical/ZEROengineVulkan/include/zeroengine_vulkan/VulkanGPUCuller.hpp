@@ -0,0 +1,122 @@
+#ifndef ZEROENGINE_VULKANGPUCULLER_H
+#define ZEROENGINE_VULKANGPUCULLER_H
+
+#include <cstdint>
+#include <cstddef>
+
+#include "vulkan/vulkan.hpp"
+#include "vk_mem_alloc.h"
+
+#include "zeroengine_graphical/GPUFrustum.hpp"
+
+namespace ZEROengine {
+    class VulkanDevice;
+
+    /**
+     * @brief Per object input of the culling shader, matching CullObject of cull.comp in std430 layout.
+     * first_instance is forwarded to the draw, shaders use it to fetch per object data.
+     * 
+     */
+    struct VulkanCullObject {
+        float center[3];
+        float radius;
+        uint32_t index_count;
+        uint32_t first_index;
+        int32_t vertex_offset;
+        uint32_t first_instance;
+    };
+    static_assert(sizeof(VulkanCullObject) == 32, "VulkanCullObject must match the std430 layout of cull.comp.");
+
+    struct VulkanCullPushConstants {
+        float planes[ZERO_FRUSTUM_PLANE_COUNT][4];
+        uint32_t object_count;
+        uint32_t padding[3];
+    };
+
+    /**
+     * @brief GPU driven visibility. Object bounds and draw arguments are uploaded once, a compute pass culls them
+     * against the view frustum into a compacted VkDrawIndexedIndirectCommand list plus a draw count, and a single
+     * vkCmdDrawIndexedIndirectCount draws the survivors. The CPU cost per frame no longer depends on the object count.
+     * Every object is drawn from the vertex and index buffers bound by the caller.
+     * 
+     */
+    class VulkanGPUCuller {
+    private:
+        VulkanDevice* m_device;
+        uint32_t m_max_objects;
+        uint32_t m_object_count;
+
+        // device local inputs and outputs of the culling pass
+        VkBuffer m_object_buffer;
+        VmaAllocation m_object_allocation;
+        void* m_object_mapped;
+        VkBuffer m_draw_buffer;
+        VmaAllocation m_draw_allocation;
+        VkBuffer m_count_buffer;
+        VmaAllocation m_count_allocation;
+
+        // used when the object buffer is not host visible
+        VkBuffer m_staging_buffer;
+        VmaAllocation m_staging_allocation;
+        void* m_staging_mapped;
+        bool m_upload_pending;
+
+        VkDescriptorSetLayout m_descriptor_set_layout;
+        VkDescriptorPool m_descriptor_pool;
+        VkDescriptorSet m_descriptor_set;
+        VkPipelineLayout m_pipeline_layout;
+        VkPipeline m_pipeline;
+
+    private:
+        void createBuffers();
+        void createPipeline(const char* shader_data, const std::size_t &shader_size);
+
+    public:
+        /**
+         * @brief Create the buffers and the culling pipeline.
+         * 
+         * @param device The device, it must have been created with drawIndirectCount.
+         * @param max_objects Capacity of the object list.
+         * @param shader_data SPIR-V of cull.comp.
+         * @param shader_size Size of the SPIR-V in bytes.
+         */
+        VulkanGPUCuller(VulkanDevice* device, const uint32_t &max_objects, const char* shader_data, const std::size_t &shader_size);
+        ~VulkanGPUCuller();
+
+        VulkanGPUCuller(const VulkanGPUCuller&) = delete;
+        VulkanGPUCuller& operator=(const VulkanGPUCuller&) = delete;
+
+        /**
+         * @brief Replace the object list. The objects reach the GPU with the next recordCull(), the previous cull must have completed.
+         * 
+         * @param objects Object bounds and draw arguments.
+         * @param object_count Number of objects, at most the capacity.
+         */
+        void uploadObjects(const VulkanCullObject* objects, const uint32_t &object_count);
+
+        /**
+         * @brief Record the culling dispatch and the barriers making its output visible to indirect draws.
+         * Must be recorded outside of a render pass.
+         * 
+         * @param command_buffer The command buffer.
+         * @param frustum The view frustum.
+         */
+        void recordCull(VkCommandBuffer command_buffer, const GPUFrustum &frustum);
+
+        /**
+         * @brief Record the indirect draw of the visible objects, inside the render pass following recordCull().
+         * 
+         * @param command_buffer The command buffer, with the graphics pipeline, vertex and index buffers bound.
+         */
+        void recordDraw(VkCommandBuffer command_buffer);
+
+        uint32_t getObjectCount() const;
+        uint32_t getMaxObjects() const;
+        VkBuffer getDrawBuffer() const;
+        VkBuffer getCountBuffer() const;
+
+        void cleanup();
+    }; // class VulkanGPUCuller
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_VULKANGPUCULLER_H
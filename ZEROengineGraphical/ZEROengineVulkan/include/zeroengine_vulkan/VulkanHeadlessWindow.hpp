@@ -0,0 +1,43 @@
+#ifndef ZEROENGINE_VULKANHEADLESSWINDOW_H
+#define ZEROENGINE_VULKANHEADLESSWINDOW_H
+
+#include <cstdint>
+#include <string>
+
+#include "vulkan/vulkan.hpp"
+#include "zeroengine_vulkan/VulkanWindow.hpp"
+
+namespace ZEROengine {
+    /**
+     * @brief A render target without a display, presenting to a VK_EXT_headless_surface swapchain.
+     * It keeps the acquire/present flow of VulkanWindow, so the full frame path can run in CI or on render nodes (e.g. on lavapipe).
+     * The owning VulkanDevice must be created in headless mode.
+     * 
+     */
+    class VulkanHeadlessWindow final : public VulkanWindow {
+    private:
+        VkInstance m_vk_instance;
+
+        static VkSurfaceKHR createHeadlessSurface(const VkInstance &vk_instance);
+
+    public:
+        VulkanHeadlessWindow(
+            const VkInstance &vk_instance,
+            const VkDevice &vk_device,
+            const VkPhysicalDevice &vk_phys_device,
+            const std::string &title,
+            const WindowTransform &transform,
+            const WindowSetting &setting,
+            const WindowStyle &style,
+            const uint32_t &image_count = 0
+        );
+        ~VulkanHeadlessWindow() override;
+
+        void pollEvent() override;
+        void handleMoveOrResize() override;
+
+        void cleanup() override;
+    }; // class VulkanHeadlessWindow
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_VULKANHEADLESSWINDOW_H
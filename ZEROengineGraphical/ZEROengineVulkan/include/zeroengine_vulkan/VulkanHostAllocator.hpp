@@ -0,0 +1,77 @@
+#ifndef ZEROENGINE_VULKANHOSTALLOCATOR_H
+#define ZEROENGINE_VULKANHOSTALLOCATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+
+#include "vulkan/vulkan.hpp"
+
+#include "zeroengine_core/TaggedHeap.hpp"
+
+namespace ZEROengine {
+    // VK_SYSTEM_ALLOCATION_SCOPE_COMMAND to VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE
+    constexpr uint32_t const_vk_allocation_scope_count = 5;
+
+    struct VulkanHostAllocationStatistics {
+        TaggedHeapStatistics heap;
+        // memory the driver allocated on its own and only reported
+        uint64_t internal_bytes = 0;
+        uint64_t internal_allocations = 0;
+    };
+
+    /**
+     * @brief VkAllocationCallbacks routing driver host allocations into a TaggedHeap, one tag per allocation scope,
+     * so bytes and counts can be read per scope and short lived command and object allocations are recycled
+     * instead of hitting the system heap.
+     * Objects must be created and destroyed with the same callbacks, every Vulkan call of the engine therefore uses
+     * getCallbacks(). When the module is built without ZEROENGINE_VULKAN_HOST_ALLOCATOR it returns nullptr and the
+     * driver allocator is used.
+     *
+     */
+    class VulkanHostAllocator {
+    private:
+        TaggedHeap m_heap;
+        VkAllocationCallbacks m_callbacks;
+
+        std::atomic<uint64_t> m_internal_bytes[const_vk_allocation_scope_count];
+        std::atomic<uint64_t> m_internal_allocations[const_vk_allocation_scope_count];
+
+    private:
+        static VKAPI_ATTR void* VKAPI_CALL allocation(void* user_data, size_t size, size_t alignment, VkSystemAllocationScope scope);
+        static VKAPI_ATTR void* VKAPI_CALL reallocation(void* user_data, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+        static VKAPI_ATTR void VKAPI_CALL free(void* user_data, void* memory);
+        static VKAPI_ATTR void VKAPI_CALL internalAllocation(void* user_data, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+        static VKAPI_ATTR void VKAPI_CALL internalFree(void* user_data, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+
+    public:
+        VulkanHostAllocator();
+
+        VulkanHostAllocator(const VulkanHostAllocator&) = delete;
+        VulkanHostAllocator& operator=(const VulkanHostAllocator&) = delete;
+
+        /**
+         * @brief The process wide allocator. It is never destroyed, Vulkan objects may outlive static destruction order.
+         *
+         */
+        static VulkanHostAllocator& getInstance();
+
+        /**
+         * @brief Callbacks to pass to every vkCreate*, vkDestroy*, vkAllocate* and vkFree* call.
+         *
+         * @return const VkAllocationCallbacks* nullptr when the engine allocator is disabled.
+         */
+        static const VkAllocationCallbacks* getCallbacks();
+
+        VulkanHostAllocationStatistics getStatistics(const VkSystemAllocationScope &scope) const;
+        static const char* getScopeName(const VkSystemAllocationScope &scope);
+
+        /**
+         * @brief Give the recycled blocks back to the system heap, for instance after a level unload.
+         *
+         */
+        void trim();
+    }; // class VulkanHostAllocator
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_VULKANHOSTALLOCATOR_H
@@ -2,6 +2,9 @@
 #define ZEROENGINE_VULKANPIPELINEMANAGER_H
 
 #include "vulkan/vulkan.hpp"
+#include "zeroengine_vulkan/VulkanDeletionQueue.hpp"
+#include "zeroengine_graphical/GPUDefines.hpp"
+#include "zeroengine_graphical/GPUHandleTable.hpp"
 
 #include <memory>
 #include <cstdint>
@@ -24,11 +27,35 @@ namespace ZEROengine {
     private:
         std::unordered_map<std::size_t, VulkanPipelineObject> m_pipeline_buffer;
 
+        // dense handles recorded in command streams
+        GPUHandleTable<VulkanPipelineObject> m_pipeline_handles;
+        std::unordered_map<std::size_t, GPUPipelineHandle> m_pipeline_handle_lookup;
+
     public:
         VulkanPipelineManager();
         VulkanPipelineObject getPipeline(std::size_t index);
         std::unordered_map<std::size_t, VulkanPipelineObject>& getAllPipelines();
 
+        /**
+         * @brief Add a pipeline to the pool and give it a handle for command streams. Registering a hash twice returns the existing handle.
+         * 
+         * @param index The pipeline hash.
+         * @param pipeline The pipeline objects, owned by the manager from now on.
+         * @return GPUPipelineHandle 
+         */
+        GPUPipelineHandle registerPipeline(std::size_t index, const VulkanPipelineObject &pipeline);
+        GPUPipelineHandle getPipelineHandle(std::size_t index) const;
+        const VulkanPipelineObject& resolvePipeline(const GPUPipelineHandle &handle) const;
+
+        /**
+         * @brief Remove a pipeline from the pool mid-session. The pipeline is retired to the deletion queue and destroyed once the GPU passes its last use.
+         * 
+         * @param index The pipeline hash.
+         * @param deletion_queue The device deletion queue.
+         * @param last_use_value Submission value the pipeline was last used in.
+         */
+        void releasePipeline(std::size_t index, VulkanDeletionQueue &deletion_queue, const uint64_t &last_use_value = const_vk_retire_on_last_submission);
+
         void cleanup(VkDevice device);
     }; // class VulkanGraphicsPipelineBuffer
 } // namespace ZEROengine
@@ -0,0 +1,181 @@
+#ifndef ZEROENGINE_VULKANREADBACKRING_H
+#define ZEROENGINE_VULKANREADBACKRING_H
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <condition_variable>
+
+#include "vulkan/vulkan.hpp"
+
+namespace ZEROengine {
+    class VulkanDevice;
+    class VulkanBuffer;
+
+    enum VulkanCaptureEncoding {
+        ZERO_VK_CAPTURE_RAW, // tightly packed RGBA rows
+        ZERO_VK_CAPTURE_PNG,
+        ZERO_VK_CAPTURE_PPM
+    };
+
+    struct VulkanCaptureResult {
+        uint64_t capture_id;
+        uint32_t width;
+        uint32_t height;
+        VulkanCaptureEncoding encoding;
+        std::vector<uint8_t> bytes; // pixels or file contents, depending on the encoding
+    };
+
+    /**
+     * @brief Receives a finished capture on the readback worker thread, it may keep the bytes by moving them out.
+     *
+     */
+    typedef std::function<void(VulkanCaptureResult &result)> VulkanCaptureCallback;
+
+    struct VulkanReadbackStatistics {
+        uint64_t captures = 0;
+        uint64_t completed = 0;
+        uint64_t dropped = 0; // every slot was busy
+        uint64_t bytes_read = 0;
+    };
+
+    /**
+     * @brief Copies images into a ring of host visible buffers and hands them to a worker thread for encoding, so frames
+     * can be captured without the render loop ever waiting for the GPU or the encoder.
+     * capture() records and submits the copy after the work already submitted, update() passes the copies the GPU has
+     * completed to the worker. When every slot is busy, the capture is dropped instead of stalling.
+     * Swapchain images are captured with recordCapture() in the frame command buffer, before the present transition:
+     * presentation only waits for the frame submission, so a separate copy submission could run while the image is
+     * presented, or after it was handed to the presentation engine. Capturing an image after it was presented is not allowed.
+     * capture(), recordCapture(), markSubmitted() and update() must be called from the thread submitting to the graphics queue.
+     *
+     */
+    class VulkanReadbackRing {
+    private:
+        enum SlotState {
+            FREE,
+            RECORDED, // recorded in a caller command buffer, waiting for markSubmitted()
+            IN_FLIGHT, // waiting for the copy submission
+            QUEUED, // handed to the worker
+        };
+
+        struct Slot {
+            SlotState state;
+            std::unique_ptr<VulkanBuffer> buffer;
+            VkCommandBuffer command_buffer;
+            uint64_t completion_value;
+
+            uint64_t capture_id;
+            VkExtent2D extent;
+            bool swizzle; // BGRA to RGBA
+            VulkanCaptureEncoding encoding;
+            VulkanCaptureCallback callback;
+        };
+
+        VulkanDevice* m_device;
+        VkCommandPool m_command_pool;
+        std::vector<Slot> m_slots;
+        uint64_t m_next_capture_id;
+
+        // worker state, guarded by m_mutex
+        std::mutex m_mutex;
+        std::condition_variable m_work_signal;
+        std::condition_variable m_idle_signal;
+        std::deque<uint32_t> m_queue;
+        uint32_t m_busy_slots;
+        bool m_stopping;
+        std::thread m_worker;
+
+        VulkanReadbackStatistics m_statistics;
+
+    private:
+        Slot* acquireSlot(
+            const VkFormat &format,
+            const VkExtent2D &extent,
+            const VulkanCaptureEncoding &encoding,
+            const VulkanCaptureCallback &callback,
+            const SlotState &state);
+        void recordCopy(const Slot &slot, VkCommandBuffer command_buffer, VkImage image, const VkImageLayout &layout);
+        void workerLoop();
+        void process(Slot &slot);
+
+    public:
+        /**
+         * @brief Create the ring and start its worker thread.
+         *
+         * @param slot_count Captures that may be in flight or being encoded at once.
+         */
+        VulkanReadbackRing(VulkanDevice* device, const uint32_t &slot_count = 3);
+        ~VulkanReadbackRing();
+
+        VulkanReadbackRing(const VulkanReadbackRing&) = delete;
+        VulkanReadbackRing& operator=(const VulkanReadbackRing&) = delete;
+
+        /**
+         * @brief Copy a color image in a submission of its own, once the work submitted so far completed. The image is
+         * returned to its layout afterwards. Not for presentable images, see recordCapture().
+         *
+         * @param image An image created with VK_IMAGE_USAGE_TRANSFER_SRC_BIT, in an 8 bit RGBA or BGRA format.
+         * @param layout Layout of the image when the copy runs, for instance VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+         * VK_IMAGE_LAYOUT_PRESENT_SRC_KHR is rejected.
+         * @param callback Called on the worker thread with the encoded result.
+         * @param completion_value Set to the submission timeline value signaled once the copy completed, if not null.
+         * @return bool false when the capture was dropped, because every slot is busy or the format is not supported.
+         */
+        bool capture(
+            VkImage image,
+            const VkFormat &format,
+            const VkExtent2D &extent,
+            const VkImageLayout &layout,
+            const VulkanCaptureEncoding &encoding,
+            const VulkanCaptureCallback &callback,
+            uint64_t* completion_value = nullptr);
+
+        /**
+         * @brief Record the copy of a color image into a command buffer of the caller, for instance the frame command buffer
+         * of a swapchain image, before the transition to VK_IMAGE_LAYOUT_PRESENT_SRC_KHR. The image is returned to its
+         * layout afterwards. The capture completes with the submission given to the next markSubmitted().
+         *
+         * @param layout Layout of the image at this point of the command buffer, for instance VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL.
+         * @return bool false when the capture was dropped, because every slot is busy or the format is not supported.
+         */
+        bool recordCapture(
+            VkCommandBuffer command_buffer,
+            VkImage image,
+            const VkFormat &format,
+            const VkExtent2D &extent,
+            const VkImageLayout &layout,
+            const VulkanCaptureEncoding &encoding,
+            const VulkanCaptureCallback &callback);
+
+        /**
+         * @brief Tag the captures recorded since the last call with the timeline value of the submission holding them.
+         *
+         */
+        void markSubmitted(const uint64_t &submission_value);
+
+        /**
+         * @brief Hand the completed copies to the worker. Should be called once per frame, it never waits for the GPU.
+         *
+         * @return std::size_t Number of captures handed to the worker.
+         */
+        std::size_t update();
+
+        /**
+         * @brief Block until every capture has been delivered, for instance before shutting down.
+         *
+         */
+        void flush();
+
+        VulkanReadbackStatistics getStatistics();
+
+        void cleanup();
+    }; // class VulkanReadbackRing
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_VULKANREADBACKRING_H
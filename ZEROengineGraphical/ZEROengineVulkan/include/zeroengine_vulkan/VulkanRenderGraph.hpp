@@ -0,0 +1,129 @@
+#ifndef ZEROENGINE_VULKANRENDERGRAPH_H
+#define ZEROENGINE_VULKANRENDERGRAPH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "vulkan/vulkan.hpp"
+#include "vk_mem_alloc.h"
+
+#include "zeroengine_graphical/GPURenderGraph.hpp"
+#include "zeroengine_vulkan/VulkanCommandBuffer.hpp"
+#include "zeroengine_vulkan/VulkanRenderTargetPool.hpp"
+
+namespace ZEROengine {
+    class VulkanDevice;
+    class VulkanRenderGraphExecutor;
+
+    /**
+     * @brief Pipeline stages, access mask and image layout matching a set of render graph accesses.
+     *
+     */
+    struct VulkanAccessInfo {
+        VkPipelineStageFlags stages;
+        VkAccessFlags access;
+        VkImageLayout layout;
+    };
+
+    /**
+     * @brief Context given to pass callbacks. getTexture() and getTextureView() return VkImage and VkImageView handles.
+     *
+     */
+    class VulkanRenderGraphPassContext : public GPURenderGraphPassContext {
+    private:
+        VulkanRenderGraphExecutor* m_executor;
+        const GPURenderGraph* m_graph;
+        VulkanCommandBuffer* m_command_buffer;
+        GPURenderGraphPass m_pass;
+
+        // scratch storage of beginRendering()
+        std::vector<VkRenderingAttachmentInfo> m_color_attachments;
+
+    public:
+        VulkanRenderGraphPassContext(VulkanRenderGraphExecutor* executor, const GPURenderGraph* graph, VulkanCommandBuffer* command_buffer);
+
+        void setPass(const GPURenderGraphPass &pass);
+
+        GraphicalCommandBuffer* getCommandBuffer() override final;
+        void* getTexture(const GPURenderGraphResource &resource) override final;
+        void* getTextureView(const GPURenderGraphResource &resource) override final;
+
+        VkCommandBuffer getVkCommandBuffer() const;
+        VkImage getImage(const GPURenderGraphResource &resource) const;
+        VkImageView getImageView(const GPURenderGraphResource &resource) const;
+
+        /**
+         * @brief Begin dynamic rendering on the attachments declared by the current pass, colors in declaration order.
+         * Attachments the pass reads are loaded, the others are cleared when clear values are given and discarded otherwise.
+         *
+         * @param clear_values One value per color attachment followed by the depth attachment, or nullptr.
+         */
+        void beginRendering(const VkClearValue* clear_values = nullptr);
+        void endRendering();
+    }; // class VulkanRenderGraphPassContext
+
+    /**
+     * @brief Realizes a compiled GPURenderGraph on Vulkan. Transient textures are created as aliasing images placed in one
+     * memory block per heap, so the memory of the whole frame is the peak of overlapping lifetimes rather than their sum.
+     * The images are kept across frames and only rebuilt when the compiled layout changes.
+     * When the device has lazily allocated memory, textures only used as attachments are instead acquired from the device
+     * VulkanRenderTargetPool for the duration of execute(), so they share their images with the other users of the pool.
+     * Each pass gets its barriers in a single vkCmdPipelineBarrier before its callback runs.
+     *
+     */
+    class VulkanRenderGraphExecutor {
+    private:
+        VulkanDevice* m_device;
+
+        std::vector<VmaAllocation> m_heap_allocations;
+        std::vector<VkImage> m_images;
+        std::vector<VkImageView> m_image_views;
+        std::vector<VulkanRenderTarget> m_targets; // external textures, valid during execute()
+        std::size_t m_layout_hash;
+
+        // scratch storage reused by every batch
+        std::vector<VkImageMemoryBarrier> m_image_barriers;
+
+    private:
+        VkImageCreateInfo makeImageInfo(const GPURenderGraphTextureDescription &description, const GPUAccessFlags &usage) const;
+        std::size_t hashLayout(const GPURenderGraph &graph) const;
+        void realize(const GPURenderGraph &graph);
+        void releaseImages();
+        void acquireTargets(const GPURenderGraph &graph);
+        void releaseTargets(const GPURenderGraph &graph);
+        void recordBarriers(VkCommandBuffer command_buffer, const GPURenderGraph &graph, const GPURenderGraphBarrier* barriers, const std::size_t &barrier_count);
+
+    public:
+        VulkanRenderGraphExecutor(VulkanDevice* device);
+        ~VulkanRenderGraphExecutor();
+
+        VulkanRenderGraphExecutor(const VulkanRenderGraphExecutor&) = delete;
+        VulkanRenderGraphExecutor& operator=(const VulkanRenderGraphExecutor&) = delete;
+
+        /**
+         * @brief Compile the graph against the device memory requirements and create its transient textures.
+         *
+         */
+        void compile(GPURenderGraph &graph);
+
+        /**
+         * @brief Record every surviving pass with its barriers, then the final transitions of imported textures.
+         *
+         * @param graph A graph compiled by this executor.
+         * @param command_buffer A command buffer in the recording state, outside of any render pass.
+         */
+        void execute(const GPURenderGraph &graph, VulkanCommandBuffer &command_buffer);
+
+        VkImage getImage(const GPURenderGraph &graph, const GPURenderGraphResource &resource) const;
+        VkImageView getImageView(const GPURenderGraph &graph, const GPURenderGraphResource &resource) const;
+
+        static VulkanAccessInfo translateAccess(const GPUAccessFlags &access, const bool &is_source);
+        static bool isDepthFormat(const VkFormat &format);
+        static VkImageAspectFlags getImageAspect(const VkFormat &format);
+
+        void cleanup();
+    }; // class VulkanRenderGraphExecutor
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_VULKANRENDERGRAPH_H
@@ -0,0 +1,124 @@
+#ifndef ZEROENGINE_VULKANRENDERTARGETPOOL_H
+#define ZEROENGINE_VULKANRENDERTARGETPOOL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "vulkan/vulkan.hpp"
+#include "vk_mem_alloc.h"
+
+namespace ZEROengine {
+    class VulkanDevice;
+
+    // frames a released target is kept for reuse before its memory is given back
+    constexpr uint32_t const_vk_render_target_unused_frames = 8;
+
+    struct VulkanRenderTargetDescription {
+        VkFormat format;
+        VkExtent2D extent;
+        VkSampleCountFlagBits samples;
+        VkImageUsageFlags usage;
+
+        bool operator==(const VulkanRenderTargetDescription &other) const;
+    };
+
+    struct VulkanRenderTarget {
+        VkImage image;
+        VkImageView view;
+        uint32_t index; // slot in the pool, given back to release()
+        // what the previous user of the image did last, for the barrier taking it from VK_IMAGE_LAYOUT_UNDEFINED, 0 for a new image
+        VkPipelineStageFlags previous_stages;
+        VkAccessFlags previous_access;
+    };
+
+    struct VulkanRenderTargetStatistics {
+        uint32_t targets = 0;
+        uint32_t in_use = 0;
+        uint32_t lazily_allocated = 0;
+        uint64_t allocated_bytes = 0;
+        uint64_t created = 0;
+        uint64_t reused = 0;
+        uint64_t freed = 0;
+    };
+
+    /**
+     * @brief Pool of render targets looked up by format, extent, samples and usage, so attachments living for one pass
+     * share their images across passes and frames instead of being created for each.
+     * Targets with VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT are backed by lazily allocated memory when the device has such
+     * a memory type, tile based GPUs then never commit memory for them.
+     * A released target may be acquired again in the same frame or a later one. Its contents are undefined on acquisition,
+     * and the acquirer transitions it from VK_IMAGE_LAYOUT_UNDEFINED after the stages and accesses the previous user gave
+     * to release(), as returned in VulkanRenderTarget.
+     * Targets left unused for const_vk_render_target_unused_frames frames are freed.
+     *
+     */
+    class VulkanRenderTargetPool {
+    private:
+        struct Entry {
+            VulkanRenderTargetDescription description;
+            VkImage image;
+            VkImageView view;
+            VmaAllocation allocation;
+            uint64_t size;
+            uint64_t last_used_frame;
+            VkPipelineStageFlags last_stages;
+            VkAccessFlags last_access;
+            bool lazily_allocated;
+            bool in_use;
+            bool alive;
+        };
+
+        VulkanDevice* m_device;
+        std::vector<Entry> m_entries;
+        std::vector<uint32_t> m_free_slots;
+        uint64_t m_frame;
+        bool m_lazy_memory_supported;
+
+        VulkanRenderTargetStatistics m_statistics;
+
+    private:
+        void create(Entry &entry);
+        void destroy(Entry &entry);
+
+    public:
+        VulkanRenderTargetPool(VulkanDevice* device);
+        ~VulkanRenderTargetPool();
+
+        VulkanRenderTargetPool(const VulkanRenderTargetPool&) = delete;
+        VulkanRenderTargetPool& operator=(const VulkanRenderTargetPool&) = delete;
+
+        /**
+         * @brief Take a target matching the description, reusing a released one when possible.
+         *
+         */
+        VulkanRenderTarget acquire(const VulkanRenderTargetDescription &description);
+
+        /**
+         * @brief Give a target back to the pool.
+         *
+         * @param stages Pipeline stages the target was last used in by the commands recorded so far.
+         * @param access Accesses of these stages.
+         */
+        void release(const VulkanRenderTarget &target, const VkPipelineStageFlags &stages, const VkAccessFlags &access);
+
+        /**
+         * @brief Whether the device has lazily allocated memory, so that transient attachments take no memory.
+         *
+         */
+        bool isLazyMemorySupported() const;
+
+        /**
+         * @brief Advance the frame and free the targets unused for too long. Should be called once per frame.
+         *
+         * @return std::size_t Number of targets freed.
+         */
+        std::size_t beginFrame();
+
+        const VulkanRenderTargetStatistics& getStatistics() const;
+
+        void cleanup();
+    }; // class VulkanRenderTargetPool
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_VULKANRENDERTARGETPOOL_H
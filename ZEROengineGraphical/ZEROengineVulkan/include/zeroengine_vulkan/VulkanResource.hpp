@@ -1,32 +1,90 @@
 #ifndef ZEROENGINE_VULKANRESOURCE_H
-#define ZERONEGINE_VULKANRESOURCE_H
+#define ZEROENGINE_VULKANRESOURCE_H
 
 #include <cstdint>
+#include <memory>
+#include <mutex>
 
 #include "zeroengine_graphical/GPUResource.hpp"
+#include "zeroengine_vulkan/VulkanDeletionQueue.hpp"
 #include "vk_mem_alloc.h"
 
 namespace ZEROengine {
-    class VulkanBuffer : GPUBuffer {
+    class VulkanBuffer : public GPUBuffer {
     private:
         VmaAllocator m_vma_alloc;
         VmaAllocation m_allocation_info;
 
+        std::weak_ptr<VulkanDeletionQueue> m_deletion_queue;
+        uint64_t m_last_use_value;
+
+        // serializes staged writes with the defragmenter moving the buffer
+        std::mutex m_move_mutex;
+        uint64_t m_write_generation;
+
     public:
-        VulkanBuffer(const VmaAllocator &vma_alloc, const GPUBufferDescription &buffer_description);
+        VulkanBuffer(
+            const VmaAllocator &vma_alloc, 
+            const GPUBufferDescription &buffer_description, 
+            const std::weak_ptr<VulkanDeletionQueue> &deletion_queue = {});
         ~VulkanBuffer();
 
         uint64_t getSize() const override final;
         uint64_t getStride() const override final;
         uint64_t getElementsCount() const override final;
 
+        std::weak_ptr<GPUSyncPrimitive> getResourceReadySync() override final;
+        std::weak_ptr<GPUSyncPrimitive> getResourceWorkDoneSync() override final;
+
         VkBufferUsageFlags translateBufferUsage();
+        VkBuffer getVkBuffer() const;
+        VmaAllocation getAllocation() const;
+
+        /**
+         * @brief Flush or invalidate a mapped range, VMA skips coherent memory and aligns the range to nonCoherentAtomSize.
+         *
+         */
+        void flush(const uint64_t &offset, const uint64_t &size);
+        void invalidate(const uint64_t &offset, const uint64_t &size);
+
+        /**
+         * @brief Point the buffer to a new VkBuffer bound to its allocation, after the defragmenter moved it.
+         *
+         * @return VkBuffer The previous buffer, owned by the caller.
+         */
+        VkBuffer rebind(const VkBuffer &buffer);
+
+        /**
+         * @brief Held by a staged write from before it resolves getVkBuffer() until its copy is submitted, and by the
+         * defragmenter while it snapshots or rebinds the buffer.
+         *
+         */
+        std::mutex& getMoveMutex();
+
+        /**
+         * @brief Count a write made by a submission on the device queue. Must be called with the move mutex held.
+         * The defragmenter drops a move when the count changed after its copy was submitted.
+         *
+         */
+        void markWritten();
+        uint64_t getWriteGeneration() const;
+
+        /**
+         * @brief Tag the buffer as used by the submission signaling the given timeline value. The buffer will not be freed before the GPU passes it.
+         * 
+         * @param submission_value The submission timeline value.
+         */
+        void markUsed(const uint64_t &submission_value);
 
         void allocate();
 
-        void cleanup();
+        /**
+         * @brief Release the buffer. If a deletion queue is bound, the buffer is retired and destroyed once the GPU is done with it.
+         * 
+         */
+        void cleanup() override;
 
     }; // class VulkanBuffer
 } // namespace ZEROengine
 
-#endif // #ifndef ZEROENGINE_VULKANRESOURCE_H
\ No newline at end of file
+#endif // #ifndef ZEROENGINE_VULKANRESOURCE_H
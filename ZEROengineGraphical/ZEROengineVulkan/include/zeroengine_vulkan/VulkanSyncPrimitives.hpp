@@ -1,6 +1,10 @@
 #ifndef ZEROENGINE_VULKANSYNCPRIMITIVES_H
 #define ZEROENGINE_VULKANSYNCPRIMITIVES_H
 
+#include <cstdint>
+#include <limits>
+#include <atomic>
+
 #include "vulkan/vulkan.hpp"
 #include "zeroengine_graphical/GPUSyncPrimitives.hpp"
 
@@ -18,6 +22,43 @@ namespace ZEROengine {
 
         void* getSemaphore() override final;
     }; // class VulkanSyncPrimitives
+
+    /**
+     * @brief A monotonically increasing timeline semaphore, used to tag queue submissions with a value that the CPU can poll without fences.
+     * 
+     */
+    class VulkanTimelineSemaphore {
+    private:
+        VkDevice m_vk_device;
+        VkSemaphore m_vk_semaphore;
+
+        // reserved under the device queue lock, read from any thread
+        std::atomic<uint64_t> m_submitted_value;
+
+    public:
+        VulkanTimelineSemaphore(const VkDevice &vk_device, const uint64_t &initial_value = 0);
+
+        /**
+         * @brief Reserve the value the next queue submission should signal.
+         * 
+         * @return uint64_t The reserved signal value.
+         */
+        uint64_t nextSubmissionValue();
+        uint64_t getSubmittedValue() const;
+        uint64_t getCompletedValue() const;
+
+        /**
+         * @brief Block until the GPU reaches the value, or the timeout expires.
+         * 
+         * @return true The timeline has reached the value.
+         * @return false The wait timed out.
+         */
+        bool wait(const uint64_t &value, const uint64_t &timeout = std::numeric_limits<uint64_t>::max()) const;
+
+        VkSemaphore getSemaphore() const;
+
+        void cleanup();
+    }; // class VulkanTimelineSemaphore
 } // namespace ZEROengine
 
 #endif // #ifndef ZEROENGINE_VULKANSYNCPRIMITIVES_H
\ No newline at end of file
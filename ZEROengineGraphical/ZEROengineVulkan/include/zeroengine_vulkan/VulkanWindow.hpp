@@ -7,13 +7,62 @@
 #include <cstdint>
 #include <unordered_map>
 #include <memory>
+#include <chrono>
 
 #include "zeroengine_graphical/GPUWindow.hpp"
 #include "zeroengine_core/ZERODefines.hpp"
 #include "zeroengine_vulkan/VulkanDevice.hpp"
+#include "zeroengine_vulkan/VulkanDeletionQueue.hpp"
+#include "zeroengine_vulkan/VulkanRenderTargetPool.hpp"
 
 namespace ZEROengine {
     class VulkanDevice;
+
+    // default bound on how long an acquire may block the calling thread, in nanoseconds
+    constexpr uint64_t const_vk_default_acquire_timeout = 1000000;
+    // number of out-of-date recreations tolerated within a single acquire call
+    constexpr uint32_t const_vk_max_acquire_attempts = 4;
+    // depth attachment of the swapchain pass, only needed within the pass
+    constexpr VkFormat const_vk_swapchain_depth_format = VK_FORMAT_D16_UNORM;
+
+    /**
+     * @brief Presentation latency policies. A policy selects the present mode, swapchain image count and frames in flight together.
+     * 
+     */
+    enum VulkanLatencyPolicy {
+        ZERO_VK_LATENCY_POLICY_LOWEST_LATENCY, // MAILBOX or IMMEDIATE, a single frame in flight
+        ZERO_VK_LATENCY_POLICY_VSYNC_THROUGHPUT, // FIFO, triple buffering with two frames in flight
+        ZERO_VK_LATENCY_POLICY_POWER_SAVING // FIFO, minimal image count with a single frame in flight
+    };
+
+    struct VulkanPresentationConfig {
+        VkPresentModeKHR present_mode = VK_PRESENT_MODE_FIFO_KHR;
+        uint32_t image_count = 0;
+        uint32_t frames_in_flight = 1;
+    };
+
+    /**
+     * @brief Input-to-present latency, measured from the input sampling of a frame to the return of its vkQueuePresentKHR.
+     * 
+     */
+    struct VulkanLatencyStatistics {
+        uint64_t samples = 0;
+        uint64_t total_ns = 0;
+        uint64_t min_ns = 0;
+        uint64_t max_ns = 0;
+        uint64_t last_ns = 0;
+    };
+
+    struct VulkanWindowStatistics {
+        uint64_t acquired_frames = 0;
+        uint64_t skipped_frames = 0; // acquisitions returning VK_NOT_READY, VK_TIMEOUT or staying out of date
+        uint64_t swapchain_recreations = 0;
+
+        uint64_t acquire_wait_ns = 0; // accumulated time spent in vkAcquireNextImageKHR
+        uint64_t last_acquire_wait_ns = 0;
+        uint64_t max_acquire_wait_ns = 0;
+        uint64_t pacing_wait_ns = 0; // accumulated time spent waiting for the frame frames_in_flight presents back
+    };
     
     /**
      * @brief A structure to manage Render Targets-related attributes.
@@ -34,16 +83,45 @@ namespace ZEROengine {
         VkRenderPass m_vk_swapchain_renderpass;
         VkFormat m_vk_swapchain_format;
 
+        // vkCmdBeginRendering on the swapchain views, without render pass and framebuffer objects
+        bool m_dynamic_rendering;
+
         int64_t m_graphical_queue_family;
         uint32_t m_acquired_swapchain;
 
+        // swapchain resources replaced on recreation are retired here instead of stalling the device
+        std::weak_ptr<VulkanDeletionQueue> m_deletion_queue;
+        VulkanDevice* m_device; // presents under the device queue lock
+        VulkanRenderTarget m_depth_target; // from the device render target pool, shared by every swapchain image
+
+        uint64_t m_acquire_timeout;
+        bool m_swapchain_dirty; // recreate lazily before the next acquisition
+        VulkanWindowStatistics m_statistics;
+
+        VulkanLatencyPolicy m_latency_policy;
+        VulkanPresentationConfig m_presentation_config;
+        uint32_t m_requested_image_count; // overrides the policy image count when non-zero
+
+        // submission timeline value of each frame in flight when it was presented, indexed by m_frame_slot
+        std::vector<uint64_t> m_frame_submissions;
+        uint32_t m_frame_slot;
+
+        bool m_has_input_timestamp;
+        std::chrono::steady_clock::time_point m_input_timestamp;
+        std::unordered_map<VkPresentModeKHR, VulkanLatencyStatistics> m_latency_statistics;
+
     private:
         VkSurfaceFormatKHR selectSwapchainSurfaceFormat(const std::vector<VkSurfaceFormatKHR> &formats);
         VkPresentModeKHR selectSwapchainPresentationMode(const std::vector<VkPresentModeKHR> &modes);
+        VulkanPresentationConfig selectPresentationConfig(const SwapChainSupportDetails &swap_chain_support);
+        void acquireDepthTarget();
+        void releaseDepthTarget();
+        void resizeFrameSubmissions();
+        bool waitForFrameSlot();
         bool m_enable_depth_stencil_subpass = false;
     
     protected:
-        void initSwapChain();
+        void initSwapChain(const VkSwapchainKHR &old_swapchain = VK_NULL_HANDLE);
         void initSwapChainRenderPass();
         void initSwapChainRenderTargets();
         
@@ -58,7 +136,51 @@ namespace ZEROengine {
             const WindowStyle &style
         );
         void init() override final;
+
+        /**
+         * @brief Create the swapchain, its render pass and per-image render targets. Requires init() and the graphical queue family.
+         * 
+         */
+        void initSwapChainResources();
         void setGraphicalQueueFamily(const uint32_t &v);
+        void setDeletionQueue(const std::weak_ptr<VulkanDeletionQueue> &deletion_queue);
+        void setDevice(VulkanDevice* device);
+
+        /**
+         * @brief Render to the swapchain with dynamic rendering. No render pass nor framebuffers are created, so swapchain
+         * recreation only replaces the image views. Must be set before initSwapChainResources().
+         * 
+         */
+        void setDynamicRendering(const bool &enable);
+        bool isDynamicRendering() const;
+
+        /**
+         * @brief Add a depth attachment, cleared and discarded within the swapchain pass, acquired from the device render target pool.
+         * Must be set before initSwapChainResources().
+         * 
+         */
+        void setDepthStencil(const bool &enable);
+        bool isDepthStencil() const;
+
+        /**
+         * @brief Attachment formats of the swapchain pass, to chain into VkGraphicsPipelineCreateInfo::pNext with renderPass left null.
+         * The returned structure points into the window and stays valid while the swapchain format does not change.
+         * 
+         */
+        VkPipelineRenderingCreateInfo getPipelineRenderingInfo() const;
+
+        /**
+         * @brief Start rendering to the acquired swapchain image, clearing it and the depth attachment to 1.0.
+         * With dynamic rendering the image is transitioned to the attachment layout by a barrier, otherwise the swapchain render pass begins.
+         * 
+         */
+        void beginSwapchainRendering(VkCommandBuffer command_buffer, const VkClearColorValue &clear_color);
+
+        /**
+         * @brief End rendering to the acquired swapchain image and leave it ready for presentation.
+         * 
+         */
+        void endSwapchainRendering(VkCommandBuffer command_buffer);
 
         std::optional<uint32_t> queryPresentationQueueIndex() const;
         std::optional<VkDeviceQueueCreateInfo> queryPresentationQueueCreation() const;
@@ -68,10 +190,71 @@ namespace ZEROengine {
         VkSwapchainKHR getSwapchain() const;
         VkFramebuffer getFramebuffer(const uint32_t &index) const;
         VkRenderPass getRenderPass() const;
+
+        /**
+         * @brief Swapchain images and views, to be imported into a render graph for the acquired image.
+         * 
+         */
+        VkImage getSwapchainImage(const uint32_t &index) const;
+        VkImageView getSwapchainImageView(const uint32_t &index) const;
+        VkFormat getSwapchainFormat() const;
         VkSurfaceKHR getSurface() const;
-        bool tryAcquireSwapchainImage(const VkSemaphore &wait_semaphore, const uint32_t &call_depth = 0);
+        /**
+         * @brief Acquire the next swapchain image, blocking at most for the acquire timeout.
+         * The frame presented frames_in_flight presents ago must first complete on the GPU, also waited for at most the acquire timeout.
+         * Out of date swapchains are recreated in place, suboptimal ones are flagged and recreated before the next acquisition.
+         * 
+         * @param wait_semaphore Semaphore signaled when the acquired image is ready.
+         * @return VkResult VK_SUCCESS or VK_SUBOPTIMAL_KHR if an image was acquired. 
+         * VK_NOT_READY, VK_TIMEOUT or VK_ERROR_OUT_OF_DATE_KHR if the caller should skip rendering this frame.
+         */
+        VkResult tryAcquireSwapchainImage(const VkSemaphore &wait_semaphore);
         uint32_t getAcquiredSwapchain() const;
 
+        /**
+         * @brief Queue the acquired image for presentation. Out of date or suboptimal results flag the swapchain for recreation.
+         * The frame must have been submitted, its latest submission closes the frame in flight slot.
+         * 
+         * @param wait_semaphore Semaphore signaled when rendering to the acquired image is done. May be VK_NULL_HANDLE.
+         * @return VkResult The presentation result.
+         */
+        VkResult presentSwapchainImage(const VkSemaphore &wait_semaphore);
+
+        void setAcquireTimeout(const uint64_t &timeout_ns);
+        uint64_t getAcquireTimeout() const;
+        void requestSwapchainRecreation();
+
+        const VulkanWindowStatistics& getStatistics() const;
+        void resetStatistics();
+
+        /**
+         * @brief Switch the latency policy. The swapchain is recreated with the new configuration before the next acquisition.
+         * 
+         */
+        void setLatencyPolicy(const VulkanLatencyPolicy &policy);
+        VulkanLatencyPolicy getLatencyPolicy() const;
+        VulkanPresentationConfig getPresentationConfig() const;
+        uint32_t getFramesInFlight() const;
+
+        /**
+         * @brief Request a swapchain image count, clamped to the surface capabilities. Zero restores the latency policy default.
+         * 
+         */
+        void setSwapchainImageCount(const uint32_t &image_count);
+        uint32_t getSwapchainImageCount() const;
+
+        /**
+         * @brief Timestamp the input sampling of the current frame. The next presentation measures its input-to-present latency against it.
+         * 
+         */
+        void markInputSampled();
+        VulkanLatencyStatistics getLatencyStatistics(const VkPresentModeKHR &present_mode) const;
+
+        /**
+         * @brief Recreate the swapchain, handing the current one over as oldSwapchain.
+         * The replaced swapchain, image views and framebuffers are retired to the deletion queue, so frames in flight are not drained.
+         * 
+         */
         void reload_swapChain();
         void cleanup_swapChain();
 
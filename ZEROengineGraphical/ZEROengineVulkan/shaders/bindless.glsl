@@ -0,0 +1,20 @@
+// Declarations of the bindless descriptor set of VulkanBindlessHeap, included by
+// shaders built against its pipeline layout. Resource indices arrive through
+// push constants and select an element of the arrays below.
+
+#ifndef ZEROENGINE_BINDLESS_GLSL
+#define ZEROENGINE_BINDLESS_GLSL
+
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(set = 0, binding = 0) uniform texture2D bindless_textures[];
+layout(set = 0, binding = 1) uniform sampler bindless_samplers[];
+
+// storage buffers are declared per use, as their block layout differs:
+// layout(std430, set = 0, binding = 2) readonly buffer Block { ... } blocks[];
+
+vec4 bindlessSample(uint texture_index, uint sampler_index, vec2 uv) {
+    return texture(sampler2D(bindless_textures[nonuniformEXT(texture_index)], bindless_samplers[nonuniformEXT(sampler_index)]), uv);
+}
+
+#endif // ZEROENGINE_BINDLESS_GLSL
@@ -0,0 +1,280 @@
+#include "zeroengine_vulkan/VulkanBindlessHeap.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
+#include "zeroengine_vulkan/VulkanDevice.hpp"
+#include "zeroengine_vulkan/VulkanDefines.hpp"
+
+#include <memory>
+#include <string>
+
+namespace ZEROengine {
+    VulkanBindlessHeap::VulkanBindlessHeap(VulkanDevice* device, const uint32_t &max_sampled_images, const uint32_t &max_samplers, const uint32_t &max_storage_buffers) :
+    m_device{device},
+    m_descriptor_set_layout{VK_NULL_HANDLE},
+    m_descriptor_pool{VK_NULL_HANDLE},
+    m_descriptor_set{VK_NULL_HANDLE},
+    m_pipeline_layout{VK_NULL_HANDLE},
+    m_slots{},
+    m_pending_writes{},
+    m_image_infos{},
+    m_buffer_infos{},
+    m_writes{},
+    m_statistics{}
+    {
+        if(m_device == nullptr) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_NULL_POINTER, "Bindless heap needs a device.");
+        }
+        ZERO_ASSERT(max_sampled_images > 0 && max_samplers > 0 && max_storage_buffers > 0, "Bindless arrays must not be empty.");
+        m_slots.reserve(ZERO_VK_BINDLESS_TYPE_COUNT);
+        m_slots.emplace_back(max_sampled_images);
+        m_slots.emplace_back(max_samplers);
+        m_slots.emplace_back(max_storage_buffers);
+        createDescriptorSet();
+    }
+
+    VulkanBindlessHeap::~VulkanBindlessHeap() {
+        cleanup();
+    }
+
+    void VulkanBindlessHeap::createDescriptorSet() {
+        VkDevice vk_device = m_device->getDevice();
+
+        VkPhysicalDeviceVulkan12Properties properties_12{};
+        properties_12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+        VkPhysicalDeviceProperties2 properties_2{};
+        properties_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties_2.pNext = &properties_12;
+        vkGetPhysicalDeviceProperties2(m_device->getPhysicalDevice(), &properties_2);
+        if(getCapacity(ZERO_VK_BINDLESS_SAMPLED_IMAGE) > properties_12.maxPerStageDescriptorUpdateAfterBindSampledImages ||
+            getCapacity(ZERO_VK_BINDLESS_SAMPLER) > properties_12.maxPerStageDescriptorUpdateAfterBindSamplers ||
+            getCapacity(ZERO_VK_BINDLESS_STORAGE_BUFFER) > properties_12.maxPerStageDescriptorUpdateAfterBindStorageBuffers) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Bindless heap capacity exceeds the device update-after-bind limits.");
+        }
+
+        const VkDescriptorType descriptor_types[ZERO_VK_BINDLESS_TYPE_COUNT] = {
+            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            VK_DESCRIPTOR_TYPE_SAMPLER,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+        };
+        VkDescriptorSetLayoutBinding bindings[ZERO_VK_BINDLESS_TYPE_COUNT]{};
+        VkDescriptorBindingFlags binding_flags[ZERO_VK_BINDLESS_TYPE_COUNT]{};
+        VkDescriptorPoolSize pool_sizes[ZERO_VK_BINDLESS_TYPE_COUNT]{};
+        for(uint32_t i = 0; i < ZERO_VK_BINDLESS_TYPE_COUNT; ++i) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = descriptor_types[i];
+            bindings[i].descriptorCount = m_slots[i].getCapacity();
+            bindings[i].stageFlags = VK_SHADER_STAGE_ALL;
+            // slots are written while the set is bound, and unused slots are never accessed
+            binding_flags[i] = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+            pool_sizes[i].type = descriptor_types[i];
+            pool_sizes[i].descriptorCount = m_slots[i].getCapacity();
+        }
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info{};
+        binding_flags_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        binding_flags_info.bindingCount = ZERO_VK_BINDLESS_TYPE_COUNT;
+        binding_flags_info.pBindingFlags = binding_flags;
+        VkDescriptorSetLayoutCreateInfo layout_info{};
+        layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_info.pNext = &binding_flags_info;
+        layout_info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        layout_info.bindingCount = ZERO_VK_BINDLESS_TYPE_COUNT;
+        layout_info.pBindings = bindings;
+        ZERO_VK_CHECK_EXCEPT(vkCreateDescriptorSetLayout(vk_device, &layout_info, VulkanHostAllocator::getCallbacks(), &m_descriptor_set_layout));
+
+        VkDescriptorPoolCreateInfo pool_info{};
+        pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        pool_info.maxSets = 1;
+        pool_info.poolSizeCount = ZERO_VK_BINDLESS_TYPE_COUNT;
+        pool_info.pPoolSizes = pool_sizes;
+        ZERO_VK_CHECK_EXCEPT(vkCreateDescriptorPool(vk_device, &pool_info, VulkanHostAllocator::getCallbacks(), &m_descriptor_pool));
+
+        VkDescriptorSetAllocateInfo set_info{};
+        set_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        set_info.descriptorPool = m_descriptor_pool;
+        set_info.descriptorSetCount = 1;
+        set_info.pSetLayouts = &m_descriptor_set_layout;
+        ZERO_VK_CHECK_EXCEPT(vkAllocateDescriptorSets(vk_device, &set_info, &m_descriptor_set));
+
+        VkPushConstantRange push_constant_range{};
+        push_constant_range.stageFlags = VK_SHADER_STAGE_ALL;
+        push_constant_range.offset = 0;
+        push_constant_range.size = const_vk_bindless_push_constant_size;
+        VkPipelineLayoutCreateInfo pipeline_layout_info{};
+        pipeline_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipeline_layout_info.setLayoutCount = 1;
+        pipeline_layout_info.pSetLayouts = &m_descriptor_set_layout;
+        pipeline_layout_info.pushConstantRangeCount = 1;
+        pipeline_layout_info.pPushConstantRanges = &push_constant_range;
+        ZERO_VK_CHECK_EXCEPT(vkCreatePipelineLayout(vk_device, &pipeline_layout_info, VulkanHostAllocator::getCallbacks(), &m_pipeline_layout));
+    }
+
+    uint32_t VulkanBindlessHeap::allocateIndex(const VulkanBindlessType &type) {
+        uint32_t index = m_slots[type].allocate();
+        if(index == const_gpu_invalid_handle) {
+            // the GPU may have finished with released indices since the last flush
+            std::shared_ptr<VulkanTimelineSemaphore> timeline = m_device->getSubmissionTimeline().lock();
+            if(timeline) {
+                m_slots[type].collect(timeline->getCompletedValue());
+                index = m_slots[type].allocate();
+            }
+        }
+        if(index == const_gpu_invalid_handle) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Bindless array " + std::to_string(type) + " is full.");
+        }
+        m_statistics.allocated[type] = m_slots[type].countAllocated();
+        return index;
+    }
+
+    void VulkanBindlessHeap::queueWrite(const PendingWrite &write) {
+        m_pending_writes.push_back(write);
+        m_statistics.pending_writes = static_cast<uint32_t>(m_pending_writes.size());
+    }
+
+    uint32_t VulkanBindlessHeap::registerSampledImage(const VkImageView &image_view, const VkImageLayout &image_layout) {
+        PendingWrite write{};
+        write.type = ZERO_VK_BINDLESS_SAMPLED_IMAGE;
+        write.index = allocateIndex(write.type);
+        write.image_info.imageView = image_view;
+        write.image_info.imageLayout = image_layout;
+        queueWrite(write);
+        return write.index;
+    }
+
+    uint32_t VulkanBindlessHeap::registerSampler(const VkSampler &sampler) {
+        PendingWrite write{};
+        write.type = ZERO_VK_BINDLESS_SAMPLER;
+        write.index = allocateIndex(write.type);
+        write.image_info.sampler = sampler;
+        queueWrite(write);
+        return write.index;
+    }
+
+    uint32_t VulkanBindlessHeap::registerStorageBuffer(const VkBuffer &buffer, const VkDeviceSize &offset, const VkDeviceSize &range) {
+        PendingWrite write{};
+        write.type = ZERO_VK_BINDLESS_STORAGE_BUFFER;
+        write.index = allocateIndex(write.type);
+        write.buffer_info.buffer = buffer;
+        write.buffer_info.offset = offset;
+        write.buffer_info.range = range;
+        queueWrite(write);
+        return write.index;
+    }
+
+    void VulkanBindlessHeap::release(const VulkanBindlessType &type, const uint32_t &index) {
+        std::shared_ptr<VulkanTimelineSemaphore> timeline = m_device->getSubmissionTimeline().lock();
+        m_slots[type].release(index, timeline ? timeline->getSubmittedValue() : 0);
+        m_statistics.allocated[type] = m_slots[type].countAllocated();
+    }
+
+    void VulkanBindlessHeap::flush() {
+        std::shared_ptr<VulkanTimelineSemaphore> timeline = m_device->getSubmissionTimeline().lock();
+        if(timeline) {
+            uint64_t completed_value = timeline->getCompletedValue();
+            for(GPUSlotAllocator &slots : m_slots) {
+                slots.collect(completed_value);
+            }
+        }
+
+        if(!m_pending_writes.empty()) {
+            // reserved up front, the writes point into these arrays
+            m_image_infos.clear();
+            m_buffer_infos.clear();
+            m_writes.clear();
+            m_image_infos.reserve(m_pending_writes.size());
+            m_buffer_infos.reserve(m_pending_writes.size());
+            for(const PendingWrite &pending : m_pending_writes) {
+                VkWriteDescriptorSet write{};
+                write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                write.dstSet = m_descriptor_set;
+                write.dstBinding = pending.type;
+                write.dstArrayElement = pending.index;
+                write.descriptorCount = 1;
+                switch(pending.type) {
+                    case ZERO_VK_BINDLESS_SAMPLED_IMAGE:
+                        write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+                        m_image_infos.push_back(pending.image_info);
+                        write.pImageInfo = &m_image_infos.back();
+                        break;
+                    case ZERO_VK_BINDLESS_SAMPLER:
+                        write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+                        m_image_infos.push_back(pending.image_info);
+                        write.pImageInfo = &m_image_infos.back();
+                        break;
+                    default:
+                        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                        m_buffer_infos.push_back(pending.buffer_info);
+                        write.pBufferInfo = &m_buffer_infos.back();
+                        break;
+                }
+                m_writes.push_back(write);
+            }
+            vkUpdateDescriptorSets(m_device->getDevice(), static_cast<uint32_t>(m_writes.size()), m_writes.data(), 0, nullptr);
+            m_statistics.descriptor_writes += m_writes.size();
+            ++m_statistics.update_calls;
+            m_pending_writes.clear();
+            m_statistics.pending_writes = 0;
+        }
+
+        for(uint32_t i = 0; i < ZERO_VK_BINDLESS_TYPE_COUNT; ++i) {
+            m_statistics.allocated[i] = m_slots[i].countAllocated();
+        }
+    }
+
+    void VulkanBindlessHeap::bind(VkCommandBuffer command_buffer, const VkPipelineBindPoint &bind_point) {
+        vkCmdBindDescriptorSets(command_buffer, bind_point, m_pipeline_layout, 0, 1, &m_descriptor_set, 0, nullptr);
+    }
+
+    void VulkanBindlessHeap::pushConstants(VkCommandBuffer command_buffer, const void* data, const uint32_t &size, const uint32_t &offset) {
+        ZERO_ASSERT(offset + size <= const_vk_bindless_push_constant_size, "Push constants exceed the bindless range.");
+        vkCmdPushConstants(command_buffer, m_pipeline_layout, VK_SHADER_STAGE_ALL, offset, size, data);
+    }
+
+    VkDescriptorSetLayout VulkanBindlessHeap::getDescriptorSetLayout() const {
+        return m_descriptor_set_layout;
+    }
+
+    VkDescriptorSet VulkanBindlessHeap::getDescriptorSet() const {
+        return m_descriptor_set;
+    }
+
+    VkPipelineLayout VulkanBindlessHeap::getPipelineLayout() const {
+        return m_pipeline_layout;
+    }
+
+    uint32_t VulkanBindlessHeap::getCapacity(const VulkanBindlessType &type) const {
+        return m_slots[type].getCapacity();
+    }
+
+    const VulkanBindlessStatistics& VulkanBindlessHeap::getStatistics() const {
+        return m_statistics;
+    }
+
+    void VulkanBindlessHeap::cleanup() {
+        if(m_descriptor_pool == VK_NULL_HANDLE && m_pipeline_layout == VK_NULL_HANDLE) {
+            return;
+        }
+
+        std::shared_ptr<VulkanDeletionQueue> deletion_queue = m_device->getDeletionQueue().lock();
+        if(deletion_queue) {
+            deletion_queue->retirePipelineLayout(m_pipeline_layout);
+            deletion_queue->retireDescriptorPool(m_descriptor_pool);
+            deletion_queue->retireDescriptorSetLayout(m_descriptor_set_layout);
+        } else {
+            VkDevice vk_device = m_device->getDevice();
+            vkDestroyPipelineLayout(vk_device, m_pipeline_layout, VulkanHostAllocator::getCallbacks());
+            vkDestroyDescriptorPool(vk_device, m_descriptor_pool, VulkanHostAllocator::getCallbacks());
+            vkDestroyDescriptorSetLayout(vk_device, m_descriptor_set_layout, VulkanHostAllocator::getCallbacks());
+        }
+
+        m_pipeline_layout = VK_NULL_HANDLE;
+        m_descriptor_pool = VK_NULL_HANDLE;
+        m_descriptor_set_layout = VK_NULL_HANDLE;
+        m_descriptor_set = VK_NULL_HANDLE;
+        for(GPUSlotAllocator &slots : m_slots) {
+            slots.reset();
+        }
+        m_pending_writes.clear();
+        m_statistics = VulkanBindlessStatistics{};
+    }
+} // namespace ZEROengine
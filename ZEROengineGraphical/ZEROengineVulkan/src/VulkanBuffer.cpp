@@ -3,9 +3,19 @@
 #include "vk_mem_alloc.h"
 
 namespace ZEROengine {
-    VulkanBuffer::VulkanBuffer(const VmaAllocator &vma_alloc, const GPUBufferDescription &buffer_description) : GPUBuffer() {
+    VulkanBuffer::VulkanBuffer(
+        const VmaAllocator &vma_alloc, 
+        const GPUBufferDescription &buffer_description,
+        const std::weak_ptr<VulkanDeletionQueue> &deletion_queue
+    ) : GPUBuffer() {
         m_vma_alloc = vma_alloc;
+        m_allocation_info = VK_NULL_HANDLE;
         m_buffer_description = buffer_description;
+        m_buffer_handle = nullptr;
+        m_buffer_mapped = nullptr;
+        m_deletion_queue = deletion_queue;
+        m_last_use_value = const_vk_retire_on_last_submission;
+        m_write_generation = 0;
         allocate();
     }
 
@@ -14,7 +24,8 @@ namespace ZEROengine {
     }
     
     VkBufferUsageFlags VulkanBuffer::translateBufferUsage() {
-        return m_buffer_description.m_usage;
+        // the defragmenter moves buffers with a copy
+        return m_buffer_description.m_usage | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
     }
 
     void VulkanBuffer::allocate() {
@@ -26,9 +37,25 @@ namespace ZEROengine {
         buffer_info.queueFamilyIndexCount = 0;
         buffer_info.usage = translateBufferUsage();
 
+        // MAPPED_BIT only maps memory the host can see, VMA picks it from the host access flags
         VmaAllocationCreateInfo alloc_info{};
-        alloc_info.usage = VMA_MEMORY_USAGE_AUTO;
-        alloc_info.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        switch(m_buffer_description.access) {
+        case ZERO_BUFFER_ACCESS_STATIC:
+            // device local, mapped only when the host can see it (resizable BAR, integrated GPUs)
+            alloc_info.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+            alloc_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+            break;
+        case ZERO_BUFFER_ACCESS_DYNAMIC:
+            // write-combined, written with memcpy and never read back
+            alloc_info.usage = VMA_MEMORY_USAGE_AUTO;
+            alloc_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+            break;
+        case ZERO_BUFFER_ACCESS_READBACK:
+            // cached host memory, reading write-combined memory is very slow
+            alloc_info.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+            alloc_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+            break;
+        }
         
         VmaAllocationInfo alloc_ret_info;
         VkBuffer buffer_handle = VK_NULL_HANDLE;
@@ -39,6 +66,7 @@ namespace ZEROengine {
             &buffer_handle,      // VkBuffer
             &m_allocation_info,  // VmaAllocation
             &alloc_ret_info));   // VmaAllocationInfo
+        m_buffer_handle = static_cast<void*>(buffer_handle);
         m_buffer_mapped = alloc_ret_info.pMappedData;
     }
 
@@ -53,10 +81,65 @@ namespace ZEROengine {
     uint64_t VulkanBuffer::getElementsCount() const {
         return m_buffer_description.elements_count;
     }
+
+    std::weak_ptr<GPUSyncPrimitive> VulkanBuffer::getResourceReadySync() {
+        return m_sync_resource_ready;
+    }
+
+    std::weak_ptr<GPUSyncPrimitive> VulkanBuffer::getResourceWorkDoneSync() {
+        return m_sync_resource_work_done;
+    }
+
+    VkBuffer VulkanBuffer::getVkBuffer() const {
+        return static_cast<VkBuffer>(m_buffer_handle);
+    }
+
+    void VulkanBuffer::flush(const uint64_t &offset, const uint64_t &size) {
+        ZERO_VK_CHECK_EXCEPT(vmaFlushAllocation(m_vma_alloc, m_allocation_info, offset, size));
+    }
+
+    void VulkanBuffer::invalidate(const uint64_t &offset, const uint64_t &size) {
+        ZERO_VK_CHECK_EXCEPT(vmaInvalidateAllocation(m_vma_alloc, m_allocation_info, offset, size));
+    }
+
+    VmaAllocation VulkanBuffer::getAllocation() const {
+        return m_allocation_info;
+    }
+
+    VkBuffer VulkanBuffer::rebind(const VkBuffer &buffer) {
+        VkBuffer old_buffer = static_cast<VkBuffer>(m_buffer_handle);
+        m_buffer_handle = static_cast<void*>(buffer);
+        return old_buffer;
+    }
+
+    std::mutex& VulkanBuffer::getMoveMutex() {
+        return m_move_mutex;
+    }
+
+    void VulkanBuffer::markWritten() {
+        ++m_write_generation;
+    }
+
+    uint64_t VulkanBuffer::getWriteGeneration() const {
+        return m_write_generation;
+    }
+
+    void VulkanBuffer::markUsed(const uint64_t &submission_value) {
+        m_last_use_value = submission_value;
+    }
         
     void VulkanBuffer::cleanup() {
+        if(m_buffer_handle == nullptr) {
+            return;
+        }
         VkBuffer buffer_handle = static_cast<VkBuffer>(m_buffer_handle);
-        vmaDestroyBuffer(m_vma_alloc, buffer_handle, m_allocation_info);
+        std::shared_ptr<VulkanDeletionQueue> deletion_queue = m_deletion_queue.lock();
+        if(deletion_queue) {
+            deletion_queue->retireBuffer(buffer_handle, m_allocation_info, m_last_use_value);
+        } else {
+            vmaDestroyBuffer(m_vma_alloc, buffer_handle, m_allocation_info);
+        }
+        m_allocation_info = VK_NULL_HANDLE;
         GPUBuffer::cleanup();
     }
-} //namespace ZEROengine
\ No newline at end of file
+} //namespace ZEROengine
@@ -1,24 +1,114 @@
 #include "zeroengine_vulkan/VulkanCommandBuffer.hpp"
+#include "zeroengine_vulkan/VulkanDevice.hpp"
+#include "zeroengine_vulkan/VulkanPipelineManager.hpp"
+#include "zeroengine_vulkan/VulkanDefines.hpp"
 
 namespace ZEROengine {
-    // void VulkanCommandBuffer::init() {
+    VulkanCommandBuffer::VulkanCommandBuffer(const VkCommandBuffer &api_handle, const VkCommandBufferLevel &level, VulkanDevice* vulkan_device) :
+    m_api_handle{api_handle},
+    m_level{level},
+    m_vulkan_device{vulkan_device}
+    {}
 
-    // }
+    void VulkanCommandBuffer::init() {
+        if(m_api_handle == VK_NULL_HANDLE) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_NULL_POINTER, "Vulkan command buffer handle is null.");
+        }
+    }
 
-    // void VulkanCommandBuffer::cleanup() {
+    void VulkanCommandBuffer::cleanup() {
+        // the handle is freed with the pool of its context
+        m_api_handle = VK_NULL_HANDLE;
+    }
 
-    // }
+    // the parameterless commands carry no state to translate, record through GPUCommandStream instead
+    void VulkanCommandBuffer::bindVertex() {
+    }
     
+    void VulkanCommandBuffer::bindPipeline() {
+    }
+    
+    void VulkanCommandBuffer::draw() {
+    }
 
-    // void VulkanCommandBuffer::bindVertex() {
+    void VulkanCommandBuffer::execute(const GPUCommandStream &stream) {
+        std::shared_ptr<VulkanPipelineManager> pipeline_manager = m_vulkan_device->getPipelineManager().lock();
+        VkPipelineLayout bound_layout = VK_NULL_HANDLE;
 
-    // }
-    
-    // void VulkanCommandBuffer::bindPipeline() {
+        GPUCommandStreamReader reader(stream);
+        const GPUCommandHeader *header = nullptr;
+        while(reader.next(header)) {
+            switch(header->type) {
+            case ZERO_COMMAND_BIND_PIPELINE: {
+                const GPUCommandBindPipeline *command = reinterpret_cast<const GPUCommandBindPipeline*>(header);
+                const VulkanPipelineObject &pipeline = pipeline_manager->resolvePipeline(command->pipeline);
+                vkCmdBindPipeline(m_api_handle, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.vk_pipeline);
+                bound_layout = pipeline.vk_pipeline_layout;
+                break;
+            }
+            case ZERO_COMMAND_BIND_DESCRIPTOR_SET: {
+                const GPUCommandBindDescriptorSet *command = reinterpret_cast<const GPUCommandBindDescriptorSet*>(header);
+                if(bound_layout == VK_NULL_HANDLE) {
+                    ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Descriptor set bound before any pipeline in command stream.");
+                }
+                VkDescriptorSet descriptor_set = m_vulkan_device->resolveDescriptorSet(command->descriptor_set);
+                vkCmdBindDescriptorSets(m_api_handle, VK_PIPELINE_BIND_POINT_GRAPHICS, bound_layout, command->set, 1, &descriptor_set, 0, nullptr);
+                break;
+            }
+            case ZERO_COMMAND_BIND_VERTEX_BUFFER: {
+                const GPUCommandBindVertexBuffer *command = reinterpret_cast<const GPUCommandBindVertexBuffer*>(header);
+                VkBuffer buffer = m_vulkan_device->resolveBuffer(command->buffer);
+                VkDeviceSize offset = command->offset;
+                vkCmdBindVertexBuffers(m_api_handle, command->binding, 1, &buffer, &offset);
+                break;
+            }
+            case ZERO_COMMAND_BIND_INDEX_BUFFER: {
+                const GPUCommandBindIndexBuffer *command = reinterpret_cast<const GPUCommandBindIndexBuffer*>(header);
+                VkIndexType index_type = command->index_type == ZERO_INDEX_TYPE_UINT16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+                vkCmdBindIndexBuffer(m_api_handle, m_vulkan_device->resolveBuffer(command->buffer), command->offset, index_type);
+                break;
+            }
+            case ZERO_COMMAND_SET_VIEWPORT: {
+                const GPUCommandSetViewport *command = reinterpret_cast<const GPUCommandSetViewport*>(header);
+                VkViewport viewport{};
+                viewport.x = command->x;
+                viewport.y = command->y;
+                viewport.width = command->width;
+                viewport.height = command->height;
+                viewport.minDepth = command->min_depth;
+                viewport.maxDepth = command->max_depth;
+                vkCmdSetViewport(m_api_handle, 0, 1, &viewport);
+                break;
+            }
+            case ZERO_COMMAND_SET_SCISSOR: {
+                const GPUCommandSetScissor *command = reinterpret_cast<const GPUCommandSetScissor*>(header);
+                VkRect2D scissor{};
+                scissor.offset = { command->x, command->y };
+                scissor.extent = { command->width, command->height };
+                vkCmdSetScissor(m_api_handle, 0, 1, &scissor);
+                break;
+            }
+            case ZERO_COMMAND_DRAW: {
+                const GPUCommandDraw *command = reinterpret_cast<const GPUCommandDraw*>(header);
+                vkCmdDraw(m_api_handle, command->vertex_count, command->instance_count, command->first_vertex, command->first_instance);
+                break;
+            }
+            case ZERO_COMMAND_DRAW_INDEXED: {
+                const GPUCommandDrawIndexed *command = reinterpret_cast<const GPUCommandDrawIndexed*>(header);
+                vkCmdDrawIndexed(m_api_handle, command->index_count, command->instance_count, command->first_index, command->vertex_offset, command->first_instance);
+                break;
+            }
+            default:
+                ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Unknown command type " + std::to_string(header->type) + " in command stream.");
+            }
+        }
+    }
 
-    // }
-    
-    // void VulkanCommandBuffer::draw() {
+    VkCommandBuffer VulkanCommandBuffer::getVkCommandBuffer() const {
+        return m_api_handle;
+    }
 
-    // }
-} // namespace ZEROengine
\ No newline at end of file
+    VkCommandBufferLevel VulkanCommandBuffer::getLevel() const {
+        return m_level;
+    }
+} // namespace ZEROengine
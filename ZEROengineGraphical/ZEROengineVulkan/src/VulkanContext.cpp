@@ -1,16 +1,23 @@
 #include <memory>
 #include <cstdint>
+#include <algorithm>
 
 #include "vulkan/vulkan.hpp"
 #include "zeroengine_vulkan/VulkanContext.hpp"
+#include "zeroengine_vulkan/VulkanDevice.hpp"
 #include "zeroengine_vulkan/VulkanDefines.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
 
 namespace ZEROengine {
-    VulkanGraphicalContext::VulkanGraphicalContext(const VkDevice &vk_device, const uint32_t &queue_family) : 
+    VulkanGraphicalContext::VulkanGraphicalContext(VulkanDevice* vulkan_device, const uint32_t &queue_family) : 
         m_primary_command_buffer{},
         m_primary_command_pool{},
-        m_vk_device{vk_device},
-        m_queue_family{queue_family}
+        m_vk_device{vulkan_device->getDevice()},
+        m_vulkan_device{vulkan_device},
+        m_queue_family{queue_family},
+        m_vulkan_command_buffers{},
+        m_is_recording{false},
+        m_submission_value{0}
     {
         init();
     }
@@ -19,35 +26,113 @@ namespace ZEROengine {
         VkCommandPoolCreateInfo pool_create_info{};
         pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
         pool_create_info.pNext = nullptr;
+        pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
         pool_create_info.queueFamilyIndex = m_queue_family;
-        ZERO_VK_CHECK_EXCEPT(vkCreateCommandPool(m_vk_device, &pool_create_info, nullptr, &m_primary_command_pool));
+        ZERO_VK_CHECK_EXCEPT(vkCreateCommandPool(m_vk_device, &pool_create_info, VulkanHostAllocator::getCallbacks(), &m_primary_command_pool));
 
+        m_primary_command_buffer = allocateVkCommandBuffer();
+        std::shared_ptr<VulkanCommandBuffer> primary = std::make_shared<VulkanCommandBuffer>(m_primary_command_buffer, VK_COMMAND_BUFFER_LEVEL_PRIMARY, m_vulkan_device);
+        primary->init();
+        m_vulkan_command_buffers.push_back(primary);
+    }
+
+    VkCommandBuffer VulkanGraphicalContext::allocateVkCommandBuffer() {
         VkCommandBufferAllocateInfo primary_cmd_buffer_allocation{};
         primary_cmd_buffer_allocation.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         primary_cmd_buffer_allocation.pNext = nullptr;
-        ZERO_VK_CHECK_EXCEPT(vkAllocateCommandBuffers(m_vk_device, &primary_cmd_buffer_allocation, &m_primary_command_buffer));
+        primary_cmd_buffer_allocation.commandPool = m_primary_command_pool;
+        primary_cmd_buffer_allocation.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        primary_cmd_buffer_allocation.commandBufferCount = 1;
+        VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+        ZERO_VK_CHECK_EXCEPT(vkAllocateCommandBuffers(m_vk_device, &primary_cmd_buffer_allocation, &command_buffer));
+        return command_buffer;
     }
 
-    // std::weak_ptr<GraphicalCommandBuffer> VulkanGraphicalContext::allocateCommandBuffer() {
-
-    // }
+    std::weak_ptr<GraphicalCommandBuffer> VulkanGraphicalContext::allocateCommandBuffer() {
+        ZERO_ASSERT(!m_is_recording, "Cannot allocate command buffers while recording.");
+        std::shared_ptr<VulkanCommandBuffer> command_buffer = std::make_shared<VulkanCommandBuffer>(allocateVkCommandBuffer(), VK_COMMAND_BUFFER_LEVEL_PRIMARY, m_vulkan_device);
+        command_buffer->init();
+        m_vulkan_command_buffers.push_back(command_buffer);
+        return command_buffer;
+    }
 
-    // std::weak_ptr<GraphicalCommandBuffer> VulkanGraphicalContext::getCommandBuffer() {
-        
-    // }
+    std::weak_ptr<GraphicalCommandBuffer> VulkanGraphicalContext::getCommandBuffer() {
+        return m_vulkan_command_buffers.back();
+    }
 
-    // size_t VulkanGraphicalContext::countCommandBuffers() const {
-        
-    // }
+    size_t VulkanGraphicalContext::countCommandBuffers() const {
+        return m_vulkan_command_buffers.size();
+    }
     
     void VulkanGraphicalContext::beginRecording() {
+        ZERO_ASSERT(!m_is_recording, "Context is already recording.");
+        // resetting the pool while the GPU still executes its command buffers is undefined
+        waitForSubmission();
+        ZERO_VK_CHECK_EXCEPT(vkResetCommandPool(m_vk_device, m_primary_command_pool, 0));
+
+        VkCommandBufferBeginInfo begin_info{};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.pNext = nullptr;
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        begin_info.pInheritanceInfo = nullptr;
+        for(std::shared_ptr<VulkanCommandBuffer> &command_buffer : m_vulkan_command_buffers) {
+            ZERO_VK_CHECK_EXCEPT(vkBeginCommandBuffer(command_buffer->getVkCommandBuffer(), &begin_info));
+        }
+        m_is_recording = true;
     }
 
-    // void VulkanGraphicalContext::endRecording() {
-        
-    // }
-    
-    // void VulkanGraphicalContext::cleanup() {
+    void VulkanGraphicalContext::endRecording() {
+        ZERO_ASSERT(m_is_recording, "Context is not recording.");
+        for(std::shared_ptr<VulkanCommandBuffer> &command_buffer : m_vulkan_command_buffers) {
+            ZERO_VK_CHECK_EXCEPT(vkEndCommandBuffer(command_buffer->getVkCommandBuffer()));
+        }
+        m_is_recording = false;
+    }
+
+    uint64_t VulkanGraphicalContext::submit() {
+        ZERO_ASSERT(!m_is_recording, "Context must end recording before it is submitted.");
+        for(std::shared_ptr<VulkanCommandBuffer> &command_buffer : m_vulkan_command_buffers) {
+            m_submission_value = m_vulkan_device->submitCommandBuffer(command_buffer->getVkCommandBuffer());
+        }
+        return m_submission_value;
+    }
+
+    void VulkanGraphicalContext::markSubmitted(const uint64_t &submission_value) {
+        ZERO_ASSERT(!m_is_recording, "Context must end recording before it is submitted.");
+        m_submission_value = std::max(m_submission_value, submission_value);
+    }
+
+    void VulkanGraphicalContext::waitForSubmission() {
+        if(m_submission_value == 0) {
+            return;
+        }
+        std::shared_ptr<VulkanTimelineSemaphore> submission_timeline = m_vulkan_device->getSubmissionTimeline().lock();
+        ZERO_ASSERT(submission_timeline, "Context outlived the submission timeline of its device.");
+        submission_timeline->wait(m_submission_value);
+        m_submission_value = 0;
+    }
 
-    // }
-} // namespace ZEROengine
\ No newline at end of file
+    VkCommandBuffer VulkanGraphicalContext::getPrimaryCommandBuffer() const {
+        return m_primary_command_buffer;
+    }
+
+    uint32_t VulkanGraphicalContext::getQueueFamily() const {
+        return m_queue_family;
+    }
+    
+    void VulkanGraphicalContext::cleanup() {
+        if(m_primary_command_pool != VK_NULL_HANDLE) {
+            waitForSubmission();
+        }
+        for(std::shared_ptr<VulkanCommandBuffer> &command_buffer : m_vulkan_command_buffers) {
+            command_buffer->cleanup();
+        }
+        m_vulkan_command_buffers.clear();
+        // destroying the pool frees its command buffers
+        if(m_primary_command_pool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(m_vk_device, m_primary_command_pool, VulkanHostAllocator::getCallbacks());
+            m_primary_command_pool = VK_NULL_HANDLE;
+        }
+        m_primary_command_buffer = VK_NULL_HANDLE;
+    }
+} // namespace ZEROengine
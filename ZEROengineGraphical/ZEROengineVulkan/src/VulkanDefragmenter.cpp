@@ -0,0 +1,311 @@
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#include "zeroengine_vulkan/VulkanDefragmenter.hpp"
+#include "zeroengine_vulkan/VulkanDevice.hpp"
+#include "zeroengine_vulkan/VulkanResource.hpp"
+#include "zeroengine_vulkan/VulkanDefines.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
+
+namespace ZEROengine {
+    VulkanDefragmenter::VulkanDefragmenter(VulkanDevice* device) :
+    m_device{device},
+    m_command_pool{VK_NULL_HANDLE},
+    m_command_buffer{VK_NULL_HANDLE},
+    m_context{VK_NULL_HANDLE},
+    m_pass{},
+    m_state{IDLE},
+    m_wait_value{0},
+    m_requested{false},
+    m_moves{},
+    m_old_buffers{},
+    m_rebind{},
+    m_statistics{}
+    {
+        // copies go through the graphics queue, the only one the device creates, so buffers never change queue family
+        VulkanQueueInfo queue_info{};
+        std::shared_ptr<VulkanQueueManager> queue_manager = m_device->getQueueManager().lock();
+        if(!queue_manager || !queue_manager->getQueueInfo(VK_QUEUE_GRAPHICS_BIT, queue_info)) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Queue manager cannot find a graphical queue.");
+        }
+
+        VkCommandPoolCreateInfo pool_create_info{};
+        pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        pool_create_info.pNext = nullptr;
+        pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        pool_create_info.queueFamilyIndex = queue_info.queueFamilyIndex;
+        ZERO_VK_CHECK_EXCEPT(vkCreateCommandPool(m_device->getDevice(), &pool_create_info, VulkanHostAllocator::getCallbacks(), &m_command_pool));
+
+        VkCommandBufferAllocateInfo command_buffer_allocation{};
+        command_buffer_allocation.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        command_buffer_allocation.pNext = nullptr;
+        command_buffer_allocation.commandPool = m_command_pool;
+        command_buffer_allocation.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        command_buffer_allocation.commandBufferCount = 1;
+        ZERO_VK_CHECK_EXCEPT(vkAllocateCommandBuffers(m_device->getDevice(), &command_buffer_allocation, &m_command_buffer));
+    }
+
+    VulkanDefragmenter::~VulkanDefragmenter() {
+        cleanup();
+    }
+
+    void VulkanDefragmenter::request() {
+        m_requested = true;
+    }
+
+    bool VulkanDefragmenter::shouldStart() const {
+        if(m_requested) {
+            return true;
+        }
+        // the heap budgets refreshed this frame already hold the VMA block and allocation sizes
+        uint64_t block_bytes = 0;
+        uint64_t allocation_bytes = 0;
+        for(const VulkanHeapBudget &heap_budget : m_device->getHeapBudgets()) {
+            block_bytes += heap_budget.block_bytes;
+            allocation_bytes += heap_budget.allocation_bytes;
+        }
+        if(block_bytes < const_vk_defragmentation_min_block_bytes) {
+            return false;
+        }
+        uint64_t unused_bytes = block_bytes - allocation_bytes;
+        return static_cast<double>(unused_bytes) > static_cast<double>(block_bytes) * const_vk_defragmentation_threshold;
+    }
+
+    void VulkanDefragmenter::start() {
+        VmaDefragmentationInfo defragmentation_info{};
+        defragmentation_info.flags = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_BALANCED_BIT;
+        defragmentation_info.pool = VK_NULL_HANDLE; // default pools
+        defragmentation_info.maxBytesPerPass = const_vk_defragmentation_bytes_per_pass;
+        defragmentation_info.maxAllocationsPerPass = const_vk_defragmentation_moves_per_pass;
+        ZERO_VK_CHECK_EXCEPT(vmaBeginDefragmentation(m_device->getAllocator(), &defragmentation_info, &m_context));
+        m_requested = false;
+        ++m_statistics.runs;
+    }
+
+    void VulkanDefragmenter::finish() {
+        VmaDefragmentationStats defragmentation_stats{};
+        vmaEndDefragmentation(m_device->getAllocator(), m_context, &defragmentation_stats);
+        m_context = VK_NULL_HANDLE;
+        m_statistics.bytes_moved += defragmentation_stats.bytesMoved;
+        m_statistics.bytes_freed += defragmentation_stats.bytesFreed;
+        m_statistics.blocks_freed += defragmentation_stats.deviceMemoryBlocksFreed;
+    }
+
+    std::shared_ptr<VulkanBuffer> VulkanDefragmenter::findMovableBuffer(const VmaAllocation &allocation) const {
+        VmaAllocationInfo allocation_info{};
+        vmaGetAllocationInfo(m_device->getAllocator(), allocation, &allocation_info);
+        if(allocation_info.pUserData == nullptr) {
+            return nullptr;
+        }
+        GPUBufferHandle buffer_handle = static_cast<GPUBufferHandle>(reinterpret_cast<uintptr_t>(allocation_info.pUserData) - 1);
+        std::shared_ptr<VulkanBuffer> buffer = m_device->findBuffer(buffer_handle);
+        // the handle may have been recycled by another buffer since
+        if(!buffer || buffer->getAllocation() != allocation) {
+            return nullptr;
+        }
+        // the host may write mapped memory at any time, and storage buffers may be written by the GPU after the copy
+        VkMemoryPropertyFlags memory_properties = 0;
+        vmaGetAllocationMemoryProperties(m_device->getAllocator(), allocation, &memory_properties);
+        if((memory_properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) || (buffer->translateBufferUsage() & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)) {
+            return nullptr;
+        }
+        return buffer;
+    }
+
+    void VulkanDefragmenter::beginPass() {
+        VkResult result = vmaBeginDefragmentationPass(m_device->getAllocator(), m_context, &m_pass);
+        if(result == VK_SUCCESS) {
+            finish(); // nothing left to move
+            return;
+        }
+        if(result != VK_INCOMPLETE) {
+            ZERO_VK_CHECK_EXCEPT(result);
+        }
+        // allocations taking part in the pass must outlive it
+        std::shared_ptr<VulkanDeletionQueue> deletion_queue = m_device->getDeletionQueue().lock();
+        if(deletion_queue) {
+            deletion_queue->holdAllocations(true);
+        }
+
+        VkDevice vk_device = m_device->getDevice();
+        m_moves.clear();
+        for(uint32_t i = 0; i < m_pass.moveCount; ++i) {
+            VmaDefragmentationMove &move = m_pass.pMoves[i];
+            std::shared_ptr<VulkanBuffer> buffer = findMovableBuffer(move.srcAllocation);
+            if(!buffer) {
+                move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                ++m_statistics.ignored_moves;
+                continue;
+            }
+            VkBufferCreateInfo buffer_info{};
+            buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            buffer_info.size = buffer->getSize();
+            buffer_info.usage = buffer->translateBufferUsage();
+            buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            VkBuffer new_buffer = VK_NULL_HANDLE;
+            ZERO_VK_CHECK_EXCEPT(vkCreateBuffer(vk_device, &buffer_info, VulkanHostAllocator::getCallbacks(), &new_buffer));
+            ZERO_VK_CHECK_EXCEPT(vmaBindBufferMemory(m_device->getAllocator(), move.dstTmpAllocation, new_buffer));
+            uint64_t write_generation = 0;
+            {
+                std::lock_guard<std::mutex> lock(buffer->getMoveMutex());
+                write_generation = buffer->getWriteGeneration();
+            }
+            m_moves.push_back({std::move(buffer), new_buffer, i, write_generation});
+        }
+        if(m_moves.empty()) {
+            endPass();
+            return;
+        }
+
+        ZERO_VK_CHECK_EXCEPT(vkResetCommandBuffer(m_command_buffer, 0));
+        VkCommandBufferBeginInfo begin_info{};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        ZERO_VK_CHECK_EXCEPT(vkBeginCommandBuffer(m_command_buffer, &begin_info));
+        // earlier submissions on the queue may still write the moved buffers
+        VkMemoryBarrier write_barrier{};
+        write_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        write_barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        write_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(m_command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &write_barrier, 0, nullptr, 0, nullptr);
+        for(const Move &move : m_moves) {
+            VkBufferCopy region{};
+            region.srcOffset = 0;
+            region.dstOffset = 0;
+            region.size = move.buffer->getSize();
+            vkCmdCopyBuffer(m_command_buffer, move.buffer->getVkBuffer(), move.new_buffer, 1, &region);
+        }
+        // later submissions on the queue read the new buffers
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        vkCmdPipelineBarrier(m_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        ZERO_VK_CHECK_EXCEPT(vkEndCommandBuffer(m_command_buffer));
+
+        m_wait_value = m_device->submitCommandBuffer(m_command_buffer);
+        m_state = COPYING;
+        m_statistics.moves += m_moves.size();
+    }
+
+    void VulkanDefragmenter::endPass() {
+        VkDevice vk_device = m_device->getDevice();
+        for(const VkBuffer &old_buffer : m_old_buffers) {
+            vkDestroyBuffer(vk_device, old_buffer, VulkanHostAllocator::getCallbacks());
+        }
+        m_old_buffers.clear();
+
+        // frees the old memory, the moved allocations now point to their new place
+        VkResult result = vmaEndDefragmentationPass(m_device->getAllocator(), m_context, &m_pass);
+        m_moves.clear();
+        std::shared_ptr<VulkanDeletionQueue> deletion_queue = m_device->getDeletionQueue().lock();
+        if(deletion_queue) {
+            deletion_queue->holdAllocations(false);
+        }
+        m_state = IDLE;
+        ++m_statistics.passes;
+        if(result == VK_SUCCESS) {
+            finish();
+        }
+    }
+
+    void VulkanDefragmenter::update() {
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+        std::shared_ptr<VulkanTimelineSemaphore> timeline = m_device->getSubmissionTimeline().lock();
+        switch(m_state) {
+        case IDLE:
+            if(m_context == VK_NULL_HANDLE) {
+                if(!shouldStart()) {
+                    return;
+                }
+                start();
+            }
+            beginPass();
+            break;
+        case COPYING:
+            if(timeline->getCompletedValue() < m_wait_value) {
+                break;
+            }
+            // handles resolve to the new buffers from now on, frames already submitted keep using the old ones
+            for(const Move &move : m_moves) {
+                std::unique_lock<std::mutex> lock(move.buffer->getMoveMutex());
+                if(move.buffer->getWriteGeneration() != move.write_generation) {
+                    // written after the copy was recorded, the new buffer would miss the write
+                    lock.unlock();
+                    m_pass.pMoves[move.pass_move].operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                    vkDestroyBuffer(m_device->getDevice(), move.new_buffer, VulkanHostAllocator::getCallbacks());
+                    --m_statistics.moves;
+                    ++m_statistics.ignored_moves;
+                    continue;
+                }
+                VkBuffer old_buffer = move.buffer->rebind(move.new_buffer);
+                lock.unlock();
+                m_old_buffers.push_back(old_buffer);
+                if(m_rebind) {
+                    m_rebind(*move.buffer, old_buffer);
+                }
+            }
+            m_wait_value = timeline->getSubmittedValue();
+            m_state = RELEASING;
+            break;
+        case RELEASING:
+            if(timeline->getCompletedValue() < m_wait_value) {
+                break;
+            }
+            endPass();
+            break;
+        }
+        m_statistics.cpu_milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+    }
+
+    void VulkanDefragmenter::stop() {
+        if(m_context == VK_NULL_HANDLE) {
+            return;
+        }
+        std::shared_ptr<VulkanTimelineSemaphore> timeline = m_device->getSubmissionTimeline().lock();
+        if(m_state == COPYING) {
+            // the copies are dropped, the buffers stay where they are
+            timeline->wait(m_wait_value);
+            VkDevice vk_device = m_device->getDevice();
+            for(uint32_t i = 0; i < m_pass.moveCount; ++i) {
+                m_pass.pMoves[i].operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+            }
+            for(const Move &move : m_moves) {
+                vkDestroyBuffer(vk_device, move.new_buffer, VulkanHostAllocator::getCallbacks());
+            }
+            m_moves.clear();
+        } else if(m_state == RELEASING) {
+            timeline->wait(m_wait_value);
+        }
+        if(m_state != IDLE) {
+            endPass();
+        }
+        if(m_context != VK_NULL_HANDLE) {
+            finish();
+        }
+        m_requested = false;
+    }
+
+    bool VulkanDefragmenter::isActive() const {
+        return m_context != VK_NULL_HANDLE;
+    }
+
+    void VulkanDefragmenter::setRebindCallback(const VulkanDefragmentationRebind &rebind) {
+        m_rebind = rebind;
+    }
+
+    const VulkanDefragmentationStatistics& VulkanDefragmenter::getStatistics() const {
+        return m_statistics;
+    }
+
+    void VulkanDefragmenter::cleanup() {
+        if(m_command_pool == VK_NULL_HANDLE) {
+            return;
+        }
+        stop();
+        vkDestroyCommandPool(m_device->getDevice(), m_command_pool, VulkanHostAllocator::getCallbacks());
+        m_command_pool = VK_NULL_HANDLE;
+        m_command_buffer = VK_NULL_HANDLE;
+    }
+} // namespace ZEROengine
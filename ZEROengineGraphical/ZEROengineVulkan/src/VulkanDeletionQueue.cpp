@@ -0,0 +1,198 @@
+#include "zeroengine_vulkan/VulkanDeletionQueue.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
+#include "zeroengine_vulkan/VulkanDefines.hpp"
+
+namespace ZEROengine {
+    VulkanDeletionQueue::VulkanDeletionQueue(
+        const VkDevice &vk_device,
+        const VmaAllocator &vma_alloc,
+        const std::shared_ptr<VulkanTimelineSemaphore> &submission_timeline
+    ) :
+    m_vk_device{vk_device},
+    m_vma_alloc{vma_alloc},
+    m_submission_timeline{submission_timeline},
+    m_mutex{},
+    m_retired{},
+    m_hold_allocations{false}
+    {}
+
+    void VulkanDeletionQueue::retire(VulkanRetiredObject object, const uint64_t &last_use_value) {
+        if(last_use_value == const_vk_retire_on_last_submission) {
+            object.retire_value = m_submission_timeline ? m_submission_timeline->getSubmittedValue() : 0;
+        } else {
+            object.retire_value = last_use_value;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_retired.push_back(object);
+    }
+
+    void VulkanDeletionQueue::retireBuffer(const VkBuffer &buffer, const VmaAllocation &allocation, const uint64_t &last_use_value) {
+        VulkanRetiredObject object{};
+        object.type = ZERO_VK_RETIRED_BUFFER;
+        object.handle.buffer = buffer;
+        object.allocation = allocation;
+        retire(object, last_use_value);
+    }
+
+    void VulkanDeletionQueue::retireImage(const VkImage &image, const VmaAllocation &allocation, const uint64_t &last_use_value) {
+        VulkanRetiredObject object{};
+        object.type = ZERO_VK_RETIRED_IMAGE;
+        object.handle.image = image;
+        object.allocation = allocation;
+        retire(object, last_use_value);
+    }
+
+    void VulkanDeletionQueue::retireImageView(const VkImageView &image_view, const uint64_t &last_use_value) {
+        VulkanRetiredObject object{};
+        object.type = ZERO_VK_RETIRED_IMAGE_VIEW;
+        object.handle.image_view = image_view;
+        retire(object, last_use_value);
+    }
+
+    void VulkanDeletionQueue::retirePipeline(const VkPipeline &pipeline, const uint64_t &last_use_value) {
+        VulkanRetiredObject object{};
+        object.type = ZERO_VK_RETIRED_PIPELINE;
+        object.handle.pipeline = pipeline;
+        retire(object, last_use_value);
+    }
+
+    void VulkanDeletionQueue::retirePipelineLayout(const VkPipelineLayout &pipeline_layout, const uint64_t &last_use_value) {
+        VulkanRetiredObject object{};
+        object.type = ZERO_VK_RETIRED_PIPELINE_LAYOUT;
+        object.handle.pipeline_layout = pipeline_layout;
+        retire(object, last_use_value);
+    }
+
+    void VulkanDeletionQueue::retireFramebuffer(const VkFramebuffer &framebuffer, const uint64_t &last_use_value) {
+        VulkanRetiredObject object{};
+        object.type = ZERO_VK_RETIRED_FRAMEBUFFER;
+        object.handle.framebuffer = framebuffer;
+        retire(object, last_use_value);
+    }
+
+    void VulkanDeletionQueue::retireRenderPass(const VkRenderPass &render_pass, const uint64_t &last_use_value) {
+        VulkanRetiredObject object{};
+        object.type = ZERO_VK_RETIRED_RENDER_PASS;
+        object.handle.render_pass = render_pass;
+        retire(object, last_use_value);
+    }
+
+    void VulkanDeletionQueue::retireDescriptorPool(const VkDescriptorPool &descriptor_pool, const uint64_t &last_use_value) {
+        VulkanRetiredObject object{};
+        object.type = ZERO_VK_RETIRED_DESCRIPTOR_POOL;
+        object.handle.descriptor_pool = descriptor_pool;
+        retire(object, last_use_value);
+    }
+
+    void VulkanDeletionQueue::retireDescriptorSetLayout(const VkDescriptorSetLayout &descriptor_set_layout, const uint64_t &last_use_value) {
+        VulkanRetiredObject object{};
+        object.type = ZERO_VK_RETIRED_DESCRIPTOR_SET_LAYOUT;
+        object.handle.descriptor_set_layout = descriptor_set_layout;
+        retire(object, last_use_value);
+    }
+
+    void VulkanDeletionQueue::retireSwapchain(const VkSwapchainKHR &swapchain, const uint64_t &last_use_value) {
+        VulkanRetiredObject object{};
+        object.type = ZERO_VK_RETIRED_SWAPCHAIN;
+        object.handle.swapchain = swapchain;
+        retire(object, last_use_value);
+    }
+
+    void VulkanDeletionQueue::retireAllocation(const VmaAllocation &allocation, const uint64_t &last_use_value) {
+        VulkanRetiredObject object{};
+        object.type = ZERO_VK_RETIRED_ALLOCATION;
+        object.allocation = allocation;
+        retire(object, last_use_value);
+    }
+
+    void VulkanDeletionQueue::destroy(const VulkanRetiredObject &object) {
+        switch(object.type) {
+        case ZERO_VK_RETIRED_BUFFER:
+            if(object.allocation != VK_NULL_HANDLE) {
+                vmaDestroyBuffer(m_vma_alloc, object.handle.buffer, object.allocation);
+            } else {
+                vkDestroyBuffer(m_vk_device, object.handle.buffer, VulkanHostAllocator::getCallbacks());
+            }
+            break;
+        case ZERO_VK_RETIRED_IMAGE:
+            if(object.allocation != VK_NULL_HANDLE) {
+                vmaDestroyImage(m_vma_alloc, object.handle.image, object.allocation);
+            } else {
+                vkDestroyImage(m_vk_device, object.handle.image, VulkanHostAllocator::getCallbacks());
+            }
+            break;
+        case ZERO_VK_RETIRED_IMAGE_VIEW:
+            vkDestroyImageView(m_vk_device, object.handle.image_view, VulkanHostAllocator::getCallbacks());
+            break;
+        case ZERO_VK_RETIRED_PIPELINE:
+            vkDestroyPipeline(m_vk_device, object.handle.pipeline, VulkanHostAllocator::getCallbacks());
+            break;
+        case ZERO_VK_RETIRED_PIPELINE_LAYOUT:
+            vkDestroyPipelineLayout(m_vk_device, object.handle.pipeline_layout, VulkanHostAllocator::getCallbacks());
+            break;
+        case ZERO_VK_RETIRED_FRAMEBUFFER:
+            vkDestroyFramebuffer(m_vk_device, object.handle.framebuffer, VulkanHostAllocator::getCallbacks());
+            break;
+        case ZERO_VK_RETIRED_RENDER_PASS:
+            vkDestroyRenderPass(m_vk_device, object.handle.render_pass, VulkanHostAllocator::getCallbacks());
+            break;
+        case ZERO_VK_RETIRED_DESCRIPTOR_POOL:
+            vkDestroyDescriptorPool(m_vk_device, object.handle.descriptor_pool, VulkanHostAllocator::getCallbacks());
+            break;
+        case ZERO_VK_RETIRED_DESCRIPTOR_SET_LAYOUT:
+            vkDestroyDescriptorSetLayout(m_vk_device, object.handle.descriptor_set_layout, VulkanHostAllocator::getCallbacks());
+            break;
+        case ZERO_VK_RETIRED_SWAPCHAIN:
+            vkDestroySwapchainKHR(m_vk_device, object.handle.swapchain, VulkanHostAllocator::getCallbacks());
+            break;
+        case ZERO_VK_RETIRED_ALLOCATION:
+            vmaFreeMemory(m_vma_alloc, object.allocation);
+            break;
+        }
+    }
+
+    std::size_t VulkanDeletionQueue::collect(const uint64_t &completed_value) {
+        // stable compaction, keeping objects still in flight in retirement order
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::size_t kept = 0;
+        for(std::size_t i = 0; i < m_retired.size(); ++i) {
+            bool held = m_hold_allocations && m_retired[i].allocation != VK_NULL_HANDLE;
+            if(m_retired[i].retire_value <= completed_value && !held) {
+                destroy(m_retired[i]);
+                continue;
+            }
+            m_retired[kept++] = m_retired[i];
+        }
+        std::size_t destroyed = m_retired.size() - kept;
+        m_retired.resize(kept);
+        return destroyed;
+    }
+
+    std::size_t VulkanDeletionQueue::collect() {
+        if(countPending() == 0) {
+            return 0;
+        }
+        if(!m_submission_timeline) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_NULL_POINTER, "Deletion queue has no submission timeline to poll.");
+        }
+        return collect(m_submission_timeline->getCompletedValue());
+    }
+
+    void VulkanDeletionQueue::holdAllocations(const bool &hold) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hold_allocations = hold;
+    }
+
+    void VulkanDeletionQueue::flush() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for(const VulkanRetiredObject &object : m_retired) {
+            destroy(object);
+        }
+        m_retired.clear();
+    }
+
+    std::size_t VulkanDeletionQueue::countPending() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_retired.size();
+    }
+} // namespace ZEROengine
@@ -0,0 +1,315 @@
+#include "zeroengine_vulkan/VulkanDescriptorAllocator.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
+#include "zeroengine_vulkan/VulkanDevice.hpp"
+#include "zeroengine_vulkan/VulkanDefines.hpp"
+#include "zeroengine_core/ZEROUtilities.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace ZEROengine {
+    VulkanDescriptorLayoutCache::VulkanDescriptorLayoutCache(VulkanDevice* device) :
+    m_device{device},
+    m_layouts{},
+    m_canonical{},
+    m_statistics{}
+    {
+        if(m_device == nullptr) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_NULL_POINTER, "Descriptor layout cache needs a device.");
+        }
+    }
+
+    VulkanDescriptorLayoutCache::~VulkanDescriptorLayoutCache() {
+        cleanup();
+    }
+
+    std::size_t VulkanDescriptorLayoutCache::hashBindings(const std::vector<VkDescriptorSetLayoutBinding> &bindings) {
+        std::size_t hash = hash_combine(0, bindings.size());
+        for(const VkDescriptorSetLayoutBinding &binding : bindings) {
+            hash = hash_combine(hash, binding.binding);
+            hash = hash_combine(hash, binding.descriptorType);
+            hash = hash_combine(hash, binding.descriptorCount);
+            hash = hash_combine(hash, binding.stageFlags);
+            if(binding.pImmutableSamplers) {
+                hash = hash_combine(hash, *binding.pImmutableSamplers, sizeof(VkSampler) * binding.descriptorCount);
+            }
+        }
+        return hash;
+    }
+
+    bool VulkanDescriptorLayoutCache::equalBindings(const std::vector<VkDescriptorSetLayoutBinding> &lhs, const std::vector<VkDescriptorSetLayoutBinding> &rhs) {
+        if(lhs.size() != rhs.size()) {
+            return false;
+        }
+        for(std::size_t i = 0; i < lhs.size(); ++i) {
+            if(lhs[i].binding != rhs[i].binding ||
+                lhs[i].descriptorType != rhs[i].descriptorType ||
+                lhs[i].descriptorCount != rhs[i].descriptorCount ||
+                lhs[i].stageFlags != rhs[i].stageFlags ||
+                (lhs[i].pImmutableSamplers == nullptr) != (rhs[i].pImmutableSamplers == nullptr)) {
+                return false;
+            }
+            if(lhs[i].pImmutableSamplers && !std::equal(lhs[i].pImmutableSamplers, lhs[i].pImmutableSamplers + lhs[i].descriptorCount, rhs[i].pImmutableSamplers)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    VkDescriptorSetLayout VulkanDescriptorLayoutCache::getLayout(const VkDescriptorSetLayoutBinding* bindings, const uint32_t &binding_count) {
+        m_canonical.assign(bindings, bindings + binding_count);
+        std::sort(m_canonical.begin(), m_canonical.end(), [](const VkDescriptorSetLayoutBinding &lhs, const VkDescriptorSetLayoutBinding &rhs) {
+            return lhs.binding < rhs.binding;
+        });
+        std::size_t hash = hashBindings(m_canonical);
+
+        std::vector<LayoutEntry> &bucket = m_layouts[hash];
+        for(const LayoutEntry &entry : bucket) {
+            if(equalBindings(entry.bindings, m_canonical)) {
+                ++m_statistics.hits;
+                return entry.layout;
+            }
+        }
+
+        ++m_statistics.misses;
+        VkDescriptorSetLayoutCreateInfo layout_info{};
+        layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_info.bindingCount = binding_count;
+        layout_info.pBindings = m_canonical.data();
+        LayoutEntry entry{m_canonical, {}, VK_NULL_HANDLE};
+        ZERO_VK_CHECK_EXCEPT(vkCreateDescriptorSetLayout(m_device->getDevice(), &layout_info, VulkanHostAllocator::getCallbacks(), &entry.layout));
+
+        // keep a copy of the immutable sampler lists compared by later lookups
+        std::size_t sampler_count = 0;
+        for(const VkDescriptorSetLayoutBinding &binding : entry.bindings) {
+            sampler_count += binding.pImmutableSamplers ? binding.descriptorCount : 0;
+        }
+        entry.immutable_samplers.reserve(sampler_count);
+        for(VkDescriptorSetLayoutBinding &binding : entry.bindings) {
+            if(binding.pImmutableSamplers) {
+                std::size_t first = entry.immutable_samplers.size();
+                entry.immutable_samplers.insert(entry.immutable_samplers.end(), binding.pImmutableSamplers, binding.pImmutableSamplers + binding.descriptorCount);
+                binding.pImmutableSamplers = entry.immutable_samplers.data() + first;
+            }
+        }
+        bucket.push_back(std::move(entry));
+        ++m_statistics.layouts;
+        return bucket.back().layout;
+    }
+
+    VkDescriptorSetLayout VulkanDescriptorLayoutCache::getLayout(const std::vector<VkDescriptorSetLayoutBinding> &bindings) {
+        return getLayout(bindings.data(), static_cast<uint32_t>(bindings.size()));
+    }
+
+    const VulkanDescriptorLayoutCacheStatistics& VulkanDescriptorLayoutCache::getStatistics() const {
+        return m_statistics;
+    }
+
+    void VulkanDescriptorLayoutCache::cleanup() {
+        if(m_layouts.empty()) {
+            return;
+        }
+        std::shared_ptr<VulkanDeletionQueue> deletion_queue = m_device->getDeletionQueue().lock();
+        for(std::pair<const std::size_t, std::vector<LayoutEntry>> &bucket : m_layouts) {
+            for(LayoutEntry &entry : bucket.second) {
+                if(deletion_queue) {
+                    deletion_queue->retireDescriptorSetLayout(entry.layout);
+                } else {
+                    vkDestroyDescriptorSetLayout(m_device->getDevice(), entry.layout, VulkanHostAllocator::getCallbacks());
+                }
+            }
+        }
+        m_layouts.clear();
+        m_statistics.layouts = 0;
+    }
+
+    VulkanDescriptorAllocator::VulkanDescriptorAllocator(
+        VulkanDevice* device,
+        const uint32_t &frames_in_flight,
+        const uint32_t &sets_per_pool,
+        const std::vector<VulkanDescriptorPoolRatio> &pool_ratios
+    ) :
+    m_device{device},
+    m_sets_per_pool{sets_per_pool},
+    m_pool_sizes{},
+    m_frame_pools(frames_in_flight),
+    m_free_pools{},
+    m_frame_index{0},
+    m_pending_writes{},
+    m_image_infos{},
+    m_buffer_infos{},
+    m_writes{},
+    m_statistics{}
+    {
+        if(m_device == nullptr) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_NULL_POINTER, "Descriptor allocator needs a device.");
+        }
+        ZERO_ASSERT(frames_in_flight > 0 && sets_per_pool > 0, "Descriptor allocator needs at least one frame and one set per pool.");
+
+        std::vector<VulkanDescriptorPoolRatio> ratios = pool_ratios;
+        if(ratios.empty()) {
+            ratios = {
+                {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2.0f},
+                {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f},
+                {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2.0f},
+                {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f},
+                {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1.0f},
+                {VK_DESCRIPTOR_TYPE_SAMPLER, 1.0f},
+                {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f}
+            };
+        }
+        for(const VulkanDescriptorPoolRatio &ratio : ratios) {
+            VkDescriptorPoolSize pool_size{};
+            pool_size.type = ratio.type;
+            pool_size.descriptorCount = std::max<uint32_t>(1, static_cast<uint32_t>(ratio.ratio * static_cast<float>(sets_per_pool)));
+            m_pool_sizes.push_back(pool_size);
+        }
+    }
+
+    VulkanDescriptorAllocator::~VulkanDescriptorAllocator() {
+        cleanup();
+    }
+
+    VkDescriptorPool VulkanDescriptorAllocator::acquirePool() {
+        VkDescriptorPool pool = VK_NULL_HANDLE;
+        if(!m_free_pools.empty()) {
+            pool = m_free_pools.back();
+            m_free_pools.pop_back();
+        } else {
+            VkDescriptorPoolCreateInfo pool_info{};
+            pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            pool_info.maxSets = m_sets_per_pool;
+            pool_info.poolSizeCount = static_cast<uint32_t>(m_pool_sizes.size());
+            pool_info.pPoolSizes = m_pool_sizes.data();
+            ZERO_VK_CHECK_EXCEPT(vkCreateDescriptorPool(m_device->getDevice(), &pool_info, VulkanHostAllocator::getCallbacks(), &pool));
+            ++m_statistics.pools;
+        }
+        m_frame_pools[m_frame_index].push_back(pool);
+        ++m_statistics.frame_pools;
+        return pool;
+    }
+
+    void VulkanDescriptorAllocator::destroyPool(const VkDescriptorPool &pool) {
+        std::shared_ptr<VulkanDeletionQueue> deletion_queue = m_device->getDeletionQueue().lock();
+        if(deletion_queue) {
+            deletion_queue->retireDescriptorPool(pool);
+        } else {
+            vkDestroyDescriptorPool(m_device->getDevice(), pool, VulkanHostAllocator::getCallbacks());
+        }
+    }
+
+    void VulkanDescriptorAllocator::beginFrame() {
+        // queued writes target sets of the previous frame and must not land on recycled sets
+        flushWrites();
+        m_frame_index = (m_frame_index + 1) % static_cast<uint32_t>(m_frame_pools.size());
+
+        VkDevice vk_device = m_device->getDevice();
+        for(const VkDescriptorPool &pool : m_frame_pools[m_frame_index]) {
+            ZERO_VK_CHECK_EXCEPT(vkResetDescriptorPool(vk_device, pool, 0));
+            m_free_pools.push_back(pool);
+            ++m_statistics.pool_resets;
+        }
+        m_frame_pools[m_frame_index].clear();
+        m_statistics.frame_pools = 0;
+        m_statistics.frame_sets = 0;
+    }
+
+    VkDescriptorSet VulkanDescriptorAllocator::allocate(const VkDescriptorSetLayout &layout) {
+        std::vector<VkDescriptorPool> &pools = m_frame_pools[m_frame_index];
+        VkDescriptorPool pool = pools.empty() ? acquirePool() : pools.back();
+
+        VkDescriptorSetAllocateInfo set_info{};
+        set_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        set_info.descriptorPool = pool;
+        set_info.descriptorSetCount = 1;
+        set_info.pSetLayouts = &layout;
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        VkResult result = vkAllocateDescriptorSets(m_device->getDevice(), &set_info, &set);
+        if(result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+            // the current pool is exhausted, continue in a fresh one
+            set_info.descriptorPool = acquirePool();
+            result = vkAllocateDescriptorSets(m_device->getDevice(), &set_info, &set);
+        }
+        ZERO_VK_CHECK_EXCEPT(result);
+        ++m_statistics.frame_sets;
+        return set;
+    }
+
+    void VulkanDescriptorAllocator::writeBuffer(const VkDescriptorSet &set, const uint32_t &binding, const VkDescriptorType &type, const VkBuffer &buffer, const VkDeviceSize &offset, const VkDeviceSize &range, const uint32_t &array_element) {
+        PendingWrite write{};
+        write.set = set;
+        write.binding = binding;
+        write.array_element = array_element;
+        write.type = type;
+        write.buffer_info.buffer = buffer;
+        write.buffer_info.offset = offset;
+        write.buffer_info.range = range;
+        write.is_image = false;
+        m_pending_writes.push_back(write);
+    }
+
+    void VulkanDescriptorAllocator::writeImage(const VkDescriptorSet &set, const uint32_t &binding, const VkDescriptorType &type, const VkImageView &image_view, const VkSampler &sampler, const VkImageLayout &image_layout, const uint32_t &array_element) {
+        PendingWrite write{};
+        write.set = set;
+        write.binding = binding;
+        write.array_element = array_element;
+        write.type = type;
+        write.image_info.imageView = image_view;
+        write.image_info.sampler = sampler;
+        write.image_info.imageLayout = image_layout;
+        write.is_image = true;
+        m_pending_writes.push_back(write);
+    }
+
+    void VulkanDescriptorAllocator::flushWrites() {
+        if(m_pending_writes.empty()) {
+            return;
+        }
+        // reserved up front, the writes point into these arrays
+        m_image_infos.clear();
+        m_buffer_infos.clear();
+        m_writes.clear();
+        m_image_infos.reserve(m_pending_writes.size());
+        m_buffer_infos.reserve(m_pending_writes.size());
+        for(const PendingWrite &pending : m_pending_writes) {
+            VkWriteDescriptorSet write{};
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = pending.set;
+            write.dstBinding = pending.binding;
+            write.dstArrayElement = pending.array_element;
+            write.descriptorCount = 1;
+            write.descriptorType = pending.type;
+            if(pending.is_image) {
+                m_image_infos.push_back(pending.image_info);
+                write.pImageInfo = &m_image_infos.back();
+            } else {
+                m_buffer_infos.push_back(pending.buffer_info);
+                write.pBufferInfo = &m_buffer_infos.back();
+            }
+            m_writes.push_back(write);
+        }
+        vkUpdateDescriptorSets(m_device->getDevice(), static_cast<uint32_t>(m_writes.size()), m_writes.data(), 0, nullptr);
+        m_statistics.descriptor_writes += m_writes.size();
+        ++m_statistics.update_calls;
+        m_pending_writes.clear();
+    }
+
+    const VulkanDescriptorAllocatorStatistics& VulkanDescriptorAllocator::getStatistics() const {
+        return m_statistics;
+    }
+
+    void VulkanDescriptorAllocator::cleanup() {
+        for(std::vector<VkDescriptorPool> &pools : m_frame_pools) {
+            for(const VkDescriptorPool &pool : pools) {
+                destroyPool(pool);
+            }
+            pools.clear();
+        }
+        for(const VkDescriptorPool &pool : m_free_pools) {
+            destroyPool(pool);
+        }
+        m_free_pools.clear();
+        m_pending_writes.clear();
+        m_statistics = VulkanDescriptorAllocatorStatistics{};
+    }
+} // namespace ZEROengine
@@ -5,9 +5,11 @@
 #include <algorithm>
 #include <unordered_set>
 #include <memory>
+#include <cstring>
 
 #include "zeroengine_vulkan/VulkanDevice.hpp"
 #include "zeroengine_vulkan/VulkanContext.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
 #include <vulkan/vk_enum_string_helper.h>
 #include "vk_mem_alloc.h"
 
@@ -35,10 +37,29 @@ namespace ZEROengine {
         return "";
     }
 
-    VulkanDevice::VulkanDevice() :
+    VulkanDevice::VulkanDevice(const bool &headless) :
     m_vk_instance{},
     m_vk_physical_device{},
-    m_vk_device{}
+    m_vk_device{},
+    m_vma_alloc{},
+    m_headless{headless},
+    m_vulkan_queue_manager{},
+    m_submission_timeline{},
+    m_deletion_queue{},
+    m_resource_mutex{},
+    m_buffers{},
+    m_descriptor_sets{},
+    m_allocation_statistics{},
+    m_queue_mutex{},
+    m_upload_mutex{},
+    m_upload_command_pool{VK_NULL_HANDLE},
+    m_pipeline_manager{std::make_shared<VulkanPipelineManager>()},
+    m_memory_budget_supported{false},
+    m_frame_index{0},
+    m_heap_budgets{},
+    m_residency_manager{std::make_shared<GPUResidencyManager>()},
+    m_defragmenter{},
+    m_render_target_pool{}
     {
         initInstance();
     }
@@ -57,8 +78,35 @@ namespace ZEROengine {
         vma_create.physicalDevice = getPhysicalDevice();
         vma_create.device = getDevice();
         vma_create.vulkanApiVersion = VK_API_VERSION_1_3;
-        vma_create.flags = VMA_ALLOCATOR_CREATE_EXTERNALLY_SYNCHRONIZED_BIT;
+        // internally synchronized, buffers and images may be created from loader threads
+        vma_create.flags = 0;
+        if(m_memory_budget_supported) {
+            vma_create.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+        }
+        vma_create.pAllocationCallbacks = VulkanHostAllocator::getCallbacks();
         ZERO_VK_CHECK_EXCEPT(vmaCreateAllocator(&vma_create, &m_vma_alloc));
+
+        // deferred destruction
+        m_submission_timeline = std::make_shared<VulkanTimelineSemaphore>(m_vk_device);
+        m_deletion_queue = std::make_shared<VulkanDeletionQueue>(m_vk_device, m_vma_alloc, m_submission_timeline);
+        if(vulkan_window) {
+            vulkan_window->setDeletionQueue(m_deletion_queue);
+            vulkan_window->setDevice(this);
+        }
+
+        VulkanQueueInfo graphical_queue_info;
+        if(!m_vulkan_queue_manager->getQueueInfo(VK_QUEUE_GRAPHICS_BIT, graphical_queue_info)) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Queue manager cannot find a graphical queue.");
+        }
+        VkCommandPoolCreateInfo pool_create_info{};
+        pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        pool_create_info.pNext = nullptr;
+        pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        pool_create_info.queueFamilyIndex = graphical_queue_info.queueFamilyIndex;
+        ZERO_VK_CHECK_EXCEPT(vkCreateCommandPool(m_vk_device, &pool_create_info, VulkanHostAllocator::getCallbacks(), &m_upload_command_pool));
+
+        m_defragmenter = std::make_shared<VulkanDefragmenter>(this);
+        m_render_target_pool = std::make_shared<VulkanRenderTargetPool>(this);
     }
 
     void VulkanDevice::initInstance() {
@@ -76,8 +124,8 @@ namespace ZEROengine {
 
         std::string val_ret;
         // Checking required instance extensions
-        constexpr const char* required_extensions[] = {
-            VulkanDevice::getRequiredExtension(),
+        const char* required_extensions[] = {
+            m_headless ? VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME : VulkanDevice::getRequiredExtension(),
             "VK_KHR_surface"
         };
         constexpr uint32_t required_extensions_count = std::extent<decltype(required_extensions)>::value;
@@ -95,7 +143,7 @@ namespace ZEROengine {
         } else {
             create_info.enabledLayerCount = 0;
         }
-        ZERO_VK_CHECK_EXCEPT(vkCreateInstance(&create_info, nullptr, &m_vk_instance));
+        ZERO_VK_CHECK_EXCEPT(vkCreateInstance(&create_info, VulkanHostAllocator::getCallbacks(), &m_vk_instance));
     }
 
     void VulkanDevice::initPhysicalDevice() {
@@ -122,6 +170,27 @@ namespace ZEROengine {
         }
 
         VkPhysicalDeviceFeatures device_features{};
+        // GPU driven rendering consumes a GPU written draw count
+        device_features.multiDrawIndirect = VK_TRUE;
+
+        VkPhysicalDeviceVulkan12Features device_features_12{};
+        device_features_12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        device_features_12.pNext = nullptr;
+        device_features_12.timelineSemaphore = VK_TRUE;
+        device_features_12.drawIndirectCount = VK_TRUE;
+        // descriptor indexing, required by the bindless heap
+        device_features_12.runtimeDescriptorArray = VK_TRUE;
+        device_features_12.descriptorBindingPartiallyBound = VK_TRUE;
+        device_features_12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        device_features_12.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        device_features_12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        device_features_12.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+
+        VkPhysicalDeviceVulkan13Features device_features_13{};
+        device_features_13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+        device_features_13.pNext = nullptr;
+        device_features_13.dynamicRendering = VK_TRUE;
+        device_features_12.pNext = &device_features_13;
 
         std::vector<VkDeviceQueueCreateInfo> queue_create_infos = m_vulkan_queue_manager->queryQueueCreation(m_vk_physical_device);
         if(vulkan_window) {
@@ -134,11 +203,18 @@ namespace ZEROengine {
 
         VkDeviceCreateInfo device_create_info{};
         device_create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO; 
+        device_create_info.pNext = &device_features_12;
         device_create_info.pQueueCreateInfos = queue_create_infos.data();
         device_create_info.queueCreateInfoCount = static_cast<uint32_t>(queue_create_infos.size());
         device_create_info.pEnabledFeatures = &device_features;
-        device_create_info.enabledExtensionCount = static_cast<uint32_t>(const_device_extensions.size());
-        device_create_info.ppEnabledExtensionNames = const_device_extensions.data();
+        // the budget extension is optional, VMA falls back to estimating usage from its own allocations
+        std::vector<const char*> device_extensions = const_device_extensions;
+        m_memory_budget_supported = checkDeviceExtensionSupport(m_vk_physical_device, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        if(m_memory_budget_supported) {
+            device_extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        }
+        device_create_info.enabledExtensionCount = static_cast<uint32_t>(device_extensions.size());
+        device_create_info.ppEnabledExtensionNames = device_extensions.data();
 
         if(const_dbg_enable_validation_layers) {
             device_create_info.enabledLayerCount = static_cast<uint32_t>(const_dbg_validation_layers.size());
@@ -146,7 +222,7 @@ namespace ZEROengine {
         } else {
             device_create_info.enabledLayerCount = 0;
         }
-        ZERO_VK_CHECK_EXCEPT(vkCreateDevice(m_vk_physical_device, &device_create_info, nullptr, &m_vk_device));
+        ZERO_VK_CHECK_EXCEPT(vkCreateDevice(m_vk_physical_device, &device_create_info, VulkanHostAllocator::getCallbacks(), &m_vk_device));
 
         // initialize queue manager
         m_vulkan_queue_manager->init(m_vk_device);
@@ -215,12 +291,30 @@ namespace ZEROengine {
         uint32_t score = 0;
         VkPhysicalDeviceProperties device_properties{};
         VkPhysicalDeviceFeatures device_features{};
+
+        VkPhysicalDeviceVulkan12Features device_features_12{};
+        device_features_12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        device_features_12.pNext = nullptr;
+        VkPhysicalDeviceVulkan13Features device_features_13{};
+        device_features_13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+        device_features_13.pNext = nullptr;
+        device_features_12.pNext = &device_features_13;
+        VkPhysicalDeviceFeatures2 device_features_2{};
+        device_features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        device_features_2.pNext = &device_features_12;
         VkPhysicalDeviceMemoryProperties device_memory{};
-        vkGetPhysicalDeviceFeatures(phys_device, &device_features);
+        vkGetPhysicalDeviceFeatures2(phys_device, &device_features_2);
+        device_features = device_features_2.features;
         vkGetPhysicalDeviceProperties(phys_device, &device_properties);
         vkGetPhysicalDeviceMemoryProperties(phys_device, &device_memory);
 
         if(!device_features.geometryShader) return 0; // since we need geometry shader
+        if(!device_features_12.timelineSemaphore) return 0;
+        if(!device_features.multiDrawIndirect || !device_features_12.drawIndirectCount) return 0;
+        if(!device_features_13.dynamicRendering) return 0;
+        if(!device_features_12.runtimeDescriptorArray || !device_features_12.descriptorBindingPartiallyBound) return 0;
+        if(!device_features_12.descriptorBindingSampledImageUpdateAfterBind || !device_features_12.descriptorBindingStorageBufferUpdateAfterBind) return 0;
+        if(!device_features_12.shaderSampledImageArrayNonUniformIndexing || !device_features_12.shaderStorageBufferArrayNonUniformIndexing) return 0;
         if(!checkDeviceExtensionSupport(phys_device)) return 0;
 
         if(device_properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) score += 100;
@@ -250,12 +344,26 @@ namespace ZEROengine {
         return required_extensions.empty();
     }
 
+    bool VulkanDevice::checkDeviceExtensionSupport(const VkPhysicalDevice &phys_device, const char* extension) {
+        uint32_t extension_count = 0;
+        vkEnumerateDeviceExtensionProperties(phys_device, nullptr, &extension_count, nullptr);
+
+        std::vector<VkExtensionProperties> available_extensions(extension_count);
+        vkEnumerateDeviceExtensionProperties(phys_device, nullptr, &extension_count, available_extensions.data());
+        for(const VkExtensionProperties &available_extension : available_extensions) {
+            if(std::strcmp(available_extension.extensionName, extension) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     std::weak_ptr<GraphicalContext> VulkanDevice::allocateGraphicalContext() {
         VulkanQueueInfo graphical_queue_info;
         if(!m_vulkan_queue_manager->getQueueInfo(VK_QUEUE_GRAPHICS_BIT, graphical_queue_info)) {
             ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Queue manager cannot find a graphical queue.");
         }
-        std::shared_ptr<GraphicalContext> graphical_context = std::make_shared<VulkanGraphicalContext>(m_vk_device, graphical_queue_info.queueFamilyIndex);
+        std::shared_ptr<GraphicalContext> graphical_context = std::make_shared<VulkanGraphicalContext>(this, graphical_queue_info.queueFamilyIndex);
         m_graphical_contexts.push_back(graphical_context);
 
         return graphical_context;
@@ -282,33 +390,342 @@ namespace ZEROengine {
         return m_vk_instance;
     }
 
+    bool VulkanDevice::isHeadless() const {
+        return m_headless;
+    }
+
+    VmaAllocator VulkanDevice::getAllocator() {
+        return m_vma_alloc;
+    }
+
     std::weak_ptr<VulkanQueueManager> VulkanDevice::getQueueManager() {
         return m_vulkan_queue_manager;
     }
 
+    std::weak_ptr<VulkanTimelineSemaphore> VulkanDevice::getSubmissionTimeline() {
+        return m_submission_timeline;
+    }
+
+    std::weak_ptr<VulkanDeletionQueue> VulkanDevice::getDeletionQueue() {
+        return m_deletion_queue;
+    }
+
+    std::weak_ptr<VulkanPipelineManager> VulkanDevice::getPipelineManager() {
+        return m_pipeline_manager;
+    }
+
+    std::weak_ptr<GPUResidencyManager> VulkanDevice::getResidencyManager() {
+        return m_residency_manager;
+    }
+
+    std::weak_ptr<VulkanDefragmenter> VulkanDevice::getDefragmenter() {
+        return m_defragmenter;
+    }
+
+    std::weak_ptr<VulkanRenderTargetPool> VulkanDevice::getRenderTargetPool() {
+        return m_render_target_pool;
+    }
+
+    VkBuffer VulkanDevice::resolveBuffer(const GPUBufferHandle &buffer_handle) {
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        return m_buffers.get(buffer_handle)->getVkBuffer();
+    }
+
+    std::weak_ptr<VulkanBuffer> VulkanDevice::getBuffer(const GPUBufferHandle &buffer_handle) {
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        return m_buffers.get(buffer_handle);
+    }
+
+    std::shared_ptr<VulkanBuffer> VulkanDevice::findBuffer(const GPUBufferHandle &buffer_handle) {
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        if(!m_buffers.contains(buffer_handle)) {
+            return nullptr;
+        }
+        return m_buffers.get(buffer_handle);
+    }
+
+    GPUDescriptorSetHandle VulkanDevice::registerDescriptorSet(const VkDescriptorSet &descriptor_set) {
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        return m_descriptor_sets.insert(descriptor_set);
+    }
+
+    void VulkanDevice::releaseDescriptorSet(const GPUDescriptorSetHandle &descriptor_set_handle) {
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        m_descriptor_sets.release(descriptor_set_handle);
+    }
+
+    VkDescriptorSet VulkanDevice::resolveDescriptorSet(const GPUDescriptorSetHandle &descriptor_set_handle) {
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        return m_descriptor_sets.get(descriptor_set_handle);
+    }
+
+    std::size_t VulkanDevice::collectRetiredObjects() {
+        if(!m_deletion_queue) {
+            return 0;
+        }
+        return m_deletion_queue->collect();
+    }
+
+    void VulkanDevice::updateMemoryBudget() {
+        if(m_vma_alloc == VK_NULL_HANDLE) {
+            return;
+        }
+        // lets VMA refresh the budget it caches between calls to vkGetPhysicalDeviceMemoryProperties2
+        vmaSetCurrentFrameIndex(m_vma_alloc, ++m_frame_index);
+
+        const VkPhysicalDeviceMemoryProperties* memory_properties = nullptr;
+        vmaGetMemoryProperties(m_vma_alloc, &memory_properties);
+        VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+        vmaGetHeapBudgets(m_vma_alloc, budgets);
+
+        m_heap_budgets.resize(memory_properties->memoryHeapCount);
+        for(uint32_t i = 0; i < memory_properties->memoryHeapCount; ++i) {
+            VulkanHeapBudget &heap_budget = m_heap_budgets[i];
+            heap_budget.usage = budgets[i].usage;
+            heap_budget.budget = budgets[i].budget;
+            heap_budget.block_bytes = budgets[i].statistics.blockBytes;
+            heap_budget.allocation_bytes = budgets[i].statistics.allocationBytes;
+            heap_budget.device_local = (memory_properties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+        }
+        m_residency_manager->update(getDeviceLocalBudget());
+    }
+
+    bool VulkanDevice::isMemoryBudgetSupported() const {
+        return m_memory_budget_supported;
+    }
+
+    const std::vector<VulkanHeapBudget>& VulkanDevice::getHeapBudgets() const {
+        return m_heap_budgets;
+    }
+
+    GPUMemoryBudget VulkanDevice::getDeviceLocalBudget() const {
+        GPUMemoryBudget device_local_budget{};
+        for(const VulkanHeapBudget &heap_budget : m_heap_budgets) {
+            if(heap_budget.device_local) {
+                device_local_budget.usage += heap_budget.usage;
+                device_local_budget.budget += heap_budget.budget;
+            }
+        }
+        return device_local_budget;
+    }
+
+    uint64_t VulkanDevice::submitCommandBuffer(VkCommandBuffer command_buffer) {
+        VulkanQueueInfo graphical_queue_info;
+        if(!m_vulkan_queue_manager->getQueueInfo(VK_QUEUE_GRAPHICS_BIT, graphical_queue_info)) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Queue manager cannot find a graphical queue.");
+        }
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        VkSemaphore semaphore = m_submission_timeline->getSemaphore();
+        uint64_t signal_value = m_submission_timeline->nextSubmissionValue();
+
+        // submission order on the queue orders the work, the recorded barriers carry the dependencies
+        VkTimelineSemaphoreSubmitInfo timeline_info{};
+        timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timeline_info.waitSemaphoreValueCount = 0;
+        timeline_info.pWaitSemaphoreValues = nullptr;
+        timeline_info.signalSemaphoreValueCount = 1;
+        timeline_info.pSignalSemaphoreValues = &signal_value;
+
+        VkSubmitInfo submit_info{};
+        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.pNext = &timeline_info;
+        submit_info.waitSemaphoreCount = 0;
+        submit_info.pWaitSemaphores = nullptr;
+        submit_info.pWaitDstStageMask = nullptr;
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers = &command_buffer;
+        submit_info.signalSemaphoreCount = 1;
+        submit_info.pSignalSemaphores = &semaphore;
+        ZERO_VK_CHECK_EXCEPT(vkQueueSubmit(graphical_queue_info.queue, 1, &submit_info, VK_NULL_HANDLE));
+        return signal_value;
+    }
+
+    VkResult VulkanDevice::present(const VkQueue &queue, const VkPresentInfoKHR &present_info) {
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        return vkQueuePresentKHR(queue, &present_info);
+    }
+
+    void VulkanDevice::waitForSubmissions() {
+        if(!m_submission_timeline) {
+            return;
+        }
+        m_submission_timeline->wait(m_submission_timeline->getSubmittedValue());
+    }
+
     void VulkanDevice::releaseFence(VkFence fence) {
         vkResetFences(m_vk_device, 1, &fence);
     }
 
     void VulkanDevice::stall() {
+        // waiting for the device idle requires every queue to be externally synchronized
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
         vkDeviceWaitIdle(m_vk_device);
     }
 
-    ZEROResult VulkanDevice::allocateBuffer() {
-        // TODO: Implement
+    ZEROResult VulkanDevice::allocateBuffer(const GPUBufferDescription &buffer_description, GPUBufferHandle &buffer_handle) {
+        if(m_vma_alloc == VK_NULL_HANDLE) {
+            return { ZERO_NULL_POINTER, "Vulkan memory allocator is not initialized." };
+        }
+        // created outside of the lock, VMA synchronizes itself
+        std::shared_ptr<VulkanBuffer> buffer = std::make_shared<VulkanBuffer>(m_vma_alloc, buffer_description, m_deletion_queue);
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        buffer_handle = m_buffers.insert(std::move(buffer));
+        // lets the defragmenter find the buffer of a moved allocation, offset so that a null user data means no buffer
+        vmaSetAllocationUserData(m_vma_alloc, m_buffers.get(buffer_handle)->getAllocation(), reinterpret_cast<void*>(static_cast<uintptr_t>(buffer_handle) + 1));
+        ++m_allocation_statistics.buffers_allocated;
         return { ZERO_SUCCESS, "" };
     }
 
-    ZEROResult VulkanDevice::allocateTexture() {
-        // TODO: Implement
+    void VulkanDevice::releaseBuffer(const GPUBufferHandle &buffer_handle) {
+        // the buffer retires itself to the deletion queue on destruction, once the lock is released
+        std::shared_ptr<VulkanBuffer> buffer;
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        ZERO_ASSERT(m_buffers.contains(buffer_handle), "Releasing an unknown buffer handle, release buffers before the device is cleaned up.");
+        buffer = m_buffers.release(buffer_handle);
+        ++m_allocation_statistics.buffers_released;
+    }
+
+    bool VulkanDevice::containsBuffer(const GPUBufferHandle &buffer_handle) const {
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        return m_buffers.contains(buffer_handle);
+    }
+
+    void* VulkanDevice::getBufferMapped(const GPUBufferHandle &buffer_handle) {
+        std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+        return m_buffers.get(buffer_handle)->getBufferMapped();
+    }
+
+    ZEROResult VulkanDevice::writeBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const void* data, const uint64_t &size) {
+        std::shared_ptr<VulkanBuffer> buffer = findBuffer(buffer_handle);
+        if(!buffer) {
+            return { ZERO_NULL_POINTER, "Unknown buffer handle." };
+        }
+        if(offset > buffer->getSize() || size > buffer->getSize() - offset) {
+            return { ZERO_FAILED, "Buffer write out of bounds." };
+        }
+        if(void* mapped = buffer->getBufferMapped()) {
+            std::memcpy(static_cast<uint8_t*>(mapped) + offset, data, size);
+            buffer->flush(offset, size);
+            return { ZERO_SUCCESS, "" };
+        }
+
+        // device local memory the host cannot see, copied from a staging buffer freed once the copy completed
+        GPUBufferDescription staging_description{};
+        staging_description.size = size;
+        staging_description.stride = size;
+        staging_description.elements_count = 1;
+        staging_description.m_usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        staging_description.access = ZERO_BUFFER_ACCESS_DYNAMIC;
+        VulkanBuffer staging(m_vma_alloc, staging_description);
+        std::memcpy(staging.getBufferMapped(), data, size);
+        staging.flush(0, size);
+
+        VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+        uint64_t copy_value = 0;
+        {
+            // the defragmenter either sees the write and drops its move of the buffer, or rebinds it before the copy is recorded
+            std::lock_guard<std::mutex> move_lock(buffer->getMoveMutex());
+            std::lock_guard<std::mutex> lock(m_upload_mutex);
+            VkCommandBufferAllocateInfo command_buffer_allocation{};
+            command_buffer_allocation.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            command_buffer_allocation.commandPool = m_upload_command_pool;
+            command_buffer_allocation.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            command_buffer_allocation.commandBufferCount = 1;
+            ZERO_VK_CHECK_EXCEPT(vkAllocateCommandBuffers(m_vk_device, &command_buffer_allocation, &command_buffer));
+
+            VkCommandBufferBeginInfo begin_info{};
+            begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            ZERO_VK_CHECK_EXCEPT(vkBeginCommandBuffer(command_buffer, &begin_info));
+            VkBufferCopy region{};
+            region.srcOffset = 0;
+            region.dstOffset = offset;
+            region.size = size;
+            vkCmdCopyBuffer(command_buffer, staging.getVkBuffer(), buffer->getVkBuffer(), 1, &region);
+            // later submissions read the buffer
+            VkMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+            ZERO_VK_CHECK_EXCEPT(vkEndCommandBuffer(command_buffer));
+            copy_value = submitCommandBuffer(command_buffer);
+            buffer->markWritten();
+        }
+        m_submission_timeline->wait(copy_value);
+        {
+            std::lock_guard<std::mutex> lock(m_upload_mutex);
+            vkFreeCommandBuffers(m_vk_device, m_upload_command_pool, 1, &command_buffer);
+        }
         return { ZERO_SUCCESS, "" };
     }
 
+    void VulkanDevice::flushBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const uint64_t &size) {
+        std::shared_ptr<VulkanBuffer> buffer = findBuffer(buffer_handle);
+        if(buffer) {
+            buffer->flush(offset, size);
+        }
+    }
+
+    void VulkanDevice::invalidateBuffer(const GPUBufferHandle &buffer_handle, const uint64_t &offset, const uint64_t &size) {
+        std::shared_ptr<VulkanBuffer> buffer = findBuffer(buffer_handle);
+        if(buffer) {
+            buffer->invalidate(offset, size);
+        }
+    }
+
+    ZEROResult VulkanDevice::allocateTexture() {
+        // TODO: Implement, the interface does not describe the texture yet
+        return { ZERO_GRAPHICAL_ERROR, "Textures are not supported by the Vulkan device yet." };
+    }
+
+    GPUAllocationStatistics VulkanDevice::getAllocationStatistics() const {
+        GPUAllocationStatistics statistics{};
+        {
+            std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+            statistics = m_allocation_statistics;
+        }
+        statistics.resource_lock = m_resource_mutex.getStatistics();
+        return statistics;
+    }
+
     void VulkanDevice::cleanup() {
         // cleanup should be called in context when the device is idling.
+        for(std::shared_ptr<GraphicalContext> &graphical_context : m_graphical_contexts) {
+            graphical_context->cleanup();
+        }
+        m_graphical_contexts.clear();
+        if(m_defragmenter) {
+            m_defragmenter->cleanup();
+            m_defragmenter.reset();
+        }
+        if(m_render_target_pool) {
+            m_render_target_pool->cleanup();
+            m_render_target_pool.reset();
+        }
+        if(m_upload_command_pool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(m_vk_device, m_upload_command_pool, VulkanHostAllocator::getCallbacks());
+            m_upload_command_pool = VK_NULL_HANDLE;
+        }
+        {
+            std::lock_guard<InstrumentedMutex> lock(m_resource_mutex);
+            m_buffers.clear();
+            m_descriptor_sets.clear();
+        }
+        if(m_pipeline_manager) {
+            m_pipeline_manager->cleanup(m_vk_device);
+        }
+        if(m_deletion_queue) {
+            m_deletion_queue->flush();
+            m_deletion_queue.reset();
+        }
+        if(m_submission_timeline) {
+            m_submission_timeline->cleanup();
+            m_submission_timeline.reset();
+        }
         vmaDestroyAllocator(m_vma_alloc);
 
-        vkDestroyDevice(m_vk_device, nullptr);
-        vkDestroyInstance(m_vk_instance, nullptr);
+        vkDestroyDevice(m_vk_device, VulkanHostAllocator::getCallbacks());
+        vkDestroyInstance(m_vk_instance, VulkanHostAllocator::getCallbacks());
     }
 } // namespace ZEROengine
\ No newline at end of file
@@ -0,0 +1,301 @@
+#include "zeroengine_vulkan/VulkanGPUCuller.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
+#include "zeroengine_vulkan/VulkanDevice.hpp"
+#include "zeroengine_vulkan/VulkanDefines.hpp"
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace ZEROengine {
+    constexpr uint32_t const_vk_cull_group_size = 64;
+
+    VulkanGPUCuller::VulkanGPUCuller(VulkanDevice* device, const uint32_t &max_objects, const char* shader_data, const std::size_t &shader_size) :
+    m_device{device},
+    m_max_objects{max_objects},
+    m_object_count{0},
+    m_object_buffer{VK_NULL_HANDLE},
+    m_object_allocation{VK_NULL_HANDLE},
+    m_object_mapped{nullptr},
+    m_draw_buffer{VK_NULL_HANDLE},
+    m_draw_allocation{VK_NULL_HANDLE},
+    m_count_buffer{VK_NULL_HANDLE},
+    m_count_allocation{VK_NULL_HANDLE},
+    m_staging_buffer{VK_NULL_HANDLE},
+    m_staging_allocation{VK_NULL_HANDLE},
+    m_staging_mapped{nullptr},
+    m_upload_pending{false},
+    m_descriptor_set_layout{VK_NULL_HANDLE},
+    m_descriptor_pool{VK_NULL_HANDLE},
+    m_descriptor_set{VK_NULL_HANDLE},
+    m_pipeline_layout{VK_NULL_HANDLE},
+    m_pipeline{VK_NULL_HANDLE}
+    {
+        if(m_device == nullptr) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_NULL_POINTER, "GPU culler needs a device.");
+        }
+        ZERO_ASSERT(max_objects > 0, "GPU culler capacity must not be zero.");
+        createBuffers();
+        createPipeline(shader_data, shader_size);
+    }
+
+    VulkanGPUCuller::~VulkanGPUCuller() {
+        cleanup();
+    }
+
+    void VulkanGPUCuller::createBuffers() {
+        VmaAllocator vma_alloc = m_device->getAllocator();
+
+        VkBufferCreateInfo buffer_info{};
+        buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        // object list, written directly when the device local memory is mappable and through a staging copy otherwise
+        buffer_info.size = static_cast<VkDeviceSize>(m_max_objects) * sizeof(VulkanCullObject);
+        buffer_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        VmaAllocationCreateInfo alloc_info{};
+        alloc_info.usage = VMA_MEMORY_USAGE_AUTO;
+        alloc_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT
+            | VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT
+            | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        VmaAllocationInfo alloc_ret_info{};
+        ZERO_VK_CHECK_EXCEPT(vmaCreateBuffer(vma_alloc, &buffer_info, &alloc_info, &m_object_buffer, &m_object_allocation, &alloc_ret_info));
+        VkMemoryPropertyFlags memory_properties = 0;
+        vmaGetAllocationMemoryProperties(vma_alloc, m_object_allocation, &memory_properties);
+        if(memory_properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+            m_object_mapped = alloc_ret_info.pMappedData;
+        } else {
+            buffer_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+            alloc_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+            ZERO_VK_CHECK_EXCEPT(vmaCreateBuffer(vma_alloc, &buffer_info, &alloc_info, &m_staging_buffer, &m_staging_allocation, &alloc_ret_info));
+            m_staging_mapped = alloc_ret_info.pMappedData;
+        }
+
+        // compacted draw list and draw count, only touched by the GPU
+        alloc_info.flags = 0;
+        alloc_info.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+        buffer_info.size = static_cast<VkDeviceSize>(m_max_objects) * sizeof(VkDrawIndexedIndirectCommand);
+        buffer_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+        ZERO_VK_CHECK_EXCEPT(vmaCreateBuffer(vma_alloc, &buffer_info, &alloc_info, &m_draw_buffer, &m_draw_allocation, nullptr));
+
+        buffer_info.size = sizeof(uint32_t);
+        buffer_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        ZERO_VK_CHECK_EXCEPT(vmaCreateBuffer(vma_alloc, &buffer_info, &alloc_info, &m_count_buffer, &m_count_allocation, nullptr));
+    }
+
+    void VulkanGPUCuller::createPipeline(const char* shader_data, const std::size_t &shader_size) {
+        if(shader_data == nullptr || shader_size == 0) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_NULL_POINTER, "GPU culler needs the SPIR-V of cull.comp.");
+        }
+        VkDevice vk_device = m_device->getDevice();
+
+        // objects, draws, count
+        VkDescriptorSetLayoutBinding bindings[3]{};
+        for(uint32_t i = 0; i < 3; ++i) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+        VkDescriptorSetLayoutCreateInfo layout_info{};
+        layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_info.bindingCount = 3;
+        layout_info.pBindings = bindings;
+        ZERO_VK_CHECK_EXCEPT(vkCreateDescriptorSetLayout(vk_device, &layout_info, VulkanHostAllocator::getCallbacks(), &m_descriptor_set_layout));
+
+        VkDescriptorPoolSize pool_size{};
+        pool_size.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        pool_size.descriptorCount = 3;
+        VkDescriptorPoolCreateInfo pool_info{};
+        pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        pool_info.maxSets = 1;
+        pool_info.poolSizeCount = 1;
+        pool_info.pPoolSizes = &pool_size;
+        ZERO_VK_CHECK_EXCEPT(vkCreateDescriptorPool(vk_device, &pool_info, VulkanHostAllocator::getCallbacks(), &m_descriptor_pool));
+
+        VkDescriptorSetAllocateInfo set_info{};
+        set_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        set_info.descriptorPool = m_descriptor_pool;
+        set_info.descriptorSetCount = 1;
+        set_info.pSetLayouts = &m_descriptor_set_layout;
+        ZERO_VK_CHECK_EXCEPT(vkAllocateDescriptorSets(vk_device, &set_info, &m_descriptor_set));
+
+        VkDescriptorBufferInfo buffer_infos[3]{};
+        buffer_infos[0].buffer = m_object_buffer;
+        buffer_infos[1].buffer = m_draw_buffer;
+        buffer_infos[2].buffer = m_count_buffer;
+        VkWriteDescriptorSet writes[3]{};
+        for(uint32_t i = 0; i < 3; ++i) {
+            buffer_infos[i].offset = 0;
+            buffer_infos[i].range = VK_WHOLE_SIZE;
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = m_descriptor_set;
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pBufferInfo = &buffer_infos[i];
+        }
+        vkUpdateDescriptorSets(vk_device, 3, writes, 0, nullptr);
+
+        VkPushConstantRange push_constant_range{};
+        push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        push_constant_range.offset = 0;
+        push_constant_range.size = sizeof(VulkanCullPushConstants);
+        VkPipelineLayoutCreateInfo pipeline_layout_info{};
+        pipeline_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipeline_layout_info.setLayoutCount = 1;
+        pipeline_layout_info.pSetLayouts = &m_descriptor_set_layout;
+        pipeline_layout_info.pushConstantRangeCount = 1;
+        pipeline_layout_info.pPushConstantRanges = &push_constant_range;
+        ZERO_VK_CHECK_EXCEPT(vkCreatePipelineLayout(vk_device, &pipeline_layout_info, VulkanHostAllocator::getCallbacks(), &m_pipeline_layout));
+
+        VkShaderModuleCreateInfo shader_info{};
+        shader_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        shader_info.codeSize = shader_size;
+        shader_info.pCode = reinterpret_cast<const uint32_t*>(shader_data);
+        VkShaderModule shader_module = VK_NULL_HANDLE;
+        ZERO_VK_CHECK_EXCEPT(vkCreateShaderModule(vk_device, &shader_info, VulkanHostAllocator::getCallbacks(), &shader_module));
+
+        VkComputePipelineCreateInfo pipeline_info{};
+        pipeline_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipeline_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipeline_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipeline_info.stage.module = shader_module;
+        pipeline_info.stage.pName = "main";
+        pipeline_info.layout = m_pipeline_layout;
+        VkResult result = vkCreateComputePipelines(vk_device, VK_NULL_HANDLE, 1, &pipeline_info, VulkanHostAllocator::getCallbacks(), &m_pipeline);
+        vkDestroyShaderModule(vk_device, shader_module, VulkanHostAllocator::getCallbacks());
+        ZERO_VK_CHECK_EXCEPT(result);
+    }
+
+    void VulkanGPUCuller::uploadObjects(const VulkanCullObject* objects, const uint32_t &object_count) {
+        if(object_count > m_max_objects) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_FAILED, "GPU culler holds at most " + std::to_string(m_max_objects) + " objects.");
+        }
+        std::size_t size = static_cast<std::size_t>(object_count) * sizeof(VulkanCullObject);
+        if(m_object_mapped) {
+            std::memcpy(m_object_mapped, objects, size);
+            vmaFlushAllocation(m_device->getAllocator(), m_object_allocation, 0, size);
+        } else {
+            std::memcpy(m_staging_mapped, objects, size);
+            vmaFlushAllocation(m_device->getAllocator(), m_staging_allocation, 0, size);
+            m_upload_pending = object_count > 0;
+        }
+        m_object_count = object_count;
+    }
+
+    void VulkanGPUCuller::recordCull(VkCommandBuffer command_buffer, const GPUFrustum &frustum) {
+        // the previous frame's indirect draw must be done reading the draw list and count before they are rewritten
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        vkCmdPipelineBarrier(command_buffer,
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+        if(m_upload_pending) {
+            VkBufferCopy region{};
+            region.size = static_cast<VkDeviceSize>(m_object_count) * sizeof(VulkanCullObject);
+            vkCmdCopyBuffer(command_buffer, m_staging_buffer, m_object_buffer, 1, &region);
+            m_upload_pending = false;
+        }
+        vkCmdFillBuffer(command_buffer, m_count_buffer, 0, sizeof(uint32_t), 0);
+
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(command_buffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        VulkanCullPushConstants push_constants{};
+        std::memcpy(push_constants.planes, frustum.planes, sizeof(push_constants.planes));
+        push_constants.object_count = m_object_count;
+
+        vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline_layout, 0, 1, &m_descriptor_set, 0, nullptr);
+        vkCmdPushConstants(command_buffer, m_pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VulkanCullPushConstants), &push_constants);
+        if(m_object_count > 0) {
+            vkCmdDispatch(command_buffer, (m_object_count + const_vk_cull_group_size - 1) / const_vk_cull_group_size, 1, 1);
+        }
+
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        vkCmdPipelineBarrier(command_buffer,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+            0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    void VulkanGPUCuller::recordDraw(VkCommandBuffer command_buffer) {
+        if(m_object_count == 0) {
+            return;
+        }
+        vkCmdDrawIndexedIndirectCount(command_buffer,
+            m_draw_buffer, 0,
+            m_count_buffer, 0,
+            m_object_count, sizeof(VkDrawIndexedIndirectCommand));
+    }
+
+    uint32_t VulkanGPUCuller::getObjectCount() const {
+        return m_object_count;
+    }
+
+    uint32_t VulkanGPUCuller::getMaxObjects() const {
+        return m_max_objects;
+    }
+
+    VkBuffer VulkanGPUCuller::getDrawBuffer() const {
+        return m_draw_buffer;
+    }
+
+    VkBuffer VulkanGPUCuller::getCountBuffer() const {
+        return m_count_buffer;
+    }
+
+    void VulkanGPUCuller::cleanup() {
+        if(m_pipeline == VK_NULL_HANDLE && m_object_buffer == VK_NULL_HANDLE) {
+            return;
+        }
+        VkBuffer* buffers[] = {&m_object_buffer, &m_draw_buffer, &m_count_buffer, &m_staging_buffer};
+        VmaAllocation* allocations[] = {&m_object_allocation, &m_draw_allocation, &m_count_allocation, &m_staging_allocation};
+
+        // everything may still be in flight, the deletion queue frees it once the last submission completes
+        std::shared_ptr<VulkanDeletionQueue> deletion_queue = m_device->getDeletionQueue().lock();
+        if(deletion_queue) {
+            deletion_queue->retirePipeline(m_pipeline);
+            deletion_queue->retirePipelineLayout(m_pipeline_layout);
+            deletion_queue->retireDescriptorPool(m_descriptor_pool);
+            deletion_queue->retireDescriptorSetLayout(m_descriptor_set_layout);
+            for(std::size_t i = 0; i < 4; ++i) {
+                if(*buffers[i] != VK_NULL_HANDLE) {
+                    deletion_queue->retireBuffer(*buffers[i], *allocations[i]);
+                }
+            }
+        } else {
+            VkDevice vk_device = m_device->getDevice();
+            vkDestroyPipeline(vk_device, m_pipeline, VulkanHostAllocator::getCallbacks());
+            vkDestroyPipelineLayout(vk_device, m_pipeline_layout, VulkanHostAllocator::getCallbacks());
+            vkDestroyDescriptorPool(vk_device, m_descriptor_pool, VulkanHostAllocator::getCallbacks());
+            vkDestroyDescriptorSetLayout(vk_device, m_descriptor_set_layout, VulkanHostAllocator::getCallbacks());
+            for(std::size_t i = 0; i < 4; ++i) {
+                if(*buffers[i] != VK_NULL_HANDLE) {
+                    vmaDestroyBuffer(m_device->getAllocator(), *buffers[i], *allocations[i]);
+                }
+            }
+        }
+
+        for(std::size_t i = 0; i < 4; ++i) {
+            *buffers[i] = VK_NULL_HANDLE;
+            *allocations[i] = VK_NULL_HANDLE;
+        }
+        m_pipeline = VK_NULL_HANDLE;
+        m_pipeline_layout = VK_NULL_HANDLE;
+        m_descriptor_pool = VK_NULL_HANDLE;
+        m_descriptor_set_layout = VK_NULL_HANDLE;
+        m_descriptor_set = VK_NULL_HANDLE;
+        m_object_mapped = nullptr;
+        m_staging_mapped = nullptr;
+        m_object_count = 0;
+    }
+} // namespace ZEROengine
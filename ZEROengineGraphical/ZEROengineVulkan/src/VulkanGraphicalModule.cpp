@@ -37,7 +37,19 @@ namespace ZEROengine {
     }
 
     void VulkanGraphicalModule::drawFrame() {
+        // release objects retired in previous frames that the GPU is done with
+        m_vulkan_device->collectRetiredObjects();
+        if(std::shared_ptr<VulkanRenderTargetPool> render_target_pool = m_vulkan_device->getRenderTargetPool().lock()) {
+            render_target_pool->beginFrame();
+        }
+        // evict low priority resources before new ones get allocated when nearing the memory budget
+        m_vulkan_device->updateMemoryBudget();
+        if(std::shared_ptr<VulkanDefragmenter> defragmenter = m_vulkan_device->getDefragmenter().lock()) {
+            defragmenter->update();
+        }
+
         m_render_window->pollEvent();
+        m_render_window->markInputSampled();
         if(m_render_window->isClosing()) {
             m_is_off = true;
             return;
@@ -56,8 +68,9 @@ namespace ZEROengine {
     }
 
     void VulkanGraphicalModule::cleanup() {
-        VkDevice device = m_vulkan_device->getDevice();
-        vkDeviceWaitIdle(device);
+        // the deferred queue covers releases during the session, the final teardown also waits for presentation
+        // and any queue work outside the submission timeline
+        m_vulkan_device->stall();
 
         // always last
         m_vulkan_device->cleanup();
@@ -0,0 +1,61 @@
+#include "zeroengine_vulkan/VulkanHeadlessWindow.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
+#include "zeroengine_vulkan/VulkanDefines.hpp"
+
+namespace ZEROengine {
+    VkSurfaceKHR VulkanHeadlessWindow::createHeadlessSurface(const VkInstance &vk_instance) {
+        auto create_headless_surface = reinterpret_cast<PFN_vkCreateHeadlessSurfaceEXT>(
+            vkGetInstanceProcAddr(vk_instance, "vkCreateHeadlessSurfaceEXT"));
+        if(!create_headless_surface) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "VK_EXT_headless_surface is not enabled on the Vulkan instance.");
+        }
+
+        VkHeadlessSurfaceCreateInfoEXT surface_info{};
+        surface_info.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+        surface_info.pNext = nullptr;
+        surface_info.flags = 0;
+
+        VkSurfaceKHR surface = VK_NULL_HANDLE;
+        ZERO_VK_CHECK_EXCEPT(create_headless_surface(vk_instance, &surface_info, VulkanHostAllocator::getCallbacks(), &surface));
+        return surface;
+    }
+
+    VulkanHeadlessWindow::VulkanHeadlessWindow(
+        const VkInstance &vk_instance,
+        const VkDevice &vk_device,
+        const VkPhysicalDevice &vk_phys_device,
+        const std::string &title,
+        const WindowTransform &transform,
+        const WindowSetting &setting,
+        const WindowStyle &style,
+        const uint32_t &image_count
+    ) :
+    VulkanWindow(vk_device, vk_phys_device, createHeadlessSurface(vk_instance), title, transform, setting, style),
+    m_vk_instance{vk_instance}
+    {
+        // read when the swapchain is first created, setSwapchainImageCount() would recreate it on the first acquire
+        m_requested_image_count = image_count;
+    }
+
+    VulkanHeadlessWindow::~VulkanHeadlessWindow() {
+        cleanup();
+    }
+
+    void VulkanHeadlessWindow::pollEvent() {
+        // no event source, a headless target is always active
+    }
+
+    void VulkanHeadlessWindow::handleMoveOrResize() {
+        // the extent only changes through resize(), which takes effect on the next recreation
+        reload_swapChain();
+    }
+
+    void VulkanHeadlessWindow::cleanup() {
+        if(m_vk_surface == VK_NULL_HANDLE) {
+            return;
+        }
+        VulkanWindow::cleanup();
+        vkDestroySurfaceKHR(m_vk_instance, m_vk_surface, VulkanHostAllocator::getCallbacks());
+        m_vk_surface = VK_NULL_HANDLE;
+    }
+} // namespace ZEROengine
@@ -0,0 +1,81 @@
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
+#include "zeroengine_vulkan/VulkanDefines.hpp"
+
+namespace ZEROengine {
+    VulkanHostAllocator::VulkanHostAllocator() :
+    m_heap{const_vk_allocation_scope_count},
+    m_callbacks{},
+    m_internal_bytes{},
+    m_internal_allocations{}
+    {
+        m_callbacks.pUserData = this;
+        m_callbacks.pfnAllocation = &VulkanHostAllocator::allocation;
+        m_callbacks.pfnReallocation = &VulkanHostAllocator::reallocation;
+        m_callbacks.pfnFree = &VulkanHostAllocator::free;
+        m_callbacks.pfnInternalAllocation = &VulkanHostAllocator::internalAllocation;
+        m_callbacks.pfnInternalFree = &VulkanHostAllocator::internalFree;
+    }
+
+    VulkanHostAllocator& VulkanHostAllocator::getInstance() {
+        static VulkanHostAllocator* instance = new VulkanHostAllocator();
+        return *instance;
+    }
+
+    const VkAllocationCallbacks* VulkanHostAllocator::getCallbacks() {
+    #ifdef ZEROENGINE_VULKAN_HOST_ALLOCATOR
+        return &getInstance().m_callbacks;
+    #else
+        return nullptr;
+    #endif
+    }
+
+    VKAPI_ATTR void* VKAPI_CALL VulkanHostAllocator::allocation(void* user_data, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+        VulkanHostAllocator* allocator = static_cast<VulkanHostAllocator*>(user_data);
+        return allocator->m_heap.allocate(size, alignment, static_cast<uint32_t>(scope));
+    }
+
+    VKAPI_ATTR void* VKAPI_CALL VulkanHostAllocator::reallocation(void* user_data, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+        VulkanHostAllocator* allocator = static_cast<VulkanHostAllocator*>(user_data);
+        return allocator->m_heap.reallocate(original, size, alignment, static_cast<uint32_t>(scope));
+    }
+
+    VKAPI_ATTR void VKAPI_CALL VulkanHostAllocator::free(void* user_data, void* memory) {
+        VulkanHostAllocator* allocator = static_cast<VulkanHostAllocator*>(user_data);
+        allocator->m_heap.free(memory);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL VulkanHostAllocator::internalAllocation(void* user_data, size_t size, VkInternalAllocationType, VkSystemAllocationScope scope) {
+        VulkanHostAllocator* allocator = static_cast<VulkanHostAllocator*>(user_data);
+        allocator->m_internal_bytes[scope] += size;
+        ++allocator->m_internal_allocations[scope];
+    }
+
+    VKAPI_ATTR void VKAPI_CALL VulkanHostAllocator::internalFree(void* user_data, size_t size, VkInternalAllocationType, VkSystemAllocationScope scope) {
+        VulkanHostAllocator* allocator = static_cast<VulkanHostAllocator*>(user_data);
+        allocator->m_internal_bytes[scope] -= size;
+        --allocator->m_internal_allocations[scope];
+    }
+
+    VulkanHostAllocationStatistics VulkanHostAllocator::getStatistics(const VkSystemAllocationScope &scope) const {
+        VulkanHostAllocationStatistics statistics{};
+        statistics.heap = m_heap.getStatistics(static_cast<uint32_t>(scope));
+        statistics.internal_bytes = m_internal_bytes[scope].load();
+        statistics.internal_allocations = m_internal_allocations[scope].load();
+        return statistics;
+    }
+
+    const char* VulkanHostAllocator::getScopeName(const VkSystemAllocationScope &scope) {
+        switch(scope) {
+            case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND: return "command";
+            case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT: return "object";
+            case VK_SYSTEM_ALLOCATION_SCOPE_CACHE: return "cache";
+            case VK_SYSTEM_ALLOCATION_SCOPE_DEVICE: return "device";
+            case VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE: return "instance";
+            default: return "unknown";
+        }
+    }
+
+    void VulkanHostAllocator::trim() {
+        m_heap.trim();
+    }
+} // namespace ZEROengine
@@ -1,4 +1,5 @@
 #include "zeroengine_vulkan/VulkanPipelineManager.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
 
 #include <numeric>
 #include <utility>
@@ -9,7 +10,9 @@
 namespace ZEROengine {
 
     VulkanPipelineManager::VulkanPipelineManager() :
-    m_pipeline_buffer{}
+    m_pipeline_buffer{},
+    m_pipeline_handles{},
+    m_pipeline_handle_lookup{}
     {}
 
 
@@ -20,10 +23,48 @@ namespace ZEROengine {
         return m_pipeline_buffer;
     }
 
+    GPUPipelineHandle VulkanPipelineManager::registerPipeline(std::size_t index, const VulkanPipelineObject &pipeline) {
+        auto it = m_pipeline_handle_lookup.find(index);
+        if(it != m_pipeline_handle_lookup.end()) {
+            return it->second;
+        }
+        m_pipeline_buffer[index] = pipeline;
+        GPUPipelineHandle handle = m_pipeline_handles.insert(pipeline);
+        m_pipeline_handle_lookup[index] = handle;
+        return handle;
+    }
+
+    GPUPipelineHandle VulkanPipelineManager::getPipelineHandle(std::size_t index) const {
+        auto it = m_pipeline_handle_lookup.find(index);
+        return it == m_pipeline_handle_lookup.end() ? const_gpu_invalid_handle : it->second;
+    }
+
+    const VulkanPipelineObject& VulkanPipelineManager::resolvePipeline(const GPUPipelineHandle &handle) const {
+        return m_pipeline_handles.get(handle);
+    }
+
+    void VulkanPipelineManager::releasePipeline(std::size_t index, VulkanDeletionQueue &deletion_queue, const uint64_t &last_use_value) {
+        auto it = m_pipeline_buffer.find(index);
+        if(it == m_pipeline_buffer.end()) {
+            return;
+        }
+        deletion_queue.retirePipeline(it->second.vk_pipeline, last_use_value);
+        m_pipeline_buffer.erase(it);
+
+        auto handle_it = m_pipeline_handle_lookup.find(index);
+        if(handle_it != m_pipeline_handle_lookup.end()) {
+            m_pipeline_handles.release(handle_it->second);
+            m_pipeline_handle_lookup.erase(handle_it);
+        }
+    }
+
     void VulkanPipelineManager::cleanup(VkDevice device) {
         for(auto &[key, pipeline] : m_pipeline_buffer) {
-            vkDestroyPipeline(device, pipeline.vk_pipeline, nullptr);
+            vkDestroyPipeline(device, pipeline.vk_pipeline, VulkanHostAllocator::getCallbacks());
         }
+        m_pipeline_buffer.clear();
+        m_pipeline_handles.clear();
+        m_pipeline_handle_lookup.clear();
     }
     
     // std::vector<std::size_t> VulkanPipelineManager::requestGraphicsPipelines(
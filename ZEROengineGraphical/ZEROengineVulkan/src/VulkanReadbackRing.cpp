@@ -0,0 +1,354 @@
+#include <utility>
+
+#include "zeroengine_core/ImageEncoder.hpp"
+
+#include "zeroengine_vulkan/VulkanReadbackRing.hpp"
+#include "zeroengine_vulkan/VulkanDevice.hpp"
+#include "zeroengine_vulkan/VulkanResource.hpp"
+#include "zeroengine_vulkan/VulkanDefines.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
+
+namespace ZEROengine {
+    VulkanReadbackRing::VulkanReadbackRing(VulkanDevice* device, const uint32_t &slot_count) :
+    m_device{device},
+    m_command_pool{VK_NULL_HANDLE},
+    m_slots{},
+    m_next_capture_id{0},
+    m_queue{},
+    m_busy_slots{0},
+    m_stopping{false},
+    m_statistics{}
+    {
+        ZERO_ASSERT(slot_count > 0, "Readback ring needs at least one slot.");
+        VulkanQueueInfo queue_info{};
+        std::shared_ptr<VulkanQueueManager> queue_manager = m_device->getQueueManager().lock();
+        if(!queue_manager || !queue_manager->getQueueInfo(VK_QUEUE_GRAPHICS_BIT, queue_info)) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Queue manager cannot find a graphical queue.");
+        }
+
+        VkCommandPoolCreateInfo pool_create_info{};
+        pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        pool_create_info.pNext = nullptr;
+        pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        pool_create_info.queueFamilyIndex = queue_info.queueFamilyIndex;
+        ZERO_VK_CHECK_EXCEPT(vkCreateCommandPool(m_device->getDevice(), &pool_create_info, VulkanHostAllocator::getCallbacks(), &m_command_pool));
+
+        std::vector<VkCommandBuffer> command_buffers(slot_count, VK_NULL_HANDLE);
+        VkCommandBufferAllocateInfo command_buffer_allocation{};
+        command_buffer_allocation.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        command_buffer_allocation.pNext = nullptr;
+        command_buffer_allocation.commandPool = m_command_pool;
+        command_buffer_allocation.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        command_buffer_allocation.commandBufferCount = slot_count;
+        ZERO_VK_CHECK_EXCEPT(vkAllocateCommandBuffers(m_device->getDevice(), &command_buffer_allocation, command_buffers.data()));
+
+        m_slots.resize(slot_count);
+        for(uint32_t i = 0; i < slot_count; ++i) {
+            m_slots[i].state = FREE;
+            m_slots[i].command_buffer = command_buffers[i];
+            m_slots[i].completion_value = 0;
+        }
+
+        m_worker = std::thread(&VulkanReadbackRing::workerLoop, this);
+    }
+
+    VulkanReadbackRing::~VulkanReadbackRing() {
+        cleanup();
+    }
+
+    VulkanReadbackRing::Slot* VulkanReadbackRing::acquireSlot(
+        const VkFormat &format,
+        const VkExtent2D &extent,
+        const VulkanCaptureEncoding &encoding,
+        const VulkanCaptureCallback &callback,
+        const SlotState &state
+    ) {
+        bool swizzle = false;
+        switch(format) {
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+            break;
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+            swizzle = true;
+            break;
+        default:
+            return nullptr;
+        }
+
+        Slot* slot = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for(Slot &candidate : m_slots) {
+                if(candidate.state == FREE) {
+                    slot = &candidate;
+                    break;
+                }
+            }
+            if(slot == nullptr) {
+                ++m_statistics.dropped;
+                return nullptr;
+            }
+            // the worker never touches a slot before it is queued, the rest of the capture runs unlocked
+            slot->state = state;
+            ++m_busy_slots;
+            ++m_statistics.captures;
+        }
+
+        // slot buffers only grow, a free slot is no longer read by the GPU nor the worker
+        uint64_t size = static_cast<uint64_t>(extent.width) * extent.height * 4;
+        if(!slot->buffer || slot->buffer->getSize() < size) {
+            slot->buffer.reset();
+            GPUBufferDescription buffer_description{};
+            buffer_description.stride = 4;
+            buffer_description.size = size;
+            buffer_description.elements_count = extent.width * extent.height;
+            buffer_description.m_usage = ZERO_BUFFER_USAGE_TRANSFER_DST;
+            buffer_description.access = ZERO_BUFFER_ACCESS_READBACK;
+            slot->buffer = std::make_unique<VulkanBuffer>(m_device->getAllocator(), buffer_description);
+        }
+        slot->capture_id = m_next_capture_id++;
+        slot->extent = extent;
+        slot->swizzle = swizzle;
+        slot->encoding = encoding;
+        slot->callback = callback;
+        return slot;
+    }
+
+    void VulkanReadbackRing::recordCopy(const Slot &slot, VkCommandBuffer command_buffer, VkImage image, const VkImageLayout &layout) {
+        uint64_t size = static_cast<uint64_t>(slot.extent.width) * slot.extent.height * 4;
+
+        VkImageMemoryBarrier image_barrier{};
+        image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        image_barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        image_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        image_barrier.oldLayout = layout;
+        image_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        image_barrier.image = image;
+        image_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        image_barrier.subresourceRange.baseMipLevel = 0;
+        image_barrier.subresourceRange.levelCount = 1;
+        image_barrier.subresourceRange.baseArrayLayer = 0;
+        image_barrier.subresourceRange.layerCount = 1;
+        vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_barrier);
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = 0;
+        region.bufferRowLength = 0; // tightly packed
+        region.bufferImageHeight = 0;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = 0;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = {0, 0, 0};
+        region.imageExtent = {slot.extent.width, slot.extent.height, 1};
+        vkCmdCopyImageToBuffer(command_buffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, slot.buffer->getVkBuffer(), 1, &region);
+
+        // back to the layout the following commands expect, and make the copy visible to the host
+        image_barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        image_barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        image_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        image_barrier.newLayout = layout;
+        VkBufferMemoryBarrier buffer_barrier{};
+        buffer_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        buffer_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        buffer_barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        buffer_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        buffer_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        buffer_barrier.buffer = slot.buffer->getVkBuffer();
+        buffer_barrier.offset = 0;
+        buffer_barrier.size = size;
+        vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &buffer_barrier, 1, &image_barrier);
+    }
+
+    bool VulkanReadbackRing::capture(
+        VkImage image,
+        const VkFormat &format,
+        const VkExtent2D &extent,
+        const VkImageLayout &layout,
+        const VulkanCaptureEncoding &encoding,
+        const VulkanCaptureCallback &callback,
+        uint64_t* completion_value
+    ) {
+        // presentation does not wait for this submission, swapchain images go through recordCapture()
+        ZERO_ASSERT(layout != VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, "Presentable images must be captured with recordCapture() before their present transition.");
+        Slot* slot = acquireSlot(format, extent, encoding, callback, IN_FLIGHT);
+        if(slot == nullptr) {
+            return false;
+        }
+
+        VkCommandBuffer command_buffer = slot->command_buffer;
+        ZERO_VK_CHECK_EXCEPT(vkResetCommandBuffer(command_buffer, 0));
+        VkCommandBufferBeginInfo begin_info{};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        ZERO_VK_CHECK_EXCEPT(vkBeginCommandBuffer(command_buffer, &begin_info));
+        recordCopy(*slot, command_buffer, image, layout);
+        ZERO_VK_CHECK_EXCEPT(vkEndCommandBuffer(command_buffer));
+
+        // the first barrier of the copy orders it after the writes of earlier submissions
+        slot->completion_value = m_device->submitCommandBuffer(command_buffer);
+        if(completion_value != nullptr) {
+            *completion_value = slot->completion_value;
+        }
+        return true;
+    }
+
+    bool VulkanReadbackRing::recordCapture(
+        VkCommandBuffer command_buffer,
+        VkImage image,
+        const VkFormat &format,
+        const VkExtent2D &extent,
+        const VkImageLayout &layout,
+        const VulkanCaptureEncoding &encoding,
+        const VulkanCaptureCallback &callback
+    ) {
+        Slot* slot = acquireSlot(format, extent, encoding, callback, RECORDED);
+        if(slot == nullptr) {
+            return false;
+        }
+        recordCopy(*slot, command_buffer, image, layout);
+        return true;
+    }
+
+    void VulkanReadbackRing::markSubmitted(const uint64_t &submission_value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for(Slot &slot : m_slots) {
+            if(slot.state == RECORDED) {
+                slot.state = IN_FLIGHT;
+                slot.completion_value = submission_value;
+            }
+        }
+    }
+
+    std::size_t VulkanReadbackRing::update() {
+        std::shared_ptr<VulkanTimelineSemaphore> timeline = m_device->getSubmissionTimeline().lock();
+        uint64_t completed_value = timeline->getCompletedValue();
+        std::size_t queued = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for(uint32_t i = 0; i < m_slots.size(); ++i) {
+                Slot &slot = m_slots[i];
+                if(slot.state != IN_FLIGHT || slot.completion_value > completed_value) {
+                    continue;
+                }
+                slot.state = QUEUED;
+                m_queue.push_back(i);
+                ++queued;
+            }
+        }
+        if(queued > 0) {
+            m_work_signal.notify_one();
+        }
+        return queued;
+    }
+
+    void VulkanReadbackRing::process(Slot &slot) {
+        uint32_t width = slot.extent.width;
+        uint32_t height = slot.extent.height;
+        std::size_t row_pitch = static_cast<std::size_t>(width) * 4;
+        std::size_t size = row_pitch * height;
+        slot.buffer->invalidate(0, size);
+        uint8_t* pixels = static_cast<uint8_t*>(slot.buffer->getBufferMapped());
+
+        // the buffer is cached host memory and belongs to this slot until it is freed, swizzle in place
+        if(slot.swizzle) {
+            for(std::size_t i = 0; i < size; i += 4) {
+                std::swap(pixels[i], pixels[i + 2]);
+            }
+        }
+
+        VulkanCaptureResult result{};
+        result.capture_id = slot.capture_id;
+        result.width = width;
+        result.height = height;
+        result.encoding = slot.encoding;
+        switch(slot.encoding) {
+        case ZERO_VK_CAPTURE_RAW:
+            result.bytes.assign(pixels, pixels + size);
+            break;
+        case ZERO_VK_CAPTURE_PNG:
+            ImageEncoder::encodePNG(pixels, width, height, row_pitch, 4, result.bytes);
+            break;
+        case ZERO_VK_CAPTURE_PPM:
+            ImageEncoder::encodePPM(pixels, width, height, row_pitch, 4, result.bytes);
+            break;
+        }
+        if(slot.callback) {
+            slot.callback(result);
+        }
+        slot.callback = nullptr;
+    }
+
+    void VulkanReadbackRing::workerLoop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(true) {
+            m_work_signal.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if(m_queue.empty()) {
+                return; // stopping with nothing left
+            }
+            uint32_t index = m_queue.front();
+            m_queue.pop_front();
+            uint64_t bytes = static_cast<uint64_t>(m_slots[index].extent.width) * m_slots[index].extent.height * 4;
+
+            lock.unlock();
+            process(m_slots[index]);
+            lock.lock();
+
+            m_slots[index].state = FREE;
+            --m_busy_slots;
+            ++m_statistics.completed;
+            m_statistics.bytes_read += bytes;
+            if(m_busy_slots == 0) {
+                m_idle_signal.notify_all();
+            }
+        }
+    }
+
+    void VulkanReadbackRing::flush() {
+        uint64_t wait_value = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for(const Slot &slot : m_slots) {
+                ZERO_ASSERT(slot.state != RECORDED, "Recorded captures must be marked submitted before they can be flushed.");
+                if(slot.state == IN_FLIGHT && slot.completion_value > wait_value) {
+                    wait_value = slot.completion_value;
+                }
+            }
+        }
+        if(wait_value > 0) {
+            std::shared_ptr<VulkanTimelineSemaphore> timeline = m_device->getSubmissionTimeline().lock();
+            timeline->wait(wait_value);
+        }
+        update();
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle_signal.wait(lock, [this]() { return m_busy_slots == 0; });
+    }
+
+    VulkanReadbackStatistics VulkanReadbackRing::getStatistics() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_statistics;
+    }
+
+    void VulkanReadbackRing::cleanup() {
+        if(m_command_pool == VK_NULL_HANDLE) {
+            return;
+        }
+        flush();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_work_signal.notify_one();
+        m_worker.join();
+
+        for(Slot &slot : m_slots) {
+            slot.buffer.reset();
+        }
+        m_slots.clear();
+        vkDestroyCommandPool(m_device->getDevice(), m_command_pool, VulkanHostAllocator::getCallbacks());
+        m_command_pool = VK_NULL_HANDLE;
+    }
+} // namespace ZEROengine
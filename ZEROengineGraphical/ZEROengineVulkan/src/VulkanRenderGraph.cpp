@@ -0,0 +1,510 @@
+#include "zeroengine_vulkan/VulkanRenderGraph.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
+#include "zeroengine_vulkan/VulkanDevice.hpp"
+#include "zeroengine_vulkan/VulkanDefines.hpp"
+#include "zeroengine_core/ZEROUtilities.hpp"
+
+#include <memory>
+
+namespace ZEROengine {
+    VulkanRenderGraphPassContext::VulkanRenderGraphPassContext(VulkanRenderGraphExecutor* executor, const GPURenderGraph* graph, VulkanCommandBuffer* command_buffer) :
+    m_executor{executor},
+    m_graph{graph},
+    m_command_buffer{command_buffer},
+    m_pass{0},
+    m_color_attachments{}
+    {}
+
+    void VulkanRenderGraphPassContext::setPass(const GPURenderGraphPass &pass) {
+        m_pass = pass;
+    }
+
+    GraphicalCommandBuffer* VulkanRenderGraphPassContext::getCommandBuffer() {
+        return m_command_buffer;
+    }
+
+    void* VulkanRenderGraphPassContext::getTexture(const GPURenderGraphResource &resource) {
+        return static_cast<void*>(getImage(resource));
+    }
+
+    void* VulkanRenderGraphPassContext::getTextureView(const GPURenderGraphResource &resource) {
+        return static_cast<void*>(getImageView(resource));
+    }
+
+    VkCommandBuffer VulkanRenderGraphPassContext::getVkCommandBuffer() const {
+        return m_command_buffer->getVkCommandBuffer();
+    }
+
+    VkImage VulkanRenderGraphPassContext::getImage(const GPURenderGraphResource &resource) const {
+        return m_executor->getImage(*m_graph, resource);
+    }
+
+    VkImageView VulkanRenderGraphPassContext::getImageView(const GPURenderGraphResource &resource) const {
+        return m_executor->getImageView(*m_graph, resource);
+    }
+
+    void VulkanRenderGraphPassContext::beginRendering(const VkClearValue* clear_values) {
+        m_color_attachments.clear();
+        VkRenderingAttachmentInfo depth_attachment{};
+        bool has_depth = false;
+        VkExtent2D extent{0, 0};
+
+        for(const GPURenderGraphResource &resource : m_graph->getPassResources(m_pass)) {
+            GPUAccessFlags access = m_graph->getPassAccess(m_pass, resource);
+            bool is_color = access & (ZERO_ACCESS_COLOR_ATTACHMENT_READ | ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+            bool is_depth = access & (ZERO_ACCESS_DEPTH_ATTACHMENT_READ | ZERO_ACCESS_DEPTH_ATTACHMENT_WRITE);
+            if(!is_color && !is_depth) {
+                continue;
+            }
+            const GPURenderGraphTextureDescription &description = m_graph->getTextureDescription(resource);
+            extent = {description.width, description.height};
+
+            VkRenderingAttachmentInfo attachment{};
+            attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+            attachment.imageView = getImageView(resource);
+            attachment.imageLayout = VulkanRenderGraphExecutor::translateAccess(access, false).layout;
+            attachment.storeOp = (access & const_gpu_access_write_mask) ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_NONE;
+            if(access & (ZERO_ACCESS_COLOR_ATTACHMENT_READ | ZERO_ACCESS_DEPTH_ATTACHMENT_READ)) {
+                attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+            } else {
+                attachment.loadOp = clear_values ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            }
+            if(is_depth) {
+                depth_attachment = attachment;
+                has_depth = true;
+            } else {
+                m_color_attachments.push_back(attachment);
+            }
+        }
+        if(clear_values) {
+            for(std::size_t i = 0; i < m_color_attachments.size(); ++i) {
+                m_color_attachments[i].clearValue = clear_values[i];
+            }
+            if(has_depth) {
+                depth_attachment.clearValue = clear_values[m_color_attachments.size()];
+            }
+        }
+
+        VkRenderingInfo rendering_info{};
+        rendering_info.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+        rendering_info.renderArea.extent = extent;
+        rendering_info.layerCount = 1;
+        rendering_info.colorAttachmentCount = static_cast<uint32_t>(m_color_attachments.size());
+        rendering_info.pColorAttachments = m_color_attachments.data();
+        rendering_info.pDepthAttachment = has_depth ? &depth_attachment : nullptr;
+        vkCmdBeginRendering(m_command_buffer->getVkCommandBuffer(), &rendering_info);
+    }
+
+    void VulkanRenderGraphPassContext::endRendering() {
+        vkCmdEndRendering(m_command_buffer->getVkCommandBuffer());
+    }
+
+    VulkanRenderGraphExecutor::VulkanRenderGraphExecutor(VulkanDevice* device) :
+    m_device{device},
+    m_heap_allocations{},
+    m_images{},
+    m_image_views{},
+    m_targets{},
+    m_layout_hash{0},
+    m_image_barriers{}
+    {
+        if(m_device == nullptr) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_NULL_POINTER, "Render graph executor needs a device.");
+        }
+    }
+
+    VulkanRenderGraphExecutor::~VulkanRenderGraphExecutor() {
+        cleanup();
+    }
+
+    VulkanAccessInfo VulkanRenderGraphExecutor::translateAccess(const GPUAccessFlags &access, const bool &is_source) {
+        VulkanAccessInfo info{};
+        if(access & (ZERO_ACCESS_COLOR_ATTACHMENT_READ | ZERO_ACCESS_COLOR_ATTACHMENT_WRITE)) {
+            info.stages |= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        }
+        if(access & ZERO_ACCESS_COLOR_ATTACHMENT_READ) {
+            info.access |= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+        }
+        if(access & ZERO_ACCESS_COLOR_ATTACHMENT_WRITE) {
+            info.access |= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        }
+        if(access & (ZERO_ACCESS_DEPTH_ATTACHMENT_READ | ZERO_ACCESS_DEPTH_ATTACHMENT_WRITE)) {
+            info.stages |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            info.access |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+        }
+        if(access & ZERO_ACCESS_DEPTH_ATTACHMENT_WRITE) {
+            info.access |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        }
+        if(access & (ZERO_ACCESS_SHADER_SAMPLED_READ | ZERO_ACCESS_SHADER_STORAGE_READ | ZERO_ACCESS_SHADER_STORAGE_WRITE)) {
+            info.stages |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        }
+        if(access & (ZERO_ACCESS_SHADER_SAMPLED_READ | ZERO_ACCESS_SHADER_STORAGE_READ)) {
+            info.access |= VK_ACCESS_SHADER_READ_BIT;
+        }
+        if(access & ZERO_ACCESS_SHADER_STORAGE_WRITE) {
+            info.access |= VK_ACCESS_SHADER_WRITE_BIT;
+        }
+        if(access & (ZERO_ACCESS_TRANSFER_READ | ZERO_ACCESS_TRANSFER_WRITE)) {
+            info.stages |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+        }
+        if(access & ZERO_ACCESS_TRANSFER_READ) {
+            info.access |= VK_ACCESS_TRANSFER_READ_BIT;
+        }
+        if(access & ZERO_ACCESS_TRANSFER_WRITE) {
+            info.access |= VK_ACCESS_TRANSFER_WRITE_BIT;
+        }
+        if(access & ZERO_ACCESS_PRESENT) {
+            // presentation is ordered by semaphores, the barrier only has to make the layout change visible
+            info.stages |= is_source ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        }
+
+        // the most specific layout covering every access, GENERAL when they conflict
+        if(access == ZERO_ACCESS_NONE) {
+            info.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        } else if(access == ZERO_ACCESS_PRESENT) {
+            info.layout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        } else if((access & ~(ZERO_ACCESS_COLOR_ATTACHMENT_READ | ZERO_ACCESS_COLOR_ATTACHMENT_WRITE)) == 0) {
+            info.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        } else if((access & ~(ZERO_ACCESS_DEPTH_ATTACHMENT_READ | ZERO_ACCESS_DEPTH_ATTACHMENT_WRITE)) == 0 && (access & ZERO_ACCESS_DEPTH_ATTACHMENT_WRITE)) {
+            info.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        } else if((access & ~(ZERO_ACCESS_DEPTH_ATTACHMENT_READ | ZERO_ACCESS_SHADER_SAMPLED_READ)) == 0 && (access & ZERO_ACCESS_DEPTH_ATTACHMENT_READ)) {
+            info.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+        } else if(access == ZERO_ACCESS_SHADER_SAMPLED_READ) {
+            info.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        } else if(access == ZERO_ACCESS_TRANSFER_READ) {
+            info.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        } else if(access == ZERO_ACCESS_TRANSFER_WRITE) {
+            info.layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        } else {
+            info.layout = VK_IMAGE_LAYOUT_GENERAL;
+        }
+        return info;
+    }
+
+    bool VulkanRenderGraphExecutor::isDepthFormat(const VkFormat &format) {
+        switch(format) {
+        case VK_FORMAT_D16_UNORM:
+        case VK_FORMAT_X8_D24_UNORM_PACK32:
+        case VK_FORMAT_D32_SFLOAT:
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    VkImageAspectFlags VulkanRenderGraphExecutor::getImageAspect(const VkFormat &format) {
+        switch(format) {
+        case VK_FORMAT_D16_UNORM:
+        case VK_FORMAT_X8_D24_UNORM_PACK32:
+        case VK_FORMAT_D32_SFLOAT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT;
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        default:
+            return VK_IMAGE_ASPECT_COLOR_BIT;
+        }
+    }
+
+    VkImageCreateInfo VulkanRenderGraphExecutor::makeImageInfo(const GPURenderGraphTextureDescription &description, const GPUAccessFlags &usage) const {
+        VkImageUsageFlags image_usage = 0;
+        if(usage & (ZERO_ACCESS_COLOR_ATTACHMENT_READ | ZERO_ACCESS_COLOR_ATTACHMENT_WRITE)) {
+            image_usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        }
+        if(usage & (ZERO_ACCESS_DEPTH_ATTACHMENT_READ | ZERO_ACCESS_DEPTH_ATTACHMENT_WRITE)) {
+            image_usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        }
+        if(usage & ZERO_ACCESS_SHADER_SAMPLED_READ) {
+            image_usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+        }
+        if(usage & (ZERO_ACCESS_SHADER_STORAGE_READ | ZERO_ACCESS_SHADER_STORAGE_WRITE)) {
+            image_usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+        }
+        if(usage & ZERO_ACCESS_TRANSFER_READ) {
+            image_usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        }
+        if(usage & ZERO_ACCESS_TRANSFER_WRITE) {
+            image_usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        }
+
+        VkImageCreateInfo image_info{};
+        image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        image_info.imageType = VK_IMAGE_TYPE_2D;
+        image_info.format = static_cast<VkFormat>(description.format);
+        image_info.extent = {description.width, description.height, 1};
+        image_info.mipLevels = 1;
+        image_info.arrayLayers = 1;
+        image_info.samples = static_cast<VkSampleCountFlagBits>(description.samples);
+        image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+        image_info.usage = image_usage;
+        image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        return image_info;
+    }
+
+    void VulkanRenderGraphExecutor::compile(GPURenderGraph &graph) {
+        VkDevice vk_device = m_device->getDevice();
+        std::shared_ptr<VulkanRenderTargetPool> render_target_pool = m_device->getRenderTargetPool().lock();
+        bool use_pool = render_target_pool && render_target_pool->isLazyMemorySupported();
+        graph.compile([this, vk_device, use_pool](const GPURenderGraphTextureDescription &description, const GPUAccessFlags &usage) {
+            constexpr GPUAccessFlags attachment_access =
+                ZERO_ACCESS_COLOR_ATTACHMENT_READ | ZERO_ACCESS_COLOR_ATTACHMENT_WRITE |
+                ZERO_ACCESS_DEPTH_ATTACHMENT_READ | ZERO_ACCESS_DEPTH_ATTACHMENT_WRITE;
+            GPUMemoryRequirements ret{};
+            if(use_pool && (usage & ~attachment_access) == 0) {
+                // lazily allocated, the pool image takes no memory on tile based GPUs
+                ret.external = true;
+                return ret;
+            }
+
+            VkImageCreateInfo image_info = makeImageInfo(description, usage);
+            VkDeviceImageMemoryRequirements requirements_info{};
+            requirements_info.sType = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS;
+            requirements_info.pCreateInfo = &image_info;
+            VkMemoryRequirements2 requirements{};
+            requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+            vkGetDeviceImageMemoryRequirements(vk_device, &requirements_info, &requirements);
+
+            ret.size = requirements.memoryRequirements.size;
+            ret.alignment = requirements.memoryRequirements.alignment;
+            ret.memory_type_bits = requirements.memoryRequirements.memoryTypeBits;
+            return ret;
+        });
+        realize(graph);
+    }
+
+    std::size_t VulkanRenderGraphExecutor::hashLayout(const GPURenderGraph &graph) const {
+        std::size_t hash = hash_combine(static_cast<std::size_t>(0), graph.countResources());
+        for(const GPUMemoryRequirements &heap : graph.getHeaps()) {
+            hash = hash_combine(hash, heap.size);
+            hash = hash_combine(hash, heap.memory_type_bits);
+        }
+        for(GPURenderGraphResource resource = 0; resource < graph.countResources(); ++resource) {
+            if(!graph.isTextureAllocated(resource) && !graph.isTextureExternal(resource)) {
+                continue;
+            }
+            hash = hash_combine(hash, resource);
+            hash = hash_combine(hash, graph.getTextureDescription(resource));
+            hash = hash_combine(hash, graph.getTextureUsage(resource));
+            hash = hash_combine(hash, graph.getTextureHeap(resource));
+            hash = hash_combine(hash, graph.getTextureOffset(resource));
+        }
+        return hash;
+    }
+
+    void VulkanRenderGraphExecutor::realize(const GPURenderGraph &graph) {
+        std::size_t layout_hash = hashLayout(graph);
+        if(layout_hash == m_layout_hash && m_images.size() == graph.countResources()) {
+            return;
+        }
+        releaseImages();
+
+        VkDevice vk_device = m_device->getDevice();
+        VmaAllocator vma_alloc = m_device->getAllocator();
+
+        for(const GPUMemoryRequirements &heap : graph.getHeaps()) {
+            VkMemoryRequirements memory_requirements{};
+            memory_requirements.size = heap.size;
+            memory_requirements.alignment = heap.alignment;
+            memory_requirements.memoryTypeBits = heap.memory_type_bits;
+            VmaAllocationCreateInfo alloc_info{};
+            alloc_info.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            VmaAllocation allocation = VK_NULL_HANDLE;
+            ZERO_VK_CHECK_EXCEPT(vmaAllocateMemory(vma_alloc, &memory_requirements, &alloc_info, &allocation, nullptr));
+            m_heap_allocations.push_back(allocation);
+        }
+
+        m_images.assign(graph.countResources(), VK_NULL_HANDLE);
+        m_image_views.assign(graph.countResources(), VK_NULL_HANDLE);
+        m_targets.assign(graph.countResources(), VulkanRenderTarget{});
+        for(GPURenderGraphResource resource = 0; resource < graph.countResources(); ++resource) {
+            if(!graph.isTextureAllocated(resource)) {
+                continue;
+            }
+            const GPURenderGraphTextureDescription &description = graph.getTextureDescription(resource);
+            VkImageCreateInfo image_info = makeImageInfo(description, graph.getTextureUsage(resource));
+            ZERO_VK_CHECK_EXCEPT(vmaCreateAliasingImage2(
+                vma_alloc,
+                m_heap_allocations[graph.getTextureHeap(resource)],
+                graph.getTextureOffset(resource),
+                &image_info,
+                &m_images[resource]));
+
+            VkImageViewCreateInfo view_info{};
+            view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            view_info.image = m_images[resource];
+            view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            view_info.format = image_info.format;
+            view_info.subresourceRange.aspectMask = getImageAspect(image_info.format);
+            view_info.subresourceRange.levelCount = 1;
+            view_info.subresourceRange.layerCount = 1;
+            ZERO_VK_CHECK_EXCEPT(vkCreateImageView(vk_device, &view_info, VulkanHostAllocator::getCallbacks(), &m_image_views[resource]));
+        }
+        m_layout_hash = layout_hash;
+    }
+
+    void VulkanRenderGraphExecutor::recordBarriers(VkCommandBuffer command_buffer, const GPURenderGraph &graph, const GPURenderGraphBarrier* barriers, const std::size_t &barrier_count) {
+        if(barrier_count == 0) {
+            return;
+        }
+        VkPipelineStageFlags src_stages = 0;
+        VkPipelineStageFlags dst_stages = 0;
+        m_image_barriers.clear();
+        for(std::size_t i = 0; i < barrier_count; ++i) {
+            const GPURenderGraphBarrier &barrier = barriers[i];
+            VulkanAccessInfo before = translateAccess(barrier.before, true);
+            VulkanAccessInfo after = translateAccess(barrier.after, false);
+            if(barrier.before == ZERO_ACCESS_NONE) {
+                // imported textures may be waited on by a semaphore at any stage, transients have nothing to wait for
+                before.stages = graph.isImported(barrier.resource) ? VK_PIPELINE_STAGE_ALL_COMMANDS_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+            }
+            if(barrier.discard && graph.isTextureExternal(barrier.resource)) {
+                // the previous user of the pooled image may have recorded its commands earlier in the frame
+                VulkanRenderTarget &target = m_targets[barrier.resource];
+                before.stages |= target.previous_stages;
+                before.access |= target.previous_access;
+                target.previous_stages = 0;
+                target.previous_access = 0;
+            }
+            src_stages |= before.stages;
+            dst_stages |= after.stages;
+
+            VkImageMemoryBarrier image_barrier{};
+            image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            image_barrier.srcAccessMask = before.access;
+            image_barrier.dstAccessMask = after.access;
+            image_barrier.oldLayout = barrier.discard ? VK_IMAGE_LAYOUT_UNDEFINED : before.layout;
+            image_barrier.newLayout = after.layout;
+            image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            image_barrier.image = getImage(graph, barrier.resource);
+            image_barrier.subresourceRange.aspectMask = getImageAspect(static_cast<VkFormat>(graph.getTextureDescription(barrier.resource).format));
+            image_barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+            image_barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+            m_image_barriers.push_back(image_barrier);
+        }
+        if(dst_stages == 0) {
+            dst_stages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        }
+        vkCmdPipelineBarrier(command_buffer, src_stages, dst_stages, 0,
+            0, nullptr,
+            0, nullptr,
+            static_cast<uint32_t>(m_image_barriers.size()), m_image_barriers.data());
+    }
+
+    void VulkanRenderGraphExecutor::execute(const GPURenderGraph &graph, VulkanCommandBuffer &command_buffer) {
+        ZERO_ASSERT(graph.isCompiled(), "Render graph must be compiled before it is executed.");
+        ZERO_ASSERT(m_images.size() == graph.countResources(), "Render graph was not compiled by this executor.");
+        VkCommandBuffer vk_command_buffer = command_buffer.getVkCommandBuffer();
+        VulkanRenderGraphPassContext context(this, &graph, &command_buffer);
+        acquireTargets(graph);
+
+        std::size_t barrier_count = 0;
+        for(const GPURenderGraphPass &pass : graph.getExecutionOrder()) {
+            const GPURenderGraphBarrier* barriers = graph.getPassBarriers(pass, barrier_count);
+            recordBarriers(vk_command_buffer, graph, barriers, barrier_count);
+            context.setPass(pass);
+            graph.executePass(pass, context);
+        }
+        const GPURenderGraphBarrier* barriers = graph.getFinalBarriers(barrier_count);
+        recordBarriers(vk_command_buffer, graph, barriers, barrier_count);
+        releaseTargets(graph);
+    }
+
+    void VulkanRenderGraphExecutor::acquireTargets(const GPURenderGraph &graph) {
+        if(graph.getStatistics().external_textures == 0) {
+            return;
+        }
+        std::shared_ptr<VulkanRenderTargetPool> render_target_pool = m_device->getRenderTargetPool().lock();
+        ZERO_ASSERT(render_target_pool, "Render graph needs the render target pool of the device.");
+        for(GPURenderGraphResource resource = 0; resource < graph.countResources(); ++resource) {
+            if(!graph.isTextureExternal(resource)) {
+                continue;
+            }
+            VkImageCreateInfo image_info = makeImageInfo(graph.getTextureDescription(resource), graph.getTextureUsage(resource));
+            VulkanRenderTargetDescription description{};
+            description.format = image_info.format;
+            description.extent = {image_info.extent.width, image_info.extent.height};
+            description.samples = image_info.samples;
+            description.usage = image_info.usage | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+            m_targets[resource] = render_target_pool->acquire(description);
+        }
+    }
+
+    void VulkanRenderGraphExecutor::releaseTargets(const GPURenderGraph &graph) {
+        std::shared_ptr<VulkanRenderTargetPool> render_target_pool = m_device->getRenderTargetPool().lock();
+        for(GPURenderGraphResource resource = 0; resource < m_targets.size(); ++resource) {
+            VulkanRenderTarget &target = m_targets[resource];
+            if(target.image == VK_NULL_HANDLE) {
+                continue;
+            }
+            if(render_target_pool) {
+                // the next user waits for every access this graph may have made
+                VulkanAccessInfo info = translateAccess(graph.getTextureUsage(resource), true);
+                render_target_pool->release(target, info.stages, info.access);
+            }
+            target = VulkanRenderTarget{};
+        }
+    }
+
+    VkImage VulkanRenderGraphExecutor::getImage(const GPURenderGraph &graph, const GPURenderGraphResource &resource) const {
+        if(graph.isImported(resource)) {
+            return static_cast<VkImage>(graph.getImportedTexture(resource));
+        }
+        if(graph.isTextureExternal(resource)) {
+            return resource < m_targets.size() ? m_targets[resource].image : VK_NULL_HANDLE;
+        }
+        return resource < m_images.size() ? m_images[resource] : VK_NULL_HANDLE;
+    }
+
+    VkImageView VulkanRenderGraphExecutor::getImageView(const GPURenderGraph &graph, const GPURenderGraphResource &resource) const {
+        if(graph.isImported(resource)) {
+            return static_cast<VkImageView>(graph.getImportedTextureView(resource));
+        }
+        if(graph.isTextureExternal(resource)) {
+            return resource < m_targets.size() ? m_targets[resource].view : VK_NULL_HANDLE;
+        }
+        return resource < m_image_views.size() ? m_image_views[resource] : VK_NULL_HANDLE;
+    }
+
+    void VulkanRenderGraphExecutor::releaseImages() {
+        if(m_images.empty() && m_heap_allocations.empty()) {
+            return;
+        }
+        // previous frames may still render to the old images
+        std::shared_ptr<VulkanDeletionQueue> deletion_queue = m_device->getDeletionQueue().lock();
+        VkDevice vk_device = m_device->getDevice();
+        for(std::size_t i = 0; i < m_images.size(); ++i) {
+            if(m_images[i] == VK_NULL_HANDLE) {
+                continue;
+            }
+            if(deletion_queue) {
+                deletion_queue->retireImageView(m_image_views[i]);
+                deletion_queue->retireImage(m_images[i], VK_NULL_HANDLE);
+            } else {
+                vkDestroyImageView(vk_device, m_image_views[i], VulkanHostAllocator::getCallbacks());
+                vkDestroyImage(vk_device, m_images[i], VulkanHostAllocator::getCallbacks());
+            }
+        }
+        for(const VmaAllocation &allocation : m_heap_allocations) {
+            if(deletion_queue) {
+                deletion_queue->retireAllocation(allocation);
+            } else {
+                vmaFreeMemory(m_device->getAllocator(), allocation);
+            }
+        }
+        m_images.clear();
+        m_image_views.clear();
+        m_targets.clear();
+        m_heap_allocations.clear();
+        m_layout_hash = 0;
+    }
+
+    void VulkanRenderGraphExecutor::cleanup() {
+        releaseImages();
+    }
+} // namespace ZEROengine
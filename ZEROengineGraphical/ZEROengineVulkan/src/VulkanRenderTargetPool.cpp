@@ -0,0 +1,188 @@
+#include "zeroengine_vulkan/VulkanRenderTargetPool.hpp"
+#include "zeroengine_vulkan/VulkanDevice.hpp"
+#include "zeroengine_vulkan/VulkanRenderGraph.hpp"
+#include "zeroengine_vulkan/VulkanDefines.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
+
+namespace ZEROengine {
+    bool VulkanRenderTargetDescription::operator==(const VulkanRenderTargetDescription &other) const {
+        return format == other.format &&
+            extent.width == other.extent.width &&
+            extent.height == other.extent.height &&
+            samples == other.samples &&
+            usage == other.usage;
+    }
+
+    VulkanRenderTargetPool::VulkanRenderTargetPool(VulkanDevice* device) :
+    m_device{device},
+    m_entries{},
+    m_free_slots{},
+    m_frame{0},
+    m_lazy_memory_supported{false},
+    m_statistics{}
+    {
+        const VkPhysicalDeviceMemoryProperties* memory_properties = nullptr;
+        vmaGetMemoryProperties(m_device->getAllocator(), &memory_properties);
+        for(uint32_t i = 0; i < memory_properties->memoryTypeCount; ++i) {
+            if(memory_properties->memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) {
+                m_lazy_memory_supported = true;
+            }
+        }
+    }
+
+    VulkanRenderTargetPool::~VulkanRenderTargetPool() {
+        cleanup();
+    }
+
+    void VulkanRenderTargetPool::create(Entry &entry) {
+        const VulkanRenderTargetDescription &description = entry.description;
+        VkImageCreateInfo image_info{};
+        image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        image_info.imageType = VK_IMAGE_TYPE_2D;
+        image_info.format = description.format;
+        image_info.extent = {description.extent.width, description.extent.height, 1};
+        image_info.mipLevels = 1;
+        image_info.arrayLayers = 1;
+        image_info.samples = description.samples;
+        image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+        image_info.usage = description.usage;
+        image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VmaAllocator vma_alloc = m_device->getAllocator();
+        VmaAllocationCreateInfo alloc_info{};
+        VmaAllocationInfo allocation_info{};
+        VkResult result = VK_ERROR_FEATURE_NOT_PRESENT;
+        entry.lazily_allocated = false;
+        if((description.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) && m_lazy_memory_supported) {
+            alloc_info.usage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+            result = vmaCreateImage(vma_alloc, &image_info, &alloc_info, &entry.image, &entry.allocation, &allocation_info);
+            if(result == VK_ERROR_FEATURE_NOT_PRESENT) {
+                // no lazily allocated memory type accepts this image
+                entry.lazily_allocated = false;
+            } else {
+                ZERO_VK_CHECK_EXCEPT(result);
+                entry.lazily_allocated = true;
+            }
+        }
+        if(!entry.lazily_allocated) {
+            alloc_info.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+            // attachments are large and recreated rarely
+            alloc_info.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+            ZERO_VK_CHECK_EXCEPT(vmaCreateImage(vma_alloc, &image_info, &alloc_info, &entry.image, &entry.allocation, &allocation_info));
+        }
+        entry.size = allocation_info.size;
+
+        VkImageViewCreateInfo view_info{};
+        view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        view_info.image = entry.image;
+        view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        view_info.format = description.format;
+        view_info.subresourceRange.aspectMask = VulkanRenderGraphExecutor::getImageAspect(description.format);
+        view_info.subresourceRange.levelCount = 1;
+        view_info.subresourceRange.layerCount = 1;
+        ZERO_VK_CHECK_EXCEPT(vkCreateImageView(m_device->getDevice(), &view_info, VulkanHostAllocator::getCallbacks(), &entry.view));
+
+        ++m_statistics.targets;
+        ++m_statistics.created;
+        m_statistics.allocated_bytes += entry.size;
+        if(entry.lazily_allocated) {
+            ++m_statistics.lazily_allocated;
+        }
+    }
+
+    void VulkanRenderTargetPool::destroy(Entry &entry) {
+        // frames in flight may still render to the target
+        std::shared_ptr<VulkanDeletionQueue> deletion_queue = m_device->getDeletionQueue().lock();
+        if(deletion_queue) {
+            deletion_queue->retireImageView(entry.view);
+            deletion_queue->retireImage(entry.image, entry.allocation);
+        } else {
+            vkDestroyImageView(m_device->getDevice(), entry.view, VulkanHostAllocator::getCallbacks());
+            vmaDestroyImage(m_device->getAllocator(), entry.image, entry.allocation);
+        }
+        --m_statistics.targets;
+        ++m_statistics.freed;
+        m_statistics.allocated_bytes -= entry.size;
+        if(entry.lazily_allocated) {
+            --m_statistics.lazily_allocated;
+        }
+        entry = Entry{};
+    }
+
+    VulkanRenderTarget VulkanRenderTargetPool::acquire(const VulkanRenderTargetDescription &description) {
+        // few targets live at once, a linear search is cheaper than hashing the description
+        uint32_t index = const_gpu_invalid_handle;
+        for(uint32_t i = 0; i < m_entries.size(); ++i) {
+            const Entry &entry = m_entries[i];
+            if(entry.alive && !entry.in_use && entry.description == description) {
+                index = i;
+                break;
+            }
+        }
+        if(index != const_gpu_invalid_handle) {
+            ++m_statistics.reused;
+        } else {
+            if(!m_free_slots.empty()) {
+                index = m_free_slots.back();
+                m_free_slots.pop_back();
+            } else {
+                index = static_cast<uint32_t>(m_entries.size());
+                m_entries.push_back(Entry{});
+            }
+            Entry &entry = m_entries[index];
+            entry.description = description;
+            create(entry);
+            entry.alive = true;
+        }
+        Entry &entry = m_entries[index];
+        entry.in_use = true;
+        entry.last_used_frame = m_frame;
+        ++m_statistics.in_use;
+        return {entry.image, entry.view, index, entry.last_stages, entry.last_access};
+    }
+
+    void VulkanRenderTargetPool::release(const VulkanRenderTarget &target, const VkPipelineStageFlags &stages, const VkAccessFlags &access) {
+        ZERO_ASSERT(target.index < m_entries.size() && m_entries[target.index].in_use, "Releasing a render target that is not in use.");
+        Entry &entry = m_entries[target.index];
+        entry.in_use = false;
+        entry.last_used_frame = m_frame;
+        entry.last_stages = stages;
+        entry.last_access = access;
+        --m_statistics.in_use;
+    }
+
+    bool VulkanRenderTargetPool::isLazyMemorySupported() const {
+        return m_lazy_memory_supported;
+    }
+
+    std::size_t VulkanRenderTargetPool::beginFrame() {
+        ++m_frame;
+        std::size_t freed = 0;
+        for(uint32_t i = 0; i < m_entries.size(); ++i) {
+            Entry &entry = m_entries[i];
+            if(!entry.alive || entry.in_use || entry.last_used_frame + const_vk_render_target_unused_frames > m_frame) {
+                continue;
+            }
+            destroy(entry);
+            m_free_slots.push_back(i);
+            ++freed;
+        }
+        return freed;
+    }
+
+    const VulkanRenderTargetStatistics& VulkanRenderTargetPool::getStatistics() const {
+        return m_statistics;
+    }
+
+    void VulkanRenderTargetPool::cleanup() {
+        for(Entry &entry : m_entries) {
+            if(entry.alive) {
+                destroy(entry);
+            }
+        }
+        m_entries.clear();
+        m_free_slots.clear();
+        m_statistics.in_use = 0;
+    }
+} // namespace ZEROengine
@@ -1,4 +1,5 @@
 #include "zeroengine_vulkan/VulkanSyncPrimitives.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
 #include "zeroengine_vulkan/VulkanDefines.hpp"
 
 namespace ZEROengine {
@@ -8,7 +9,7 @@ namespace ZEROengine {
         semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
         semaphore_info.pNext = nullptr;
         semaphore_info.flags = 0;
-        ZERO_VK_CHECK_EXCEPT(vkCreateSemaphore(vk_device, &semaphore_info, nullptr, &semaphore_handle));
+        ZERO_VK_CHECK_EXCEPT(vkCreateSemaphore(vk_device, &semaphore_info, VulkanHostAllocator::getCallbacks(), &semaphore_handle));
         m_api_semaphore_handle = static_cast<void*>(semaphore_handle);
 
         VkFence fence_handle;
@@ -16,7 +17,7 @@ namespace ZEROengine {
         fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
         fence_info.pNext = nullptr;
         //fence_info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-        ZERO_VK_CHECK_EXCEPT(vkCreateFence(vk_device, &fence_info, nullptr, &fence_handle));
+        ZERO_VK_CHECK_EXCEPT(vkCreateFence(vk_device, &fence_info, VulkanHostAllocator::getCallbacks(), &fence_handle));
         m_api_fence_handle = static_cast<void*>(fence_handle);
 
         m_vk_device = vk_device;
@@ -41,4 +42,61 @@ namespace ZEROengine {
         return m_api_semaphore_handle;
     }
 
+    VulkanTimelineSemaphore::VulkanTimelineSemaphore(const VkDevice &vk_device, const uint64_t &initial_value) :
+    m_vk_device{vk_device},
+    m_vk_semaphore{},
+    m_submitted_value{initial_value}
+    {
+        VkSemaphoreTypeCreateInfo timeline_info{};
+        timeline_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        timeline_info.pNext = nullptr;
+        timeline_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        timeline_info.initialValue = initial_value;
+
+        VkSemaphoreCreateInfo semaphore_info{};
+        semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphore_info.pNext = &timeline_info;
+        semaphore_info.flags = 0;
+        ZERO_VK_CHECK_EXCEPT(vkCreateSemaphore(m_vk_device, &semaphore_info, VulkanHostAllocator::getCallbacks(), &m_vk_semaphore));
+    }
+
+    uint64_t VulkanTimelineSemaphore::nextSubmissionValue() {
+        return m_submitted_value.fetch_add(1, std::memory_order_acq_rel) + 1;
+    }
+
+    uint64_t VulkanTimelineSemaphore::getSubmittedValue() const {
+        return m_submitted_value.load(std::memory_order_acquire);
+    }
+
+    uint64_t VulkanTimelineSemaphore::getCompletedValue() const {
+        uint64_t value = 0;
+        ZERO_VK_CHECK_EXCEPT(vkGetSemaphoreCounterValue(m_vk_device, m_vk_semaphore, &value));
+        return value;
+    }
+
+    bool VulkanTimelineSemaphore::wait(const uint64_t &value, const uint64_t &timeout) const {
+        VkSemaphoreWaitInfo wait_info{};
+        wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        wait_info.pNext = nullptr;
+        wait_info.flags = 0;
+        wait_info.semaphoreCount = 1;
+        wait_info.pSemaphores = &m_vk_semaphore;
+        wait_info.pValues = &value;
+        VkResult rslt = vkWaitSemaphores(m_vk_device, &wait_info, timeout);
+        if(rslt == VK_TIMEOUT) {
+            return false;
+        }
+        ZERO_VK_CHECK_EXCEPT(rslt);
+        return true;
+    }
+
+    VkSemaphore VulkanTimelineSemaphore::getSemaphore() const {
+        return m_vk_semaphore;
+    }
+
+    void VulkanTimelineSemaphore::cleanup() {
+        vkDestroySemaphore(m_vk_device, m_vk_semaphore, VulkanHostAllocator::getCallbacks());
+        m_vk_semaphore = VK_NULL_HANDLE;
+    }
+
 } // namespace ZEROengine
\ No newline at end of file
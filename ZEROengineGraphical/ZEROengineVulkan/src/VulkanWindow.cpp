@@ -1,6 +1,10 @@
 #include "zeroengine_vulkan/VulkanWindow.hpp"
+#include "zeroengine_vulkan/VulkanHostAllocator.hpp"
 
 #include <limits>
+#include <chrono>
+#include <algorithm>
+#include <array>
 
 namespace ZEROengine {
     VulkanWindow::VulkanWindow(
@@ -23,8 +27,23 @@ namespace ZEROengine {
     m_vk_swapchain_framebuffers{},
     m_vk_swapchain_renderpass{},
     m_vk_swapchain_format{},
+    m_dynamic_rendering{false},
     m_graphical_queue_family{-1},
-    m_acquired_swapchain{}
+    m_acquired_swapchain{},
+    m_deletion_queue{},
+    m_device{nullptr},
+    m_depth_target{},
+    m_acquire_timeout{const_vk_default_acquire_timeout},
+    m_swapchain_dirty{false},
+    m_statistics{},
+    m_latency_policy{ZERO_VK_LATENCY_POLICY_LOWEST_LATENCY},
+    m_presentation_config{},
+    m_requested_image_count{0},
+    m_frame_submissions{},
+    m_frame_slot{0},
+    m_has_input_timestamp{false},
+    m_input_timestamp{},
+    m_latency_statistics{}
     {}
 
     void VulkanWindow::init() {
@@ -39,15 +58,30 @@ namespace ZEROengine {
         m_vulkan_presentation_queue.queueFamilyIndex = queue_family_index.value();
     }
 
+    void VulkanWindow::initSwapChainResources() {
+        initSwapChain();
+        initSwapChainRenderPass();
+        initSwapChainRenderTargets();
+    }
+
     void VulkanWindow::setGraphicalQueueFamily(const uint32_t &v) {
         m_graphical_queue_family = static_cast<int64_t>(v);
     }
 
-    void VulkanWindow::initSwapChain() {
+    void VulkanWindow::setDeletionQueue(const std::weak_ptr<VulkanDeletionQueue> &deletion_queue) {
+        m_deletion_queue = deletion_queue;
+    }
+
+    void VulkanWindow::setDevice(VulkanDevice* device) {
+        m_device = device;
+    }
+
+    void VulkanWindow::initSwapChain(const VkSwapchainKHR &old_swapchain) {
         SwapChainSupportDetails swap_chain_support = querySwapChainSupport();
 
         VkSurfaceFormatKHR surface_format = selectSwapchainSurfaceFormat(swap_chain_support.formats);
-        VkPresentModeKHR present_mode = selectSwapchainPresentationMode(swap_chain_support.present_modes);
+        m_presentation_config = selectPresentationConfig(swap_chain_support);
+        resizeFrameSubmissions();
 
         uint32_t actual_width = std::clamp(
                                     getWidth(), 
@@ -62,18 +96,19 @@ namespace ZEROengine {
         VkExtent2D extent = { getWidth(), getHeight() };
         m_vk_swapchain_format = surface_format.format;
         
-        uint32_t image_count = swap_chain_support.capabilities.minImageCount + 1;
-        if(swap_chain_support.capabilities.maxImageCount > 0 && image_count > swap_chain_support.capabilities.maxImageCount) 
-            image_count = swap_chain_support.capabilities.maxImageCount;
         VkSwapchainCreateInfoKHR swap_chain_create_info{};
         swap_chain_create_info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
         swap_chain_create_info.surface = m_vk_surface;
-        swap_chain_create_info.minImageCount = image_count;
+        swap_chain_create_info.minImageCount = m_presentation_config.image_count;
         swap_chain_create_info.imageFormat = surface_format.format;
         swap_chain_create_info.imageColorSpace = surface_format.colorSpace;
         swap_chain_create_info.imageExtent = extent;
         swap_chain_create_info.imageArrayLayers = 1;
         swap_chain_create_info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        // lets the readback ring capture presented frames
+        if(swap_chain_support.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) {
+            swap_chain_create_info.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        }
         
         if(m_graphical_queue_family == -1) {
             ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "VulkanWindow cannot find a graphical queue.");
@@ -94,10 +129,10 @@ namespace ZEROengine {
         }
         swap_chain_create_info.preTransform = swap_chain_support.capabilities.currentTransform;
         swap_chain_create_info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-        swap_chain_create_info.presentMode = present_mode;
+        swap_chain_create_info.presentMode = m_presentation_config.present_mode;
         swap_chain_create_info.clipped = VK_TRUE;
-        swap_chain_create_info.oldSwapchain = VK_NULL_HANDLE;
-        ZERO_VK_CHECK_EXCEPT(vkCreateSwapchainKHR(m_vk_device, &swap_chain_create_info, nullptr, &m_vk_swapchain));
+        swap_chain_create_info.oldSwapchain = old_swapchain;
+        ZERO_VK_CHECK_EXCEPT(vkCreateSwapchainKHR(m_vk_device, &swap_chain_create_info, VulkanHostAllocator::getCallbacks(), &m_vk_swapchain));
     }
 
     VkSwapchainKHR VulkanWindow::getSwapchain() const {
@@ -112,6 +147,18 @@ namespace ZEROengine {
         return m_vk_swapchain_renderpass;
     }
 
+    VkImage VulkanWindow::getSwapchainImage(const uint32_t &index) const {
+        return m_vk_swapchain_images[index];
+    }
+
+    VkImageView VulkanWindow::getSwapchainImageView(const uint32_t &index) const {
+        return m_vk_swapchain_image_views[index];
+    }
+
+    VkFormat VulkanWindow::getSwapchainFormat() const {
+        return m_vk_swapchain_format;
+    }
+
     VkSurfaceKHR VulkanWindow::getSurface() const {
         return m_vk_surface;
     }
@@ -159,6 +206,173 @@ namespace ZEROengine {
         return details;
     }
 
+    void VulkanWindow::setDynamicRendering(const bool &enable) {
+        ZERO_ASSERT(m_vk_swapchain == VK_NULL_HANDLE, "Dynamic rendering must be chosen before the swapchain resources are created.");
+        m_dynamic_rendering = enable;
+    }
+
+    bool VulkanWindow::isDynamicRendering() const {
+        return m_dynamic_rendering;
+    }
+
+    void VulkanWindow::setDepthStencil(const bool &enable) {
+        ZERO_ASSERT(m_vk_swapchain == VK_NULL_HANDLE, "Depth attachment must be chosen before the swapchain resources are created.");
+        m_enable_depth_stencil_subpass = enable;
+    }
+
+    bool VulkanWindow::isDepthStencil() const {
+        return m_enable_depth_stencil_subpass;
+    }
+
+    void VulkanWindow::acquireDepthTarget() {
+        ZERO_ASSERT(m_device != nullptr, "Window is not bound to a device.");
+        std::shared_ptr<VulkanRenderTargetPool> render_target_pool = m_device->getRenderTargetPool().lock();
+        if(!render_target_pool) {
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_NULL_POINTER, "Depth attachment needs the render target pool of the device.");
+        }
+        VulkanRenderTargetDescription description{};
+        description.format = const_vk_swapchain_depth_format;
+        description.extent = { getWidth(), getHeight() };
+        description.samples = VK_SAMPLE_COUNT_1_BIT;
+        description.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        m_depth_target = render_target_pool->acquire(description);
+    }
+
+    void VulkanWindow::releaseDepthTarget() {
+        if(m_depth_target.image == VK_NULL_HANDLE) {
+            return;
+        }
+        // the pool may already be gone on device teardown, its images with it
+        std::shared_ptr<VulkanRenderTargetPool> render_target_pool = m_device ? m_device->getRenderTargetPool().lock() : nullptr;
+        if(render_target_pool) {
+            render_target_pool->release(m_depth_target,
+                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+        }
+        m_depth_target = VulkanRenderTarget{};
+    }
+
+    VkPipelineRenderingCreateInfo VulkanWindow::getPipelineRenderingInfo() const {
+        VkPipelineRenderingCreateInfo rendering_info{};
+        rendering_info.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+        rendering_info.colorAttachmentCount = 1;
+        rendering_info.pColorAttachmentFormats = &m_vk_swapchain_format;
+        rendering_info.depthAttachmentFormat = m_enable_depth_stencil_subpass ? const_vk_swapchain_depth_format : VK_FORMAT_UNDEFINED;
+        rendering_info.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+        return rendering_info;
+    }
+
+    void VulkanWindow::beginSwapchainRendering(VkCommandBuffer command_buffer, const VkClearColorValue &clear_color) {
+        VkRect2D render_area{};
+        render_area.extent = { getWidth(), getHeight() };
+
+        if(!m_dynamic_rendering) {
+            std::array<VkClearValue, 2> clear_values{};
+            clear_values[0].color = clear_color;
+            clear_values[1].depthStencil = {1.0f, 0};
+            VkRenderPassBeginInfo render_pass_info{};
+            render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            render_pass_info.renderPass = m_vk_swapchain_renderpass;
+            render_pass_info.framebuffer = m_vk_swapchain_framebuffers[m_acquired_swapchain];
+            render_pass_info.renderArea = render_area;
+            render_pass_info.clearValueCount = static_cast<uint32_t>(m_enable_depth_stencil_subpass ? 2 : 1);
+            render_pass_info.pClearValues = clear_values.data();
+            vkCmdBeginRenderPass(command_buffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+            return;
+        }
+
+        // same dependency as the render pass: wait for the acquire semaphore stage, discard the previous contents
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = m_vk_swapchain_images[m_acquired_swapchain];
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.layerCount = 1;
+        vkCmdPipelineBarrier(command_buffer,
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        VkRenderingAttachmentInfo depth_attachment{};
+        if(m_enable_depth_stencil_subpass) {
+            // the previous frame, or the previous user of the pooled image, may still test against it
+            VkPipelineStageFlags depth_stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            VkImageMemoryBarrier depth_barrier{};
+            depth_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            depth_barrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | m_depth_target.previous_access;
+            depth_barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            depth_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            depth_barrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            depth_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            depth_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            depth_barrier.image = m_depth_target.image;
+            depth_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+            depth_barrier.subresourceRange.levelCount = 1;
+            depth_barrier.subresourceRange.layerCount = 1;
+            vkCmdPipelineBarrier(command_buffer,
+                depth_stages | m_depth_target.previous_stages,
+                depth_stages,
+                0, 0, nullptr, 0, nullptr, 1, &depth_barrier);
+            m_depth_target.previous_stages = 0;
+            m_depth_target.previous_access = 0;
+
+            depth_attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+            depth_attachment.imageView = m_depth_target.view;
+            depth_attachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            depth_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            depth_attachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            depth_attachment.clearValue.depthStencil = {1.0f, 0};
+        }
+
+        VkRenderingAttachmentInfo color_attachment{};
+        color_attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        color_attachment.imageView = m_vk_swapchain_image_views[m_acquired_swapchain];
+        color_attachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        color_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        color_attachment.clearValue.color = clear_color;
+
+        VkRenderingInfo rendering_info{};
+        rendering_info.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+        rendering_info.renderArea = render_area;
+        rendering_info.layerCount = 1;
+        rendering_info.colorAttachmentCount = 1;
+        rendering_info.pColorAttachments = &color_attachment;
+        rendering_info.pDepthAttachment = m_enable_depth_stencil_subpass ? &depth_attachment : nullptr;
+        vkCmdBeginRendering(command_buffer, &rendering_info);
+    }
+
+    void VulkanWindow::endSwapchainRendering(VkCommandBuffer command_buffer) {
+        if(!m_dynamic_rendering) {
+            vkCmdEndRenderPass(command_buffer);
+            return;
+        }
+        vkCmdEndRendering(command_buffer);
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        barrier.dstAccessMask = 0;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = m_vk_swapchain_images[m_acquired_swapchain];
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.layerCount = 1;
+        vkCmdPipelineBarrier(command_buffer,
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
     std::optional<uint32_t> VulkanWindow::queryPresentationQueueIndex() const {
         uint32_t queue_family_count = 0;
         vkGetPhysicalDeviceQueueFamilyProperties(m_vk_phys_device, &queue_family_count, nullptr);
@@ -190,6 +404,9 @@ namespace ZEROengine {
     }
 
     void VulkanWindow::initSwapChainRenderPass() {
+        if(m_dynamic_rendering) {
+            return;
+        }
         std::array<VkAttachmentDescription, 2> attachments = {};
 
         attachments[0].format = m_vk_swapchain_format;
@@ -219,31 +436,31 @@ namespace ZEROengine {
         subpass_dep[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
         subpass_dep[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
 
-        /* future support
-        if(settings.enableDepthStencil) {
-            attachments[1].format = VK_FORMAT_D16_UNORM;
+        VkAttachmentReference depth_attachment_ref = {};
+        if(m_enable_depth_stencil_subpass) {
+            // never stored, so a lazily allocated pool image never gets memory on tile based GPUs
+            attachments[1].format = const_vk_swapchain_depth_format;
             attachments[1].samples = VK_SAMPLE_COUNT_1_BIT;
             attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-            attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-            attachments[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachments[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
             attachments[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
             attachments[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
             attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
-            VkAttachmentReference depth_attachment_ref = {};
             depth_attachment_ref.attachment = 1;
             depth_attachment_ref.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
             subpass.pDepthStencilAttachment = &depth_attachment_ref;
+
+            // the pool only hands this image to users of the same depth only description, whose last accesses are depth tests
             subpass_dep[1].srcSubpass = VK_SUBPASS_EXTERNAL;
             subpass_dep[1].dstSubpass = 0;
-            subpass_dep[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            subpass_dep[1].dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-            subpass_dep[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-            subpass_dep[1].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-            subpass_dep[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+            subpass_dep[1].srcStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            subpass_dep[1].dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            subpass_dep[1].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            subpass_dep[1].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            subpass_dep[1].dependencyFlags = 0;
         }
-        */
 
         VkRenderPassCreateInfo render_pass_info{};
         render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
@@ -253,7 +470,7 @@ namespace ZEROengine {
         render_pass_info.pSubpasses = &subpass;
         render_pass_info.dependencyCount = static_cast<uint32_t>(m_enable_depth_stencil_subpass ? 2 : 1);
         render_pass_info.pDependencies = subpass_dep.data();
-        ZERO_VK_CHECK_EXCEPT(vkCreateRenderPass(m_vk_device, &render_pass_info, nullptr, &m_vk_swapchain_renderpass));
+        ZERO_VK_CHECK_EXCEPT(vkCreateRenderPass(m_vk_device, &render_pass_info, VulkanHostAllocator::getCallbacks(), &m_vk_swapchain_renderpass));
     }
 
     void VulkanWindow::initSwapChainRenderTargets() {
@@ -261,8 +478,11 @@ namespace ZEROengine {
         vkGetSwapchainImagesKHR(m_vk_device, m_vk_swapchain, &image_count, nullptr);
         m_vk_swapchain_images.resize(image_count);
         m_vk_swapchain_image_views.resize(image_count);
-        m_vk_swapchain_framebuffers.resize(image_count);
+        m_vk_swapchain_framebuffers.resize(m_dynamic_rendering ? 0 : image_count);
         ZERO_VK_CHECK_EXCEPT(vkGetSwapchainImagesKHR(m_vk_device, m_vk_swapchain, &image_count, m_vk_swapchain_images.data()));
+        if(m_enable_depth_stencil_subpass) {
+            acquireDepthTarget();
+        }
 
         for(std::size_t i = 0; i < image_count; ++i) {
             VkImageViewCreateInfo img_view_create_info{};
@@ -279,21 +499,24 @@ namespace ZEROengine {
             img_view_create_info.subresourceRange.levelCount = 1;
             img_view_create_info.subresourceRange.baseMipLevel = 0;
             img_view_create_info.subresourceRange.baseArrayLayer = 0;
-            ZERO_VK_CHECK_EXCEPT(vkCreateImageView(m_vk_device, &img_view_create_info, nullptr, &m_vk_swapchain_image_views[i]));
+            ZERO_VK_CHECK_EXCEPT(vkCreateImageView(m_vk_device, &img_view_create_info, VulkanHostAllocator::getCallbacks(), &m_vk_swapchain_image_views[i]));
+            if(m_dynamic_rendering) {
+                continue;
+            }
 
-            VkImageView* img_view_ref = &m_vk_swapchain_image_views[i];
+            std::array<VkImageView, 2> framebuffer_attachments = { m_vk_swapchain_image_views[i], m_depth_target.view };
             VkFramebufferCreateInfo framebuffers_create_info{};
             framebuffers_create_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
             framebuffers_create_info.width = getWidth();
             framebuffers_create_info.height = getHeight();
             framebuffers_create_info.layers = 1;
-            framebuffers_create_info.attachmentCount = 1;
-            framebuffers_create_info.pAttachments = img_view_ref;
+            framebuffers_create_info.attachmentCount = static_cast<uint32_t>(m_enable_depth_stencil_subpass ? 2 : 1);
+            framebuffers_create_info.pAttachments = framebuffer_attachments.data();
             framebuffers_create_info.renderPass = m_vk_swapchain_renderpass;
             ZERO_VK_CHECK_EXCEPT(vkCreateFramebuffer(
                 m_vk_device, 
                 &framebuffers_create_info, 
-                nullptr, 
+                VulkanHostAllocator::getCallbacks(), 
                 &m_vk_swapchain_framebuffers[i]));
         }
     }
@@ -309,32 +532,233 @@ namespace ZEROengine {
     }
 
     VkPresentModeKHR VulkanWindow::selectSwapchainPresentationMode(const std::vector<VkPresentModeKHR> &modes) {
+        if(m_latency_policy != ZERO_VK_LATENCY_POLICY_LOWEST_LATENCY) {
+            return VK_PRESENT_MODE_FIFO_KHR; // vsync'd, always supported
+        }
+        bool has_immediate = false;
         for(const auto& mode : modes) {
             if(mode == VK_PRESENT_MODE_MAILBOX_KHR) return mode;
+            if(mode == VK_PRESENT_MODE_IMMEDIATE_KHR) has_immediate = true;
         }
-        return VK_PRESENT_MODE_FIFO_KHR;
+        return has_immediate ? VK_PRESENT_MODE_IMMEDIATE_KHR : VK_PRESENT_MODE_FIFO_KHR;
     }
 
-    bool VulkanWindow::tryAcquireSwapchainImage(const VkSemaphore &wait_semaphore, const uint32_t &call_depth) {
-        if(call_depth == 64u) {
-            ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Maximum swapchin reacquisition depth.");
+    VulkanPresentationConfig VulkanWindow::selectPresentationConfig(const SwapChainSupportDetails &swap_chain_support) {
+        const VkSurfaceCapabilitiesKHR &capabilities = swap_chain_support.capabilities;
+
+        VulkanPresentationConfig config{};
+        config.present_mode = selectSwapchainPresentationMode(swap_chain_support.present_modes);
+        switch(m_latency_policy) {
+        case ZERO_VK_LATENCY_POLICY_LOWEST_LATENCY:
+            // an extra image lets MAILBOX always have a free image to render to
+            config.image_count = capabilities.minImageCount + 1;
+            config.frames_in_flight = 1;
+            break;
+        case ZERO_VK_LATENCY_POLICY_VSYNC_THROUGHPUT:
+            config.image_count = std::max(capabilities.minImageCount + 1, 3u);
+            config.frames_in_flight = 2;
+            break;
+        case ZERO_VK_LATENCY_POLICY_POWER_SAVING:
+            config.image_count = std::max(capabilities.minImageCount, 2u);
+            config.frames_in_flight = 1;
+            break;
         }
-        
-        VkResult rslt = vkAcquireNextImageKHR(
-            m_vk_device, m_vk_swapchain, 
-            UINT64_MAX, 
-            wait_semaphore, 
-            VK_NULL_HANDLE, 
-            &m_acquired_swapchain
-        ); // handle resize
-        if(rslt == VK_ERROR_OUT_OF_DATE_KHR) {
-            handleMoveOrResize();
-            // reacquire
-            return tryAcquireSwapchainImage(wait_semaphore, call_depth+1);
-        } else if(rslt != VK_SUCCESS && rslt != VK_SUBOPTIMAL_KHR) {
-            ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Error while trying to acquire swapchain image.");
-        }
-        return call_depth == 0;
+        if(m_requested_image_count > 0) {
+            config.image_count = std::max(m_requested_image_count, capabilities.minImageCount);
+        }
+        if(capabilities.maxImageCount > 0 && config.image_count > capabilities.maxImageCount) {
+            config.image_count = capabilities.maxImageCount;
+        }
+        config.frames_in_flight = std::min(config.frames_in_flight, config.image_count);
+        return config;
+    }
+
+    void VulkanWindow::setLatencyPolicy(const VulkanLatencyPolicy &policy) {
+        if(policy == m_latency_policy) {
+            return;
+        }
+        m_latency_policy = policy;
+        requestSwapchainRecreation();
+    }
+
+    VulkanLatencyPolicy VulkanWindow::getLatencyPolicy() const {
+        return m_latency_policy;
+    }
+
+    VulkanPresentationConfig VulkanWindow::getPresentationConfig() const {
+        return m_presentation_config;
+    }
+
+    uint32_t VulkanWindow::getFramesInFlight() const {
+        return m_presentation_config.frames_in_flight;
+    }
+
+    void VulkanWindow::setSwapchainImageCount(const uint32_t &image_count) {
+        if(image_count == m_requested_image_count) {
+            return;
+        }
+        m_requested_image_count = image_count;
+        requestSwapchainRecreation();
+    }
+
+    uint32_t VulkanWindow::getSwapchainImageCount() const {
+        return static_cast<uint32_t>(m_vk_swapchain_images.size());
+    }
+
+    void VulkanWindow::markInputSampled() {
+        m_input_timestamp = std::chrono::steady_clock::now();
+        m_has_input_timestamp = true;
+    }
+
+    VulkanLatencyStatistics VulkanWindow::getLatencyStatistics(const VkPresentModeKHR &present_mode) const {
+        auto it = m_latency_statistics.find(present_mode);
+        if(it == m_latency_statistics.end()) {
+            return {};
+        }
+        return it->second;
+    }
+
+    void VulkanWindow::resizeFrameSubmissions() {
+        uint32_t frames_in_flight = std::max(m_presentation_config.frames_in_flight, 1u);
+        if(m_frame_submissions.size() == frames_in_flight) {
+            return;
+        }
+        // the latest presented frame gates every slot, so lowering the count never lets more frames run ahead
+        uint64_t latest = 0;
+        for(const uint64_t &submission_value : m_frame_submissions) {
+            latest = std::max(latest, submission_value);
+        }
+        m_frame_submissions.assign(frames_in_flight, latest);
+        m_frame_slot = 0;
+    }
+
+    bool VulkanWindow::waitForFrameSlot() {
+        if(m_frame_submissions.empty() || m_frame_submissions[m_frame_slot] == 0 || m_device == nullptr) {
+            return true;
+        }
+        uint64_t submission_value = m_frame_submissions[m_frame_slot];
+        std::shared_ptr<VulkanTimelineSemaphore> submission_timeline = m_device->getSubmissionTimeline().lock();
+        if(!submission_timeline) {
+            return true;
+        }
+        auto wait_begin = std::chrono::steady_clock::now();
+        bool completed = submission_timeline->wait(submission_value, m_acquire_timeout);
+        m_statistics.pacing_wait_ns += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - wait_begin).count());
+        return completed;
+    }
+
+    VkResult VulkanWindow::tryAcquireSwapchainImage(const VkSemaphore &wait_semaphore) {
+        // pace the CPU to frames_in_flight frames ahead of the GPU
+        if(!waitForFrameSlot()) {
+            ++m_statistics.skipped_frames;
+            return VK_TIMEOUT;
+        }
+        VkResult rslt = VK_ERROR_OUT_OF_DATE_KHR;
+        uint64_t wait_ns = 0;
+        for(uint32_t attempt = 0; attempt < const_vk_max_acquire_attempts; ++attempt) {
+            if(m_swapchain_dirty) {
+                m_swapchain_dirty = false;
+                handleMoveOrResize();
+            }
+
+            auto acquire_begin = std::chrono::steady_clock::now();
+            rslt = vkAcquireNextImageKHR(
+                m_vk_device, m_vk_swapchain, 
+                m_acquire_timeout, 
+                wait_semaphore, 
+                VK_NULL_HANDLE, 
+                &m_acquired_swapchain
+            );
+            wait_ns += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - acquire_begin).count());
+
+            if(rslt != VK_ERROR_OUT_OF_DATE_KHR) {
+                break;
+            }
+            // unusable swapchain, recreate and reacquire
+            m_swapchain_dirty = true;
+        }
+        m_statistics.acquire_wait_ns += wait_ns;
+        m_statistics.last_acquire_wait_ns = wait_ns;
+        m_statistics.max_acquire_wait_ns = std::max(m_statistics.max_acquire_wait_ns, wait_ns);
+
+        switch(rslt) {
+        case VK_SUBOPTIMAL_KHR:
+            // the image is still presentable, recreate before the next acquisition
+            m_swapchain_dirty = true;
+            ZEROengine_FALLTHROUGH;
+        case VK_SUCCESS:
+            ++m_statistics.acquired_frames;
+            break;
+        case VK_NOT_READY:
+        case VK_TIMEOUT:
+        case VK_ERROR_OUT_OF_DATE_KHR:
+            ++m_statistics.skipped_frames;
+            break;
+        default:
+            ZERO_EXCEPT(ZEROResultEnum::ZERO_GRAPHICAL_ERROR, "Error while trying to acquire swapchain image: " + std::string(string_VkResult(rslt)));
+        }
+        return rslt;
+    }
+
+    VkResult VulkanWindow::presentSwapchainImage(const VkSemaphore &wait_semaphore) {
+        VkPresentInfoKHR present_info{};
+        present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        present_info.pNext = nullptr;
+        present_info.waitSemaphoreCount = wait_semaphore == VK_NULL_HANDLE ? 0 : 1;
+        present_info.pWaitSemaphores = wait_semaphore == VK_NULL_HANDLE ? nullptr : &wait_semaphore;
+        present_info.swapchainCount = 1;
+        present_info.pSwapchains = &m_vk_swapchain;
+        present_info.pImageIndices = &m_acquired_swapchain;
+        present_info.pResults = nullptr;
+
+        // the presentation queue may be the graphics queue the device submits to from other threads
+        ZERO_ASSERT(m_device != nullptr, "Window is not bound to a device.");
+        VkResult rslt = m_device->present(m_vulkan_presentation_queue.queue, present_info);
+        std::shared_ptr<VulkanTimelineSemaphore> submission_timeline = m_device->getSubmissionTimeline().lock();
+        if(submission_timeline && !m_frame_submissions.empty()) {
+            // the frame's own submissions are the latest ones on the timeline
+            m_frame_submissions[m_frame_slot] = submission_timeline->getSubmittedValue();
+            m_frame_slot = (m_frame_slot + 1) % static_cast<uint32_t>(m_frame_submissions.size());
+        }
+        if(m_has_input_timestamp) {
+            uint64_t latency_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - m_input_timestamp).count());
+            VulkanLatencyStatistics &latency = m_latency_statistics[m_presentation_config.present_mode];
+            latency.min_ns = latency.samples == 0 ? latency_ns : std::min(latency.min_ns, latency_ns);
+            latency.max_ns = std::max(latency.max_ns, latency_ns);
+            latency.total_ns += latency_ns;
+            latency.last_ns = latency_ns;
+            ++latency.samples;
+            m_has_input_timestamp = false;
+        }
+        if(rslt == VK_ERROR_OUT_OF_DATE_KHR || rslt == VK_SUBOPTIMAL_KHR) {
+            m_swapchain_dirty = true;
+            return rslt;
+        }
+        ZERO_VK_CHECK_EXCEPT(rslt);
+        return rslt;
+    }
+
+    void VulkanWindow::setAcquireTimeout(const uint64_t &timeout_ns) {
+        m_acquire_timeout = timeout_ns;
+    }
+
+    uint64_t VulkanWindow::getAcquireTimeout() const {
+        return m_acquire_timeout;
+    }
+
+    void VulkanWindow::requestSwapchainRecreation() {
+        m_swapchain_dirty = true;
+    }
+
+    const VulkanWindowStatistics& VulkanWindow::getStatistics() const {
+        return m_statistics;
+    }
+
+    void VulkanWindow::resetStatistics() {
+        m_statistics = VulkanWindowStatistics{};
     }
 
     uint32_t VulkanWindow::getAcquiredSwapchain() const {
@@ -343,24 +767,50 @@ namespace ZEROengine {
 
     void VulkanWindow::cleanup_swapChain() {
         for(auto &framebuffer : m_vk_swapchain_framebuffers) {
-            vkDestroyFramebuffer(m_vk_device, framebuffer, nullptr);
+            vkDestroyFramebuffer(m_vk_device, framebuffer, VulkanHostAllocator::getCallbacks());
         }
         for(auto &img_view : m_vk_swapchain_image_views) {
-            vkDestroyImageView(m_vk_device, img_view, nullptr);
+            vkDestroyImageView(m_vk_device, img_view, VulkanHostAllocator::getCallbacks());
         }
-        vkDestroySwapchainKHR(m_vk_device, m_vk_swapchain, nullptr);
+        releaseDepthTarget();
+        vkDestroySwapchainKHR(m_vk_device, m_vk_swapchain, VulkanHostAllocator::getCallbacks());
     }
 
     void VulkanWindow::reload_swapChain() {
-        // should only be called in context when none of these is in used.
-        cleanup_swapChain();
+        ++m_statistics.swapchain_recreations;
+        std::shared_ptr<VulkanDeletionQueue> deletion_queue = m_deletion_queue.lock();
+        if(!deletion_queue) {
+            // without a deletion queue, should only be called in context when none of these is in used.
+            cleanup_swapChain();
+            initSwapChain();
+            initSwapChainRenderTargets();
+            return;
+        }
 
-        initSwapChain();
+        VkSwapchainKHR old_swapchain = m_vk_swapchain;
+        std::vector<VkImageView> old_image_views = std::move(m_vk_swapchain_image_views);
+        std::vector<VkFramebuffer> old_framebuffers = std::move(m_vk_swapchain_framebuffers);
+        m_vk_swapchain_image_views.clear();
+        m_vk_swapchain_framebuffers.clear();
+        // the extent may have changed, the pool hands the same image back otherwise
+        releaseDepthTarget();
+
+        // the presentation engine keeps presenting already queued images of the old swapchain while the new one is built
+        initSwapChain(old_swapchain);
         initSwapChainRenderTargets();
+
+        // frames in flight may still reference the old targets, free them once the GPU has passed the last submission
+        for(const VkFramebuffer &framebuffer : old_framebuffers) {
+            deletion_queue->retireFramebuffer(framebuffer);
+        }
+        for(const VkImageView &img_view : old_image_views) {
+            deletion_queue->retireImageView(img_view);
+        }
+        deletion_queue->retireSwapchain(old_swapchain);
     }
 
     void VulkanWindow::cleanup() {
-        vkDestroyRenderPass(m_vk_device, m_vk_swapchain_renderpass, nullptr);
+        vkDestroyRenderPass(m_vk_device, m_vk_swapchain_renderpass, VulkanHostAllocator::getCallbacks());
         cleanup_swapChain();
     }
 } // namespace ZEROengine
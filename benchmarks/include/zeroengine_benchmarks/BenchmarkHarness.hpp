@@ -0,0 +1,146 @@
+#ifndef ZEROENGINE_BENCHMARKHARNESS_H
+#define ZEROENGINE_BENCHMARKHARNESS_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include "zeroengine_graphical/GPUDevice.hpp"
+#include "zeroengine_graphical/GPUCommandBuffer.hpp"
+#include "zeroengine_null/NullGraphicalModule.hpp"
+#include "zeroengine_software/SoftwareGraphicalModule.hpp"
+
+namespace ZEROengine {
+    struct BenchmarkConfig {
+        std::string backend = "null"; // null or software
+        std::vector<std::string> scenes; // every scene when empty
+        uint32_t frames = 1000;
+        uint32_t warmup_frames = 100;
+        uint32_t width = 1280;
+        uint32_t height = 720;
+        uint32_t threads = 0; // software rasterizer threads, 0 for the hardware concurrency
+        uint64_t seed = 0x5EED;
+        bool strict_allocations = false; // fail a scene whose measured frames allocate, needs ZEROENGINE_ALLOCATION_TRACKING
+    };
+
+    /**
+     * @brief xorshift64* generator, scenes draw every random value from it so runs with the same seed do the same work.
+     *
+     */
+    class BenchmarkRandom {
+    private:
+        uint64_t m_state;
+
+    public:
+        BenchmarkRandom(const uint64_t &seed);
+
+        uint64_t next();
+        uint32_t nextBelow(const uint32_t &bound);
+        float nextFloat(); // [0, 1)
+    }; // class BenchmarkRandom
+
+    /**
+     * @brief A fixed workload recorded once per frame. Scenes only use the backend-agnostic device and command streams.
+     *
+     */
+    class BenchmarkScene {
+    public:
+        virtual ~BenchmarkScene() = default;
+
+        virtual const char* getName() const = 0;
+        virtual void setup(GPUDevice &device, const uint64_t &seed) = 0;
+
+        /**
+         * @brief Build and record one frame.
+         *
+         * @return uint64_t Number of draws recorded.
+         */
+        virtual uint64_t recordFrame(const uint64_t &frame, GraphicalCommandBuffer &command_buffer) = 0;
+        virtual void cleanup(GPUDevice &device) = 0;
+    }; // class BenchmarkScene
+
+    /**
+     * @brief The graphical module a benchmark runs on. Both backends are headless and GPU time is not measured. The
+     * software backend reports the wall time of its rasterizer flush separately, the null backend has none.
+     *
+     */
+    class BenchmarkBackend {
+    private:
+        std::string m_name;
+        std::unique_ptr<NullGraphicalModule> m_null_module;
+        std::unique_ptr<SoftwareGraphicalModule> m_software_module;
+
+        std::shared_ptr<GPUDevice> m_device;
+        std::shared_ptr<GraphicalCommandBuffer> m_command_buffer;
+
+    public:
+        /**
+         * @brief Create and initialize a backend.
+         *
+         * @return std::unique_ptr<BenchmarkBackend> nullptr for an unknown backend name.
+         */
+        static std::unique_ptr<BenchmarkBackend> create(const BenchmarkConfig &config);
+
+        BenchmarkBackend(const std::string &name);
+        ~BenchmarkBackend();
+
+        const std::string& getName() const;
+        GPUDevice& getDevice();
+        GraphicalCommandBuffer& getCommandBuffer();
+        bool hasRasterTime() const;
+
+        void drawFrame();
+        void cleanup();
+    }; // class BenchmarkBackend
+
+    struct BenchmarkDistribution {
+        double mean = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+
+        /**
+         * @brief Nearest-rank percentiles of the samples.
+         *
+         */
+        static BenchmarkDistribution compute(std::vector<double> samples);
+    };
+
+    struct BenchmarkSceneResult {
+        std::string name;
+        uint32_t frames = 0;
+        BenchmarkDistribution cpu_frame_ms; // recording and submission, the rasterizer flush excluded
+        bool has_raster_time = false;
+        BenchmarkDistribution raster_ms; // wall time of the software rasterizer flush, not a GPU time
+        uint64_t draws = 0;
+        double draws_per_frame = 0.0;
+        uint64_t setup_buffer_allocations = 0;
+        uint64_t frame_buffer_allocations = 0; // during the measured frames, 0 in a steady state
+        // heap activity of the measured frames, only counted when built with ZEROENGINE_ALLOCATION_TRACKING
+        uint64_t heap_allocations = 0;
+        uint64_t heap_bytes = 0;
+        uint64_t max_frame_heap_allocations = 0;
+        std::string top_heap_scope;
+    };
+
+    /**
+     * @brief Runs each scene for the warm-up frames, then measures the configured frame count.
+     *
+     */
+    class BenchmarkRunner {
+    private:
+        BenchmarkConfig m_config;
+
+    public:
+        BenchmarkRunner(const BenchmarkConfig &config);
+
+        BenchmarkSceneResult run(BenchmarkBackend &backend, BenchmarkScene &scene);
+        void writeJSON(std::ostream &output, const std::vector<BenchmarkSceneResult> &results) const;
+    }; // class BenchmarkRunner
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_BENCHMARKHARNESS_H
@@ -0,0 +1,110 @@
+#ifndef ZEROENGINE_BENCHMARKSCENES_H
+#define ZEROENGINE_BENCHMARKSCENES_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "zeroengine_graphical/GPUDrawList.hpp"
+#include "zeroengine_graphical/GPUCommandStream.hpp"
+#include "zeroengine_graphical/GPUStreamingBuffer.hpp"
+#include "zeroengine_graphical/GPURenderGraph.hpp"
+#include "zeroengine_benchmarks/BenchmarkHarness.hpp"
+
+namespace ZEROengine {
+    constexpr uint32_t const_benchmark_mesh_count = 32;
+    constexpr uint32_t const_benchmark_pipeline_count = 16;
+    constexpr uint32_t const_benchmark_material_count = 64;
+    constexpr uint32_t const_benchmark_sorted_draw_count = 4096;
+    constexpr uint32_t const_benchmark_instance_count = 16384;
+    constexpr uint32_t const_benchmark_mesh_vertices = 12; // four triangles
+
+    /**
+     * @brief Small triangle meshes in the SoftwareVertex layout, shared by the draw scenes.
+     *
+     */
+    class BenchmarkMeshSet {
+    private:
+        std::vector<GPUBufferHandle> m_vertex_buffers;
+
+    public:
+        void create(GPUDevice &device, BenchmarkRandom &random, const uint32_t &mesh_count);
+        GPUBufferHandle getVertexBuffer(const uint32_t &mesh) const;
+        void release(GPUDevice &device);
+    }; // class BenchmarkMeshSet
+
+    /**
+     * @brief Thousands of unique draws with shuffled state, sorted by key and emitted with redundant binds skipped.
+     * Depths change every frame so the sort does real work.
+     *
+     */
+    class SortedDrawsScene : public BenchmarkScene {
+    private:
+        BenchmarkMeshSet m_meshes;
+        std::vector<GPUDrawDescription> m_draws;
+        BenchmarkRandom m_random;
+        GPUDrawList m_draw_list;
+        GPUCommandStream m_stream;
+
+    public:
+        SortedDrawsScene();
+
+        const char* getName() const override;
+        void setup(GPUDevice &device, const uint64_t &seed) override;
+        uint64_t recordFrame(const uint64_t &frame, GraphicalCommandBuffer &command_buffer) override;
+        void cleanup(GPUDevice &device) override;
+    }; // class SortedDrawsScene
+
+    /**
+     * @brief Many instances of few meshes, merged into instanced draws whose transforms are streamed every frame.
+     *
+     */
+    class InstancedDrawsScene : public BenchmarkScene {
+    private:
+        BenchmarkMeshSet m_meshes;
+        std::vector<uint32_t> m_instance_meshes;
+        std::vector<float> m_instance_phases;
+        std::unique_ptr<GPUStreamingBuffer> m_instance_buffer;
+        GPUDrawList m_draw_list;
+        GPUCommandStream m_stream;
+
+    public:
+        const char* getName() const override;
+        void setup(GPUDevice &device, const uint64_t &seed) override;
+        uint64_t recordFrame(const uint64_t &frame, GraphicalCommandBuffer &command_buffer) override;
+        void cleanup(GPUDevice &device) override;
+    }; // class InstancedDrawsScene
+
+    /**
+     * @brief Declares a deferred frame graph once and recompiles it every frame, measuring pass ordering, culling,
+     * barrier derivation and aliasing. Recompiling reuses the graph storage, so a steady-state frame does not allocate.
+     * Nothing is drawn.
+     *
+     */
+    class RenderGraphScene : public BenchmarkScene {
+    private:
+        GPURenderGraph m_graph;
+        GPURenderGraphMemoryQuery m_memory_query;
+
+    public:
+        const char* getName() const override;
+        void setup(GPUDevice &device, const uint64_t &seed) override;
+        uint64_t recordFrame(const uint64_t &frame, GraphicalCommandBuffer &command_buffer) override;
+        void cleanup(GPUDevice &device) override;
+    }; // class RenderGraphScene
+
+    /**
+     * @brief Names of every scene, in the order they run by default.
+     *
+     */
+    std::vector<std::string> getBenchmarkSceneNames();
+
+    /**
+     * @brief Create a scene by name, nullptr if the name is unknown.
+     *
+     */
+    std::unique_ptr<BenchmarkScene> createBenchmarkScene(const std::string &name);
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_BENCHMARKSCENES_H
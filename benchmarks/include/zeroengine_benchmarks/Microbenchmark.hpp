@@ -0,0 +1,100 @@
+#ifndef ZEROENGINE_MICROBENCHMARK_H
+#define ZEROENGINE_MICROBENCHMARK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <functional>
+
+namespace ZEROengine {
+    /**
+     * @brief Keep a value alive so the compiler cannot drop the computation producing it.
+     *
+     */
+    template<typename T>
+    inline void doNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    /**
+     * @brief Runs the measured operation the given number of times. Setup belongs outside of the body, in its captures.
+     *
+     */
+    typedef std::function<void(const uint64_t &iterations)> MicrobenchmarkBody;
+
+    struct Microbenchmark {
+        std::string name;
+        MicrobenchmarkBody body;
+        uint64_t items_per_iteration; // bytes or commands processed by one iteration, for throughput
+        const char* item_unit;
+    };
+
+    struct MicrobenchmarkConfig {
+        std::string filter; // runs the benchmarks whose name contains it, every benchmark when empty
+        uint32_t repetitions = 10;
+        double min_repetition_ms = 20.0; // iterations are calibrated so a repetition lasts at least this long
+        int32_t cpu = -1; // core to pin the thread to, -1 to leave it to the scheduler
+    };
+
+    /**
+     * @brief Per iteration timings over the repetitions. cv is the coefficient of variation, stddev / mean.
+     *
+     */
+    struct MicrobenchmarkResult {
+        std::string name;
+        uint64_t iterations = 0;
+        uint32_t repetitions = 0;
+        double mean_ns = 0.0;
+        double median_ns = 0.0;
+        double min_ns = 0.0;
+        double max_ns = 0.0;
+        double stddev_ns = 0.0;
+        double cv = 0.0;
+        uint64_t items_per_iteration = 0;
+        const char* item_unit = "";
+        double items_per_second = 0.0; // from the median
+    };
+
+    /**
+     * @brief Registry and runner of microbenchmarks. Each benchmark is calibrated, run once unmeasured, then measured
+     * over the configured repetitions with the same iteration count, so the spread between repetitions shows how far
+     * a difference between two runs can be trusted.
+     *
+     */
+    class MicrobenchmarkSuite {
+    private:
+        std::vector<Microbenchmark> m_benchmarks;
+        MicrobenchmarkConfig m_config;
+        bool m_pinned;
+
+    private:
+        uint64_t calibrate(const Microbenchmark &benchmark) const;
+
+    public:
+        MicrobenchmarkSuite(const MicrobenchmarkConfig &config);
+
+        void add(const std::string &name, const MicrobenchmarkBody &body, const uint64_t &items_per_iteration = 0, const char* item_unit = "");
+
+        /**
+         * @brief Pin the calling thread to the configured core.
+         *
+         * @return bool false if no core is configured or pinning is not supported.
+         */
+        bool pinThread();
+
+        std::vector<std::string> getNames() const;
+        std::vector<MicrobenchmarkResult> run();
+        void writeJSON(std::ostream &output, const std::vector<MicrobenchmarkResult> &results) const;
+    }; // class MicrobenchmarkSuite
+
+    void registerCoreMicrobenchmarks(MicrobenchmarkSuite &suite);
+    void registerGraphicalMicrobenchmarks(MicrobenchmarkSuite &suite);
+} // namespace ZEROengine
+
+#endif // #ifndef ZEROENGINE_MICROBENCHMARK_H
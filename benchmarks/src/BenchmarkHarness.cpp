@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "zeroengine_core/AllocationTracker.hpp"
+#include "zeroengine_core/ZERODefines.hpp"
+#include "zeroengine_benchmarks/BenchmarkHarness.hpp"
+
+namespace ZEROengine {
+    BenchmarkRandom::BenchmarkRandom(const uint64_t &seed) :
+    m_state{seed != 0 ? seed : 0x9E3779B97F4A7C15ull}
+    {}
+
+    uint64_t BenchmarkRandom::next() {
+        m_state ^= m_state >> 12;
+        m_state ^= m_state << 25;
+        m_state ^= m_state >> 27;
+        return m_state * 0x2545F4914F6CDD1Dull;
+    }
+
+    uint32_t BenchmarkRandom::nextBelow(const uint32_t &bound) {
+        return static_cast<uint32_t>((next() >> 32) % bound);
+    }
+
+    float BenchmarkRandom::nextFloat() {
+        return static_cast<float>(next() >> 40) / static_cast<float>(1u << 24);
+    }
+
+    std::unique_ptr<BenchmarkBackend> BenchmarkBackend::create(const BenchmarkConfig &config) {
+        std::unique_ptr<BenchmarkBackend> backend = std::make_unique<BenchmarkBackend>(config.backend);
+        if(config.backend == "null") {
+            backend->m_null_module = std::make_unique<NullGraphicalModule>();
+            backend->m_null_module->initGraphicalModule();
+            backend->m_device = backend->m_null_module->getNullDevice().lock();
+        } else if(config.backend == "software") {
+            backend->m_software_module = std::make_unique<SoftwareGraphicalModule>(config.width, config.height, config.threads);
+            backend->m_software_module->initGraphicalModule();
+            backend->m_device = backend->m_software_module->getSoftwareDevice().lock();
+        } else {
+            return nullptr;
+        }
+        std::shared_ptr<GraphicalContext> context = backend->m_device->allocateGraphicalContext().lock();
+        ZERO_ASSERT(context, "Benchmark backend cannot allocate a graphical context.");
+        backend->m_command_buffer = context->allocateCommandBuffer().lock();
+        return backend;
+    }
+
+    BenchmarkBackend::BenchmarkBackend(const std::string &name) :
+    m_name{name},
+    m_null_module{},
+    m_software_module{},
+    m_device{},
+    m_command_buffer{}
+    {}
+
+    BenchmarkBackend::~BenchmarkBackend() {
+        cleanup();
+    }
+
+    const std::string& BenchmarkBackend::getName() const {
+        return m_name;
+    }
+
+    GPUDevice& BenchmarkBackend::getDevice() {
+        return *m_device;
+    }
+
+    GraphicalCommandBuffer& BenchmarkBackend::getCommandBuffer() {
+        return *m_command_buffer;
+    }
+
+    bool BenchmarkBackend::hasRasterTime() const {
+        return m_software_module != nullptr;
+    }
+
+    void BenchmarkBackend::drawFrame() {
+        if(m_null_module) {
+            m_null_module->drawFrame();
+        }
+        if(m_software_module) {
+            m_software_module->drawFrame();
+        }
+    }
+
+    void BenchmarkBackend::cleanup() {
+        m_command_buffer.reset();
+        m_device.reset();
+        if(m_null_module) {
+            m_null_module->cleanup();
+            m_null_module.reset();
+        }
+        if(m_software_module) {
+            m_software_module->cleanup();
+            m_software_module.reset();
+        }
+    }
+
+    BenchmarkDistribution BenchmarkDistribution::compute(std::vector<double> samples) {
+        BenchmarkDistribution distribution{};
+        if(samples.empty()) {
+            return distribution;
+        }
+        std::sort(samples.begin(), samples.end());
+        double sum = 0.0;
+        for(const double &sample : samples) {
+            sum += sample;
+        }
+        auto percentile = [&samples](const double &p) {
+            std::size_t rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(samples.size())));
+            return samples[std::max<std::size_t>(rank, 1) - 1];
+        };
+        distribution.mean = sum / static_cast<double>(samples.size());
+        distribution.p50 = percentile(0.50);
+        distribution.p95 = percentile(0.95);
+        distribution.p99 = percentile(0.99);
+        distribution.min = samples.front();
+        distribution.max = samples.back();
+        return distribution;
+    }
+
+    BenchmarkRunner::BenchmarkRunner(const BenchmarkConfig &config) :
+    m_config{config}
+    {}
+
+    BenchmarkSceneResult BenchmarkRunner::run(BenchmarkBackend &backend, BenchmarkScene &scene) {
+        typedef std::chrono::steady_clock Clock;
+        GPUDevice &device = backend.getDevice();
+        GraphicalCommandBuffer &command_buffer = backend.getCommandBuffer();
+
+        BenchmarkSceneResult result{};
+        result.name = scene.getName();
+        result.frames = m_config.frames;
+        result.has_raster_time = backend.hasRasterTime();
+
+        uint64_t allocations_before_setup = device.getAllocationStatistics().buffers_allocated;
+        scene.setup(device, m_config.seed);
+        for(uint32_t frame = 0; frame < m_config.warmup_frames; ++frame) {
+            scene.recordFrame(frame, command_buffer);
+            backend.drawFrame();
+        }
+        // sized up front so the harness does not allocate between measured frames
+        std::vector<double> cpu_samples;
+        std::vector<double> raster_samples;
+        cpu_samples.reserve(m_config.frames);
+        raster_samples.reserve(m_config.frames);
+        // closes the warm-up so that the measured frames start from fresh counters
+        AllocationTracker::endFrame();
+        AllocationTracker::setStrictMode(m_config.strict_allocations);
+        AllocationCounters scope_allocations[const_allocation_max_scopes] = {};
+        uint64_t allocations_before_frames = device.getAllocationStatistics().buffers_allocated;
+        result.setup_buffer_allocations = allocations_before_frames - allocations_before_setup;
+
+        for(uint32_t frame = 0; frame < m_config.frames; ++frame) {
+            Clock::time_point frame_start = Clock::now();
+            {
+                ZERO_ALLOCATION_SCOPE("record");
+                result.draws += scene.recordFrame(m_config.warmup_frames + frame, command_buffer);
+            }
+            Clock::time_point record_end = Clock::now();
+            {
+                ZERO_ALLOCATION_SCOPE("draw");
+                backend.drawFrame();
+            }
+            Clock::time_point frame_end = Clock::now();
+            AllocationTracker::endFrame();
+
+            const AllocationFrameStatistics &heap = AllocationTracker::getLastFrame();
+            result.heap_allocations += heap.total.allocations;
+            result.heap_bytes += heap.total.bytes;
+            result.max_frame_heap_allocations = std::max(result.max_frame_heap_allocations, heap.total.allocations);
+            for(uint32_t scope = 0; scope < heap.scope_count; ++scope) {
+                scope_allocations[scope].allocations += heap.scopes[scope].allocations;
+            }
+
+            if(result.has_raster_time) {
+                cpu_samples.push_back(std::chrono::duration<double, std::milli>(record_end - frame_start).count());
+                raster_samples.push_back(std::chrono::duration<double, std::milli>(frame_end - record_end).count());
+            } else {
+                cpu_samples.push_back(std::chrono::duration<double, std::milli>(frame_end - frame_start).count());
+            }
+        }
+        result.frame_buffer_allocations = device.getAllocationStatistics().buffers_allocated - allocations_before_frames;
+        AllocationTracker::setStrictMode(false);
+        uint32_t top_scope = 0;
+        for(uint32_t scope = 1; scope < const_allocation_max_scopes; ++scope) {
+            if(scope_allocations[scope].allocations > scope_allocations[top_scope].allocations) {
+                top_scope = scope;
+            }
+        }
+        if(result.heap_allocations > 0) {
+            result.top_heap_scope = AllocationTracker::getScopeName(top_scope);
+        }
+        scene.cleanup(device);
+
+        result.cpu_frame_ms = BenchmarkDistribution::compute(std::move(cpu_samples));
+        result.raster_ms = BenchmarkDistribution::compute(std::move(raster_samples));
+        result.draws_per_frame = m_config.frames > 0 ? static_cast<double>(result.draws) / m_config.frames : 0.0;
+        return result;
+    }
+
+    static void writeDistribution(std::ostream &output, const BenchmarkDistribution &distribution) {
+        output << "{ \"mean\": " << distribution.mean
+            << ", \"p50\": " << distribution.p50
+            << ", \"p95\": " << distribution.p95
+            << ", \"p99\": " << distribution.p99
+            << ", \"min\": " << distribution.min
+            << ", \"max\": " << distribution.max << " }";
+    }
+
+    void BenchmarkRunner::writeJSON(std::ostream &output, const std::vector<BenchmarkSceneResult> &results) const {
+        // names come from the scene table and the command line backend list, neither needs escaping
+        output << "{\n";
+        output << "  \"config\": {\n";
+        output << "    \"backend\": \"" << m_config.backend << "\",\n";
+        output << "    \"frames\": " << m_config.frames << ",\n";
+        output << "    \"warmup_frames\": " << m_config.warmup_frames << ",\n";
+        output << "    \"width\": " << m_config.width << ",\n";
+        output << "    \"height\": " << m_config.height << ",\n";
+        output << "    \"threads\": " << m_config.threads << ",\n";
+        output << "    \"seed\": " << m_config.seed << ",\n";
+        output << "    \"allocation_tracking\": " << (AllocationTracker::isEnabled() ? "true" : "false") << ",\n";
+        output << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << "\n";
+        output << "  },\n";
+        output << "  \"scenes\": [";
+        for(std::size_t i = 0; i < results.size(); ++i) {
+            const BenchmarkSceneResult &result = results[i];
+            output << (i == 0 ? "\n" : ",\n");
+            output << "    {\n";
+            output << "      \"name\": \"" << result.name << "\",\n";
+            output << "      \"frames\": " << result.frames << ",\n";
+            output << "      \"cpu_frame_ms\": ";
+            writeDistribution(output, result.cpu_frame_ms);
+            output << ",\n";
+            output << "      \"raster_ms\": ";
+            if(result.has_raster_time) {
+                writeDistribution(output, result.raster_ms);
+            } else {
+                output << "null";
+            }
+            output << ",\n";
+            output << "      \"draws\": " << result.draws << ",\n";
+            output << "      \"draws_per_frame\": " << result.draws_per_frame << ",\n";
+            output << "      \"allocations\": { \"setup_buffers\": " << result.setup_buffer_allocations
+                << ", \"frame_buffers\": " << result.frame_buffer_allocations << " },\n";
+            output << "      \"heap\": ";
+            if(AllocationTracker::isEnabled()) {
+                output << "{ \"allocations\": " << result.heap_allocations
+                    << ", \"bytes\": " << result.heap_bytes
+                    << ", \"allocations_per_frame\": " << (result.frames > 0 ? static_cast<double>(result.heap_allocations) / result.frames : 0.0)
+                    << ", \"max_frame_allocations\": " << result.max_frame_heap_allocations
+                    << ", \"top_scope\": \"" << result.top_heap_scope << "\" }\n";
+            } else {
+                output << "null\n";
+            }
+            output << "    }";
+        }
+        output << "\n  ]\n";
+        output << "}\n";
+    }
+} // namespace ZEROengine
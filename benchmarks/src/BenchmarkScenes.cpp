@@ -0,0 +1,267 @@
+#include <cmath>
+#include <string>
+
+#include "zeroengine_core/ZERODefines.hpp"
+#include "zeroengine_software/SoftwareDefines.hpp"
+#include "zeroengine_benchmarks/BenchmarkScenes.hpp"
+
+namespace ZEROengine {
+    void BenchmarkMeshSet::create(GPUDevice &device, BenchmarkRandom &random, const uint32_t &mesh_count) {
+        // small triangles scattered over the screen, so the software rasterizer touches many tiles with little fill
+        std::vector<SoftwareVertex> vertices(const_benchmark_mesh_vertices);
+        for(uint32_t mesh = 0; mesh < mesh_count; ++mesh) {
+            for(uint32_t triangle = 0; triangle < const_benchmark_mesh_vertices / 3; ++triangle) {
+                float center_x = random.nextFloat() * 1.8f - 0.9f;
+                float center_y = random.nextFloat() * 1.8f - 0.9f;
+                float r = random.nextFloat();
+                float g = random.nextFloat();
+                float b = random.nextFloat();
+                vertices[triangle * 3 + 0] = {center_x, center_y - 0.015f, r, g, b};
+                vertices[triangle * 3 + 1] = {center_x + 0.015f, center_y + 0.015f, r, g, b};
+                vertices[triangle * 3 + 2] = {center_x - 0.015f, center_y + 0.015f, r, g, b};
+            }
+
+            GPUBufferDescription buffer_description{};
+            buffer_description.stride = sizeof(SoftwareVertex);
+            buffer_description.size = sizeof(SoftwareVertex) * vertices.size();
+            buffer_description.elements_count = static_cast<uint32_t>(vertices.size());
+            buffer_description.m_usage = ZERO_BUFFER_USAGE_VERTEX_BUFFER;
+            buffer_description.access = ZERO_BUFFER_ACCESS_STATIC;
+            GPUBufferHandle buffer_handle = const_gpu_invalid_handle;
+            ZEROResult result = device.allocateBuffer(buffer_description, buffer_handle);
+            if(result.result_code != ZEROResultEnum::ZERO_SUCCESS) {
+                ZERO_EXCEPT(result.result_code, result.result_string);
+            }
+            result = device.writeBuffer(buffer_handle, 0, vertices.data(), buffer_description.size);
+            if(result.result_code != ZEROResultEnum::ZERO_SUCCESS) {
+                ZERO_EXCEPT(result.result_code, result.result_string);
+            }
+            m_vertex_buffers.push_back(buffer_handle);
+        }
+    }
+
+    GPUBufferHandle BenchmarkMeshSet::getVertexBuffer(const uint32_t &mesh) const {
+        return m_vertex_buffers[mesh];
+    }
+
+    void BenchmarkMeshSet::release(GPUDevice &device) {
+        for(const GPUBufferHandle &buffer_handle : m_vertex_buffers) {
+            device.releaseBuffer(buffer_handle);
+        }
+        m_vertex_buffers.clear();
+    }
+
+    SortedDrawsScene::SortedDrawsScene() :
+    m_meshes{},
+    m_draws{},
+    m_random{0},
+    m_draw_list{},
+    m_stream{}
+    {}
+
+    const char* SortedDrawsScene::getName() const {
+        return "sorted_draws";
+    }
+
+    void SortedDrawsScene::setup(GPUDevice &device, const uint64_t &seed) {
+        m_random = BenchmarkRandom(seed);
+        m_meshes.create(device, m_random, const_benchmark_mesh_count);
+        m_draws.resize(const_benchmark_sorted_draw_count);
+        for(GPUDrawDescription &draw : m_draws) {
+            uint32_t mesh = m_random.nextBelow(const_benchmark_mesh_count);
+            draw.pipeline = m_random.nextBelow(const_benchmark_pipeline_count);
+            draw.material = m_random.nextBelow(const_benchmark_material_count);
+            draw.vertex_buffer = m_meshes.getVertexBuffer(mesh);
+            draw.vertex_count = const_benchmark_mesh_vertices;
+        }
+        m_draw_list.reserve(m_draws.size());
+    }
+
+    uint64_t SortedDrawsScene::recordFrame(const uint64_t &, GraphicalCommandBuffer &command_buffer) {
+        m_draw_list.reset();
+        for(const GPUDrawDescription &draw : m_draws) {
+            m_draw_list.submit(0, m_random.nextFloat(), draw);
+        }
+        m_draw_list.sort();
+        m_stream.reset();
+        m_draw_list.emit(m_stream);
+        command_buffer.execute(m_stream);
+        return m_draw_list.getStatistics().draws;
+    }
+
+    void SortedDrawsScene::cleanup(GPUDevice &device) {
+        m_meshes.release(device);
+        m_draws.clear();
+        m_draw_list.reset();
+        m_stream.reset();
+    }
+
+    const char* InstancedDrawsScene::getName() const {
+        return "instanced_draws";
+    }
+
+    void InstancedDrawsScene::setup(GPUDevice &device, const uint64_t &seed) {
+        BenchmarkRandom random(seed);
+        m_meshes.create(device, random, const_benchmark_mesh_count);
+        m_instance_meshes.resize(const_benchmark_instance_count);
+        m_instance_phases.resize(const_benchmark_instance_count);
+        for(uint32_t i = 0; i < const_benchmark_instance_count; ++i) {
+            m_instance_meshes[i] = random.nextBelow(const_benchmark_mesh_count);
+            m_instance_phases[i] = random.nextFloat() * 6.2831853f;
+        }
+        // two frames in flight, the backends complete every frame in drawFrame()
+        m_instance_buffer = std::make_unique<GPUStreamingBuffer>(
+            &device, static_cast<uint32_t>(sizeof(GPUInstanceTransform)), const_benchmark_instance_count, 2, ZERO_BUFFER_USAGE_VERTEX_BUFFER);
+        m_draw_list.setInstanceBuffer(m_instance_buffer.get(), 1);
+        m_draw_list.reserve(const_benchmark_instance_count);
+    }
+
+    uint64_t InstancedDrawsScene::recordFrame(const uint64_t &frame, GraphicalCommandBuffer &command_buffer) {
+        m_instance_buffer->beginFrame();
+        m_draw_list.reset();
+        float time = static_cast<float>(frame) * (1.0f / 60.0f);
+        GPUInstanceTransform transform{};
+        transform.model[0] = 1.0f;
+        transform.model[5] = 1.0f;
+        transform.model[10] = 1.0f;
+        transform.model[15] = 1.0f;
+        for(uint32_t i = 0; i < const_benchmark_instance_count; ++i) {
+            uint32_t mesh = m_instance_meshes[i];
+            GPUDrawDescription draw{};
+            draw.pipeline = mesh % const_benchmark_pipeline_count;
+            draw.material = mesh;
+            draw.vertex_buffer = m_meshes.getVertexBuffer(mesh);
+            draw.vertex_count = const_benchmark_mesh_vertices;
+            float phase = m_instance_phases[i] + time;
+            transform.model[12] = std::cos(phase);
+            transform.model[13] = std::sin(phase);
+            m_draw_list.submitInstance(0, 0.5f + 0.5f * transform.model[13], draw, transform);
+        }
+        m_draw_list.sort();
+        m_stream.reset();
+        m_draw_list.emit(m_stream);
+        m_instance_buffer->flush();
+        command_buffer.execute(m_stream);
+        return m_draw_list.getStatistics().draws;
+    }
+
+    void InstancedDrawsScene::cleanup(GPUDevice &device) {
+        m_draw_list.setInstanceBuffer(nullptr, 1);
+        m_draw_list.reset();
+        m_instance_buffer.reset();
+        m_meshes.release(device);
+        m_stream.reset();
+    }
+
+    const char* RenderGraphScene::getName() const {
+        return "render_graph";
+    }
+
+    void RenderGraphScene::setup(GPUDevice &, const uint64_t &) {
+        const uint32_t width = 1920;
+        const uint32_t height = 1080;
+        constexpr uint32_t format_rgba8 = 37; // VK_FORMAT_R8G8B8A8_UNORM
+        constexpr uint32_t format_rgba16f = 97; // VK_FORMAT_R16G16B16A16_SFLOAT
+        constexpr uint32_t format_depth = 126; // VK_FORMAT_D32_SFLOAT
+        GPURenderGraphPassExecute nothing = [](GPURenderGraphPassContext &) {};
+
+        m_graph.clear();
+        GPURenderGraphResource backbuffer = m_graph.importTexture(
+            "backbuffer", {width, height, format_rgba8, 1}, nullptr, nullptr, ZERO_ACCESS_NONE, ZERO_ACCESS_PRESENT);
+        GPURenderGraphResource albedo = m_graph.createTexture("albedo", {width, height, format_rgba8, 1});
+        GPURenderGraphResource normal = m_graph.createTexture("normal", {width, height, format_rgba16f, 1});
+        GPURenderGraphResource material = m_graph.createTexture("material", {width, height, format_rgba8, 1});
+        GPURenderGraphResource depth = m_graph.createTexture("depth", {width, height, format_depth, 1});
+        GPURenderGraphResource occlusion = m_graph.createTexture("occlusion", {width, height, format_rgba8, 1});
+        GPURenderGraphResource lighting = m_graph.createTexture("lighting", {width, height, format_rgba16f, 1});
+        GPURenderGraphResource debug = m_graph.createTexture("debug", {width, height, format_rgba8, 1});
+
+        GPURenderGraphPass gbuffer_pass = m_graph.addPass("gbuffer", nothing);
+        m_graph.write(gbuffer_pass, albedo, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+        m_graph.write(gbuffer_pass, normal, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+        m_graph.write(gbuffer_pass, material, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+        m_graph.write(gbuffer_pass, depth, ZERO_ACCESS_DEPTH_ATTACHMENT_WRITE);
+
+        GPURenderGraphPass occlusion_pass = m_graph.addPass("occlusion", nothing);
+        m_graph.read(occlusion_pass, depth, ZERO_ACCESS_SHADER_SAMPLED_READ);
+        m_graph.read(occlusion_pass, normal, ZERO_ACCESS_SHADER_SAMPLED_READ);
+        m_graph.write(occlusion_pass, occlusion, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+
+        GPURenderGraphPass lighting_pass = m_graph.addPass("lighting", nothing);
+        m_graph.read(lighting_pass, albedo, ZERO_ACCESS_SHADER_SAMPLED_READ);
+        m_graph.read(lighting_pass, normal, ZERO_ACCESS_SHADER_SAMPLED_READ);
+        m_graph.read(lighting_pass, material, ZERO_ACCESS_SHADER_SAMPLED_READ);
+        m_graph.read(lighting_pass, occlusion, ZERO_ACCESS_SHADER_SAMPLED_READ);
+        m_graph.write(lighting_pass, lighting, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+
+        // bloom mip chain, each level aliasing the memory of levels that are no longer read
+        GPURenderGraphResource previous = lighting;
+        std::vector<GPURenderGraphResource> bloom_levels;
+        for(uint32_t level = 1; level <= 6; ++level) {
+            GPURenderGraphResource bloom = m_graph.createTexture(
+                "bloom_down" + std::to_string(level), {width >> level, height >> level, format_rgba16f, 1});
+            GPURenderGraphPass pass = m_graph.addPass("bloom_down" + std::to_string(level), nothing);
+            m_graph.read(pass, previous, ZERO_ACCESS_SHADER_SAMPLED_READ);
+            m_graph.write(pass, bloom, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+            bloom_levels.push_back(bloom);
+            previous = bloom;
+        }
+        for(uint32_t level = 5; level >= 1; --level) {
+            GPURenderGraphResource bloom = m_graph.createTexture(
+                "bloom_up" + std::to_string(level), {width >> level, height >> level, format_rgba16f, 1});
+            GPURenderGraphPass pass = m_graph.addPass("bloom_up" + std::to_string(level), nothing);
+            m_graph.read(pass, previous, ZERO_ACCESS_SHADER_SAMPLED_READ);
+            m_graph.read(pass, bloom_levels[level - 1], ZERO_ACCESS_SHADER_SAMPLED_READ);
+            m_graph.write(pass, bloom, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+            previous = bloom;
+        }
+
+        GPURenderGraphPass tonemap_pass = m_graph.addPass("tonemap", nothing);
+        m_graph.read(tonemap_pass, lighting, ZERO_ACCESS_SHADER_SAMPLED_READ);
+        m_graph.read(tonemap_pass, previous, ZERO_ACCESS_SHADER_SAMPLED_READ);
+        m_graph.write(tonemap_pass, backbuffer, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+
+        // never consumed, culled by compile()
+        GPURenderGraphPass debug_pass = m_graph.addPass("debug", nothing);
+        m_graph.read(debug_pass, depth, ZERO_ACCESS_SHADER_SAMPLED_READ);
+        m_graph.write(debug_pass, debug, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+
+        m_memory_query = [](const GPURenderGraphTextureDescription &description, const GPUAccessFlags &) {
+            GPUMemoryRequirements requirements{};
+            uint32_t texel_size = description.format == format_rgba16f ? 8 : 4;
+            requirements.size = static_cast<uint64_t>(description.width) * description.height * texel_size * description.samples;
+            requirements.alignment = 65536;
+            requirements.memory_type_bits = 0x1;
+            return requirements;
+        };
+        // the first compile sizes the scratch storage reused by the following ones
+        m_graph.compile(m_memory_query);
+    }
+
+    uint64_t RenderGraphScene::recordFrame(const uint64_t &, GraphicalCommandBuffer &) {
+        m_graph.compile(m_memory_query);
+        return 0;
+    }
+
+    void RenderGraphScene::cleanup(GPUDevice &) {
+        m_graph.clear();
+        m_memory_query = nullptr;
+    }
+
+    std::vector<std::string> getBenchmarkSceneNames() {
+        return {"sorted_draws", "instanced_draws", "render_graph"};
+    }
+
+    std::unique_ptr<BenchmarkScene> createBenchmarkScene(const std::string &name) {
+        if(name == "sorted_draws") {
+            return std::make_unique<SortedDrawsScene>();
+        }
+        if(name == "instanced_draws") {
+            return std::make_unique<InstancedDrawsScene>();
+        }
+        if(name == "render_graph") {
+            return std::make_unique<RenderGraphScene>();
+        }
+        return nullptr;
+    }
+} // namespace ZEROengine
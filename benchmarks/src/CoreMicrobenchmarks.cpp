@@ -0,0 +1,123 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "zeroengine_core/MurmurHash3.hpp"
+#include "zeroengine_core/ZEROUtilities.hpp"
+#include "zeroengine_benchmarks/Microbenchmark.hpp"
+
+namespace ZEROengine {
+    namespace {
+        // the pipeline and descriptor layout keys are a few dozen bytes, textures and shaders reach kilobytes
+        constexpr int const_hash_key_sizes[] = {4, 16, 64, 256, 1024, 4096};
+
+        struct HashedState {
+            uint64_t words[8];
+        };
+
+        struct SharedPayload {
+            uint64_t value;
+        };
+    } // namespace
+
+    void registerCoreMicrobenchmarks(MicrobenchmarkSuite &suite) {
+        std::shared_ptr<std::vector<uint8_t>> key = std::make_shared<std::vector<uint8_t>>(4096);
+        for(std::size_t i = 0; i < key->size(); ++i) {
+            (*key)[i] = static_cast<uint8_t>(i * 131 + 7);
+        }
+
+        for(const int &size : const_hash_key_sizes) {
+            suite.add("murmur3_x86_32/" + std::to_string(size), [key, size](const uint64_t &iterations) {
+                uint32_t hash = 0;
+                for(uint64_t i = 0; i < iterations; ++i) {
+                    // chaining the seed keeps the calls dependent, as in hash_combine chains
+                    MurmurHash3_x86_32(key->data(), size, hash, &hash);
+                }
+                doNotOptimize(hash);
+            }, static_cast<uint64_t>(size), "bytes");
+        }
+        for(const int &size : const_hash_key_sizes) {
+            suite.add("murmur3_x64_128/" + std::to_string(size), [key, size](const uint64_t &iterations) {
+                uint64_t hash[2] = {0, 0};
+                for(uint64_t i = 0; i < iterations; ++i) {
+                    MurmurHash3_x64_128(key->data(), size, static_cast<uint32_t>(hash[0]), hash);
+                }
+                doNotOptimize(hash);
+            }, static_cast<uint64_t>(size), "bytes");
+        }
+
+        // eight fields, the shape of the descriptor set layout key
+        suite.add("hash_combine/8_fields", [](const uint64_t &iterations) {
+            std::size_t hash = 0;
+            for(uint64_t i = 0; i < iterations; ++i) {
+                for(uint32_t field = 0; field < 8; ++field) {
+                    hash = hash_combine(hash, field);
+                }
+            }
+            doNotOptimize(hash);
+        }, 8, "fields");
+        suite.add("hash_combine/64_byte_struct", [](const uint64_t &iterations) {
+            HashedState state{};
+            std::size_t hash = 0;
+            for(uint64_t i = 0; i < iterations; ++i) {
+                state.words[0] = i;
+                hash = hash_combine(hash, state);
+            }
+            doNotOptimize(hash);
+        }, sizeof(HashedState), "bytes");
+
+        // the graphical layer hands objects around as shared_ptr and weak_ptr, every copy is an atomic increment
+        std::shared_ptr<SharedPayload> shared = std::make_shared<SharedPayload>();
+        std::weak_ptr<SharedPayload> weak = shared;
+        suite.add("pointer/raw_deref", [shared](const uint64_t &iterations) {
+            SharedPayload* raw = shared.get();
+            uint64_t sum = 0;
+            for(uint64_t i = 0; i < iterations; ++i) {
+                doNotOptimize(raw);
+                sum += raw->value;
+            }
+            doNotOptimize(sum);
+        });
+        suite.add("pointer/shared_ptr_copy", [shared](const uint64_t &iterations) {
+            uint64_t sum = 0;
+            for(uint64_t i = 0; i < iterations; ++i) {
+                std::shared_ptr<SharedPayload> copy = shared;
+                doNotOptimize(copy);
+                sum += copy->value;
+            }
+            doNotOptimize(sum);
+        });
+        suite.add("pointer/weak_ptr_lock", [weak](const uint64_t &iterations) {
+            uint64_t sum = 0;
+            for(uint64_t i = 0; i < iterations; ++i) {
+                std::shared_ptr<SharedPayload> locked = weak.lock();
+                doNotOptimize(locked);
+                sum += locked->value;
+            }
+            doNotOptimize(sum);
+        });
+        suite.add("pointer/weak_ptr_expired", [weak](const uint64_t &iterations) {
+            uint64_t alive = 0;
+            for(uint64_t i = 0; i < iterations; ++i) {
+                alive += weak.expired() ? 0 : 1;
+                doNotOptimize(alive);
+            }
+        });
+        suite.add("pointer/shared_ptr_by_value_call", [shared](const uint64_t &iterations) {
+            auto consume = [](std::shared_ptr<SharedPayload> payload) { return payload->value; };
+            uint64_t sum = 0;
+            for(uint64_t i = 0; i < iterations; ++i) {
+                sum += consume(shared);
+                doNotOptimize(sum);
+            }
+        });
+        suite.add("pointer/shared_ptr_by_reference_call", [shared](const uint64_t &iterations) {
+            auto consume = [](const std::shared_ptr<SharedPayload> &payload) { return payload->value; };
+            uint64_t sum = 0;
+            for(uint64_t i = 0; i < iterations; ++i) {
+                sum += consume(shared);
+                doNotOptimize(sum);
+            }
+        });
+    }
+} // namespace ZEROengine
@@ -0,0 +1,163 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "zeroengine_core/ZEROUtilities.hpp"
+#include "zeroengine_graphical/GPUCommandStream.hpp"
+#include "zeroengine_graphical/GPUDrawList.hpp"
+#include "zeroengine_graphical/GPUHandleTable.hpp"
+#include "zeroengine_null/NullCommandBuffer.hpp"
+#include "zeroengine_benchmarks/Microbenchmark.hpp"
+
+#if defined(ZEROENGINE_BENCHMARKS_VULKAN)
+#include "zeroengine_vulkan/VulkanPipelineManager.hpp"
+#endif
+
+namespace ZEROengine {
+    namespace {
+        constexpr uint32_t const_pipeline_counts[] = {16, 256, 4096};
+        constexpr uint32_t const_recorded_draws = 256;
+        constexpr uint32_t const_lookups_per_iteration = 64;
+
+        struct PipelineObject {
+            void* pipeline;
+            void* layout;
+        };
+
+        /**
+         * @brief Pipeline hashes as the manager receives them, and a shuffled lookup order so lookups miss the cache
+         * the way a sorted frame does.
+         *
+         */
+        struct PipelineKeys {
+            std::vector<std::size_t> hashes;
+            std::vector<uint32_t> order;
+
+            PipelineKeys(const uint32_t &count) {
+                for(uint32_t i = 0; i < count; ++i) {
+                    hashes.push_back(hash_combine(hash_combine(0, i), count));
+                }
+                uint64_t state = 0x9E3779B97F4A7C15ull;
+                for(uint32_t i = 0; i < const_lookups_per_iteration; ++i) {
+                    state = state * 6364136223846793005ull + 1442695040888963407ull;
+                    order.push_back(static_cast<uint32_t>((state >> 33) % count));
+                }
+            }
+        };
+
+        void recordDraws(GPUCommandStream &stream) {
+            for(uint32_t draw = 0; draw < const_recorded_draws; ++draw) {
+                stream.bindPipeline(draw & 15);
+                stream.bindVertexBuffer(0, draw & 63);
+                stream.draw(36);
+            }
+        }
+    } // namespace
+
+    void registerGraphicalMicrobenchmarks(MicrobenchmarkSuite &suite) {
+        for(const uint32_t &count : const_pipeline_counts) {
+            std::shared_ptr<PipelineKeys> keys = std::make_shared<PipelineKeys>(count);
+
+            // same containers as VulkanPipelineManager: hash to handle, then handle to objects in a dense table
+            std::shared_ptr<std::unordered_map<std::size_t, GPUPipelineHandle>> lookup = std::make_shared<std::unordered_map<std::size_t, GPUPipelineHandle>>();
+            std::shared_ptr<GPUHandleTable<PipelineObject>> table = std::make_shared<GPUHandleTable<PipelineObject>>();
+            std::shared_ptr<std::vector<GPUPipelineHandle>> handles = std::make_shared<std::vector<GPUPipelineHandle>>();
+            for(const std::size_t &hash : keys->hashes) {
+                GPUPipelineHandle handle = table->insert({nullptr, nullptr});
+                (*lookup)[hash] = handle;
+                handles->push_back(handle);
+            }
+
+            suite.add("pipeline_lookup/hash_map/" + std::to_string(count), [keys, lookup](const uint64_t &iterations) {
+                GPUPipelineHandle sum = 0;
+                for(uint64_t i = 0; i < iterations; ++i) {
+                    for(const uint32_t &index : keys->order) {
+                        auto it = lookup->find(keys->hashes[index]);
+                        sum += it == lookup->end() ? const_gpu_invalid_handle : it->second;
+                    }
+                }
+                doNotOptimize(sum);
+            }, const_lookups_per_iteration, "lookups");
+            // the full lookup of a pipeline by its hash, as VulkanPipelineManager resolves it
+            suite.add("pipeline_lookup/hash_map_then_table/" + std::to_string(count), [keys, lookup, table](const uint64_t &iterations) {
+                uintptr_t sum = 0;
+                for(uint64_t i = 0; i < iterations; ++i) {
+                    for(const uint32_t &index : keys->order) {
+                        auto it = lookup->find(keys->hashes[index]);
+                        if(it != lookup->end()) {
+                            sum += reinterpret_cast<uintptr_t>(table->get(it->second).pipeline);
+                        }
+                    }
+                }
+                doNotOptimize(sum);
+            }, const_lookups_per_iteration, "lookups");
+            // handles already resolved and kept by the caller, no hashing
+            suite.add("pipeline_lookup/handle_table_get/" + std::to_string(count), [keys, table, handles](const uint64_t &iterations) {
+                uintptr_t sum = 0;
+                for(uint64_t i = 0; i < iterations; ++i) {
+                    for(const uint32_t &index : keys->order) {
+                        sum += reinterpret_cast<uintptr_t>(table->get((*handles)[index]).pipeline);
+                    }
+                }
+                doNotOptimize(sum);
+            }, const_lookups_per_iteration, "lookups");
+
+#if defined(ZEROENGINE_BENCHMARKS_VULKAN)
+            // null pipelines, the manager is never cleaned up so nothing reaches the driver
+            std::shared_ptr<VulkanPipelineManager> manager = std::make_shared<VulkanPipelineManager>();
+            for(const std::size_t &hash : keys->hashes) {
+                manager->registerPipeline(hash, {VK_NULL_HANDLE, VK_NULL_HANDLE});
+            }
+            suite.add("pipeline_lookup/vulkan_pipeline_manager/" + std::to_string(count), [keys, manager](const uint64_t &iterations) {
+                GPUPipelineHandle sum = 0;
+                for(uint64_t i = 0; i < iterations; ++i) {
+                    for(const uint32_t &index : keys->order) {
+                        sum += manager->getPipelineHandle(keys->hashes[index]);
+                    }
+                }
+                doNotOptimize(sum);
+            }, const_lookups_per_iteration, "lookups");
+#endif
+        }
+
+        // three commands per draw
+        std::shared_ptr<GPUCommandStream> stream = std::make_shared<GPUCommandStream>();
+        suite.add("command_stream/record", [stream](const uint64_t &iterations) {
+            for(uint64_t i = 0; i < iterations; ++i) {
+                stream->reset();
+                recordDraws(*stream);
+                doNotOptimize(stream->data());
+            }
+        }, const_recorded_draws * 3, "commands");
+
+        std::shared_ptr<GPUCommandStream> recorded = std::make_shared<GPUCommandStream>();
+        recordDraws(*recorded);
+        std::shared_ptr<NullCommandBuffer> command_buffer = std::make_shared<NullCommandBuffer>(std::make_shared<NullGraphicalCounters>());
+        suite.add("command_stream/replay_null", [recorded, command_buffer](const uint64_t &iterations) {
+            for(uint64_t i = 0; i < iterations; ++i) {
+                command_buffer->execute(*recorded);
+            }
+        }, const_recorded_draws * 3, "commands");
+
+        std::shared_ptr<GPUDrawList> draw_list = std::make_shared<GPUDrawList>();
+        std::shared_ptr<GPUCommandStream> emitted = std::make_shared<GPUCommandStream>();
+        suite.add("draw_list/submit_sort_emit", [draw_list, emitted](const uint64_t &iterations) {
+            GPUDrawDescription draw{};
+            draw.vertex_count = 36;
+            for(uint64_t i = 0; i < iterations; ++i) {
+                draw_list->reset();
+                for(uint32_t index = 0; index < const_recorded_draws; ++index) {
+                    draw.pipeline = (index * 7) & 15;
+                    draw.material = (index * 13) & 63;
+                    draw.vertex_buffer = (index * 31) & 63;
+                    draw_list->submit(0, static_cast<float>(index) / const_recorded_draws, draw);
+                }
+                draw_list->sort();
+                emitted->reset();
+                draw_list->emit(*emitted);
+                doNotOptimize(emitted->data());
+            }
+        }, const_recorded_draws, "draws");
+    }
+} // namespace ZEROengine
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include "zeroengine_benchmarks/Microbenchmark.hpp"
+
+namespace ZEROengine {
+    typedef std::chrono::steady_clock MicrobenchmarkClock;
+
+    static double measure(const Microbenchmark &benchmark, const uint64_t &iterations) {
+        MicrobenchmarkClock::time_point start = MicrobenchmarkClock::now();
+        benchmark.body(iterations);
+        return std::chrono::duration<double, std::nano>(MicrobenchmarkClock::now() - start).count();
+    }
+
+    MicrobenchmarkSuite::MicrobenchmarkSuite(const MicrobenchmarkConfig &config) :
+    m_benchmarks{},
+    m_config{config},
+    m_pinned{false}
+    {}
+
+    void MicrobenchmarkSuite::add(const std::string &name, const MicrobenchmarkBody &body, const uint64_t &items_per_iteration, const char* item_unit) {
+        m_benchmarks.push_back({name, body, items_per_iteration, item_unit});
+    }
+
+    bool MicrobenchmarkSuite::pinThread() {
+        if(m_config.cpu < 0) {
+            return false;
+        }
+#if defined(__linux__)
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(m_config.cpu, &cpu_set);
+        m_pinned = sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0;
+#elif defined(_WIN32)
+        m_pinned = SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << m_config.cpu) != 0;
+#endif
+        return m_pinned;
+    }
+
+    uint64_t MicrobenchmarkSuite::calibrate(const Microbenchmark &benchmark) const {
+        // grow until a run is long enough for the clock resolution, then scale to the repetition length
+        const double target_ns = m_config.min_repetition_ms * 1e6;
+        uint64_t iterations = 1;
+        while(true) {
+            double elapsed_ns = measure(benchmark, iterations);
+            if(elapsed_ns >= target_ns * 0.1 || iterations >= (uint64_t(1) << 40)) {
+                double per_iteration_ns = std::max(elapsed_ns / static_cast<double>(iterations), 0.01);
+                return std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(target_ns / per_iteration_ns)));
+            }
+            iterations *= 10;
+        }
+    }
+
+    std::vector<std::string> MicrobenchmarkSuite::getNames() const {
+        std::vector<std::string> names;
+        for(const Microbenchmark &benchmark : m_benchmarks) {
+            names.push_back(benchmark.name);
+        }
+        return names;
+    }
+
+    std::vector<MicrobenchmarkResult> MicrobenchmarkSuite::run() {
+        std::vector<MicrobenchmarkResult> results;
+        std::vector<double> samples;
+        for(const Microbenchmark &benchmark : m_benchmarks) {
+            if(!m_config.filter.empty() && benchmark.name.find(m_config.filter) == std::string::npos) {
+                continue;
+            }
+            uint64_t iterations = calibrate(benchmark);
+            measure(benchmark, iterations); // warm caches and branch predictors
+
+            samples.clear();
+            for(uint32_t repetition = 0; repetition < m_config.repetitions; ++repetition) {
+                samples.push_back(measure(benchmark, iterations) / static_cast<double>(iterations));
+            }
+            std::sort(samples.begin(), samples.end());
+
+            MicrobenchmarkResult result{};
+            result.name = benchmark.name;
+            result.iterations = iterations;
+            result.repetitions = m_config.repetitions;
+            result.items_per_iteration = benchmark.items_per_iteration;
+            result.item_unit = benchmark.item_unit;
+            if(!samples.empty()) {
+                double sum = 0.0;
+                for(const double &sample : samples) {
+                    sum += sample;
+                }
+                result.mean_ns = sum / static_cast<double>(samples.size());
+                double squared_deviations = 0.0;
+                for(const double &sample : samples) {
+                    squared_deviations += (sample - result.mean_ns) * (sample - result.mean_ns);
+                }
+                // sample standard deviation, the repetitions are a sample of every possible run
+                result.stddev_ns = samples.size() > 1 ? std::sqrt(squared_deviations / static_cast<double>(samples.size() - 1)) : 0.0;
+                result.cv = result.mean_ns > 0.0 ? result.stddev_ns / result.mean_ns : 0.0;
+                std::size_t middle = samples.size() / 2;
+                result.median_ns = samples.size() % 2 == 1 ? samples[middle] : 0.5 * (samples[middle - 1] + samples[middle]);
+                result.min_ns = samples.front();
+                result.max_ns = samples.back();
+                if(result.items_per_iteration > 0 && result.median_ns > 0.0) {
+                    result.items_per_second = static_cast<double>(result.items_per_iteration) * 1e9 / result.median_ns;
+                }
+            }
+            results.push_back(result);
+        }
+        return results;
+    }
+
+    void MicrobenchmarkSuite::writeJSON(std::ostream &output, const std::vector<MicrobenchmarkResult> &results) const {
+        output << "{\n";
+        output << "  \"config\": {\n";
+        output << "    \"filter\": \"" << m_config.filter << "\",\n";
+        output << "    \"repetitions\": " << m_config.repetitions << ",\n";
+        output << "    \"min_repetition_ms\": " << m_config.min_repetition_ms << ",\n";
+        output << "    \"cpu\": " << m_config.cpu << ",\n";
+        output << "    \"pinned\": " << (m_pinned ? "true" : "false") << ",\n";
+        output << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << "\n";
+        output << "  },\n";
+        output << "  \"benchmarks\": [";
+        for(std::size_t i = 0; i < results.size(); ++i) {
+            const MicrobenchmarkResult &result = results[i];
+            output << (i == 0 ? "\n" : ",\n");
+            output << "    { \"name\": \"" << result.name << "\""
+                << ", \"iterations\": " << result.iterations
+                << ", \"repetitions\": " << result.repetitions
+                << ", \"mean_ns\": " << result.mean_ns
+                << ", \"median_ns\": " << result.median_ns
+                << ", \"min_ns\": " << result.min_ns
+                << ", \"max_ns\": " << result.max_ns
+                << ", \"stddev_ns\": " << result.stddev_ns
+                << ", \"cv\": " << result.cv;
+            if(result.items_per_iteration > 0) {
+                output << ", \"" << result.item_unit << "_per_second\": " << result.items_per_second;
+            }
+            output << " }";
+        }
+        output << "\n  ]\n";
+        output << "}\n";
+    }
+} // namespace ZEROengine
@@ -0,0 +1,115 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "zeroengine_benchmarks/BenchmarkHarness.hpp"
+#include "zeroengine_benchmarks/BenchmarkScenes.hpp"
+
+using namespace ZEROengine;
+
+static void printUsage() {
+    std::cerr
+        << "usage: ZEROengineBenchmarks [options]\n"
+        << "  --backend <null|software>  graphical backend (default null)\n"
+        << "  --scene <name>             scene to run, repeatable (default every scene)\n"
+        << "  --frames <count>           measured frames per scene (default 1000)\n"
+        << "  --warmup <count>           frames run before measuring (default 100)\n"
+        << "  --width <pixels>           software framebuffer width (default 1280)\n"
+        << "  --height <pixels>          software framebuffer height (default 720)\n"
+        << "  --threads <count>          software rasterizer threads, 0 for every core (default 0)\n"
+        << "  --seed <value>             seed of the scene contents (default 24301)\n"
+        << "  --strict-allocations       fail when a measured frame allocates on the heap (allocation tracking builds)\n"
+        << "  --output <path>            JSON report path (default stdout)\n"
+        << "  --list                     print the scene names and exit\n";
+}
+
+/**
+ * @brief Parse an unsigned integer option value.
+ *
+ * @return false if the value is missing or not a number.
+ */
+static bool parseNumber(const int &argc, char** argv, int &i, uint64_t &value) {
+    if(i + 1 >= argc) {
+        return false;
+    }
+    char* end = nullptr;
+    value = std::strtoull(argv[++i], &end, 0);
+    return end != nullptr && *end == '\0';
+}
+
+int main(int argc, char** argv) {
+    BenchmarkConfig config{};
+    std::string output_path;
+    for(int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        uint64_t value = 0;
+        if(option == "--backend" && i + 1 < argc) {
+            config.backend = argv[++i];
+        } else if(option == "--scene" && i + 1 < argc) {
+            config.scenes.push_back(argv[++i]);
+        } else if(option == "--output" && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if(option == "--frames" && parseNumber(argc, argv, i, value)) {
+            config.frames = static_cast<uint32_t>(value);
+        } else if(option == "--warmup" && parseNumber(argc, argv, i, value)) {
+            config.warmup_frames = static_cast<uint32_t>(value);
+        } else if(option == "--width" && parseNumber(argc, argv, i, value)) {
+            config.width = static_cast<uint32_t>(value);
+        } else if(option == "--height" && parseNumber(argc, argv, i, value)) {
+            config.height = static_cast<uint32_t>(value);
+        } else if(option == "--threads" && parseNumber(argc, argv, i, value)) {
+            config.threads = static_cast<uint32_t>(value);
+        } else if(option == "--seed" && parseNumber(argc, argv, i, value)) {
+            config.seed = value;
+        } else if(option == "--strict-allocations") {
+            config.strict_allocations = true;
+        } else if(option == "--list") {
+            for(const std::string &name : getBenchmarkSceneNames()) {
+                std::cout << name << std::endl;
+            }
+            return EXIT_SUCCESS;
+        } else {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+    if(config.scenes.empty()) {
+        config.scenes = getBenchmarkSceneNames();
+    }
+
+    try {
+        std::unique_ptr<BenchmarkBackend> backend = BenchmarkBackend::create(config);
+        if(!backend) {
+            std::cerr << "unknown backend: " << config.backend << std::endl;
+            return EXIT_FAILURE;
+        }
+        BenchmarkRunner runner(config);
+        std::vector<BenchmarkSceneResult> results;
+        for(const std::string &name : config.scenes) {
+            std::unique_ptr<BenchmarkScene> scene = createBenchmarkScene(name);
+            if(!scene) {
+                std::cerr << "unknown scene: " << name << std::endl;
+                return EXIT_FAILURE;
+            }
+            results.push_back(runner.run(*backend, *scene));
+        }
+        backend->cleanup();
+
+        if(output_path.empty()) {
+            runner.writeJSON(std::cout, results);
+        } else {
+            std::ofstream output(output_path);
+            if(!output.is_open()) {
+                std::cerr << "cannot write " << output_path << std::endl;
+                return EXIT_FAILURE;
+            }
+            runner.writeJSON(output, results);
+        }
+    } catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,75 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "zeroengine_benchmarks/Microbenchmark.hpp"
+
+using namespace ZEROengine;
+
+static void printUsage() {
+    std::cerr
+        << "usage: ZEROengineMicrobenchmarks [options]\n"
+        << "  --filter <text>            run the benchmarks whose name contains the text\n"
+        << "  --repetitions <count>      measured repetitions per benchmark (default 10)\n"
+        << "  --min-time <ms>            minimum duration of a repetition (default 20)\n"
+        << "  --cpu <index>              pin the benchmark thread to a core\n"
+        << "  --output <path>            JSON report path (default stdout)\n"
+        << "  --list                     print the benchmark names and exit\n";
+}
+
+int main(int argc, char** argv) {
+    MicrobenchmarkConfig config{};
+    std::string output_path;
+    bool list = false;
+    for(int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        bool has_value = i + 1 < argc;
+        if(option == "--filter" && has_value) {
+            config.filter = argv[++i];
+        } else if(option == "--repetitions" && has_value) {
+            config.repetitions = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if(option == "--min-time" && has_value) {
+            config.min_repetition_ms = std::strtod(argv[++i], nullptr);
+        } else if(option == "--cpu" && has_value) {
+            config.cpu = static_cast<int32_t>(std::strtol(argv[++i], nullptr, 10));
+        } else if(option == "--output" && has_value) {
+            output_path = argv[++i];
+        } else if(option == "--list") {
+            list = true;
+        } else {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+    if(config.repetitions == 0 || config.min_repetition_ms <= 0.0) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    MicrobenchmarkSuite suite(config);
+    registerCoreMicrobenchmarks(suite);
+    registerGraphicalMicrobenchmarks(suite);
+    if(list) {
+        for(const std::string &name : suite.getNames()) {
+            std::cout << name << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+    if(config.cpu >= 0 && !suite.pinThread()) {
+        std::cerr << "cannot pin the thread to cpu " << config.cpu << ", running unpinned" << std::endl;
+    }
+
+    std::vector<MicrobenchmarkResult> results = suite.run();
+    if(output_path.empty()) {
+        suite.writeJSON(std::cout, results);
+        return EXIT_SUCCESS;
+    }
+    std::ofstream output(output_path);
+    if(!output.is_open()) {
+        std::cerr << "cannot write " << output_path << std::endl;
+        return EXIT_FAILURE;
+    }
+    suite.writeJSON(output, results);
+    return EXIT_SUCCESS;
+}
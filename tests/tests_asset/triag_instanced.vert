@@ -0,0 +1,18 @@
+#version 450
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 projection;
+} ubo;
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in mat4 inInstanceModel;
+
+layout(location = 0) out vec3 fragColor;
+
+void main() {
+    gl_Position = ubo.projection * ubo.view * inInstanceModel * vec4(inPosition, 0.0, 1.0);
+    fragColor = inColor;
+}
@@ -0,0 +1,29 @@
+#ifndef ZEROENGINE_UNITTEST_H
+#define ZEROENGINE_UNITTEST_H
+
+#include <cstdint>
+#include <iostream>
+
+namespace ZEROengine {
+    /**
+     * @brief Failed checks of the running test executable, returned by main() through ZERO_TEST_RESULT.
+     *
+     */
+    inline uint32_t& unitTestFailures() {
+        static uint32_t failures = 0;
+        return failures;
+    }
+} // namespace ZEROengine
+
+// records a failure and keeps going, so one run reports every broken expectation
+#define ZERO_TEST_CHECK(condition) \
+    do { \
+        if(!(condition)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " << #condition << std::endl; \
+            ++ZEROengine::unitTestFailures(); \
+        } \
+    } while(0)
+
+#define ZERO_TEST_RESULT() (ZEROengine::unitTestFailures() == 0 ? 0 : 1)
+
+#endif // #ifndef ZEROENGINE_UNITTEST_H
@@ -0,0 +1,261 @@
+#include "zeroengine_graphical/GPUDrawList.hpp"
+#include "zeroengine_null/NullDevice.hpp"
+#include "zeroengine_tests/UnitTest.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace ZEROengine;
+
+namespace {
+    GPUDrawDescription makeDraw(const uint32_t &pipeline, const uint32_t &material, const uint32_t &mesh, const uint32_t &id) {
+        GPUDrawDescription draw{};
+        draw.pipeline = pipeline;
+        draw.material = material;
+        draw.vertex_buffer = mesh;
+        draw.vertex_count = 3;
+        draw.first_vertex = id; // identifies the draw once sorted
+        return draw;
+    }
+
+    std::vector<uint32_t> sortedIds(const GPUDrawList &draw_list) {
+        std::vector<uint32_t> ids;
+        for(std::size_t i = 0; i < draw_list.countDraws(); ++i) {
+            ids.push_back(draw_list.getSortedDraw(i).first_vertex);
+        }
+        return ids;
+    }
+
+    constexpr uint32_t const_test_instances_per_frame = 16;
+    constexpr uint32_t const_test_instance_binding = 1;
+
+    struct RecordedDraw {
+        uint32_t vertex_count;
+        uint32_t instance_count;
+        uint32_t first_instance;
+    };
+
+    struct EmittedInstances {
+        std::vector<RecordedDraw> draws;
+        uint32_t instance_buffer_binds = 0;
+    };
+
+    EmittedInstances readDraws(const GPUCommandStream &stream, const GPUBufferHandle &instance_buffer) {
+        EmittedInstances emitted;
+        GPUCommandStreamReader reader(stream);
+        const GPUCommandHeader *header = nullptr;
+        while(reader.next(header)) {
+            if(header->type == ZERO_COMMAND_DRAW) {
+                const GPUCommandDraw *draw = reinterpret_cast<const GPUCommandDraw*>(header);
+                emitted.draws.push_back({draw->vertex_count, draw->instance_count, draw->first_instance});
+            } else if(header->type == ZERO_COMMAND_BIND_VERTEX_BUFFER) {
+                const GPUCommandBindVertexBuffer *bind = reinterpret_cast<const GPUCommandBindVertexBuffer*>(header);
+                if(bind->binding == const_test_instance_binding && bind->buffer == instance_buffer) {
+                    ++emitted.instance_buffer_binds;
+                }
+            }
+        }
+        return emitted;
+    }
+
+    // the first matrix element identifies the instance
+    GPUInstanceTransform makeTransform(const float &id) {
+        GPUInstanceTransform transform{};
+        transform.model[0] = id;
+        return transform;
+    }
+
+    float streamedId(NullDevice &device, const GPUStreamingBuffer &buffer, const uint32_t &element) {
+        const GPUInstanceTransform *transforms = static_cast<const GPUInstanceTransform*>(device.getBufferMapped(buffer.getBufferHandle()));
+        return transforms[element].model[0];
+    }
+
+    void testKeyOrder() {
+        GPUDrawList draw_list;
+        // layer first, then pipeline, material, mesh and depth
+        draw_list.submit(1, 0.0f, makeDraw(0, 0, 0, 0));
+        draw_list.submit(0, 0.5f, makeDraw(1, 0, 0, 1));
+        draw_list.submit(0, 0.9f, makeDraw(0, 1, 0, 2));
+        draw_list.submit(0, 0.7f, makeDraw(0, 0, 1, 3));
+        draw_list.submit(0, 0.8f, makeDraw(0, 0, 0, 4));
+        draw_list.submit(0, 0.2f, makeDraw(0, 0, 0, 5));
+        draw_list.sort();
+        ZERO_TEST_CHECK((sortedIds(draw_list) == std::vector<uint32_t>{5, 4, 3, 2, 1, 0}));
+    }
+
+    void testEqualKeysKeepSubmissionOrder() {
+        GPUDrawList draw_list;
+        const uint32_t draw_count = 20000;
+        std::vector<uint32_t> expected_first;
+        std::vector<uint32_t> expected_second;
+        for(uint32_t i = 0; i < draw_count; ++i) {
+            // two interleaved pipelines, every draw of a pipeline has the same key
+            uint32_t pipeline = (i * 7) % 2;
+            draw_list.submit(0, 0.5f, makeDraw(pipeline, 3, 4, i));
+            (pipeline == 0 ? expected_first : expected_second).push_back(i);
+        }
+        ThreadPool thread_pool(4);
+        draw_list.sort(&thread_pool);
+
+        std::vector<uint32_t> expected = expected_first;
+        expected.insert(expected.end(), expected_second.begin(), expected_second.end());
+        ZERO_TEST_CHECK(sortedIds(draw_list) == expected);
+    }
+
+    void testMinimalBinds() {
+        GPUDrawList draw_list;
+        for(uint32_t i = 0; i < 12; ++i) {
+            draw_list.submit(0, 0.5f, makeDraw(i % 3, i % 2, 0, i));
+        }
+        draw_list.sort();
+        GPUCommandStream stream;
+        draw_list.emit(stream);
+
+        const GPUDrawListStatistics &statistics = draw_list.getStatistics();
+        ZERO_TEST_CHECK(statistics.draws == 12);
+        ZERO_TEST_CHECK(statistics.pipeline_binds == 3);
+        // a pipeline bind invalidates the material, each pipeline uses both materials
+        ZERO_TEST_CHECK(statistics.descriptor_set_binds == 6);
+        ZERO_TEST_CHECK(statistics.vertex_buffer_binds == 1);
+    }
+
+    void testUnboundHandlesSortLast() {
+        GPUDrawList draw_list;
+        draw_list.submit(0, 0.5f, makeDraw(0, const_gpu_invalid_handle, 0, 0));
+        draw_list.submit(0, 0.5f, makeDraw(0, (1u << const_draw_key_material_bits) - 2, 0, 1));
+        draw_list.sort();
+        ZERO_TEST_CHECK((sortedIds(draw_list) == std::vector<uint32_t>{1, 0}));
+    }
+
+    void testOutOfRangeFieldsThrow() {
+        bool handle_thrown = false;
+        try {
+            GPUDrawList::makeKey(0, 0.5f, makeDraw(1u << const_draw_key_pipeline_bits, 0, 0, 0));
+        } catch(const std::runtime_error&) {
+            handle_thrown = true;
+        }
+        ZERO_TEST_CHECK(handle_thrown);
+
+        bool layer_thrown = false;
+        try {
+            GPUDrawList::makeKey(1u << const_draw_key_layer_bits, 0.5f, makeDraw(0, 0, 0, 0));
+        } catch(const std::runtime_error&) {
+            layer_thrown = true;
+        }
+        ZERO_TEST_CHECK(layer_thrown);
+    }
+    void testInstancesMerge() {
+        NullDevice device(std::make_shared<NullGraphicalCounters>());
+        GPUStreamingBuffer buffer(&device, sizeof(GPUInstanceTransform), const_test_instances_per_frame, 2, ZERO_BUFFER_USAGE_VERTEX_BUFFER);
+        GPUDrawList draw_list;
+        draw_list.setInstanceBuffer(&buffer, const_test_instance_binding);
+
+        // two meshes submitted interleaved, depth orders the instances of a mesh
+        draw_list.submitInstance(0, 0.3f, makeDraw(0, 0, 1, 0), makeTransform(13.0f));
+        draw_list.submitInstance(0, 0.5f, makeDraw(0, 0, 0, 0), makeTransform(5.0f));
+        draw_list.submitInstance(0, 0.1f, makeDraw(0, 0, 0, 0), makeTransform(1.0f));
+        draw_list.submitInstance(0, 0.2f, makeDraw(0, 0, 1, 0), makeTransform(12.0f));
+        draw_list.submitInstance(0, 0.3f, makeDraw(0, 0, 0, 0), makeTransform(3.0f));
+        draw_list.sort();
+        GPUCommandStream stream;
+        draw_list.emit(stream);
+
+        EmittedInstances emitted = readDraws(stream, buffer.getBufferHandle());
+        ZERO_TEST_CHECK(emitted.instance_buffer_binds == 1);
+        ZERO_TEST_CHECK(emitted.draws.size() == 2);
+        if(emitted.draws.size() == 2) {
+            ZERO_TEST_CHECK(emitted.draws[0].instance_count == 3 && emitted.draws[0].first_instance == 0);
+            ZERO_TEST_CHECK(emitted.draws[1].instance_count == 2 && emitted.draws[1].first_instance == 3);
+        }
+        // transforms land in key order at first_instance
+        const float expected[5] = {1.0f, 3.0f, 5.0f, 12.0f, 13.0f};
+        for(uint32_t element = 0; element < 5; ++element) {
+            ZERO_TEST_CHECK(streamedId(device, buffer, element) == expected[element]);
+        }
+        ZERO_TEST_CHECK(buffer.getUsedElements() == 5);
+
+        const GPUDrawListStatistics &statistics = draw_list.getStatistics();
+        ZERO_TEST_CHECK(statistics.draws == 2);
+        ZERO_TEST_CHECK(statistics.instanced_batches == 2);
+        ZERO_TEST_CHECK(statistics.instances_batched == 5);
+
+        buffer.cleanup();
+        device.cleanup();
+    }
+
+    void testFirstInstanceInFrameSegment() {
+        NullDevice device(std::make_shared<NullGraphicalCounters>());
+        GPUStreamingBuffer buffer(&device, sizeof(GPUInstanceTransform), const_test_instances_per_frame, 2, ZERO_BUFFER_USAGE_VERTEX_BUFFER);
+        GPUDrawList draw_list;
+        draw_list.setInstanceBuffer(&buffer, const_test_instance_binding);
+
+        // the second frame writes the second segment of the buffer
+        buffer.beginFrame();
+        draw_list.submitInstance(0, 0.5f, makeDraw(0, 0, 0, 0), makeTransform(7.0f));
+        draw_list.submitInstance(0, 0.6f, makeDraw(0, 0, 0, 0), makeTransform(8.0f));
+        draw_list.sort();
+        GPUCommandStream stream;
+        draw_list.emit(stream);
+
+        EmittedInstances emitted = readDraws(stream, buffer.getBufferHandle());
+        ZERO_TEST_CHECK(emitted.draws.size() == 1);
+        if(emitted.draws.size() == 1) {
+            ZERO_TEST_CHECK(emitted.draws[0].instance_count == 2);
+            ZERO_TEST_CHECK(emitted.draws[0].first_instance == const_test_instances_per_frame);
+        }
+        ZERO_TEST_CHECK(streamedId(device, buffer, const_test_instances_per_frame) == 7.0f);
+        ZERO_TEST_CHECK(streamedId(device, buffer, const_test_instances_per_frame + 1) == 8.0f);
+
+        buffer.cleanup();
+        device.cleanup();
+    }
+
+    void testUnbatchableDrawsSplitRuns() {
+        NullDevice device(std::make_shared<NullGraphicalCounters>());
+        GPUStreamingBuffer buffer(&device, sizeof(GPUInstanceTransform), const_test_instances_per_frame, 2, ZERO_BUFFER_USAGE_VERTEX_BUFFER);
+        GPUDrawList draw_list;
+        draw_list.setInstanceBuffer(&buffer, const_test_instance_binding);
+
+        // same key fields, but a different vertex range and a draw without a transform sort between the instances
+        GPUDrawDescription other_range = makeDraw(0, 0, 0, 0);
+        other_range.vertex_count = 6;
+        draw_list.submitInstance(0, 0.1f, makeDraw(0, 0, 0, 0), makeTransform(1.0f));
+        draw_list.submitInstance(0, 0.2f, makeDraw(0, 0, 0, 0), makeTransform(2.0f));
+        draw_list.submitInstance(0, 0.3f, other_range, makeTransform(3.0f));
+        draw_list.submitInstance(0, 0.4f, makeDraw(0, 0, 0, 0), makeTransform(4.0f));
+        draw_list.submit(0, 0.5f, makeDraw(0, 0, 0, 0));
+        draw_list.submitInstance(0, 0.6f, makeDraw(0, 0, 0, 0), makeTransform(6.0f));
+        draw_list.sort();
+        GPUCommandStream stream;
+        draw_list.emit(stream);
+
+        EmittedInstances emitted = readDraws(stream, buffer.getBufferHandle());
+        ZERO_TEST_CHECK(emitted.draws.size() == 5);
+        if(emitted.draws.size() == 5) {
+            ZERO_TEST_CHECK(emitted.draws[0].instance_count == 2 && emitted.draws[0].first_instance == 0);
+            ZERO_TEST_CHECK(emitted.draws[1].vertex_count == 6 && emitted.draws[1].instance_count == 1 && emitted.draws[1].first_instance == 2);
+            ZERO_TEST_CHECK(emitted.draws[2].instance_count == 1 && emitted.draws[2].first_instance == 3);
+            // the plain draw keeps its own instance range
+            ZERO_TEST_CHECK(emitted.draws[3].instance_count == 1 && emitted.draws[3].first_instance == 0);
+            ZERO_TEST_CHECK(emitted.draws[4].instance_count == 1 && emitted.draws[4].first_instance == 4);
+        }
+        ZERO_TEST_CHECK(streamedId(device, buffer, 4) == 6.0f);
+        ZERO_TEST_CHECK(draw_list.getStatistics().instanced_batches == 4);
+
+        buffer.cleanup();
+        device.cleanup();
+    }
+} // namespace
+
+int main() {
+    testKeyOrder();
+    testEqualKeysKeepSubmissionOrder();
+    testMinimalBinds();
+    testUnboundHandlesSortLast();
+    testOutOfRangeFieldsThrow();
+    testInstancesMerge();
+    testFirstInstanceInFrameSegment();
+    testUnbatchableDrawsSplitRuns();
+    return ZERO_TEST_RESULT();
+}
@@ -0,0 +1,182 @@
+#include "zeroengine_graphical/GPURenderGraph.hpp"
+#include "zeroengine_tests/UnitTest.hpp"
+
+#include <cstddef>
+#include <vector>
+
+using namespace ZEROengine;
+
+namespace {
+    constexpr uint64_t const_test_alignment = 256;
+
+    // RGBA8 sized textures in a single memory type
+    GPUMemoryRequirements queryMemory(const GPURenderGraphTextureDescription &description, const GPUAccessFlags&) {
+        GPUMemoryRequirements requirements{};
+        requirements.size = static_cast<uint64_t>(description.width) * description.height * 4;
+        requirements.alignment = const_test_alignment;
+        requirements.memory_type_bits = 1;
+        return requirements;
+    }
+
+    GPURenderGraphTextureDescription makeDescription(const uint32_t &extent) {
+        GPURenderGraphTextureDescription description{};
+        description.width = extent;
+        description.height = extent;
+        return description;
+    }
+
+    GPURenderGraphResource importBackbuffer(GPURenderGraph &graph) {
+        return graph.importTexture("backbuffer", makeDescription(64), nullptr, nullptr, ZERO_ACCESS_NONE, ZERO_ACCESS_PRESENT);
+    }
+
+    const GPURenderGraphBarrier* findBarrier(const GPURenderGraphBarrier *barriers, const std::size_t &barrier_count, const GPURenderGraphResource &resource) {
+        for(std::size_t i = 0; i < barrier_count; ++i) {
+            if(barriers[i].resource == resource) {
+                return barriers + i;
+            }
+        }
+        return nullptr;
+    }
+
+    void testCulling() {
+        GPURenderGraph graph;
+        GPURenderGraphResource backbuffer = importBackbuffer(graph);
+        GPURenderGraphResource gbuffer = graph.createTexture("gbuffer", makeDescription(64));
+        GPURenderGraphResource unused = graph.createTexture("unused", makeDescription(64));
+        GPURenderGraphResource chained = graph.createTexture("chained", makeDescription(64));
+        GPURenderGraphResource readback = graph.createTexture("readback", makeDescription(64));
+
+        GPURenderGraphPass geometry = graph.addPass("geometry", {});
+        graph.write(geometry, gbuffer, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+        // nothing reads what these two produce, the second one only feeds the first
+        GPURenderGraphPass producer = graph.addPass("producer", {});
+        graph.write(producer, chained, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+        GPURenderGraphPass consumer = graph.addPass("consumer", {});
+        graph.read(consumer, chained, ZERO_ACCESS_SHADER_SAMPLED_READ);
+        graph.write(consumer, unused, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+        GPURenderGraphPass lighting = graph.addPass("lighting", {});
+        graph.read(lighting, gbuffer, ZERO_ACCESS_SHADER_SAMPLED_READ);
+        graph.write(lighting, backbuffer, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+        // kept for its side effect although nothing in the graph reads its result
+        GPURenderGraphPass copy = graph.addPass("copy", {});
+        graph.read(copy, gbuffer, ZERO_ACCESS_TRANSFER_READ);
+        graph.write(copy, readback, ZERO_ACCESS_TRANSFER_WRITE);
+        graph.setSideEffect(copy);
+
+        graph.compile(queryMemory);
+        ZERO_TEST_CHECK((graph.getExecutionOrder() == std::vector<GPURenderGraphPass>{geometry, lighting, copy}));
+        ZERO_TEST_CHECK(graph.isPassCulled(producer));
+        ZERO_TEST_CHECK(graph.isPassCulled(consumer));
+        ZERO_TEST_CHECK(!graph.isPassCulled(copy));
+        ZERO_TEST_CHECK(graph.getStatistics().culled_passes == 2);
+        ZERO_TEST_CHECK(!graph.isTextureAllocated(unused));
+        ZERO_TEST_CHECK(!graph.isTextureAllocated(chained));
+        ZERO_TEST_CHECK(graph.isTextureAllocated(gbuffer));
+        ZERO_TEST_CHECK(graph.getTextureUsage(gbuffer) == (ZERO_ACCESS_COLOR_ATTACHMENT_WRITE | ZERO_ACCESS_SHADER_SAMPLED_READ | ZERO_ACCESS_TRANSFER_READ));
+
+        // an access added to a resource the pass already uses invalidates the compiled graph
+        graph.read(lighting, backbuffer, ZERO_ACCESS_COLOR_ATTACHMENT_READ);
+        ZERO_TEST_CHECK(!graph.isCompiled());
+        graph.compile(queryMemory);
+        ZERO_TEST_CHECK(graph.getPassAccess(lighting, backbuffer) == (ZERO_ACCESS_COLOR_ATTACHMENT_WRITE | ZERO_ACCESS_COLOR_ATTACHMENT_READ));
+    }
+
+    void testBarriers() {
+        GPURenderGraph graph;
+        GPURenderGraphResource backbuffer = importBackbuffer(graph);
+        GPURenderGraphResource shadow = graph.createTexture("shadow", makeDescription(64));
+
+        // declared before the pass producing its input, runs after it
+        GPURenderGraphPass lighting = graph.addPass("lighting", {});
+        graph.read(lighting, shadow, ZERO_ACCESS_SHADER_SAMPLED_READ);
+        graph.write(lighting, backbuffer, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+        GPURenderGraphPass shadows = graph.addPass("shadows", {});
+        graph.write(shadows, shadow, ZERO_ACCESS_DEPTH_ATTACHMENT_WRITE);
+        GPURenderGraphPass overlay = graph.addPass("overlay", {});
+        graph.read(overlay, backbuffer, ZERO_ACCESS_COLOR_ATTACHMENT_READ);
+        graph.write(overlay, backbuffer, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+
+        graph.compile(queryMemory);
+        ZERO_TEST_CHECK((graph.getExecutionOrder() == std::vector<GPURenderGraphPass>{shadows, lighting, overlay}));
+
+        std::size_t barrier_count = 0;
+        const GPURenderGraphBarrier *barriers = graph.getPassBarriers(shadows, barrier_count);
+        ZERO_TEST_CHECK(barrier_count == 1);
+        const GPURenderGraphBarrier *barrier = findBarrier(barriers, barrier_count, shadow);
+        ZERO_TEST_CHECK(barrier != nullptr && barrier->before == ZERO_ACCESS_NONE && barrier->after == ZERO_ACCESS_DEPTH_ATTACHMENT_WRITE && barrier->discard);
+
+        barriers = graph.getPassBarriers(lighting, barrier_count);
+        ZERO_TEST_CHECK(barrier_count == 2);
+        barrier = findBarrier(barriers, barrier_count, shadow);
+        ZERO_TEST_CHECK(barrier != nullptr && barrier->before == ZERO_ACCESS_DEPTH_ATTACHMENT_WRITE && barrier->after == ZERO_ACCESS_SHADER_SAMPLED_READ && !barrier->discard);
+        barrier = findBarrier(barriers, barrier_count, backbuffer);
+        ZERO_TEST_CHECK(barrier != nullptr && barrier->before == ZERO_ACCESS_NONE && barrier->after == ZERO_ACCESS_COLOR_ATTACHMENT_WRITE && barrier->discard);
+
+        // a read-modify-write keeps the contents
+        barriers = graph.getPassBarriers(overlay, barrier_count);
+        ZERO_TEST_CHECK(barrier_count == 1);
+        barrier = findBarrier(barriers, barrier_count, backbuffer);
+        ZERO_TEST_CHECK(barrier != nullptr && barrier->before == ZERO_ACCESS_COLOR_ATTACHMENT_WRITE
+            && barrier->after == (ZERO_ACCESS_COLOR_ATTACHMENT_READ | ZERO_ACCESS_COLOR_ATTACHMENT_WRITE) && !barrier->discard);
+
+        barriers = graph.getFinalBarriers(barrier_count);
+        ZERO_TEST_CHECK(barrier_count == 1);
+        barrier = findBarrier(barriers, barrier_count, backbuffer);
+        ZERO_TEST_CHECK(barrier != nullptr && barrier->after == ZERO_ACCESS_PRESENT && !barrier->discard);
+        ZERO_TEST_CHECK(graph.getStatistics().barriers == 5);
+        ZERO_TEST_CHECK(graph.getStatistics().barrier_batches == 4);
+    }
+
+    void testAliasing() {
+        GPURenderGraph graph;
+        GPURenderGraphResource backbuffer = importBackbuffer(graph);
+        // a chain of post passes, each texture only lives between its writer and its reader
+        std::vector<GPURenderGraphResource> textures = {
+            graph.createTexture("scene", makeDescription(64)),
+            graph.createTexture("bloom", makeDescription(32)),
+            graph.createTexture("tonemapped", makeDescription(64)),
+            graph.createTexture("sharpened", makeDescription(48))
+        };
+        std::vector<GPURenderGraphPass> passes;
+        for(std::size_t i = 0; i <= textures.size(); ++i) {
+            passes.push_back(graph.addPass("post", {}));
+            if(i > 0) {
+                graph.read(passes[i], textures[i - 1], ZERO_ACCESS_SHADER_SAMPLED_READ);
+            }
+            graph.write(passes[i], i < textures.size() ? textures[i] : backbuffer, ZERO_ACCESS_COLOR_ATTACHMENT_WRITE);
+        }
+
+        graph.compile(queryMemory);
+        ZERO_TEST_CHECK(graph.getExecutionOrder() == passes);
+        ZERO_TEST_CHECK(graph.getHeaps().size() == 1);
+        ZERO_TEST_CHECK(graph.getStatistics().aliased_bytes < graph.getStatistics().transient_bytes);
+
+        // textures alive at the same time never share bytes, in execution order texture i lives in passes i and i + 1
+        for(std::size_t i = 0; i < textures.size(); ++i) {
+            const uint64_t offset = graph.getTextureOffset(textures[i]);
+            const uint64_t size = queryMemory(graph.getTextureDescription(textures[i]), ZERO_ACCESS_NONE).size;
+            ZERO_TEST_CHECK(graph.isTextureAllocated(textures[i]));
+            ZERO_TEST_CHECK(offset % const_test_alignment == 0);
+            ZERO_TEST_CHECK(offset + size <= graph.getHeaps()[0].size);
+            if(i + 1 < textures.size()) {
+                const uint64_t next_offset = graph.getTextureOffset(textures[i + 1]);
+                const uint64_t next_size = queryMemory(graph.getTextureDescription(textures[i + 1]), ZERO_ACCESS_NONE).size;
+                ZERO_TEST_CHECK(offset + size <= next_offset || next_offset + next_size <= offset);
+            }
+        }
+
+        // the largest textures take the same bytes, the first use of the later one waits for the last reads of the earlier one
+        ZERO_TEST_CHECK(graph.getTextureOffset(textures[0]) == graph.getTextureOffset(textures[2]));
+        std::size_t barrier_count = 0;
+        const GPURenderGraphBarrier *barriers = graph.getPassBarriers(passes[2], barrier_count);
+        const GPURenderGraphBarrier *barrier = findBarrier(barriers, barrier_count, textures[2]);
+        ZERO_TEST_CHECK(barrier != nullptr && barrier->discard && (barrier->before & ZERO_ACCESS_SHADER_SAMPLED_READ) != 0);
+    }
+} // namespace
+
+int main() {
+    testCulling();
+    testBarriers();
+    testAliasing();
+    return ZERO_TEST_RESULT();
+}
@@ -0,0 +1,151 @@
+#include "zeroengine_graphical/GPUResidencyManager.hpp"
+#include "zeroengine_tests/UnitTest.hpp"
+
+#include <vector>
+
+using namespace ZEROengine;
+
+namespace {
+    // budget of 1000 bytes: evictions start past 900 and stop at 800
+    constexpr uint64_t const_test_budget = 1000;
+
+    // advance past the frames in flight so that every resource registered so far may be evicted
+    void settle(GPUResidencyManager &manager) {
+        for(uint32_t i = 0; i < const_gpu_residency_release_latency; ++i) {
+            manager.update({0, const_test_budget});
+        }
+    }
+
+    void testUnderWatermark() {
+        GPUResidencyManager manager;
+        uint32_t calls = 0;
+        manager.registerResource(500, 0, [&](const uint64_t&) { ++calls; return uint64_t{500}; });
+        settle(manager);
+
+        ZERO_TEST_CHECK(manager.update({850, const_test_budget}) == 0);
+        ZERO_TEST_CHECK(calls == 0);
+        ZERO_TEST_CHECK(manager.getStatistics().over_budget_frames == 0);
+    }
+
+    void testEvictionOrder() {
+        GPUResidencyManager manager;
+        std::vector<uint32_t> evicted;
+        manager.registerResource(100, 2, [&](const uint64_t&) { evicted.push_back(2); return uint64_t{100}; });
+        manager.registerResource(100, 0, [&](const uint64_t&) { evicted.push_back(0); return uint64_t{100}; });
+        manager.registerResource(100, 1, [&](const uint64_t&) { evicted.push_back(1); return uint64_t{100}; });
+        settle(manager);
+
+        // 1000 used, 200 to free to get back under the low watermark
+        ZERO_TEST_CHECK(manager.update({1000, const_test_budget}) == 200);
+        ZERO_TEST_CHECK((evicted == std::vector<uint32_t>{0, 1}));
+
+        GPUResidencyStatistics statistics = manager.getStatistics();
+        ZERO_TEST_CHECK(statistics.resident_bytes == 100);
+        ZERO_TEST_CHECK(statistics.evicted_bytes == 200);
+        ZERO_TEST_CHECK(statistics.evictions == 2);
+        ZERO_TEST_CHECK(statistics.over_budget_frames == 1);
+    }
+
+    void testLeastRecentlyUsedFirst() {
+        GPUResidencyManager manager;
+        std::vector<uint32_t> evicted;
+        GPUResidencyHandle older = manager.registerResource(100, 0, [&](const uint64_t&) { evicted.push_back(0); return uint64_t{100}; });
+        GPUResidencyHandle newer = manager.registerResource(100, 0, [&](const uint64_t&) { evicted.push_back(1); return uint64_t{100}; });
+        manager.markUsed(older);
+        manager.update({0, const_test_budget});
+        manager.markUsed(newer);
+        settle(manager);
+
+        ZERO_TEST_CHECK(manager.update({1000, const_test_budget}) == 200);
+        ZERO_TEST_CHECK((evicted == std::vector<uint32_t>{0, 1}));
+    }
+
+    void testFramesInFlightProtected() {
+        GPUResidencyManager manager;
+        uint32_t protected_calls = 0;
+        uint32_t idle_calls = 0;
+        GPUResidencyHandle in_flight = manager.registerResource(400, 0, [&](const uint64_t&) { ++protected_calls; return uint64_t{400}; });
+        manager.registerResource(400, 1, [&](const uint64_t&) { ++idle_calls; return uint64_t{400}; });
+        settle(manager);
+        manager.markUsed(in_flight);
+
+        ZERO_TEST_CHECK(manager.update({1000, const_test_budget}) == 400);
+        ZERO_TEST_CHECK(protected_calls == 0);
+        ZERO_TEST_CHECK(idle_calls == 1);
+    }
+
+    void testPartialShrink() {
+        GPUResidencyManager manager;
+        uint64_t wanted = 0;
+        GPUResidencyHandle handle = manager.registerResource(600, 0, [&](const uint64_t &bytes_wanted) {
+            wanted = bytes_wanted;
+            return uint64_t{150}; // drops its far mips only
+        });
+        settle(manager);
+
+        ZERO_TEST_CHECK(manager.update({1000, const_test_budget}) == 150);
+        ZERO_TEST_CHECK(wanted == 200);
+        ZERO_TEST_CHECK(manager.getStatistics().resident_bytes == 450);
+
+        // streamed back in, the manager tracks the new size
+        manager.setSize(handle, 600);
+        ZERO_TEST_CHECK(manager.getStatistics().resident_bytes == 600);
+    }
+
+    void testPendingReleaseNotEvictedTwice() {
+        GPUResidencyManager manager;
+        uint32_t calls = 0;
+        for(uint32_t i = 0; i < 4; ++i) {
+            manager.registerResource(100, 0, [&](const uint64_t&) { ++calls; return uint64_t{100}; });
+        }
+        settle(manager);
+
+        ZERO_TEST_CHECK(manager.update({1000, const_test_budget}) == 200);
+        ZERO_TEST_CHECK(calls == 2);
+
+        // the driver keeps reporting the freed memory until the deletion queue releases it
+        for(uint32_t i = 1; i < const_gpu_residency_release_latency; ++i) {
+            ZERO_TEST_CHECK(manager.update({1000, const_test_budget}) == 0);
+        }
+        ZERO_TEST_CHECK(calls == 2);
+
+        // still over budget once the released bytes aged out, so something else is in use
+        ZERO_TEST_CHECK(manager.update({1000, const_test_budget}) == 200);
+        ZERO_TEST_CHECK(calls == 4);
+    }
+
+    void testReentrantCallbacks() {
+        GPUResidencyManager manager;
+        GPUResidencyHandle unregistered = 0;
+        GPUResidencyHandle resized = 0;
+        unregistered = manager.registerResource(150, 0, [&](const uint64_t&) {
+            manager.unregisterResource(unregistered);
+            return uint64_t{150};
+        });
+        resized = manager.registerResource(400, 1, [&](const uint64_t&) {
+            manager.setSize(resized, 350);
+            manager.markUsed(resized);
+            return uint64_t{0};
+        });
+        settle(manager);
+
+        // returns instead of deadlocking on the manager lock
+        ZERO_TEST_CHECK(manager.update({1000, const_test_budget}) == 150);
+
+        GPUResidencyStatistics statistics = manager.getStatistics();
+        ZERO_TEST_CHECK(statistics.resources == 1);
+        ZERO_TEST_CHECK(statistics.resident_bytes == 350);
+        ZERO_TEST_CHECK(statistics.evictions == 1);
+    }
+} // namespace
+
+int main() {
+    testUnderWatermark();
+    testEvictionOrder();
+    testLeastRecentlyUsedFirst();
+    testFramesInFlightProtected();
+    testPartialShrink();
+    testPendingReleaseNotEvictedTwice();
+    testReentrantCallbacks();
+    return ZERO_TEST_RESULT();
+}
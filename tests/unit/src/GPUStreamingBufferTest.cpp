@@ -0,0 +1,62 @@
+#include "zeroengine_graphical/GPUStreamingBuffer.hpp"
+#include "zeroengine_null/NullDevice.hpp"
+#include "zeroengine_tests/UnitTest.hpp"
+
+#include <memory>
+#include <stdexcept>
+
+using namespace ZEROengine;
+
+namespace {
+    void testSegments() {
+        NullDevice device(std::make_shared<NullGraphicalCounters>());
+        GPUStreamingBuffer buffer(&device, 16, 4, 2, ZERO_BUFFER_USAGE_VERTEX_BUFFER);
+
+        uint32_t first_element = 0;
+        ZERO_TEST_CHECK(buffer.allocate(3, first_element) != nullptr);
+        ZERO_TEST_CHECK(first_element == 0);
+        ZERO_TEST_CHECK(buffer.allocate(2, first_element) == nullptr);
+        ZERO_TEST_CHECK(buffer.allocate(1, first_element) != nullptr);
+        ZERO_TEST_CHECK(first_element == 3);
+
+        // the next frame writes the second segment while the GPU reads the first
+        buffer.beginFrame();
+        ZERO_TEST_CHECK(buffer.allocate(1, first_element) != nullptr);
+        ZERO_TEST_CHECK(first_element == 4);
+        buffer.beginFrame();
+        ZERO_TEST_CHECK(buffer.allocate(1, first_element) != nullptr);
+        ZERO_TEST_CHECK(first_element == 0);
+
+        buffer.cleanup();
+        ZERO_TEST_CHECK(device.getAllocationStatistics().buffers_released == 1);
+        device.cleanup();
+    }
+
+    void testDestroyedAfterDeviceCleanup() {
+        NullDevice device(std::make_shared<NullGraphicalCounters>());
+        {
+            GPUStreamingBuffer buffer(&device, 16, 4, 2, ZERO_BUFFER_USAGE_VERTEX_BUFFER);
+            device.cleanup();
+            // an explicit release of a buffer the device already freed is an error
+            bool thrown = false;
+            try {
+                buffer.cleanup();
+            } catch(const std::runtime_error&) {
+                thrown = true;
+            }
+            ZERO_TEST_CHECK(thrown);
+        }
+        {
+            // the destructor leaves the buffer to the device instead of terminating
+            GPUStreamingBuffer buffer(&device, 16, 4, 2, ZERO_BUFFER_USAGE_VERTEX_BUFFER);
+            device.cleanup();
+        }
+        ZERO_TEST_CHECK(device.getAllocationStatistics().buffers_released == 0);
+    }
+} // namespace
+
+int main() {
+    testSegments();
+    testDestroyedAfterDeviceCleanup();
+    return ZERO_TEST_RESULT();
+}
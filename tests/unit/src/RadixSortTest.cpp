@@ -0,0 +1,111 @@
+#include "zeroengine_core/AllocationTracker.hpp"
+#include "zeroengine_core/RadixSort.hpp"
+#include "zeroengine_core/ThreadPool.hpp"
+#include "zeroengine_tests/UnitTest.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace ZEROengine;
+
+namespace {
+    // large enough to be split into several chunks on the thread pool
+    constexpr uint32_t const_test_key_count = 100000;
+
+    // std::stable_sort of (key, submission index) pairs is the reference order
+    void checkSorted(const std::vector<uint64_t> &input, const std::vector<uint64_t> &keys, const std::vector<uint32_t> &values) {
+        std::vector<uint32_t> expected(input.size());
+        for(uint32_t i = 0; i < expected.size(); ++i) {
+            expected[i] = i;
+        }
+        std::stable_sort(expected.begin(), expected.end(), [&input](const uint32_t &a, const uint32_t &b) {
+            return input[a] < input[b];
+        });
+        ZERO_TEST_CHECK(values == expected);
+        ZERO_TEST_CHECK(std::is_sorted(keys.begin(), keys.end()));
+    }
+
+    void sortAndCheck(const std::vector<uint64_t> &input, ThreadPool *thread_pool) {
+        RadixSorter sorter;
+        std::vector<uint64_t> keys = input;
+        std::vector<uint32_t> values(input.size());
+        for(uint32_t i = 0; i < values.size(); ++i) {
+            values[i] = i;
+        }
+        sorter.sort(keys, values, thread_pool);
+        checkSorted(input, keys, values);
+    }
+
+    void testRandomKeys(ThreadPool *thread_pool) {
+        std::mt19937_64 random(42);
+        std::vector<uint64_t> input(const_test_key_count);
+        for(uint64_t &key : input) {
+            key = random();
+        }
+        sortAndCheck(input, thread_pool);
+    }
+
+    void testStability(ThreadPool *thread_pool) {
+        // few distinct keys spread over the high and low bytes, most keys compare equal
+        std::mt19937_64 random(7);
+        std::vector<uint64_t> input(const_test_key_count);
+        for(uint64_t &key : input) {
+            key = ((random() % 4) << 56) | (random() % 3);
+        }
+        sortAndCheck(input, thread_pool);
+    }
+
+    void testSkippedPasses() {
+        RadixSorter sorter;
+        std::vector<uint64_t> keys = {0x300, 0x100, 0x200, 0x100};
+        std::vector<uint32_t> values = {0, 1, 2, 3};
+        sorter.sort(keys, values);
+        // only the second byte differs between the keys
+        ZERO_TEST_CHECK(sorter.getLastPassCount() == 1);
+        ZERO_TEST_CHECK((values == std::vector<uint32_t>{1, 3, 2, 0}));
+    }
+
+    void testRepeatedSortDoesNotAllocate(ThreadPool *thread_pool) {
+        // only measurable when built with ZEROENGINE_ALLOCATION_TRACKING
+        if(!AllocationTracker::isEnabled()) {
+            return;
+        }
+        std::mt19937_64 random(3);
+        std::vector<uint64_t> input(const_test_key_count);
+        for(uint64_t &key : input) {
+            key = random();
+        }
+        std::vector<uint64_t> keys = input;
+        std::vector<uint32_t> values(input.size(), 0);
+        RadixSorter sorter;
+        sorter.sort(keys, values, thread_pool);
+
+        // the scratch storage is sized by the first sort, the parallel passes must not allocate either
+        keys = input;
+        uint64_t allocations_before = AllocationTracker::getThreadCounters().allocations;
+        sorter.sort(keys, values, thread_pool);
+        ZERO_TEST_CHECK(AllocationTracker::getThreadCounters().allocations == allocations_before);
+    }
+
+    void testEmpty() {
+        RadixSorter sorter;
+        std::vector<uint64_t> keys;
+        std::vector<uint32_t> values;
+        sorter.sort(keys, values);
+        ZERO_TEST_CHECK(keys.empty() && values.empty());
+    }
+} // namespace
+
+int main() {
+    ThreadPool thread_pool(4);
+    testRandomKeys(nullptr);
+    testRandomKeys(&thread_pool);
+    testStability(nullptr);
+    testStability(&thread_pool);
+    testSkippedPasses();
+    testRepeatedSortDoesNotAllocate(nullptr);
+    testRepeatedSortDoesNotAllocate(&thread_pool);
+    testEmpty();
+    return ZERO_TEST_RESULT();
+}
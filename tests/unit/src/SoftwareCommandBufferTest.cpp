@@ -0,0 +1,160 @@
+#include "zeroengine_software/SoftwareCommandBuffer.hpp"
+#include "zeroengine_tests/UnitTest.hpp"
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace ZEROengine;
+
+namespace {
+    constexpr uint32_t const_test_extent = 64;
+    constexpr uint32_t const_test_clear_color = 0xFF000000u;
+
+    struct Replay {
+        std::shared_ptr<SoftwareRasterizer> rasterizer;
+        std::shared_ptr<SoftwareBufferTable> buffers;
+        SoftwareCommandBuffer command_buffer;
+
+        Replay() :
+        rasterizer{std::make_shared<SoftwareRasterizer>(const_test_extent, const_test_extent, 1)},
+        buffers{std::make_shared<SoftwareBufferTable>()},
+        command_buffer{rasterizer, buffers}
+        {
+            rasterizer->setClearColor(const_test_clear_color);
+        }
+
+        template<typename T>
+        GPUBufferHandle upload(const std::vector<T> &elements) {
+            auto storage = std::make_shared<std::vector<uint8_t>>(elements.size() * sizeof(T));
+            std::memcpy(storage->data(), elements.data(), storage->size());
+            return buffers->buffers.insert(std::move(storage));
+        }
+
+        // true when the replay threw
+        bool execute(const GPUCommandStream &stream) {
+            try {
+                command_buffer.execute(stream);
+            } catch(const std::runtime_error&) {
+                return true;
+            }
+            return false;
+        }
+
+        bool covered(const uint32_t &x, const uint32_t &y) {
+            return rasterizer->getFramebuffer().getPixel(x, y) != const_test_clear_color;
+        }
+    };
+
+    // a quad over the left half of the framebuffer, two triangles
+    std::vector<SoftwareVertex> makeQuad() {
+        return {
+            { -1.0f, -1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, -1.0f, 1.0f, 1.0f, 1.0f },
+            { 0.0f, 1.0f, 1.0f, 1.0f, 1.0f }, { -1.0f, 1.0f, 1.0f, 1.0f, 1.0f }
+        };
+    }
+
+    GPUInstanceTransform makeTranslation(const float &x, const float &y) {
+        GPUInstanceTransform transform{};
+        transform.model[0] = 1.0f;
+        transform.model[5] = 1.0f;
+        transform.model[10] = 1.0f;
+        transform.model[15] = 1.0f;
+        transform.model[12] = x;
+        transform.model[13] = y;
+        return transform;
+    }
+
+    void testNegativeVertexOffset() {
+        Replay replay;
+        // the quad sits after two unused vertices, the indices address it from past its end
+        std::vector<SoftwareVertex> vertices(2, SoftwareVertex{});
+        for(const SoftwareVertex &vertex : makeQuad()) {
+            vertices.push_back(vertex);
+        }
+        GPUBufferHandle vertex_buffer = replay.upload(vertices);
+        GPUBufferHandle index_buffer = replay.upload(std::vector<uint32_t>{ 4, 5, 6, 4, 6, 7, 8, 9, 10 });
+
+        GPUCommandStream stream;
+        stream.bindVertexBuffer(0, vertex_buffer);
+        stream.bindIndexBuffer(index_buffer);
+        stream.drawIndexed(6, 1, 0, -2);
+        ZERO_TEST_CHECK(!replay.execute(stream));
+        replay.rasterizer->flush();
+        ZERO_TEST_CHECK(replay.covered(8, 32));
+        ZERO_TEST_CHECK(!replay.covered(56, 32));
+
+        // index 8 fetches vertex 6, past the four bound quad vertices
+        stream.reset();
+        stream.bindVertexBuffer(0, vertex_buffer);
+        stream.bindIndexBuffer(index_buffer);
+        stream.drawIndexed(3, 1, 6, -4);
+        ZERO_TEST_CHECK(replay.execute(stream));
+    }
+
+    void testInstanceTransforms() {
+        Replay replay;
+        GPUBufferHandle vertex_buffer = replay.upload(makeQuad());
+        GPUBufferHandle index_buffer = replay.upload(std::vector<uint32_t>{ 0, 1, 2, 0, 2, 3 });
+        // the first transform is skipped by first_instance, the second moves the quad to the right half
+        GPUBufferHandle instance_buffer = replay.upload(std::vector<GPUInstanceTransform>{
+            makeTranslation(0.0f, 0.0f), makeTranslation(0.0f, 0.0f), makeTranslation(1.0f, 0.0f)
+        });
+
+        GPUCommandStream stream;
+        stream.bindVertexBuffer(0, vertex_buffer);
+        stream.bindVertexBuffer(1, instance_buffer);
+        stream.bindIndexBuffer(index_buffer);
+        stream.drawIndexed(6, 1, 0, 0, 2);
+        ZERO_TEST_CHECK(!replay.execute(stream));
+        replay.rasterizer->flush();
+        ZERO_TEST_CHECK(!replay.covered(8, 32));
+        ZERO_TEST_CHECK(replay.covered(56, 32));
+
+        // each instance reads its own transform, so two instances cover both halves
+        stream.reset();
+        stream.bindVertexBuffer(0, vertex_buffer);
+        stream.bindVertexBuffer(1, instance_buffer);
+        stream.draw(3, 2, 0, 1);
+        stream.draw(3, 2, 1, 1);
+        ZERO_TEST_CHECK(!replay.execute(stream));
+        replay.rasterizer->flush();
+        ZERO_TEST_CHECK(replay.covered(8, 8));
+        ZERO_TEST_CHECK(replay.covered(56, 8));
+
+        // past the bound transforms
+        stream.reset();
+        stream.bindVertexBuffer(0, vertex_buffer);
+        stream.bindVertexBuffer(1, instance_buffer);
+        stream.draw(3, 2, 0, 2);
+        ZERO_TEST_CHECK(replay.execute(stream));
+    }
+
+    void testInstancesWithoutInstanceBuffer() {
+        Replay replay;
+        GPUBufferHandle vertex_buffer = replay.upload(makeQuad());
+
+        GPUCommandStream stream;
+        stream.bindVertexBuffer(0, vertex_buffer);
+        stream.draw(3, 2);
+        ZERO_TEST_CHECK(replay.execute(stream));
+
+        // the instance binding ends with the stream it was bound in
+        GPUBufferHandle instance_buffer = replay.upload(std::vector<GPUInstanceTransform>(2, makeTranslation(0.0f, 0.0f)));
+        stream.reset();
+        stream.bindVertexBuffer(1, instance_buffer);
+        ZERO_TEST_CHECK(!replay.execute(stream));
+        stream.reset();
+        stream.bindVertexBuffer(0, vertex_buffer);
+        stream.draw(3, 2);
+        ZERO_TEST_CHECK(replay.execute(stream));
+    }
+} // namespace
+
+int main() {
+    testNegativeVertexOffset();
+    testInstanceTransforms();
+    testInstancesWithoutInstanceBuffer();
+    return ZERO_TEST_RESULT();
+}
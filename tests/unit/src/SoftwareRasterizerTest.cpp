@@ -0,0 +1,159 @@
+#include "zeroengine_software/SoftwareRasterizer.hpp"
+#include "zeroengine_tests/UnitTest.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace ZEROengine;
+
+namespace {
+    constexpr uint32_t const_test_clear_color = 0xFF000000u;
+    constexpr uint32_t const_test_outline_extent = 64;
+
+    struct Image {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint32_t> pixels; // without the row padding
+    };
+
+    Image render(const uint32_t &width, const uint32_t &height, const uint32_t &thread_count, const bool &simd,
+        const std::vector<SoftwareVertex> &vertices, uint64_t *scalar_fallbacks = nullptr) {
+        SoftwareRasterizer rasterizer(width, height, thread_count);
+        rasterizer.setClearColor(const_test_clear_color);
+        rasterizer.setSIMD(simd);
+        rasterizer.submitTriangles(vertices.data(), static_cast<uint32_t>(vertices.size()));
+        rasterizer.flush();
+        if(scalar_fallbacks != nullptr) {
+            *scalar_fallbacks = rasterizer.getStatistics().scalar_fallbacks;
+        }
+
+        const SoftwareFramebuffer &framebuffer = rasterizer.getFramebuffer();
+        Image image{width, height, {}};
+        image.pixels.reserve(static_cast<std::size_t>(width) * height);
+        for(uint32_t y = 0; y < height; ++y) {
+            for(uint32_t x = 0; x < width; ++x) {
+                image.pixels.push_back(framebuffer.getPixel(x, y));
+            }
+        }
+        return image;
+    }
+
+    // NDC of a pixel center, exactly representable for power of two extents
+    float pixelCenter(const float &pixel, const uint32_t &extent) {
+        return (pixel + 0.5f) / (static_cast<float>(extent) * 0.5f) - 1.0f;
+    }
+
+    SoftwareVertex vertexAt(const float &px, const float &py, const uint32_t &extent, const float &r, const float &g, const float &b) {
+        return { pixelCenter(px, extent), pixelCenter(py, extent), r, g, b };
+    }
+
+    // a grid of quads sharing their edges, random triangles on top and one triangle reaching the guard band
+    std::vector<SoftwareVertex> makeScene(const uint32_t &extent) {
+        std::vector<SoftwareVertex> vertices;
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        constexpr uint32_t grid = 12;
+        const float cell = static_cast<float>(extent) / grid;
+        std::vector<SoftwareVertex> corners;
+        for(uint32_t y = 0; y <= grid; ++y) {
+            for(uint32_t x = 0; x <= grid; ++x) {
+                // corners on pixel centers, so the shared edges run through samples
+                corners.push_back(vertexAt(static_cast<float>(static_cast<uint32_t>(x * cell)), static_cast<float>(static_cast<uint32_t>(y * cell)),
+                    extent, unit(random), unit(random), unit(random)));
+            }
+        }
+        for(uint32_t y = 0; y < grid; ++y) {
+            for(uint32_t x = 0; x < grid; ++x) {
+                const SoftwareVertex &top_left = corners[y * (grid + 1) + x];
+                const SoftwareVertex &top_right = corners[y * (grid + 1) + x + 1];
+                const SoftwareVertex &bottom_left = corners[(y + 1) * (grid + 1) + x];
+                const SoftwareVertex &bottom_right = corners[(y + 1) * (grid + 1) + x + 1];
+                vertices.insert(vertices.end(), { top_left, top_right, bottom_right });
+                vertices.insert(vertices.end(), { top_left, bottom_right, bottom_left });
+            }
+        }
+
+        std::uniform_real_distribution<float> position(-1.2f, 1.2f);
+        for(uint32_t i = 0; i < 64; ++i) {
+            for(uint32_t v = 0; v < 3; ++v) {
+                vertices.push_back({ position(random), position(random), unit(random), unit(random), unit(random) });
+            }
+        }
+
+        // spans the guard band, its edge functions do not fit 32 bits
+        vertices.push_back({ -3.9f, -3.9f, 1.0f, 0.0f, 0.0f });
+        vertices.push_back({ 3.9f, -3.5f, 0.0f, 1.0f, 0.0f });
+        vertices.push_back({ -3.5f, 3.9f, 0.0f, 0.0f, 1.0f });
+        return vertices;
+    }
+
+    void testDeterministicAcrossThreadsAndPaths() {
+        constexpr uint32_t extent = 1024;
+        std::vector<SoftwareVertex> scene = makeScene(extent);
+
+        uint64_t scalar_fallbacks = 0;
+        Image reference = render(extent, extent, 1, false, scene);
+        Image simd_single = render(extent, extent, 1, true, scene, &scalar_fallbacks);
+        Image simd_threaded = render(extent, extent, 4, true, scene);
+        Image scalar_threaded = render(extent, extent, 4, false, scene);
+
+        ZERO_TEST_CHECK(simd_single.pixels == reference.pixels);
+        ZERO_TEST_CHECK(simd_threaded.pixels == reference.pixels);
+        ZERO_TEST_CHECK(scalar_threaded.pixels == reference.pixels);
+
+        SoftwareRasterizer rasterizer(1, 1, 1);
+        if(rasterizer.isSIMD()) {
+            ZERO_TEST_CHECK(scalar_fallbacks > 0);
+        }
+    }
+
+    void testSharedEdgesCoveredOnce(const bool &simd) {
+        // convex outline on pixel centers, triangulated as a fan around an inner pixel and as a fan from its first corner
+        constexpr uint32_t extent = const_test_outline_extent;
+        const float outline[8][2] = {
+            {8, 8}, {32, 4}, {56, 8}, {60, 32}, {56, 56}, {32, 60}, {8, 56}, {4, 32}
+        };
+        auto corner = [&outline](const uint32_t &i) -> SoftwareVertex {
+            return vertexAt(outline[i % 8][0], outline[i % 8][1], const_test_outline_extent, 1.0f, 1.0f, 1.0f);
+        };
+        const SoftwareVertex center = vertexAt(31, 33, extent, 1.0f, 1.0f, 1.0f);
+
+        // every edge inside the outline is shared by two triangles, the top-left rule gives its samples to one of them
+        std::vector<uint32_t> coverage(extent * extent, 0);
+        for(uint32_t i = 0; i < 8; ++i) {
+            Image image = render(extent, extent, 2, simd, std::vector<SoftwareVertex>{ center, corner(i), corner(i + 1) });
+            for(std::size_t pixel = 0; pixel < image.pixels.size(); ++pixel) {
+                coverage[pixel] += image.pixels[pixel] != const_test_clear_color ? 1 : 0;
+            }
+        }
+
+        // any triangulation covers the same samples, a gap along a shared edge would show here
+        std::vector<SoftwareVertex> corner_fan;
+        for(uint32_t i = 1; i + 1 < 8; ++i) {
+            corner_fan.push_back(corner(0));
+            corner_fan.push_back(corner(i));
+            corner_fan.push_back(corner(i + 1));
+        }
+        Image outline_image = render(extent, extent, 2, simd, corner_fan);
+
+        uint32_t covered = 0;
+        uint32_t overlaps = 0;
+        uint32_t mismatches = 0;
+        for(std::size_t pixel = 0; pixel < coverage.size(); ++pixel) {
+            covered += coverage[pixel] > 0 ? 1 : 0;
+            overlaps += coverage[pixel] > 1 ? 1 : 0;
+            mismatches += (coverage[pixel] > 0) != (outline_image.pixels[pixel] != const_test_clear_color) ? 1 : 0;
+        }
+        ZERO_TEST_CHECK(covered > 0);
+        ZERO_TEST_CHECK(overlaps == 0);
+        ZERO_TEST_CHECK(mismatches == 0);
+    }
+} // namespace
+
+int main() {
+    testDeterministicAcrossThreadsAndPaths();
+    testSharedEdgesCoveredOnce(true);
+    testSharedEdgesCoveredOnce(false);
+    return ZERO_TEST_RESULT();
+}